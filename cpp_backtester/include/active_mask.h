@@ -0,0 +1,176 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace atlas {
+
+class ActiveMaskView;
+
+/**
+ * @brief Bitset of active days packed into 64-bit words
+ * Replaces std::vector<bool> day masks on the plan execution path. Mask
+ * algebra works a word (or a SIMD register) at a time, and bits past size()
+ * in the last word are always zero so counts and scans need no tail masking.
+ * Words come from a polymorphic allocator so run-scoped masks can live in a
+ * RunArena; copies without an explicit allocator use the default resource.
+ */
+class ActiveMask {
+public:
+    using Word = uint64_t;
+    using allocator_type = std::pmr::polymorphic_allocator<Word>;
+    static constexpr size_t kWordBits = 64;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    ActiveMask() = default;
+    explicit ActiveMask(size_t size, bool value = false, allocator_type alloc = {});
+    explicit ActiveMask(const ActiveMaskView& view, allocator_type alloc = {});
+    ActiveMask(const ActiveMask& other, allocator_type alloc) : words_(other.words_, alloc), size_(other.size_) {}
+
+    ActiveMask(const ActiveMask&) = default;
+    ActiveMask(ActiveMask&&) = default;
+    ActiveMask& operator=(const ActiveMask&) = default;
+    ActiveMask& operator=(ActiveMask&&) = default;
+
+    /**
+     * @brief Pack a bool vector into a mask
+     * @param bools Day mask
+     * @param alloc Allocator for the words
+     * @return Packed mask
+     */
+    static ActiveMask from_bools(const std::vector<bool>& bools, allocator_type alloc = {});
+
+    /**
+     * @brief Unpack the mask into a bool vector
+     * @return Day mask
+     */
+    std::vector<bool> to_bools() const;
+
+    // Getters
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t word_count() const { return words_.size(); }
+    const Word* data() const { return words_.data(); }
+    allocator_type get_allocator() const { return words_.get_allocator(); }
+
+    bool test(size_t index) const { return (words_[index / kWordBits] >> (index % kWordBits)) & 1u; }
+    bool operator[](size_t index) const { return test(index); }
+
+    void set(size_t index, bool value = true);
+    void fill(bool value);
+    void resize(size_t size, bool value = false);
+
+    // Mask algebra; operands must have the same size
+    ActiveMask& operator&=(const ActiveMask& other);
+    ActiveMask& operator|=(const ActiveMask& other);
+    ActiveMask& and_not(const ActiveMask& other);   // this &= ~other
+    ActiveMask& flip();
+
+    friend ActiveMask operator&(ActiveMask lhs, const ActiveMask& rhs) { return lhs &= rhs; }
+    friend ActiveMask operator|(ActiveMask lhs, const ActiveMask& rhs) { return lhs |= rhs; }
+
+    // Queries
+    size_t count() const;
+    bool any() const;
+    bool none() const { return !any(); }
+    size_t first_set() const;       // npos if no bit is set
+    size_t last_set() const;        // npos if no bit is set
+
+    /**
+     * @brief Call fn(index) for every set bit in ascending order
+     * @param fn Callback taking the bit index
+     */
+    template <typename Fn>
+    void for_each_set(Fn&& fn) const {
+        for (size_t w = 0; w < words_.size(); ++w) {
+            for (Word word = words_[w]; word != 0; word &= word - 1) {
+                fn(w * kWordBits + static_cast<size_t>(std::countr_zero(word)));
+            }
+        }
+    }
+
+    /**
+     * @brief View over the whole mask
+     */
+    ActiveMaskView view() const;
+
+    /**
+     * @brief Offset view over the mask, without copying
+     * Bit i of the view is bit (i + offset) of this mask; bits that fall
+     * outside the mask read as fill. A negative offset pads the front, e.g.
+     * for a sort window or volatility period.
+     * @param offset Offset of view bit 0 in this mask
+     * @param size Number of bits in the view
+     * @param fill Value of bits outside the mask
+     * @return View referencing this mask
+     */
+    ActiveMaskView view(std::ptrdiff_t offset, size_t size, bool fill = false) const;
+
+    bool operator==(const ActiveMask& other) const { return size_ == other.size_ && words_ == other.words_; }
+
+private:
+    static size_t words_for(size_t bits) { return (bits + kWordBits - 1) / kWordBits; }
+    void clear_tail();
+
+    std::pmr::vector<Word> words_;
+    size_t size_{0};
+};
+
+/**
+ * @brief Read-only offset window over an ActiveMask
+ * The referenced mask must outlive the view.
+ */
+class ActiveMaskView {
+public:
+    ActiveMaskView() = default;
+    ActiveMaskView(const ActiveMask& mask, std::ptrdiff_t offset, size_t size, bool fill)
+        : mask_(&mask), offset_(offset), size_(size), fill_(fill) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool fill() const { return fill_; }
+
+    bool test(size_t index) const;
+    bool operator[](size_t index) const { return test(index); }
+
+    /**
+     * @brief Word k of the view: bits [64k, 64k + 64), zero past size()
+     * @param k Word index
+     * @return Packed bits
+     */
+    ActiveMask::Word word(size_t k) const;
+
+    /**
+     * @brief Window into this view; bits past the end of this view read as its fill
+     * @param offset Offset of window bit 0 in this view
+     * @param size Number of bits in the window
+     * @return View over the same mask
+     */
+    ActiveMaskView subview(std::ptrdiff_t offset, size_t size) const {
+        return ActiveMaskView(*mask_, offset_ + offset, size, fill_);
+    }
+
+    size_t count() const;
+    bool any() const;
+
+    template <typename Fn>
+    void for_each_set(Fn&& fn) const {
+        const size_t words = (size_ + ActiveMask::kWordBits - 1) / ActiveMask::kWordBits;
+        for (size_t w = 0; w < words; ++w) {
+            for (ActiveMask::Word bits = word(w); bits != 0; bits &= bits - 1) {
+                fn(w * ActiveMask::kWordBits + static_cast<size_t>(std::countr_zero(bits)));
+            }
+        }
+    }
+
+private:
+    const ActiveMask* mask_ = nullptr;
+    std::ptrdiff_t offset_ = 0;
+    size_t size_ = 0;
+    bool fill_ = false;
+};
+
+} // namespace atlas
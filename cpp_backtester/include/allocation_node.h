@@ -1,22 +1,12 @@
 #pragma once
 
-#include \"node_processor.h\"
+#include "node_processor.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
 
 namespace atlas {
 
-/**
- * @brief Allocation function types
- */
-enum class AllocationFunction {
-    EQUAL_ALLOCATION,       // Equal weight allocation
-    INVERSE_VOLATILITY,     // Inverse volatility weighting
-    MARKET_CAP,             // Market cap weighting
-    ALLOCATION              // Manual allocation
-};
-
 /**
  * @brief Processor for allocation nodes (portfolio weighting)
  * Equivalent to Julia's AllocationNode.jl functionality
@@ -31,17 +21,31 @@ public:
         int total_days,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution = false,
         int global_cache_length = 0
     ) override;
     
-    std::string get_node_type() const override { return \"allocation\"; }
+    std::string get_node_type() const override { return "allocation"; }
+    
+    /**
+     * @brief Parse allocation function from node properties
+     * @param properties Node properties
+     * @return Allocation function enum
+     */
+    static AllocationFunction parse_allocation_function(const nlohmann::json& properties);
+    
+    /**
+     * @brief Parse allocation function from its name
+     * @param function_name Allocation function name ("Equal Allocation", "Allocation", ...)
+     * @return Allocation function enum
+     */
+    static AllocationFunction parse_allocation_function(const std::string& function_name);
     
 private:
     /**
@@ -51,13 +55,6 @@ private:
      */
     bool validate_allocation_node(const StrategyNode& node) const;
     
-    /**
-     * @brief Parse allocation function from node properties
-     * @param properties Node properties
-     * @return Allocation function enum
-     */
-    AllocationFunction parse_allocation_function(const nlohmann::json& properties) const;
-    
     /**
      * @brief Process equal allocation
      * @param node Allocation node
@@ -65,7 +62,7 @@ private:
      * @param total_days Total number of days
      * @param node_weight Node weight
      * @param portfolio_history Portfolio history to update
-     * @param date_range Date range
+     * @param date_range Trading day indices
      * @param flow_count Flow count tracking
      * @param flow_stocks Flow stocks tracking
      * @param strategy Strategy context
@@ -79,7 +76,7 @@ private:
         int total_days,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
         const Strategy& strategy,
@@ -94,7 +91,7 @@ private:
      * @param total_days Total number of days
      * @param node_weight Node weight
      * @param portfolio_history Portfolio history to update
-     * @param date_range Date range
+     * @param date_range Trading day indices
      * @param flow_count Flow count tracking
      * @param flow_stocks Flow stocks tracking
      * @param indicator_cache Indicator cache
@@ -110,10 +107,10 @@ private:
         int total_days,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution,
@@ -127,7 +124,7 @@ private:
      * @param total_days Total number of days
      * @param node_weight Node weight
      * @param portfolio_history Portfolio history to update
-     * @param date_range Date range
+     * @param date_range Trading day indices
      * @param flow_count Flow count tracking
      * @param flow_stocks Flow stocks tracking
      * @param indicator_cache Indicator cache
@@ -142,10 +139,10 @@ private:
         int total_days,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution
@@ -210,7 +207,7 @@ private:
      * @param total_days Total number of days
      * @param node_weight Node weight
      * @param portfolio_history Portfolio history to update
-     * @param date_range Date range
+     * @param date_range Trading day indices
      * @param flow_count Flow count tracking
      * @param flow_stocks Flow stocks tracking
      * @param indicator_cache Indicator cache
@@ -226,10 +223,10 @@ private:
         int total_days,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution,
@@ -243,7 +240,7 @@ private:
 class AllocationNodeError : public NodeProcessingError {
 public:
     explicit AllocationNodeError(const std::string& message) 
-        : NodeProcessingError(\"Allocation node error: \" + message) {}
+        : NodeProcessingError("Allocation node error: " + message) {}
 };
 
 } // namespace atlas
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
-#include \"types.h\"
-#include \"strategy_parser.h\"
-#include \"node_processor.h\"
+#include "types.h"
+#include "strategy_parser.h"
+#include "node_processor.h"
+#include "plan_executor.h"
+#include "indicator_planner.h"
+#include "ticker_prefetch.h"
 #include <memory>
 #include <unordered_map>
 #include <chrono>
@@ -19,6 +22,7 @@ struct BacktestResult {
     bool success;
     std::string error_message;
     std::chrono::milliseconds execution_time;
+    std::vector<PrefetchEvent> prefetch_timeline;   // Price loads of this request, in queue order
     
     BacktestResult() : success(false), execution_time(0) {}
 };
@@ -29,7 +33,7 @@ struct BacktestResult {
 struct BacktestParams {
     Strategy strategy;
     int period;
-    std::string end_date;
+    std::string end_date;           // Last bar evaluated; today's live bar in a live run
     bool live_execution;
     int global_cache_length;
     
@@ -59,14 +63,46 @@ public:
      */
     std::string handle_backtesting_api(const std::string& json_request);
     
+    /**
+     * @brief Enable parallel evaluation of independent subtrees (serial by default)
+     * @param options Thread count and serial threshold
+     */
+    void set_parallel_options(const ParallelOptions& options) { executor_.set_parallel_options(options); }
+    
+    /**
+     * @brief Price source for the indicator planning phase (placeholder prices by default)
+     * @param loader Returns the last N closes of a ticker, oldest first
+     */
+    void set_price_loader(IndicatorPlanner::PriceLoader loader) { price_loader_ = std::move(loader); }
+    
+    /**
+     * @brief Size of the I/O pool that loads a request's tickers concurrently
+     * @param thread_count Concurrent loads, 0 for hardware concurrency
+     */
+    void set_prefetch_threads(size_t thread_count) {
+        prefetch_threads_ = thread_count;
+        io_pool_.reset();
+    }
+    
+    /**
+     * @brief Generate date range for backtest
+     * end_date names the last bar in live and historical runs alike, as in
+     * GlobalCache::get_trading_days.
+     * @param period Number of trading days
+     * @param end_date End date string; the range ends on the last trading day on or before it
+     * @return TradingCalendar::nyse() day indices, oldest first
+     */
+    std::vector<int32_t> generate_date_range(int period, const std::string& end_date) const;
+    
     /**
      * @brief Post-order DFS traversal (equivalent to Julia's post_order_dfs)
+     * Legacy recursive path; execute_backtest runs the compiled ExecutionPlan instead
      * @param node Current node to process
      * @param active_mask Boolean mask of active days
      * @param common_data_span Data span
      * @param node_weight Weight of the node
      * @param portfolio_history Portfolio history
-     * @param date_range Date range
+     * @param date_range Trading day indices
      * @param flow_count Flow count tracking
      * @param flow_stocks Flow stocks tracking
      * @param indicator_cache Indicator cache
@@ -82,10 +118,10 @@ public:
         int common_data_span,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution = false,
@@ -99,24 +135,20 @@ private:
     // Strategy parser
     StrategyParser parser_;
     
+    // Strategy compilation and plan execution
+    PlanCompiler compiler_;
+    PlanExecutor executor_;
+    IndicatorPlanner::PriceLoader price_loader_;
+    
+    // Ticker loads run here, started on first use
+    size_t prefetch_threads_ = 16;
+    std::unique_ptr<WorkStealingPool> io_pool_;
+    
     /**
      * @brief Initialize node processors
      */
     void initialize_processors();
     
-    /**
-     * @brief Generate date range for backtest
-     * @param period Number of days
-     * @param end_date End date string
-     * @param live_execution Live execution flag
-     * @return Vector of date strings
-     */
-    std::vector<std::string> generate_date_range(
-        int period, 
-        const std::string& end_date, 
-        bool live_execution
-    );
-    
     /**
      * @brief Initialize portfolio history
      * @param period Number of days
@@ -131,7 +163,7 @@ private:
      * @param common_data_span Data span
      * @param node_weight Node weight
      * @param portfolio_history Portfolio history
-     * @param date_range Date range
+     * @param date_range Trading day indices
      * @param flow_count Flow count
      * @param flow_stocks Flow stocks
      * @param indicator_cache Indicator cache
@@ -147,10 +179,10 @@ private:
         int common_data_span,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution,
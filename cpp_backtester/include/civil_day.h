@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace atlas {
+
+/**
+ * @brief Days since 1970-01-01 of a calendar date; the date is not validated
+ */
+int32_t civil_day(int year, unsigned month, unsigned day);
+
+/**
+ * @brief Days in a month of the proleptic Gregorian calendar
+ */
+unsigned days_in_month(int year, unsigned month);
+
+/**
+ * @brief Days since 1970-01-01 of a YYYY-MM-DD date
+ * @param date Date string; anything after the day (a time of day) is ignored
+ * @return Day number, or nullopt if the string does not start with a valid date
+ */
+std::optional<int32_t> parse_civil_day(std::string_view date);
+
+/**
+ * @brief YYYY-MM-DD of a day number from parse_civil_day
+ */
+std::string format_civil_day(int32_t day);
+
+} // namespace atlas
@@ -1,24 +1,15 @@
 #pragma once
 
-#include \"node_processor.h\"
+#include "node_processor.h"
+#include "active_mask.h"
+#include <deque>
+#include <span>
 #include <vector>
 #include <string>
 #include <functional>
 
 namespace atlas {
 
-/**
- * @brief Comparison operators for conditional evaluation
- */
-enum class ComparisonOperator {
-    GREATER_THAN,      // >
-    LESS_THAN,         // <
-    EQUAL,             // ==
-    GREATER_EQUAL,     // >=
-    LESS_EQUAL,        // <=
-    NOT_EQUAL          // !=
-};
-
 /**
  * @brief Processor for conditional nodes (if/then/else logic)
  * Equivalent to Julia's ConditionalNode.jl functionality
@@ -33,62 +24,129 @@ public:
         int total_days,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution = false,
         int global_cache_length = 0
     ) override;
     
-    std::string get_node_type() const override { return \"condition\"; }
-    
-private:
     /**
-     * @brief Validate conditional node structure
-     * @param node Conditional node to validate
-     * @return true if valid, false otherwise
+     * @brief Process the node over a packed day mask
+     * The std::vector<bool> override packs its mask once and forwards here.
      */
-    bool validate_conditional_node(const StrategyNode& node) const;
+    NodeResult process(
+        const StrategyNode& node,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        std::span<const int32_t> date_range,
+        std::unordered_map<std::string, int>& flow_count,
+        std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
+        IndicatorCache& indicator_cache,
+        std::unordered_map<std::string, std::vector<float>>& price_cache,
+        const Strategy& strategy,
+        bool live_execution = false,
+        int global_cache_length = 0
+    );
     
-    /**
-     * @brief Validate condition properties (x, y, comparison)
-     * @param properties Node properties to validate
-     * @return true if valid, false otherwise
-     */
-    bool validate_condition_properties(const nlohmann::json& properties) const;
+    std::string get_node_type() const override { return "condition"; }
     
     /**
      * @brief Evaluate the condition to get boolean result for each day
      * @param node Conditional node with comparison properties
-     * @param date_range Date range for evaluation
+     * @param date_range Trading day indices
      * @param total_days Total number of days
      * @param indicator_cache Indicator value cache
      * @param price_cache Price data cache
      * @param strategy Strategy context
      * @param live_execution Live execution flag
-     * @return Boolean vector indicating condition result for each day
+     * @param alloc Allocator for the result words
+     * @return Mask of the days the condition holds
      */
-    std::vector<bool> evaluate_condition(
+    ActiveMask evaluate_condition(
         const StrategyNode& node,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
+        int total_days,
+        IndicatorCache& indicator_cache,
+        std::unordered_map<std::string, std::vector<float>>& price_cache,
+        const Strategy& strategy,
+        bool live_execution,
+        ActiveMask::allocator_type alloc = {}
+    );
+    
+    /**
+     * @brief Evaluate a parsed condition to get boolean result for each day
+     * @param spec Parsed condition (operands and comparison)
+     * @param date_range Trading day indices
+     * @param total_days Total number of days
+     * @param indicator_cache Indicator value cache
+     * @param price_cache Price data cache
+     * @param strategy Strategy context
+     * @param live_execution Live execution flag
+     * @param alloc Allocator for the result words
+     * @return Mask of the days the condition holds
+     */
+    ActiveMask evaluate_condition(
+        const ConditionSpec& spec,
+        std::span<const int32_t> date_range,
         int total_days,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
-        bool live_execution
+        bool live_execution,
+        ActiveMask::allocator_type alloc = {}
+    );
+    
+    /**
+     * @brief Whether evaluating a parsed condition only reads the caches
+     * evaluate_condition inserts any indicator or price series it has to
+     * compute or load; this is false while one of them is missing.
+     * @param spec Parsed condition
+     * @param indicator_cache Indicator value cache
+     * @param price_cache Price data cache
+     * @return true if every operand is a constant or already cached
+     */
+    static bool is_cached(
+        const ConditionSpec& spec,
+        const IndicatorCache& indicator_cache,
+        const std::unordered_map<std::string, std::vector<float>>& price_cache
     );
     
+    /**
+     * @brief Parse comparison operator from string
+     * @param comparison_str Comparison operator string (">", "<", "==", etc.)
+     * @return Comparison operator enum
+     */
+    static ComparisonOperator parse_comparison_operator(const std::string& comparison_str);
+    
+private:
+    /**
+     * @brief Validate conditional node structure
+     * @param node Conditional node to validate
+     * @return true if valid, false otherwise
+     */
+    bool validate_conditional_node(const StrategyNode& node) const;
+    
+    /**
+     * @brief Validate condition properties (x, y, comparison)
+     * @param properties Node properties to validate
+     * @return true if valid, false otherwise
+     */
+    bool validate_condition_properties(const nlohmann::json& properties) const;
+    
     /**
      * @brief Process a branch (true or false path)
-     * @param nodes Vector of nodes in the branch
+     * @param nodes Nodes in the branch
      * @param active_mask Active days mask for this branch
      * @param total_days Total number of days
      * @param node_weight Weight for this branch
      * @param portfolio_history Portfolio history to update
-     * @param date_range Date range
+     * @param date_range Trading day indices
      * @param flow_count Flow count tracking
      * @param flow_stocks Flow stocks tracking
      * @param indicator_cache Indicator cache
@@ -99,15 +157,15 @@ private:
      * @return Number of processed days
      */
     int process_branch(
-        const std::vector<StrategyNode>& nodes,
-        std::vector<bool>& active_mask,
+        const std::vector<const StrategyNode*>& nodes,
+        const ActiveMask& active_mask,
         int total_days,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution,
@@ -116,60 +174,63 @@ private:
     
     /**
      * @brief Get indicator values for condition evaluation
-     * @param indicator_def Indicator definition from JSON
-     * @param date_range Date range
+     * @param operand Parsed indicator operand
+     * @param date_range Trading day indices
      * @param total_days Total number of days
      * @param indicator_cache Indicator cache
      * @param price_cache Price cache
      * @param live_execution Live execution flag
-     * @return Vector of indicator values
+     * @param storage Owner of values that are not cached, such as constants
+     * @return View of the last total_days values, valid while the caches and storage live
      */
-    std::vector<float> get_indicator_value(
-        const nlohmann::json& indicator_def,
-        const std::vector<std::string>& date_range,
+    std::span<const float> get_indicator_value(
+        const Operand& operand,
+        std::span<const int32_t> date_range,
         int total_days,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
-        bool live_execution
+        bool live_execution,
+        std::vector<float>& storage
     );
     
     /**
-     * @brief Compare two indicator value vectors
+     * @brief Compare two indicator value series
      * @param x First indicator values
      * @param y Second indicator values
-     * @param comparison_str Comparison operator as string
-     * @return Boolean vector of comparison results
+     * @param op Comparison operator
+     * @param alloc Allocator for the result words
+     * @return Mask of the days the comparison holds
      */
-    std::vector<bool> compare_values(
-        const std::vector<float>& x,
-        const std::vector<float>& y,
-        const std::string& comparison_str
+    ActiveMask compare_values(
+        std::span<const float> x,
+        std::span<const float> y,
+        ComparisonOperator op,
+        ActiveMask::allocator_type alloc
     );
     
     /**
-     * @brief Parse comparison operator from string
-     * @param comparison_str Comparison operator string (\">\", \"<\", \"==\", etc.)
-     * @return Comparison operator enum
+     * @brief Align two views to the same length (drop the oldest values of the longer one)
+     * @param x First view (narrowed in place if needed)
+     * @param y Second view (narrowed in place if needed)
      */
-    ComparisonOperator parse_comparison_operator(const std::string& comparison_str);
-    
-    /**
-     * @brief Align two vectors to the same length (truncate longer one)
-     * @param x First vector (modified in place if needed)
-     * @param y Second vector (modified in place if needed)
-     */
-    void align_indicator_lengths(std::vector<float>& x, std::vector<float>& y);
+    void align_indicator_lengths(std::span<const float>& x, std::span<const float>& y);
     
     /**
      * @brief Extract branches from conditional node
+     * Branch nodes come from the strategy's NodeGraph by reference; only nodes
+     * missing from the graph are materialized from JSON into storage.
      * @param node Conditional node
+     * @param strategy Strategy context (node graph)
+     * @param storage Owner of nodes materialized from JSON
      * @param true_branch Output: true branch nodes
      * @param false_branch Output: false branch nodes
      */
     void extract_branches(
         const StrategyNode& node,
-        std::vector<StrategyNode>& true_branch,
-        std::vector<StrategyNode>& false_branch
+        const Strategy& strategy,
+        std::deque<StrategyNode>& storage,
+        std::vector<const StrategyNode*>& true_branch,
+        std::vector<const StrategyNode*>& false_branch
     );
 };
 
@@ -179,7 +240,7 @@ private:
 class ConditionalNodeError : public NodeProcessingError {
 public:
     explicit ConditionalNodeError(const std::string& message) 
-        : NodeProcessingError(\"Conditional node error: \" + message) {}
+        : NodeProcessingError("Conditional node error: " + message) {}
 };
 
 /**
@@ -188,7 +249,7 @@ public:
 class ConditionEvalError : public NodeProcessingError {
 public:
     explicit ConditionEvalError(const std::string& message) 
-        : NodeProcessingError(\"Condition evaluation error: \" + message) {}
+        : NodeProcessingError("Condition evaluation error: " + message) {}
 };
 
 } // namespace atlas
\ No newline at end of file
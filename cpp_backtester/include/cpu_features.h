@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+namespace atlas {
+
+/**
+ * @brief Instruction set used by the vectorized kernels
+ * Vector bodies are compiled for their targets regardless of -march and
+ * picked at runtime, so default builds still get the vector paths. The TA
+ * kernels and the active-day mask dispatch on the same level.
+ */
+enum class SimdLevel : uint8_t {
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @brief Best instruction set the running CPU supports
+ */
+SimdLevel detected_simd_level();
+
+/**
+ * @brief Instruction set the kernels currently dispatch to
+ */
+SimdLevel simd_level();
+
+/**
+ * @brief Select the kernel instruction set, e.g. to compare paths in tests
+ * Requests above detected_simd_level() are clamped to it.
+ * @param level Requested instruction set
+ */
+void set_simd_level(SimdLevel level);
+
+/**
+ * @brief Whether the running CPU has the AVX-512 VPOPCNTDQ extension
+ */
+bool has_avx512_vpopcntdq();
+
+} // namespace atlas
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "types.h"
+#include "strategy_parser.h"
+#include "node_graph.h"
+#include "conditional_node.h"
+#include "sort_node.h"
+#include "allocation_node.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * @brief Contiguous range of child instructions belonging to one branch
+ * A folder has one group, a condition has two (true, false), sort and
+ * allocation nodes have one group per branch.
+ */
+struct ChildGroup {
+    uint32_t first_child = 0;       // Index into ExecutionPlan::children
+    uint32_t child_count = 0;
+    float weight = 1.0f;            // Fraction of the parent weight given to this group
+};
+
+/**
+ * @brief A single lowered node of the strategy tree
+ */
+struct PlanInstruction {
+    NodeKind kind = NodeKind::NOOP;
+    const StrategyNode* node = nullptr;     // Source node in ExecutionPlan::graph (hash, legacy processors)
+    uint32_t first_group = 0;               // Index into ExecutionPlan::groups
+    uint32_t group_count = 0;
+    int32_t result_slot = -1;               // First of group_count branch result buffers, -1 writes into the parent buffer
+    uint32_t subtree_size = 1;              // Instructions in this node's subtree, itself included
+    int32_t shared_index = -1;              // Deduplicated subtree evaluated once per run, -1 if unique
+
+    NodeSpec spec;                          // Parsed node properties
+    bool has_folder_branch = false;         // SORT: a candidate is a folder and needs window padding
+
+    const StockSpec& stock() const { return std::get<StockSpec>(spec); }
+    const ConditionSpec& condition() const { return std::get<ConditionSpec>(spec); }
+    const SortSpec& sort() const { return std::get<SortSpec>(spec); }
+    const AllocationSpec& allocation() const { return std::get<AllocationSpec>(spec); }
+
+    /**
+     * @brief Extra history days a SORT with folder candidates evaluates them over
+     * Covers the sort window, one day for return deltas, and 252 days of
+     * warm-up for RSI and EMA. Zero when no candidate is a folder.
+     */
+    int sort_padding() const {
+        if (!has_folder_branch) {
+            return 0;
+        }
+        const auto& s = sort();
+        bool uses_delta = s.sort_function == SortFunction::STANDARD_DEVIATION_RETURN ||
+                          s.sort_function == SortFunction::MOVING_AVERAGE_RETURN ||
+                          s.sort_function == SortFunction::CUMULATIVE_RETURN;
+        bool pad_252_days = s.sort_function == SortFunction::RELATIVE_STRENGTH_INDEX ||
+                            s.sort_function == SortFunction::EXPONENTIAL_MOVING_AVERAGE;
+        return s.window + (uses_delta ? 1 : 0) + (pad_252_days ? 252 : 0);
+    }
+};
+
+/**
+ * @brief Node hashes of one reuse of a shared subtree, keyed by the hashes
+ * of the lowered copy; hashes equal in both are omitted
+ */
+using HashAlias = std::unordered_map<std::string, std::string>;
+
+/**
+ * @brief Flat, topologically ordered (post-order) form of a strategy tree
+ * Children always precede their parents; the root is the last instruction.
+ * Structurally identical subtrees are lowered once and referenced from every
+ * group that contains them, so the plan is a DAG rather than a tree.
+ * Instructions point at nodes owned by the graph the plan was compiled from,
+ * which the plan keeps alive.
+ */
+struct ExecutionPlan {
+    std::vector<PlanInstruction> instructions;
+    std::vector<ChildGroup> groups;
+    std::vector<uint32_t> children;         // Instruction indices referenced by groups
+    std::vector<int32_t> child_aliases;     // Per child: index into hash_aliases for a reused subtree, -1 otherwise
+    std::vector<HashAlias> hash_aliases;
+    uint32_t root_index = 0;
+    uint32_t result_slot_count = 0;
+    uint32_t shared_subtree_count = 0;      // Distinct PlanInstruction::shared_index values
+
+    std::shared_ptr<const NodeGraph> graph;
+
+    bool empty() const { return instructions.empty(); }
+    size_t size() const { return instructions.size(); }
+
+    const PlanInstruction& root() const { return instructions[root_index]; }
+
+    const ChildGroup& group(const PlanInstruction& instruction, uint32_t group_index) const {
+        return groups[instruction.first_group + group_index];
+    }
+
+    const PlanInstruction& child(const ChildGroup& group, uint32_t child_index) const {
+        return instructions[children[group.first_child + child_index]];
+    }
+
+    /**
+     * @brief Hashes under which a child reuses a shared subtree
+     * @return Alias, or nullptr if the child is the lowered copy itself
+     */
+    const HashAlias* alias(const ChildGroup& group, uint32_t child_index) const {
+        const int32_t index = child_aliases[group.first_child + child_index];
+        return index < 0 ? nullptr : &hash_aliases[index];
+    }
+};
+
+/**
+ * @brief Lowers a parsed Strategy into an ExecutionPlan
+ * Walks the strategy's NodeGraph, so node kinds, specs and branch nodes all
+ * come from the single parse done by StrategyParser.
+ */
+class PlanCompiler {
+public:
+    PlanCompiler() = default;
+
+    /**
+     * @brief Enable or disable common subtree elimination (enabled by default)
+     * Subtrees with the same node_children_hash, type and properties are
+     * lowered once and marked shared, so the executor evaluates them once per
+     * run and replays the result under each caller's weight and mask.
+     * @param enabled Whether to deduplicate
+     */
+    void set_deduplicate_subtrees(bool enabled) { deduplicate_subtrees_ = enabled; }
+
+    /**
+     * @brief Compile a strategy into a flat execution plan
+     * @param strategy Parsed strategy; its graph is built if the parser did not attach one
+     * @return Execution plan rooted at strategy.root
+     */
+    ExecutionPlan compile(const Strategy& strategy);
+
+    /**
+     * @brief Compile a single subtree into a flat execution plan
+     * @param root Root node of the subtree
+     * @return Execution plan rooted at the given node
+     */
+    ExecutionPlan compile(const StrategyNode& root);
+
+    /**
+     * @brief Compile a node graph into a flat execution plan
+     * @param graph Node graph, shared with the returned plan
+     * @return Execution plan rooted at the graph root
+     */
+    ExecutionPlan compile(std::shared_ptr<const NodeGraph> graph);
+
+private:
+    /**
+     * @brief Lower a node and its descendants, emitting children first
+     * @param node Graph node to lower
+     * @param plan Plan under construction
+     * @param alias Output: index into plan.hash_aliases if node reuses a shared subtree under other hashes, else -1
+     * @return Index of the emitted instruction
+     */
+    uint32_t lower_node(const GraphNode& node, ExecutionPlan& plan, int32_t& alias);
+
+    /**
+     * @brief Lower the nodes of one branch, skipping no-op nodes
+     * @param nodes Graph nodes of the branch
+     * @param plan Plan under construction
+     * @return Instruction index and hash alias of each lowered node
+     */
+    std::vector<std::pair<uint32_t, int32_t>> lower_branch(std::span<const GraphNode* const> nodes, ExecutionPlan& plan);
+
+    /**
+     * @brief Collect the branches of a node as lists of graph nodes
+     * @param node Graph node
+     * @param instruction Instruction being lowered (kind and parsed parameters)
+     * @param weights Output: fraction of the node weight per branch
+     * @return Branch node lists in evaluation order
+     */
+    std::vector<std::span<const GraphNode* const>> collect_branches(
+        const GraphNode& node,
+        PlanInstruction& instruction,
+        std::vector<float>& weights
+    );
+
+    /**
+     * @brief Find an already lowered subtree identical to the given node
+     * @param node Graph node about to be lowered
+     * @return Graph node the identical subtree was lowered from, or nullptr
+     */
+    const GraphNode* find_shared_subtree(const GraphNode& node) const;
+
+    /**
+     * @brief Map the hashes of a lowered subtree to those of an identical one
+     * @param lowered Root of the lowered subtree
+     * @param reuse Root of the subtree reusing it
+     * @param alias Output: lowered hash -> reuse hash for every hash that differs
+     */
+    static void collect_aliases(const GraphNode& lowered, const GraphNode& reuse, HashAlias& alias);
+
+    struct LoweredSubtree {
+        uint32_t index;                     // Instruction of the subtree root
+        const GraphNode* node;              // Graph node it was lowered from
+    };
+
+    bool deduplicate_subtrees_ = true;
+    std::unordered_map<std::string, LoweredSubtree> subtree_index_;    // node_children_hash -> lowered subtree, per compile
+};
+
+/**
+ * @brief Exception for plan compilation errors
+ */
+class PlanCompileError : public std::exception {
+public:
+    explicit PlanCompileError(const std::string& message) : message_("Plan compile error: " + message) {}
+    const char* what() const noexcept override { return message_.c_str(); }
+
+private:
+    std::string message_;
+};
+
+} // namespace atlas
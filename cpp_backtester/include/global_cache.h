@@ -1,6 +1,7 @@
 #pragma once
 
 #include "types.h"
+#include "indicator_state.h"
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -66,14 +67,24 @@ public:
         bool cache_present;
     };
     
-    CacheDataResult get_cached_data(const std::string& hash, const std::string& end_date, 
-                                   bool live_data = false);
+    CacheDataResult get_cached_data(const std::string& hash, const std::string& end_date);
+    
+    /**
+     * @brief NYSE sessions after start_date through end_date
+     * end_date names the last bar in live and historical runs alike; in a
+     * live run it is today, whose live bar is counted like any other, as in
+     * BacktestingEngine::generate_date_range.
+     */
+    int get_trading_days(const std::string& start_date, const std::string& end_date) const;
     
     // Cache management
     void clear_cache();
     void clear_expired_entries(std::chrono::seconds max_age = std::chrono::seconds(3600));
     size_t get_cache_size() const;
     
+    // Incremental indicator state for live execution
+    IndicatorStateStore& indicator_states() { return indicator_states_; }
+    
     // File-based caching (equivalent to Julia's JSON file operations)
     bool save_cache_to_file(const std::string& cache_dir = "./Cache");
     bool load_cache_from_file(const std::string& cache_dir = "./Cache");
@@ -87,6 +98,7 @@ private:
     // Cache storage
     std::unordered_map<std::string, FlowCacheEntry> flow_cache_;
     std::unordered_map<std::string, ResultsCacheEntry> results_cache_;
+    IndicatorStateStore indicator_states_;
     
     // Utility methods
     std::string generate_flow_key(const std::string& hash, const std::string& end_date) const;
@@ -99,8 +111,6 @@ private:
     std::unique_ptr<nlohmann::json> read_json_from_file(const std::string& file_path) const;
     
     // Date utilities
-    int get_trading_days(const std::string& symbol, const std::string& start_date, 
-                        const std::string& end_date, bool live_data = false) const;
     bool is_date_greater_equal(const std::string& date1, const std::string& date2) const;
 };
 
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ta_batch.h"
+#include "ticker_table.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * @brief Identity of one computed indicator series
+ * The period is the effective one from IndicatorPlanner::batch_spec, so an
+ * operand that leaves the period at its default shares the entry of one
+ * that spells it out.
+ */
+struct IndicatorKey {
+    TickerId ticker = 0;                            // TickerTable::instance() id of the source
+    ta::IndicatorKind kind = ta::IndicatorKind::SMA;
+    int32_t period = 0;
+
+    bool operator==(const IndicatorKey& other) const = default;
+
+    /**
+     * @brief Key of an indicator over a ticker's prices
+     * @param source Ticker symbol
+     * @param spec Kernel spec
+     * @return Key with the ticker interned
+     */
+    static IndicatorKey of(std::string_view source, const ta::IndicatorSpec& spec);
+};
+
+struct IndicatorKeyHash {
+    size_t operator()(const IndicatorKey& key) const noexcept;
+};
+
+/**
+ * @brief Run-scoped store of indicator series keyed by IndicatorKey
+ * Series are stored day-aligned to the run's last day and never replaced
+ * once inserted, so views stay valid for the cache's lifetime even while
+ * other entries are added.
+ */
+class IndicatorCache {
+public:
+    /**
+     * @brief View of the last days values of a cached series
+     * @param key Series key
+     * @param days Values wanted; fewer are returned if the series is shorter
+     * @return View, or nullopt if the series is not cached
+     */
+    std::optional<std::span<const float>> find(const IndicatorKey& key, size_t days) const;
+
+    /**
+     * @brief Store a series unless one is already cached under the key
+     * @param key Series key
+     * @param values Series, oldest first
+     * @param days Values wanted in the returned view
+     * @return View of the cached series' last days values
+     */
+    std::span<const float> insert(const IndicatorKey& key, std::vector<float> values, size_t days);
+
+    bool contains(const IndicatorKey& key) const { return series_.count(key) != 0; }
+    size_t size() const { return series_.size(); }
+    bool empty() const { return series_.empty(); }
+    void clear() { series_.clear(); }
+
+    /**
+     * @brief Last days values of a series
+     */
+    static std::span<const float> tail(std::span<const float> values, size_t days) {
+        return values.last(std::min(days, values.size()));
+    }
+
+private:
+    std::unordered_map<IndicatorKey, std::vector<float>, IndicatorKeyHash> series_;
+};
+
+} // namespace atlas
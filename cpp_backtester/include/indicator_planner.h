@@ -0,0 +1,152 @@
+#pragma once
+
+#include "indicator_cache.h"
+#include "node_specs.h"
+#include "series_cache.h"
+#include "ta_batch.h"
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+struct ExecutionPlan;
+class WorkStealingPool;
+class TickerPrefetch;
+
+/**
+ * @brief One deduplicated (source, indicator, period) requirement of a strategy
+ */
+struct IndicatorRequest {
+    std::string source;
+    std::string indicator;
+    int period = 0;                 // As written in the strategy, 0 if not given
+    int days = 0;                   // Price days it is computed over: lookback() at the largest span reading it
+
+    bool operator==(const IndicatorRequest& other) const = default;
+
+    /**
+     * @brief Key of the computed series in the run's indicator cache
+     * Same key ConditionalNodeProcessor::get_indicator_value looks up.
+     */
+    IndicatorKey cache_key() const;
+};
+
+/**
+ * @brief Indicator requirements of a compiled strategy, sized for one run
+ */
+struct IndicatorPlan {
+    int total_days = 0;
+    std::vector<IndicatorRequest> requests;             // Deduplicated, in plan order
+    std::unordered_map<std::string, int> lookback;      // Ticker -> price days to load
+    std::vector<std::string> tickers;                   // Keys of lookback, in plan order
+    uint32_t as_of = 0;                                 // Last price date as YYYYMMDD; 0 bypasses the shared cache
+};
+
+/**
+ * @brief Plans and precomputes every indicator a strategy's conditions read
+ * Runs between plan compilation and execution: each ticker's prices are
+ * loaded once at its exact maximum lookback, and all indicators are computed
+ * in batches into the run's caches, so condition evaluation only reads them.
+ * Each indicator is computed over its own lookback, the tail the lazy path
+ * in ConditionalNodeProcessor would use, so seeded kernels such as RSI and
+ * EMA do not depend on other indicators of the same ticker.
+ */
+class IndicatorPlanner {
+public:
+    /**
+     * @brief Price source: the last days closes of a ticker, oldest first
+     */
+    using PriceLoader = std::function<std::vector<float>(const std::string& ticker, int days)>;
+
+    /**
+     * @brief Collect and size the indicator requirements of a plan
+     * @param plan Compiled strategy
+     * @param total_days Days the run evaluates
+     * @return Deduplicated requests and per-ticker lookbacks
+     */
+    static IndicatorPlan plan(const ExecutionPlan& plan, int total_days);
+
+    /**
+     * @brief Load prices and compute every planned indicator
+     * @param plan Output of plan()
+     * @param loader Price source, or nullptr for placeholder_prices()
+     * @param indicator_cache Run indicator cache to fill
+     * @param price_cache Run price cache to fill
+     * @param pool Pool for the batched indicator kernels, or nullptr
+     * @param shared Cross-request cache consulted before loading or computing
+     *        and filled afterwards; used only with a loader and a plan as_of date
+     * @param loads Loads already started for this plan; prices are taken from
+     *        it, waiting on one ticker at a time, instead of calling loader
+     */
+    static void prefetch(
+        const IndicatorPlan& plan,
+        const PriceLoader& loader,
+        IndicatorCache& indicator_cache,
+        std::unordered_map<std::string, std::vector<float>>& price_cache,
+        WorkStealingPool* pool = nullptr,
+        SeriesCache* shared = nullptr,
+        TickerPrefetch* loads = nullptr
+    );
+
+    /**
+     * @brief Closes of one ticker, through the shared cache when one applies
+     * A cached series at least days long is returned as is; otherwise the
+     * loader's result is cached for later requests.
+     * @param ticker Ticker symbol
+     * @param days Closes needed
+     * @param loader Price source, or nullptr for placeholder_prices()
+     * @param shared Cross-request cache, or nullptr
+     * @param as_of Last price date as YYYYMMDD; 0 bypasses the shared cache
+     * @param cached Set to whether the shared cache served the series
+     * @return At least days closes when the source has them, oldest first
+     */
+    static SeriesCache::Series load_prices(
+        const std::string& ticker,
+        int days,
+        const PriceLoader& loader,
+        SeriesCache* shared,
+        uint32_t as_of,
+        bool* cached = nullptr
+    );
+
+    /**
+     * @brief Batched kernel and effective period behind an indicator name
+     * @param indicator Indicator name, e.g. "Relative Strength Index"
+     * @param period Period from the strategy, 0 for the default
+     * @return Kernel spec, or nullopt for prices, constants and unsupported names
+     */
+    static std::optional<ta::IndicatorSpec> batch_spec(const std::string& indicator, int period);
+
+    /**
+     * @brief Price days needed to produce total_days values of an indicator
+     * @param indicator Indicator name
+     * @param period Period from the strategy
+     * @param total_days Values needed
+     * @return Price days to load
+     */
+    static int lookback(const std::string& indicator, int period, int total_days);
+
+    /**
+     * @brief Compute an indicator over one price series
+     * @param spec Kernel spec from batch_spec()
+     * @param prices Prices, oldest first
+     * @return Values from the first complete window on
+     */
+    static std::vector<float> compute(const ta::IndicatorSpec& spec, std::span<const float> prices);
+
+    /**
+     * @brief Synthetic prices used when no loader is configured
+     */
+    static std::vector<float> placeholder_prices(int days);
+
+    /**
+     * @brief Index of the first defined value of a kernel's day-aligned output
+     */
+    static int warmup(const ta::IndicatorSpec& spec);
+};
+
+} // namespace atlas
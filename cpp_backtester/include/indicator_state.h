@@ -0,0 +1,148 @@
+#pragma once
+
+#include "ta_batch.h"
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace atlas {
+
+/**
+ * @brief Resumable state of one indicator over one price series
+ * Each bar updates the indicator in O(1): Wilder averages for RSI, the last
+ * value for EMA, and a ring buffer with running sums for the rolling
+ * indicators. Values follow TAFunctions: NaN until the first full window,
+ * and for RSI wherever the average loss is zero. RETURNS_STANDARD_DEVIATION
+ * is day-aligned as in ta::compute_indicator. CUMULATIVE_RETURN and
+ * MAX_DRAWDOWN have no incremental form and are rejected.
+ */
+class IndicatorState {
+public:
+    IndicatorState() = default;
+    IndicatorState(ta::IndicatorKind kind, int period);
+
+    /**
+     * @brief Append a new bar
+     * @param price Closing price of the bar
+     * @return Indicator value after the bar
+     */
+    float push(float price);
+
+    /**
+     * @brief Replace the most recent bar, e.g. a live quote that moved
+     * @param price New price of the last bar
+     * @return Indicator value after the replaced bar
+     */
+    float amend(float price);
+
+    float value() const { return core_.value; }
+    uint64_t bars() const { return core_.bars; }
+    ta::IndicatorKind kind() const { return kind_; }
+    int period() const { return period_; }
+
+    nlohmann::json to_json() const;
+    static IndicatorState from_json(const nlohmann::json& json);
+
+private:
+    // Everything push() changes apart from the ring slot it overwrites
+    struct Core {
+        uint64_t bars = 0;
+        double s1 = 0.0;        // Running sums of shifted values (rolling kinds)
+        double s2 = 0.0;
+        double shift = 0.0;     // First finite value, keeps s2 small
+        int32_t bad = 0;        // Non-finite values in the window
+        float ema = 0.0f;       // EMA, or its warm-up sum
+        float gain = 0.0f;      // RSI average gain, or its warm-up sum
+        float loss = 0.0f;
+        float last_price = 0.0f;
+        float value = 0.0f;
+    };
+
+    float roll(float x);
+    void roll_window(float y, uint64_t count);
+    void recompute_sums();
+
+    ta::IndicatorKind kind_ = ta::IndicatorKind::SMA;
+    int period_ = 0;
+    Core core_;
+    std::vector<float> window_;     // Ring of the last period inputs (prices, or returns)
+    uint32_t head_ = 0;             // Next slot to overwrite
+
+    // Undo record of the last push, for amend()
+    Core undo_core_;
+    uint32_t undo_head_ = 0;
+    float undo_slot_ = 0.0f;
+    bool undo_wrote_slot_ = false;
+};
+
+/**
+ * @brief Key of a persisted indicator state
+ */
+struct IndicatorStateKey {
+    std::string ticker;
+    ta::IndicatorKind kind = ta::IndicatorKind::SMA;
+    int period = 0;
+
+    bool operator==(const IndicatorStateKey& other) const = default;
+
+    /**
+     * @brief Stable text form, e.g. "SPY|rsi|14"
+     */
+    std::string to_string() const;
+    static IndicatorStateKey parse(const std::string& text);
+};
+
+struct IndicatorStateKeyHash {
+    size_t operator()(const IndicatorStateKey& key) const;
+};
+
+/**
+ * @brief Indicator states of live strategies, keyed by (ticker, indicator, period)
+ * Owned by GlobalCache and saved with it. Thread-safe.
+ */
+class IndicatorStateStore {
+public:
+    using HistoryFn = std::function<std::vector<float>()>;
+
+    /**
+     * @brief Advance an indicator to a bar
+     * Closed bars are committed: the next session after the state's last bar
+     * appends, the last bar itself is replaced. A live bar is an amend of a
+     * copy of the committed state, re-quoted in place until its session
+     * closes, and never saved. If the state is behind the previous session
+     * (unknown key, or days without a closed bar) the missed closes are
+     * replayed from history, or the state is reseeded from it.
+     * @param key Ticker, indicator and period
+     * @param date Bar date, "YYYY-MM-DD", a trading day
+     * @param price Bar price
+     * @param history Closes before date, oldest first; only called when the state is behind
+     * @param closed Whether the bar's session has closed
+     * @return Indicator value at date
+     */
+    float advance(const IndicatorStateKey& key, const std::string& date, float price,
+                  const HistoryFn& history, bool closed);
+
+    bool contains(const IndicatorStateKey& key) const;
+    size_t size() const;
+    void clear();
+
+    nlohmann::json to_json() const;
+    void load_json(const nlohmann::json& json);
+
+private:
+    struct Entry {
+        IndicatorState state;       // Committed through last_date
+        std::string last_date;
+        IndicatorState live;        // state plus the live bar of live_date
+        std::string live_date;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<IndicatorStateKey, Entry, IndicatorStateKeyHash> entries_;
+};
+
+} // namespace atlas
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "strategy_parser.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * @brief Resolved node kind of a strategy node
+ * Replaces the per-visit string comparisons on StrategyNode::type
+ */
+enum class NodeKind : uint8_t {
+    ROOT,
+    FOLDER,
+    STOCK,
+    CONDITION,
+    SORT,
+    ALLOCATION,
+    NOOP            // comment, icon, interruptingIcon
+};
+
+/**
+ * @brief Resolve a strategy node type string to its node kind
+ * @param type Node type string from the strategy JSON
+ * @return Node kind
+ * @throws StrategyParseError if the type is unknown
+ */
+NodeKind resolve_node_kind(const std::string& type);
+
+struct GraphNode;
+
+/**
+ * @brief Named list of child nodes
+ * Folders and the root have a single "sequence" branch, conditions have
+ * "true" and "false", sort and allocation nodes use their branch keys.
+ */
+struct GraphBranch {
+    std::string name;
+    std::span<const GraphNode* const> nodes;
+};
+
+/**
+ * @brief Node of the immutable strategy graph
+ * Children are spans into the graph arena, so walking a branch never copies
+ * or re-parses nodes.
+ */
+struct GraphNode {
+    NodeKind kind = NodeKind::NOOP;
+    const StrategyNode* source = nullptr;   // Node fields and parsed spec, owned by the graph
+    const GraphNode* parent = nullptr;      // nullptr for the graph root
+    std::span<const GraphBranch> branches;
+
+    const std::string& hash() const { return source->hash; }
+    const std::string& type() const { return source->type; }
+    const NodeSpec& spec() const { return source->spec; }
+
+    /**
+     * @brief Find a branch by name
+     * @param name Branch name
+     * @return Branch nodes, empty if the node has no such branch
+     */
+    std::span<const GraphNode* const> branch(std::string_view name) const;
+};
+
+/**
+ * @brief Immutable, arena-allocated graph of a strategy tree
+ * Built once per strategy by StrategyParser. Branch nodes stored as JSON on
+ * their parents are materialized exactly once, nodes live contiguously in
+ * pre-order, and a hash index gives O(1) lookup from a node hash to its node.
+ * The graph owns every node it references, so it stays valid independently
+ * of the Strategy it was built from.
+ */
+class NodeGraph {
+public:
+    /**
+     * @brief Build a graph from a strategy tree
+     * Specs already resolved on the tree are reused; missing ones, including
+     * those of branch nodes, are parsed as the nodes are added.
+     * @param root Root node of the tree (copied into the graph)
+     * @return Shared, immutable graph
+     * @throws StrategyParseError if a node has an unknown type or invalid properties
+     */
+    static std::shared_ptr<const NodeGraph> build(const StrategyNode& root);
+
+    const GraphNode& root() const { return nodes_.front(); }
+    std::span<const GraphNode> nodes() const { return nodes_; }
+    size_t size() const { return nodes_.size(); }
+
+    /**
+     * @brief Look up a node by hash
+     * @param hash Node hash
+     * @return First node in pre-order with this hash, nullptr if none
+     */
+    const GraphNode* find(const std::string& hash) const;
+
+private:
+    NodeGraph() = default;
+
+    /**
+     * @brief Node record collected before the arena is sized
+     */
+    struct PendingNode {
+        const StrategyNode* source = nullptr;
+        NodeKind kind = NodeKind::NOOP;
+        uint32_t parent = 0;
+        std::vector<std::pair<std::string, std::vector<uint32_t>>> branches;
+    };
+
+    /**
+     * @brief Collect a node and its descendants in pre-order
+     * @param node Source node owned by the graph
+     * @param parent Index of the parent record
+     * @param parser Parser used for branch node specs
+     * @param pending Output records
+     * @return Index of the node's record
+     */
+    uint32_t collect(
+        const StrategyNode& node,
+        uint32_t parent,
+        StrategyParser& parser,
+        std::vector<PendingNode>& pending
+    );
+
+    /**
+     * @brief Materialize a JSON node array as graph-owned nodes
+     * @param nodes_json JSON array of nodes
+     * @param parser Parser used for the node specs
+     * @return Materialized nodes in order
+     */
+    std::vector<const StrategyNode*> materialize(const nlohmann::json& nodes_json, StrategyParser& parser);
+
+    /**
+     * @brief Parse specs for a node and its sequence where they are not resolved yet
+     * @param node Graph-owned node
+     * @param parser Parser used for the node specs
+     */
+    static void resolve_missing_specs(StrategyNode& node, StrategyParser& parser);
+
+    StrategyNode root_source_;
+    std::deque<StrategyNode> branch_sources_;
+
+    std::vector<GraphNode> nodes_;
+    std::vector<GraphBranch> branches_;
+    std::vector<const GraphNode*> children_;
+    std::unordered_map<std::string, const GraphNode*> by_hash_;
+};
+
+} // namespace atlas
@@ -1,7 +1,10 @@
 #pragma once
 
-#include \"types.h\"
-#include \"strategy_parser.h\"
+#include "types.h"
+#include "strategy_parser.h"
+#include "indicator_cache.h"
+#include <cstdint>
+#include <span>
 #include <vector>
 #include <unordered_map>
 #include <string>
@@ -17,7 +20,7 @@ struct NodeResult {
     std::string error_message;
     
     NodeResult() : processed_days(0), success(false) {}
-    NodeResult(int days, bool success, const std::string& error = \"\")
+    NodeResult(int days, bool success, const std::string& error = "")
         : processed_days(days), success(success), error_message(error) {}
 };
 
@@ -36,7 +39,7 @@ public:
      * @param total_days Total number of days in the backtest
      * @param node_weight Weight of this node in the portfolio
      * @param portfolio_history History of portfolio data
-     * @param date_range Range of dates for the backtest
+     * @param date_range TradingCalendar::nyse() index of each backtest day, oldest first
      * @param flow_count Flow count tracking
      * @param flow_stocks Flow stocks tracking
      * @param indicator_cache Cache for technical indicators
@@ -52,10 +55,10 @@ public:
         int total_days,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution = false,
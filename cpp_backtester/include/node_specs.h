@@ -0,0 +1,114 @@
+#pragma once
+
+#include "ticker_table.h"
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * @brief Comparison operators for conditional evaluation
+ */
+enum class ComparisonOperator {
+    GREATER_THAN,      // >
+    LESS_THAN,         // <
+    EQUAL,             // ==
+    GREATER_EQUAL,     // >=
+    LESS_EQUAL,        // <=
+    NOT_EQUAL          // !=
+};
+
+/**
+ * @brief Selection function types for sorting
+ */
+enum class SelectFunction {
+    TOP,     // Select top N items
+    BOTTOM   // Select bottom N items
+};
+
+/**
+ * @brief Sort functions for ranking criteria
+ */
+enum class SortFunction {
+    RELATIVE_STRENGTH_INDEX,        // RSI
+    SIMPLE_MOVING_AVERAGE,          // SMA
+    EXPONENTIAL_MOVING_AVERAGE,     // EMA
+    STANDARD_DEVIATION_RETURN,      // Std dev of returns
+    MOVING_AVERAGE_RETURN,          // Moving avg of returns
+    CURRENT_PRICE,                  // Current price
+    PORTFOLIO_RETURN,               // Portfolio return
+    CUMULATIVE_RETURN,              // Return over the window
+    MAX_DRAWDOWN                    // Max drawdown within the window
+};
+
+/**
+ * @brief Allocation function types
+ */
+enum class AllocationFunction {
+    EQUAL_ALLOCATION,       // Equal weight allocation
+    INVERSE_VOLATILITY,     // Inverse volatility weighting
+    MARKET_CAP,             // Market cap weighting
+    ALLOCATION              // Manual allocation
+};
+
+/**
+ * @brief One side (x or y) of a condition
+ * Equivalent to the property dict consumed by Julia's get_indicator_value
+ */
+struct Operand {
+    std::string indicator;          // e.g. "Relative Strength Index", "current price", "Fixed-Value"
+    std::string source;             // Ticker the indicator is computed on
+    int period = 0;                 // Indicator window, 0 if not applicable
+    float value = 0.0f;             // Constant value for "Fixed-Value" / "constant"
+    std::string numerator;          // "Stock Ratio" numerator ticker
+    std::string denominator;        // "Stock Ratio" denominator ticker
+
+    bool is_constant() const { return indicator == "Fixed-Value" || indicator == "constant"; }
+    bool is_ratio() const { return source.empty() && !numerator.empty() && !denominator.empty(); }
+};
+
+/**
+ * @brief Parsed properties of a stock node
+ */
+struct StockSpec {
+    std::string symbol;
+    TickerId id = 0;        // Interned id of symbol
+};
+
+/**
+ * @brief Parsed properties of a conditional node
+ */
+struct ConditionSpec {
+    Operand x;
+    Operand y;
+    ComparisonOperator comparison = ComparisonOperator::LESS_THAN;
+};
+
+/**
+ * @brief Parsed properties of a sort node
+ */
+struct SortSpec {
+    SelectFunction select_function = SelectFunction::TOP;
+    int selection_count = 0;
+    SortFunction sort_function = SortFunction::RELATIVE_STRENGTH_INDEX;
+    int window = 20;
+};
+
+/**
+ * @brief Parsed properties of an allocation node
+ */
+struct AllocationSpec {
+    AllocationFunction function = AllocationFunction::EQUAL_ALLOCATION;
+    int period = 0;                                         // Volatility window for inverse volatility
+    std::vector<std::pair<std::string, float>> weights;     // Manual allocation: branch key -> fraction of node weight
+};
+
+/**
+ * @brief Typed node properties, resolved once by StrategyParser
+ * std::monostate for folder, root and no-op nodes
+ */
+using NodeSpec = std::variant<std::monostate, StockSpec, ConditionSpec, SortSpec, AllocationSpec>;
+
+} // namespace atlas
@@ -0,0 +1,392 @@
+#pragma once
+
+#include "execution_plan.h"
+#include "active_mask.h"
+#include "indicator_cache.h"
+#include "run_arena.h"
+#include "work_stealing_pool.h"
+#include <functional>
+#include <memory_resource>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+struct PlanTask;
+struct PlanRunState;
+
+/**
+ * @brief Per-run state shared by every instruction of a plan
+ * Inside a parallel task the flow maps refer to the task's own maps and the
+ * arena is the executing thread's RunArena. Each evaluation of a shared
+ * subtree has its own slots, since two may run at once.
+ */
+struct PlanExecutionContext {
+    std::span<const int32_t> date_range;            // TradingCalendar::nyse() index of each day, oldest first
+    std::unordered_map<std::string, int>& flow_count;
+    std::unordered_map<std::string, std::vector<DayData>>& flow_stocks;
+    IndicatorCache& indicator_cache;
+    std::unordered_map<std::string, std::vector<float>>& price_cache;
+    const Strategy& strategy;
+    bool live_execution = false;
+    int global_cache_length = 0;
+    PlanTask* task = nullptr;               // Enclosing parallel task, nullptr on the calling thread
+    std::pmr::memory_resource* arena = nullptr;     // Run-scoped scratch; set by PlanExecutor::execute
+    std::span<std::vector<DayData>> slots = {};     // Sort candidate buffers by PlanInstruction::result_slot
+    PlanRunState* run = nullptr;                    // State of the enclosing PlanExecutor::execute call
+
+    std::pmr::memory_resource* memory() const { return arena ? arena : std::pmr::get_default_resource(); }
+};
+
+/**
+ * @brief Parallel evaluation settings for PlanExecutor
+ */
+struct ParallelOptions {
+    size_t thread_count = 1;                // 1 runs serially, 0 uses hardware concurrency
+    uint32_t serial_threshold = 64;         // Sibling sets with fewer instructions than this run inline
+};
+
+/**
+ * @brief flow_stocks entry recorded inside a parallel task
+ */
+struct FlowSnapshot {
+    std::string hash;
+    std::vector<DayData> history;
+    bool relative = false;                  // Holds only the task's own contributions to its buffer
+};
+
+/**
+ * @brief Per-day flow_count increments recorded inside a parallel task
+ * Kept per day so a shared subtree replayed under a narrower mask counts
+ * only the days that mask leaves active.
+ */
+struct FlowDays {
+    std::string hash;
+    ActiveMask days;                        // Positions in the task's frame
+};
+
+/**
+ * @brief Private output of one sibling subtree evaluated on the pool
+ * The subtree writes its weight contributions into its own buffer and its
+ * flow data into its own maps; PlanExecutor merges tasks in sibling order,
+ * which reproduces the serial result exactly.
+ */
+struct PlanTask {
+    std::vector<DayData> buffer;
+    const std::vector<DayData>* frame = nullptr;    // Buffer that relative snapshots refer to
+    std::unordered_map<std::string, int> flow_count;
+    std::unordered_map<std::string, std::vector<DayData>> flow_stocks;  // Written by legacy processors
+    std::vector<FlowSnapshot> snapshots;
+    std::vector<FlowDays> day_counts;
+    int span = 0;
+};
+
+/**
+ * @brief Per-run state of one deduplicated subtree
+ * Results are keyed by the span the subtree was evaluated over, since a
+ * subtree reached under differently sized masks needs a result per size.
+ */
+struct SharedSubtreeState {
+    struct Result {
+        bool ready = false;
+        PlanTask capture;                   // Contributions and flow data at unit weight under an all-active mask
+    };
+
+    std::mutex mutex;
+    std::unordered_map<int, Result> results;
+};
+
+/**
+ * @brief State of one PlanExecutor::execute call
+ * Owned by the call rather than the executor, so one executor can run
+ * several plans at once. After IndicatorPlanner::prefetch the run caches are
+ * only read; when some condition still misses them, its lazy insert takes
+ * cache_mutex exclusively while cached reads share it.
+ */
+struct PlanRunState {
+    std::vector<std::vector<DayData>> result_slots;             // By PlanInstruction::result_slot
+    std::vector<std::unique_ptr<SharedSubtreeState>> shared;    // By PlanInstruction::shared_index
+    bool lazy_caches = false;               // Tasks may insert into the run caches
+    std::shared_mutex cache_mutex;
+};
+
+/**
+ * @brief Executes a compiled ExecutionPlan
+ * Replacement for BacktestingEngine::post_order_dfs. Dispatch is a switch on
+ * the resolved NodeKind and all node parameters come pre-parsed from the plan.
+ * With parallel options enabled, independent siblings (folder children,
+ * condition and allocation branches, sort candidates) run on a work-stealing
+ * pool and are merged deterministically.
+ */
+class PlanExecutor {
+public:
+    PlanExecutor() = default;
+    explicit PlanExecutor(const ParallelOptions& options);
+
+    /**
+     * @brief Configure parallel evaluation; restarts the pool if the thread count changes
+     * @param options Thread count and serial threshold
+     */
+    void set_parallel_options(const ParallelOptions& options);
+    const ParallelOptions& parallel_options() const { return options_; }
+
+    /**
+     * @brief Execute a plan from its root
+     * @param plan Compiled execution plan
+     * @param active_mask Boolean mask of active days
+     * @param total_days Data span
+     * @param node_weight Weight of the root node
+     * @param portfolio_history Portfolio history to update
+     * @param context Shared execution state
+     * @return Number of processed days
+     */
+    int execute(
+        const ExecutionPlan& plan,
+        std::vector<bool>& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+    /**
+     * @brief Execute a plan from its root under a packed day mask
+     * @param plan Compiled execution plan
+     * @param active_mask Active days
+     * @param total_days Data span
+     * @param node_weight Weight of the root node
+     * @param portfolio_history Portfolio history to update
+     * @param context Shared execution state
+     * @return Number of processed days
+     */
+    int execute(
+        const ExecutionPlan& plan,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+private:
+    /**
+     * @brief Execute a single instruction, replaying deduplicated subtrees
+     * @param alias Hashes the caller reaches a shared subtree under, nullptr for its own
+     * @return Number of processed days
+     */
+    int execute_instruction(
+        const ExecutionPlan& plan,
+        const PlanInstruction& instruction,
+        const HashAlias* alias,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+    /**
+     * @brief Dispatch a single instruction on its kind
+     * @return Number of processed days
+     */
+    int execute_node(
+        const ExecutionPlan& plan,
+        const PlanInstruction& instruction,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+    /**
+     * @brief Execute the children of a group, splitting the weight evenly
+     * @return Minimum number of processed days across the children
+     */
+    int execute_group(
+        const ExecutionPlan& plan,
+        const ChildGroup& group,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+    /**
+     * @brief Add the instruction's stock to every active day
+     * @return Number of processed days
+     */
+    int execute_stock(
+        const PlanInstruction& instruction,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+    /**
+     * @brief Evaluate the condition and run the true/false groups under split masks
+     * @return Number of processed days
+     */
+    int execute_condition(
+        const ExecutionPlan& plan,
+        const PlanInstruction& instruction,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+    /**
+     * @brief Evaluate each candidate into its result slot, rank and select
+     * @return Number of processed days
+     */
+    int execute_sort(
+        const ExecutionPlan& plan,
+        const PlanInstruction& instruction,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+    /**
+     * @brief Run each allocation branch with its pre-computed weight
+     * @return Number of processed days
+     */
+    int execute_allocation(
+        const ExecutionPlan& plan,
+        const PlanInstruction& instruction,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+    /**
+     * @brief Evaluate a shared subtree once per span and replay it under this caller's mask and weight
+     * Flow data is replayed too, under the caller's own node hashes.
+     * @param alias Hashes of the caller's copy of the subtree, nullptr if it is the lowered one
+     * @return Number of processed days
+     */
+    int execute_shared(
+        const ExecutionPlan& plan,
+        const PlanInstruction& instruction,
+        const HashAlias* alias,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+    /**
+     * @brief Run the instruction's groups as parallel tasks, one per group
+     * @param group_masks Active mask of each group
+     * @return Minimum number of processed days across the groups
+     */
+    int fork_groups(
+        const ExecutionPlan& plan,
+        const PlanInstruction& instruction,
+        std::span<const ActiveMask* const> group_masks,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        PlanExecutionContext& context
+    );
+
+    /**
+     * @brief Run body once per task on the pool with a task-local context
+     * @param tasks Tasks to fill
+     * @param context Parent context
+     * @param body Task body; returns the task's processed days
+     */
+    void run_tasks(
+        std::span<PlanTask> tasks,
+        PlanExecutionContext& context,
+        const std::function<int(size_t, PlanTask&, PlanExecutionContext&)>& body
+    );
+
+    /**
+     * @brief Fold a finished task into its parent
+     * @param task Finished task
+     * @param target Parent buffer receiving the task buffer, nullptr if the task wrote elsewhere
+     * @param context Parent context
+     */
+    void merge_task(PlanTask& task, std::vector<DayData>* target, PlanExecutionContext& context);
+
+    /**
+     * @brief Record a flow_stocks entry, deferring it when running inside a task
+     * @param context Current context
+     * @param hash Node hash
+     * @param history Portfolio snapshot
+     * @param frame Buffer the snapshot was taken from
+     */
+    void record_flow(
+        PlanExecutionContext& context,
+        const std::string& hash,
+        const std::vector<DayData>& history,
+        const std::vector<DayData>& frame
+    );
+
+    /**
+     * @brief Count a node once per day, deferring the days when running inside a task
+     * @param context Current context
+     * @param hash Node hash
+     * @param days Counted days, end-aligned with frame
+     * @param frame Buffer the node wrote into
+     */
+    void record_flow_days(
+        PlanExecutionContext& context,
+        const std::string& hash,
+        const ActiveMaskView& days,
+        const std::vector<DayData>& frame
+    );
+
+    /**
+     * @brief Whether a set of siblings is large enough to run in parallel
+     * @param sibling_count Number of siblings
+     * @param work Instructions across all siblings
+     */
+    bool should_fork(size_t sibling_count, uint32_t work) const;
+
+    /**
+     * @brief Whether some instruction of the plan may insert into the run caches
+     * Conditions whose operands are all cached only read them; legacy
+     * allocation processors may load or compute.
+     * @param plan Compiled execution plan
+     * @param context Run context with the caches
+     */
+    bool has_lazy_caches(const ExecutionPlan& plan, const PlanExecutionContext& context) const;
+
+    /**
+     * @brief Evaluate an instruction's condition, locking the run caches only around lazy misses
+     * @return Mask of the days the condition holds
+     */
+    ActiveMask evaluate_condition(const PlanInstruction& instruction, int total_days, PlanExecutionContext& context);
+
+    /**
+     * @brief Lock the run caches for a call that may insert into them while tasks run
+     */
+    std::unique_lock<std::shared_mutex> lock_caches(PlanExecutionContext& context) const;
+
+    ParallelOptions options_;
+    std::unique_ptr<WorkStealingPool> pool_;
+
+    // Processors reused for indicator evaluation and ranking
+    ConditionalNodeProcessor condition_processor_;
+    SortNodeProcessor sort_processor_;
+    AllocationNodeProcessor allocation_processor_;
+};
+
+} // namespace atlas
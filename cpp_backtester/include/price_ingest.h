@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace atlas {
+
+/**
+ * @brief Daily bars of one ticker as parsed from a source file
+ */
+struct DailyBars {
+    std::vector<int32_t> days;      // Days since 1970-01-01, strictly increasing
+    std::vector<float> closes;      // Adjusted closes
+    std::vector<float> volumes;     // 0 where the source has no volume
+    size_t skipped = 0;             // Rows without a close
+};
+
+/**
+ * @brief Convert YYYY-MM-DD dates to day numbers, eight digits per step
+ * The digits of each date are validated and combined with SWAR arithmetic
+ * on one 64-bit word; anything after the day (a time of day) is ignored.
+ * Results match parse_civil_day.
+ * @param dates Date strings
+ * @param days Output, at least dates.size() long
+ * @return Number of leading dates converted; dates[result] is invalid if less than dates.size()
+ */
+size_t parse_civil_days(std::span<const std::string_view> dates, std::span<int32_t> days);
+
+/**
+ * @brief Parse a CSV export of daily bars
+ * The header row names the columns: "date" (or "timestamp"), the close as
+ * "adjusted_close", "adj_close", "adj close" or "close", and optionally
+ * "volume". Rows whose close is empty or not a number are skipped.
+ * @param path CSV file
+ * @return Bars; throws StockDataError on unreadable files, bad dates or dates out of order
+ */
+DailyBars read_price_csv(const std::string& path);
+
+/**
+ * @brief Options of ingest_price_files
+ */
+struct IngestOptions {
+    std::string output_root = "./data";
+    bool append = false;            // Add rows past each file's last day instead of rewriting it
+    size_t threads = 0;             // 0 for hardware concurrency
+};
+
+/**
+ * @brief Outcome of ingesting one source file
+ */
+struct IngestReport {
+    std::string source;
+    std::string ticker;
+    size_t rows = 0;                // Rows read from the source
+    size_t skipped = 0;             // Source rows without a close
+    size_t written = 0;             // Rows added to the price file
+    size_t already_stored = 0;      // Appended rows dated on or before the file's last day, not written
+    std::string error;
+
+    bool ok() const { return error.empty(); }
+};
+
+/**
+ * @brief Build price files from source files in parallel
+ * Each source names its ticker by file stem (AAPL.csv, BRK.B.csv), which is
+ * normalized the way StockDataProvider::map_ticker does. Sources are read and
+ * written concurrently, one task per file; a failing file is reported and
+ * does not stop the others. The manifest is not touched.
+ * @param inputs Source files (.csv; .parquet is reported as unsupported)
+ * @param options Output root and mode
+ * @return One report per input, in input order
+ */
+std::vector<IngestReport> ingest_price_files(const std::vector<std::string>& inputs, const IngestOptions& options);
+
+/**
+ * @brief Describe every price file under a data root in manifest.json
+ * @param data_root Directory holding <TICKER>.apx files
+ * @return The manifest written
+ */
+nlohmann::json write_price_manifest(const std::string& data_root);
+
+} // namespace atlas
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "aligned_allocator.h"
+#include "ta_batch.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * @brief Prices of a strategy's tickers aligned to one trading calendar
+ * Stored column-major: each ticker's series is contiguous over the whole
+ * calendar, padded to 16 floats and 64-byte aligned, so kernels can run
+ * over any ticker or compare tickers day for day without re-aligning.
+ * A per-cell validity bitmap records which days a ticker actually traded;
+ * cells without data hold NaN unless forward-filled.
+ */
+class PricePanel {
+public:
+    static constexpr size_t kNoValid = static_cast<size_t>(-1);
+
+    PricePanel() = default;
+
+    /**
+     * @brief Empty panel over a calendar
+     * @param calendar Day numbers (days since 1970-01-01), strictly increasing
+     * @param tickers Ticker symbols, one column each
+     */
+    PricePanel(std::vector<int32_t> calendar, std::vector<std::string> tickers);
+
+    size_t tickers() const { return tickers_.size(); }
+    size_t days() const { return calendar_.size(); }
+    size_t stride() const { return stride_; }
+    const std::vector<int32_t>& calendar() const { return calendar_; }
+    const std::vector<std::string>& ticker_names() const { return tickers_; }
+
+    /**
+     * @brief Column of a ticker symbol
+     * @return Column index, or kNoValid if the ticker is not in the panel
+     */
+    size_t column_of(const std::string& ticker) const;
+
+    /**
+     * @brief Calendar index of a day
+     * @return Index of the last calendar day on or before day, or kNoValid if none
+     */
+    size_t index_of(int32_t day) const;
+
+    /**
+     * @brief Place one ticker's rows on the calendar
+     * Rows dated off the calendar are dropped; calendar days without a row
+     * stay invalid. Replaces anything set before for the ticker.
+     * @param ticker Column index
+     * @param days Row day numbers, strictly increasing
+     * @param values Row values, one per day
+     */
+    void set_series(size_t ticker, std::span<const int32_t> days, std::span<const float> values);
+
+    /**
+     * @brief Carry each ticker's last valid value over the invalid days after it
+     * Days before a ticker's first valid day stay NaN. Validity bits are not
+     * changed, so filled cells remain distinguishable from traded ones.
+     */
+    void forward_fill();
+    bool forward_filled() const { return forward_filled_; }
+
+    /**
+     * @brief Whole-calendar series of a ticker, oldest first
+     */
+    std::span<const float> series(size_t ticker) const {
+        return {data_.data() + ticker * stride_, calendar_.size()};
+    }
+
+    bool valid(size_t ticker, size_t day) const {
+        return (validity_[ticker * words_ + day / 64] >> (day % 64)) & 1u;
+    }
+
+    /**
+     * @brief Validity bitmap of a ticker, bit d of word d / 64 for day d
+     */
+    std::span<const uint64_t> validity(size_t ticker) const {
+        return {validity_.data() + ticker * words_, words_};
+    }
+
+    /**
+     * @brief First and last calendar index a ticker traded, kNoValid if never
+     */
+    size_t first_valid(size_t ticker) const { return first_valid_[ticker]; }
+    size_t last_valid(size_t ticker) const { return last_valid_[ticker]; }
+
+    /**
+     * @brief Series of a ticker from its first to its last valid day
+     */
+    std::span<const float> valid_series(size_t ticker) const;
+
+    /**
+     * @brief Calendar range every ticker covers, from the latest first valid
+     * day to the earliest last valid day
+     * @return [first, last) indices; empty if the tickers do not overlap
+     */
+    std::pair<size_t, size_t> common_range() const;
+
+    /**
+     * @brief Day-major copy of a calendar window for the batched TA kernels
+     * @param first First calendar index
+     * @param count Number of days
+     */
+    ta::TickerPanel window(size_t first, size_t count) const;
+
+private:
+    std::vector<int32_t> calendar_;
+    std::vector<std::string> tickers_;
+    std::unordered_map<std::string, size_t> columns_;
+    size_t stride_ = 0;
+    size_t words_ = 0;
+    std::vector<float, AlignedAllocator<float>> data_;
+    std::vector<uint64_t> validity_;
+    std::vector<size_t> first_valid_;
+    std::vector<size_t> last_valid_;
+    bool forward_filled_ = false;
+};
+
+} // namespace atlas
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace atlas {
+
+/**
+ * @brief On-disk layout of a columnar price file
+ * One file per ticker: this header, then 64-byte aligned columns of rows
+ * sorted by day: int32 days, float32 adjusted closes and float32 volumes.
+ * A uint32 index with one slot per calendar day from first_day to last_day
+ * holds how many rows are dated on or before that day, which makes any
+ * end-date lookup a single load. Columns and index are sized for capacity
+ * rows and index_capacity days, so appends write past the existing rows
+ * and never move them. rows is the publication point of an append: it is
+ * stored last, with release order, and readers derive the last day from it.
+ */
+struct PriceFileHeader {
+    static constexpr char kMagic[8] = {'A', 'T', 'L', 'A', 'S', 'P', 'X', '\0'};
+    static constexpr uint32_t kVersion = 2;
+
+    char magic[8] = {};
+    uint32_t version = 0;
+    uint32_t rows = 0;
+    uint32_t capacity = 0;
+    uint32_t index_capacity = 0;
+    int32_t first_day = 0;
+    int32_t last_day = 0;
+    uint64_t days_offset = 0;
+    uint64_t close_offset = 0;
+    uint64_t volume_offset = 0;
+    uint64_t index_offset = 0;
+    uint64_t file_size = 0;
+};
+
+/**
+ * @brief Rows to reserve for a file of rows rows that will take appends
+ * About a year of trading days or a quarter of the history, whichever is more.
+ */
+inline size_t price_file_capacity(size_t rows) {
+    return rows + std::max<size_t>(rows / 4, 256);
+}
+
+/**
+ * @brief Write a price file, replacing any file at path atomically
+ * @param path Output file
+ * @param days Day numbers, strictly increasing
+ * @param closes Adjusted closes, one per day
+ * @param volumes Volumes, one per day
+ * @param capacity Rows to size the columns for; at least days.size()
+ */
+void write_price_file(
+    const std::string& path,
+    std::span<const int32_t> days,
+    std::span<const float> closes,
+    std::span<const float> volumes,
+    size_t capacity = 0
+);
+
+/**
+ * @brief Outcome of append_price_file
+ */
+struct PriceAppendResult {
+    size_t appended = 0;        // Rows added past the file's last day
+    size_t skipped = 0;         // Rows dated on or before the file's last day, left as stored
+};
+
+/**
+ * @brief Append rows to a price file in place
+ * Rows dated on or before the file's last day are already stored and are
+ * skipped, even if their values differ. New rows go into the reserved
+ * capacity and are published by the release store of the header's row
+ * count; only when the reserve is used up is the file rewritten with room
+ * to grow. A missing file is created.
+ * @param path Price file
+ * @param days Day numbers, strictly increasing
+ * @param closes Adjusted closes, one per day
+ * @param volumes Volumes, one per day
+ * @return Rows appended and rows skipped
+ */
+PriceAppendResult append_price_file(
+    const std::string& path,
+    std::span<const int32_t> days,
+    std::span<const float> closes,
+    std::span<const float> volumes
+);
+
+/**
+ * @brief Read-only memory mapping of one price file
+ * Column accessors are views straight into the mapping; they stay valid
+ * for the lifetime of the object. The mapping is shared with the file, so
+ * existing mappings see rows appended in place: each accessor loads the
+ * row count once, with acquire order, and sizes its view by it.
+ */
+class MappedPriceFile {
+public:
+    /**
+     * @brief Map a price file and validate its header
+     * @param path Price file
+     * @return Mapping; throws StockDataError if the file is missing or malformed
+     */
+    static std::shared_ptr<const MappedPriceFile> open(const std::string& path);
+
+    ~MappedPriceFile();
+    MappedPriceFile(const MappedPriceFile&) = delete;
+    MappedPriceFile& operator=(const MappedPriceFile&) = delete;
+
+    size_t rows() const { return published_rows(); }
+    int32_t first_day() const { return header().first_day; }
+
+    /**
+     * @brief Day of the last published row, or first_day() if there are none
+     */
+    int32_t last_day() const {
+        const uint32_t rows = published_rows();
+        return rows ? column<int32_t>(header().days_offset, rows).back() : header().first_day;
+    }
+
+    std::span<const int32_t> days() const { return column<int32_t>(header().days_offset, published_rows()); }
+    std::span<const float> closes() const { return column<float>(header().close_offset, published_rows()); }
+    std::span<const float> volumes() const { return column<float>(header().volume_offset, published_rows()); }
+
+    /**
+     * @brief Number of rows dated on or before a day, in O(1)
+     */
+    size_t rows_through(int32_t day) const;
+
+    /**
+     * @brief Up to count closes ending at the last row on or before end_day
+     */
+    std::span<const float> closes_through(int32_t end_day, size_t count) const {
+        const size_t end = rows_through(end_day);
+        const size_t length = std::min(count, end);
+        return column<float>(header().close_offset, static_cast<uint32_t>(end)).subspan(end - length, length);
+    }
+
+private:
+    MappedPriceFile(const void* data, size_t size) : data_(data), size_(size) {}
+
+    const PriceFileHeader& header() const { return *static_cast<const PriceFileHeader*>(data_); }
+
+    // Pairs with the release store in append_price_file; the mapping is
+    // read-only, atomic_ref only needs a non-const type
+    uint32_t published_rows() const {
+        auto& rows = const_cast<uint32_t&>(header().rows);
+        return std::atomic_ref<uint32_t>(rows).load(std::memory_order_acquire);
+    }
+
+    template <typename T>
+    std::span<const T> column(uint64_t offset, uint32_t rows) const {
+        return {reinterpret_cast<const T*>(static_cast<const char*>(data_) + offset), rows};
+    }
+
+    const void* data_;
+    size_t size_;
+};
+
+} // namespace atlas
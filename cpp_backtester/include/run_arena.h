@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace atlas {
+
+/**
+ * @brief Monotonic arena for allocations scoped to one backtest run
+ * Allocation is a pointer bump and nothing is freed until the run ends, when
+ * the whole arena is released at once. The arena keeps one block sized to
+ * the largest run it has seen, so steady-state runs on a thread never reach
+ * the global heap. Not thread-safe: use one arena per thread (local()).
+ */
+class RunArena {
+public:
+    static constexpr size_t kDefaultBlockBytes = 64 * 1024;
+    static constexpr size_t kMaxRetainedBytes = 64 * 1024 * 1024;
+
+    explicit RunArena(size_t block_bytes = kDefaultBlockBytes);
+
+    RunArena(const RunArena&) = delete;
+    RunArena& operator=(const RunArena&) = delete;
+
+    /**
+     * @brief Arena of the calling thread, reused across runs
+     */
+    static RunArena& local();
+
+    std::pmr::memory_resource* resource() { return &*resource_; }
+
+    /**
+     * @brief Release every allocation; grow the retained block if the run overflowed it
+     * Memory handed out before the reset must no longer be used.
+     */
+    void reset();
+
+    size_t block_bytes() const { return block_bytes_; }
+    size_t overflow_bytes() const { return upstream_.allocated; }    // Taken from the heap since the last reset
+
+    /**
+     * @brief Keeps the arena alive for a run; the outermost scope resets it on exit
+     * Nested scopes (a pool thread running a task while it waits on its own)
+     * leave the arena untouched.
+     */
+    class Scope {
+    public:
+        explicit Scope(RunArena& arena) : arena_(arena) { ++arena_.depth_; }
+        ~Scope() {
+            if (--arena_.depth_ == 0) {
+                arena_.reset();
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        RunArena& arena_;
+    };
+
+private:
+    // Heap upstream that counts the bytes the arena could not serve from its block
+    struct CountingResource : std::pmr::memory_resource {
+        size_t allocated = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    void rebuild();
+
+    size_t block_bytes_;
+    std::unique_ptr<std::byte[]> block_;
+    CountingResource upstream_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+    int depth_ = 0;
+};
+
+} // namespace atlas
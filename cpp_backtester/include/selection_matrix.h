@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * @brief Branches a sort node selects, one row of up to k indices per day
+ * Dense [days x k] storage that select_top_k writes in place, so a sort
+ * allocates once per node instead of once per day. Days without a
+ * selection, such as inactive days, have empty rows.
+ */
+class SelectionMatrix {
+public:
+    SelectionMatrix() = default;
+    SelectionMatrix(size_t days, size_t k);
+
+    /**
+     * @brief Build from explicit per-day selections
+     * @param rows Selected branch indices per day
+     * @return Matrix with k = the longest row
+     */
+    static SelectionMatrix from_rows(const std::vector<std::vector<int>>& rows);
+
+    size_t size() const { return counts_.size(); }      // Days
+    size_t k() const { return k_; }
+
+    std::span<const int32_t> operator[](size_t day) const {
+        return {indices_.data() + day * k_, counts_[day]};
+    }
+
+    // Row storage of one day; set_count() sets how many entries are selected
+    int32_t* row_data(size_t day) { return indices_.data() + day * k_; }
+    void set_count(size_t day, size_t count) { counts_[day] = static_cast<uint32_t>(count); }
+
+private:
+    size_t k_ = 0;
+    std::vector<int32_t> indices_;
+    std::vector<uint32_t> counts_;
+};
+
+/**
+ * @brief Ranking key of one branch score; smaller keys are selected first
+ * Non-finite scores rank as 0. Scores order as Julia's isless (-0.0 before
+ * 0.0), reversed for Top, and equal scores by branch index, which is the
+ * tie-breaking of partialsortperm.
+ * @param score Branch metric for the day
+ * @param branch Branch index
+ * @param descending Select the highest scores (Top) rather than the lowest
+ * @return Key comparing as an unsigned integer
+ */
+uint64_t selection_key(float score, uint32_t branch, bool descending);
+
+/**
+ * @brief Write the branch indices of the k smallest keys, best first
+ * Partial selection: up to 16 keys go through a k-slot insertion buffer,
+ * more through nth_element followed by sorting only the selected prefix.
+ * @param keys Keys from selection_key(); reordered
+ * @param n Number of keys
+ * @param k Number to select
+ * @param out Output, min(k, n) branch indices
+ * @return Number of indices written
+ */
+size_t select_top_k(uint64_t* keys, size_t n, size_t k, int32_t* out);
+
+} // namespace atlas
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "indicator_cache.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * @brief Identity of a series shared across backtest requests
+ * Prices are keyed by ticker and last date only, and one entry holds the
+ * longest history loaded so far. Indicators also key the length of the
+ * price history they were computed from, since seeded kernels (EMA, RSI)
+ * depend on where the history starts.
+ */
+struct SeriesKey {
+    enum class Kind : uint8_t { PRICE, INDICATOR };
+
+    Kind kind = Kind::PRICE;
+    ta::IndicatorKind indicator = ta::IndicatorKind::SMA;
+    TickerId ticker = 0;
+    int32_t period = 0;
+    uint32_t as_of = 0;             // Last date as YYYYMMDD
+    uint32_t days = 0;              // Price history length, 0 for prices
+
+    bool operator==(const SeriesKey& other) const = default;
+
+    static SeriesKey price(TickerId ticker, uint32_t as_of);
+    static SeriesKey indicator_of(const IndicatorKey& key, uint32_t as_of, size_t days);
+};
+
+struct SeriesKeyHash {
+    size_t operator()(const SeriesKey& key) const noexcept;
+};
+
+/**
+ * @brief Counters of a SeriesCache
+ */
+struct SeriesCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;         // Entries dropped to stay within the byte budget
+    uint64_t expirations = 0;       // Entries dropped for exceeding max_age
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+/**
+ * @brief Process-wide cache of price and indicator series
+ * Equivalent to Julia's GlobalLRUCache.jl price and indicator caches. Keys
+ * are spread over lock shards. Each shard evicts with CLOCK: lookups only
+ * set an entry's reference bit under the shard's shared lock, so concurrent
+ * readers never block one another, and inserts sweep out unreferenced or
+ * expired entries until the shard is back within its share of the budget.
+ * Values are immutable and reference-counted, so a series stays readable
+ * after it is evicted.
+ */
+class SeriesCache {
+public:
+    using Series = std::shared_ptr<const std::vector<float>>;
+
+    struct Options {
+        size_t byte_budget = size_t(512) << 20;
+        std::chrono::milliseconds max_age = std::chrono::hours(4);
+        size_t shards = 16;
+    };
+
+    SeriesCache();
+    explicit SeriesCache(const Options& options);
+    ~SeriesCache();
+
+    SeriesCache(const SeriesCache&) = delete;
+    SeriesCache& operator=(const SeriesCache&) = delete;
+
+    static SeriesCache& instance();
+
+    /**
+     * @brief Cached series of a key
+     * @param key Series key
+     * @return Series, or nullptr if absent or older than max_age
+     */
+    Series find(const SeriesKey& key);
+
+    /**
+     * @brief Store a series, replacing any entry under the key
+     * Series larger than a shard's share of the budget are not cached.
+     * @param key Series key
+     * @param values Series, oldest first
+     * @return The stored series
+     */
+    Series insert(const SeriesKey& key, std::vector<float> values);
+
+    /**
+     * @brief Drop every entry older than max_age
+     * @return Number of entries dropped
+     */
+    size_t erase_expired();
+
+    /**
+     * @brief Drop all entries and apply new options; counters restart
+     */
+    void reset(const Options& options);
+    void clear();
+
+    SeriesCacheStats stats() const;
+    const Options& options() const { return options_; }
+
+    /**
+     * @brief YYYYMMDD of a YYYY-MM-DD date
+     * @param date Date string
+     * @return Packed date, 0 if the string is not a date
+     */
+    static uint32_t date_key(std::string_view date);
+
+private:
+    struct Shard;
+
+    Shard& shard(const SeriesKey& key);
+
+    Options options_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> insertions_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> expirations_{0};
+};
+
+} // namespace atlas
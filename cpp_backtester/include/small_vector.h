@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace atlas {
+
+/**
+ * @brief Vector with inline storage for the first N elements
+ * Spills to the heap only past N elements. Restricted to trivially copyable
+ * element types, so growth and copies are plain memcpy and the inline slots
+ * need no construction.
+ */
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>, "SmallVector requires a trivially copyable type");
+    static_assert(N > 0, "SmallVector needs inline capacity");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+    SmallVector(std::initializer_list<T> values) { assign(values.begin(), values.end()); }
+
+    template <typename It>
+        requires (!std::is_integral_v<It>)
+    SmallVector(It first, It last) { assign(first, last); }
+
+    SmallVector(const SmallVector& other) { assign(other.begin(), other.end()); }
+
+    SmallVector(SmallVector&& other) noexcept { take(other); }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() { release(); }
+
+    template <typename It>
+    void assign(It first, It last) {
+        const auto count = static_cast<size_t>(std::distance(first, last));
+        size_ = 0;
+        reserve(count);
+        std::copy(first, last, data_);
+        size_ = static_cast<uint32_t>(count);
+    }
+
+    // Iterators and element access
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    T& at(size_t i) {
+        if (i >= size_) {
+            throw std::out_of_range("SmallVector index out of range");
+        }
+        return data_[i];
+    }
+    const T& at(size_t i) const { return const_cast<SmallVector*>(this)->at(i); }
+
+    // Capacity
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+    bool is_inline() const { return data_ == inline_data(); }
+
+    void reserve(size_t capacity) {
+        if (capacity <= capacity_) {
+            return;
+        }
+        T* grown = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        std::memcpy(grown, data_, size_ * sizeof(T));
+        release();
+        data_ = grown;
+        capacity_ = static_cast<uint32_t>(capacity);
+    }
+
+    // Modifiers
+    void push_back(const T& value) {
+        if (size_ == capacity_) {
+            // Copy first: value may live in this vector's storage
+            T copy = value;
+            reserve(capacity_ * 2);
+            data_[size_++] = copy;
+            return;
+        }
+        data_[size_++] = value;
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        push_back(T(std::forward<Args>(args)...));
+        return back();
+    }
+
+    void pop_back() { --size_; }
+    void clear() { size_ = 0; }
+
+    void resize(size_t size, const T& value = T()) {
+        reserve(size);
+        for (size_t i = size_; i < size; ++i) {
+            data_[i] = value;
+        }
+        size_ = static_cast<uint32_t>(size);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        auto* dst = data_ + (first - data_);
+        const auto* src = data_ + (last - data_);
+        std::memmove(dst, src, static_cast<size_t>(end() - src) * sizeof(T));
+        size_ -= static_cast<uint32_t>(last - first);
+        return dst;
+    }
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    bool operator==(const SmallVector& other) const { return std::equal(begin(), end(), other.begin(), other.end()); }
+    bool operator!=(const SmallVector& other) const { return !(*this == other); }
+
+private:
+    T* inline_data() { return reinterpret_cast<T*>(inline_); }
+    const T* inline_data() const { return reinterpret_cast<const T*>(inline_); }
+
+    void release() {
+        if (!is_inline()) {
+            ::operator delete(data_);
+        }
+        data_ = inline_data();
+        capacity_ = N;
+    }
+
+    // Steal other's heap block, or copy its inline elements; other is left empty
+    void take(SmallVector& other) {
+        if (other.is_inline()) {
+            std::memcpy(inline_, other.inline_, other.size_ * sizeof(T));
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.capacity_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    T* data_ = inline_data();
+    uint32_t size_ = 0;
+    uint32_t capacity_ = N;
+    alignas(T) std::byte inline_[N * sizeof(T)];
+};
+
+} // namespace atlas
@@ -1,34 +1,16 @@
 #pragma once
 
-#include \"node_processor.h\"
+#include "node_processor.h"
+#include "active_mask.h"
+#include "selection_matrix.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
 #include <tuple>
+#include <span>
 
 namespace atlas {
 
-/**
- * @brief Selection function types for sorting
- */
-enum class SelectFunction {
-    TOP,     // Select top N items
-    BOTTOM   // Select bottom N items
-};
-
-/**
- * @brief Sort functions for ranking criteria
- */
-enum class SortFunction {
-    RELATIVE_STRENGTH_INDEX,        // RSI
-    SIMPLE_MOVING_AVERAGE,          // SMA
-    EXPONENTIAL_MOVING_AVERAGE,     // EMA
-    STANDARD_DEVIATION_RETURN,      // Std dev of returns
-    MOVING_AVERAGE_RETURN,          // Moving avg of returns
-    CURRENT_PRICE,                  // Current price
-    PORTFOLIO_RETURN                // Portfolio return
-};
-
 /**
  * @brief Processor for sort nodes (ranking and selection)
  * Equivalent to Julia's SortNode.jl functionality
@@ -43,25 +25,37 @@ public:
         int total_days,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution = false,
         int global_cache_length = 0
     ) override;
     
-    std::string get_node_type() const override { return \"Sort\"; }
-    
-private:
     /**
-     * @brief Validate sort node structure
-     * @param node Sort node to validate
-     * @return true if valid, false otherwise
+     * @brief Process the node over a packed day mask
+     * The std::vector<bool> override packs its mask once and forwards here.
      */
-    bool validate_sort_node(const StrategyNode& node) const;
+    NodeResult process(
+        const StrategyNode& node,
+        const ActiveMask& active_mask,
+        int total_days,
+        float node_weight,
+        std::vector<DayData>& portfolio_history,
+        std::span<const int32_t> date_range,
+        std::unordered_map<std::string, int>& flow_count,
+        std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
+        IndicatorCache& indicator_cache,
+        std::unordered_map<std::string, std::vector<float>>& price_cache,
+        const Strategy& strategy,
+        bool live_execution = false,
+        int global_cache_length = 0
+    );
+    
+    std::string get_node_type() const override { return "Sort"; }
     
     /**
      * @brief Extract and validate selection properties (select function and count)
@@ -70,11 +64,11 @@ private:
      * @param selection_count Output: number of items to select
      * @return true if valid, false otherwise
      */
-    bool parse_select_properties(
+    static bool parse_select_properties(
         const nlohmann::json& properties,
         SelectFunction& select_function,
         int& selection_count
-    ) const;
+    );
     
     /**
      * @brief Extract and validate sort properties (sort function and window)
@@ -83,47 +77,30 @@ private:
      * @param sort_window Output: sort window size
      * @return true if valid, false otherwise
      */
-    bool parse_sort_properties(
+    static bool parse_sort_properties(
         const nlohmann::json& properties,
         SortFunction& sort_function,
         int& sort_window
-    ) const;
+    );
     
     /**
-     * @brief Process all branches and collect portfolio data
-     * @param branches Branch definitions from node
-     * @param branch_keys Keys of branches to process
-     * @param total_days Total number of days
-     * @param node_weight Weight for nodes
-     * @param date_range Date range for processing
-     * @param flow_count Flow count tracking
-     * @param flow_stocks Flow stocks tracking
-     * @param indicator_cache Indicator cache
-     * @param price_cache Price cache
-     * @param strategy Strategy context
-     * @param live_execution Live execution flag
-     * @param global_cache_length Global cache length
-     * @return Tuple of (temp portfolio vectors, min data length)
+     * @brief Parse sort function string to enum
+     * @param sort_function_str Sort function string
+     * @return Sort function enum
      */
-    std::tuple<std::vector<std::vector<DayData>>, int> process_branches(
-        const nlohmann::json& branches,
-        const std::vector<std::string>& branch_keys,
-        int total_days,
-        float node_weight,
-        const std::vector<std::string>& date_range,
-        std::unordered_map<std::string, int>& flow_count,
-        std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
-        std::unordered_map<std::string, std::vector<float>>& price_cache,
-        const Strategy& strategy,
-        bool live_execution,
-        int global_cache_length
-    );
+    static SortFunction parse_sort_function(const std::string& sort_function_str);
+    
+    /**
+     * @brief Parse select function string to enum
+     * @param select_function_str Select function string
+     * @return Select function enum
+     */
+    static SelectFunction parse_select_function(const std::string& select_function_str);
     
     /**
      * @brief Calculate metrics for each branch based on sort function
      * @param temp_portfolio_vectors Portfolio data for each branch
-     * @param date_range Date range
+     * @param date_range Trading day indices
      * @param sort_function Sort function to apply
      * @param sort_window Window size for calculations
      * @param indicator_cache Indicator cache
@@ -132,11 +109,11 @@ private:
      * @return Vector of metrics for each branch (one metric per day)
      */
     std::vector<std::vector<float>> calculate_branch_metrics(
-        const std::vector<std::vector<DayData>>& temp_portfolio_vectors,
-        const std::vector<std::string>& date_range,
+        std::span<const std::vector<DayData>> temp_portfolio_vectors,
+        std::span<const int32_t> date_range,
         SortFunction sort_function,
         int sort_window,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         bool live_execution
     );
@@ -144,17 +121,17 @@ private:
     /**
      * @brief Calculate selection indices based on metrics and selection criteria
      * @param branch_metrics Metrics for each branch
-     * @param active_mask Active days mask
+     * @param active_mask Active days, end-aligned with the data span
      * @param data_span Data span
      * @param select_function Selection function (top/bottom)
      * @param selection_count Number of items to select
      * @param node Sort node for flow count
      * @param flow_count Flow count tracking
-     * @return Selection indices for each day
+     * @return Selected branch indices for each day, best first
      */
-    std::vector<std::vector<int>> calculate_selection_indices(
+    SelectionMatrix calculate_selection_indices(
         const std::vector<std::vector<float>>& branch_metrics,
-        const std::vector<bool>& active_mask,
+        const ActiveMaskView& active_mask,
         int data_span,
         SelectFunction select_function,
         int selection_count,
@@ -173,13 +150,52 @@ private:
      */
     void update_portfolio_history(
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::vector<DayData>>& temp_portfolio_vectors,
-        const std::vector<std::vector<int>>& selection_indices,
+        std::span<const std::vector<DayData>> temp_portfolio_vectors,
+        const SelectionMatrix& selection_indices,
         float node_weight,
         int common_data_span,
         int selection_count
     );
     
+private:
+    /**
+     * @brief Validate sort node structure
+     * @param node Sort node to validate
+     * @return true if valid, false otherwise
+     */
+    bool validate_sort_node(const StrategyNode& node) const;
+    
+    /**
+     * @brief Process all branches and collect portfolio data
+     * @param branches Branch definitions from node
+     * @param branch_keys Keys of branches to process
+     * @param total_days Total number of days
+     * @param node_weight Weight for nodes
+     * @param date_range Trading day indices
+     * @param flow_count Flow count tracking
+     * @param flow_stocks Flow stocks tracking
+     * @param indicator_cache Indicator cache
+     * @param price_cache Price cache
+     * @param strategy Strategy context
+     * @param live_execution Live execution flag
+     * @param global_cache_length Global cache length
+     * @return Tuple of (temp portfolio vectors, min data length)
+     */
+    std::tuple<std::vector<std::vector<DayData>>, int> process_branches(
+        const nlohmann::json& branches,
+        const std::vector<std::string>& branch_keys,
+        int total_days,
+        float node_weight,
+        std::span<const int32_t> date_range,
+        std::unordered_map<std::string, int>& flow_count,
+        std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
+        IndicatorCache& indicator_cache,
+        std::unordered_map<std::string, std::vector<float>>& price_cache,
+        const Strategy& strategy,
+        bool live_execution,
+        int global_cache_length
+    );
+    
     /**
      * @brief Calculate RSI for a given price series
      * @param prices Price data
@@ -204,6 +220,22 @@ private:
      */
     std::vector<float> calculate_ema(const std::vector<float>& values, int period);
     
+    /**
+     * @brief Calculate percent return over a window
+     * @param values Input values
+     * @param period Days the return spans
+     * @return Return values, 0 before the first full window
+     */
+    std::vector<float> calculate_cumulative_return(const std::vector<float>& values, int period);
+    
+    /**
+     * @brief Calculate rolling maximum drawdown
+     * @param values Input values
+     * @param period Window length
+     * @return Drawdown values in percent, 0 before the first full window
+     */
+    std::vector<float> calculate_max_drawdown(const std::vector<float>& values, int period);
+    
     /**
      * @brief Calculate portfolio returns from DayData
      * @param portfolio_data Portfolio data for multiple days
@@ -215,26 +247,12 @@ private:
         std::unordered_map<std::string, std::vector<float>>& price_cache
     );
     
-    /**
-     * @brief Parse sort function string to enum
-     * @param sort_function_str Sort function string
-     * @return Sort function enum
-     */
-    SortFunction parse_sort_function(const std::string& sort_function_str);
-    
-    /**
-     * @brief Parse select function string to enum
-     * @param select_function_str Select function string
-     * @return Select function enum
-     */
-    SelectFunction parse_select_function(const std::string& select_function_str);
-    
     /**
      * @brief Get branches from sort node
      * @param node Sort node
-     * @return Pair of (branches JSON, has_folder_node flag)
+     * @return Pair of (reference to the branches JSON on the node, has_folder_node flag)
      */
-    std::pair<nlohmann::json, bool> get_branches(const StrategyNode& node);
+    std::pair<const nlohmann::json&, bool> get_branches(const StrategyNode& node);
 };
 
 /**
@@ -243,7 +261,7 @@ private:
 class SortNodeError : public NodeProcessingError {
 public:
     explicit SortNodeError(const std::string& message) 
-        : NodeProcessingError(\"Sort node error: \" + message) {}
+        : NodeProcessingError("Sort node error: " + message) {}
 };
 
 } // namespace atlas
\ No newline at end of file
@@ -1,11 +1,17 @@
 #pragma once
 
+#include "price_panel.h"
+#include "price_store.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 #include <chrono>
+#include <filesystem>
 #include <optional>
+#include <mutex>
+#include <span>
+#include <stdexcept>
 
 namespace atlas {
 
@@ -14,9 +20,9 @@ namespace atlas {
  */
 struct StockDataRecord {
     std::string date;
-    float adjusted_close;
-    float volume;
-    float market_cap;
+    float adjusted_close = 0.0f;
+    float volume = 0.0f;
+    float market_cap = 0.0f;
     
     StockDataRecord() = default;
     StockDataRecord(const std::string& d, float price, float vol = 0.0f, float cap = 0.0f)
@@ -38,6 +44,46 @@ struct LiveDataRecord {
         : symbol(sym), current_price(price), change(chg), change_percent(chg_pct), timestamp(ts) {}
 };
 
+/**
+ * @brief Full price history of one ticker as columns sorted by day
+ * Days are day numbers (days since 1970-01-01, as parse_civil_day returns).
+ */
+struct PriceHistory {
+    std::vector<int32_t> days;
+    std::vector<float> closes;
+    std::vector<float> volumes;
+    
+    size_t size() const { return days.size(); }
+    
+    /**
+     * @brief Number of rows dated on or before a day; O(log n)
+     */
+    size_t rows_through(int32_t day) const;
+};
+
+/**
+ * @brief Rows [first, last) of a cached price history
+ * Shares ownership of the history, so the spans stay valid even if the
+ * provider reloads the ticker meanwhile.
+ */
+struct PriceSlice {
+    std::shared_ptr<const PriceHistory> history;
+    std::span<const int32_t> days;
+    std::span<const float> closes;
+    std::span<const float> volumes;
+    
+    PriceSlice() = default;
+    PriceSlice(std::shared_ptr<const PriceHistory> h, size_t first, size_t last);
+    
+    size_t size() const { return days.size(); }
+    bool empty() const { return days.empty(); }
+    
+    /**
+     * @brief Rows as records, oldest first
+     */
+    std::vector<StockDataRecord> records() const;
+};
+
 /**
  * @brief Database connection manager for thread-safe operations
  */
@@ -150,6 +196,42 @@ public:
     std::vector<StockDataRecord> get_historical_data_until_end_date(
         const std::string& ticker, const std::string& end_date, bool live_data = false);
     
+    /**
+     * @brief Last period rows on or before end_date, without materializing records
+     * @param ticker Stock symbol
+     * @param period Number of days
+     * @param end_date End date (YYYY-MM-DD format)
+     * @return Slice of the ticker's cached history
+     */
+    PriceSlice get_history_slice(const std::string& ticker, int period, const std::string& end_date);
+    
+    /**
+     * @brief Rows dated in [start_date, end_date], without materializing records
+     */
+    PriceSlice get_history_slice_range(
+        const std::string& ticker, const std::string& start_date, const std::string& end_date);
+    
+    /**
+     * @brief Rows dated on or before end_date, without materializing records
+     * The live bar is never part of a slice; append get_live_data() if needed.
+     */
+    PriceSlice get_history_slice_until(const std::string& ticker, const std::string& end_date);
+    
+    /**
+     * @brief Full cached history of a ticker
+     * Loaded with one query on first use and kept until the ticker's data
+     * file changes, so requests differing only in period or end date share it.
+     * @param ticker Stock symbol
+     * @return History; throws StockDataError if the ticker has no data file
+     */
+    std::shared_ptr<const PriceHistory> get_full_history(const std::string& ticker);
+    
+    /**
+     * @brief Drop cached histories and live quotes
+     * @param ticker Stock symbol, or empty for every ticker
+     */
+    void invalidate_cache(const std::string& ticker = "");
+    
     /**
      * @brief Get live stock data
      * @param ticker Stock symbol
@@ -201,14 +283,19 @@ private:
     std::string data_root_;
     DatabaseManager& db_manager_;
     
-    // Cache for recently accessed data
-    std::unordered_map<std::string, std::vector<StockDataRecord>> data_cache_;
+    // Full histories, one per ticker, reloaded only when the data file changes
+    struct HistoryEntry {
+        std::shared_ptr<const PriceHistory> history;
+        std::filesystem::file_time_type modified;
+    };
+    std::unordered_map<std::string, HistoryEntry> history_cache_;
+    
+    // Live quotes change intraday, so they are cached apart from the history and briefly
     std::unordered_map<std::string, LiveDataRecord> live_data_cache_;
-    std::unordered_map<std::string, std::chrono::steady_clock::time_point> cache_timestamps_;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> live_timestamps_;
     mutable std::mutex cache_mutex_;
     
-    // Cache timeout (5 minutes)
-    static constexpr std::chrono::minutes CACHE_TIMEOUT{5};
+    static constexpr std::chrono::seconds LIVE_CACHE_TIMEOUT{30};
     
     /**
      * @brief Map ticker symbol (e.g., FNGU to FNGA)
@@ -256,18 +343,17 @@ private:
         const std::optional<LiveDataRecord>& live_data);
     
     /**
-     * @brief Check if cache is valid for key
-     * @param cache_key Cache key
-     * @return true if cache is valid
+     * @brief Query a ticker's full history from its data file
+     * @param ticker Mapped stock symbol
+     * @param file_path Data file path
+     * @return History sorted by day
      */
-    bool is_cache_valid(const std::string& cache_key) const;
+    std::shared_ptr<const PriceHistory> load_full_history(const std::string& ticker, const std::string& file_path);
     
     /**
-     * @brief Update cache with data
-     * @param cache_key Cache key
-     * @param data Data to cache
+     * @brief Parse a YYYY-MM-DD date; throws StockDataError if malformed
      */
-    void update_cache(const std::string& cache_key, const std::vector<StockDataRecord>& data);
+    static int32_t parse_date(const std::string& date);
     
     /**
      * @brief Update live data cache
@@ -276,13 +362,6 @@ private:
      */
     void update_live_cache(const std::string& ticker, const LiveDataRecord& live_data);
     
-    /**
-     * @brief Get cached data
-     * @param cache_key Cache key
-     * @return Cached data if available
-     */
-    std::optional<std::vector<StockDataRecord>> get_cached_data(const std::string& cache_key);
-    
     /**
      * @brief Get cached live data
      * @param ticker Stock symbol
@@ -316,6 +395,77 @@ private:
     float get_base_price(const std::string& ticker) const;
 };
 
+/**
+ * @brief Stock data provider over memory-mapped columnar price files
+ * Reads <data_root>/<TICKER>.apx files written by write_price_file. Files
+ * are mapped on first use and stay mapped for the provider's lifetime, so
+ * loading a price history is an index lookup and a pointer offset.
+ */
+class MappedStockDataProvider : public IStockDataProvider {
+public:
+    explicit MappedStockDataProvider(const std::string& data_root = "./data");
+    
+    std::vector<StockDataRecord> get_historical_data(
+        const std::string& ticker, int period, const std::string& end_date) override;
+    
+    std::vector<StockDataRecord> get_historical_data_range(
+        const std::string& ticker, const std::string& start_date, const std::string& end_date) override;
+    
+    /**
+     * @brief Price files hold no live quotes
+     * @return nullopt
+     */
+    std::optional<LiveDataRecord> get_live_data(const std::string& ticker) override;
+    
+    /**
+     * @brief Price files hold no market caps; throws StockDataError
+     */
+    std::vector<StockDataRecord> get_market_cap_data(
+        const std::string& ticker, const std::string& date, int period) override;
+    
+    /**
+     * @brief Adjusted closes without materializing records
+     * @param ticker Stock symbol
+     * @param period Number of days
+     * @param end_date End date (YYYY-MM-DD format)
+     * @return Up to period closes ending on or before end_date, viewing the mapping
+     */
+    std::span<const float> get_closes(const std::string& ticker, int period, const std::string& end_date);
+    
+    /**
+     * @brief Closes of several tickers aligned to a calendar
+     * @param tickers Stock symbols, one panel column each
+     * @param calendar Day numbers to align to, strictly increasing
+     * @param forward_fill Carry closes over days a ticker did not trade
+     * @return Panel; throws StockDataError if a ticker has no price file
+     */
+    PricePanel load_panel(const std::vector<std::string>& tickers, std::vector<int32_t> calendar, bool forward_fill = false);
+    
+    /**
+     * @brief Mapped price file of a ticker
+     * @param ticker Stock symbol
+     * @return Mapping; throws StockDataError if the ticker has no price file
+     */
+    std::shared_ptr<const MappedPriceFile> file(const std::string& ticker);
+    
+    /**
+     * @brief Price file path of a ticker under a data root
+     */
+    static std::string price_file_path(const std::string& data_root, const std::string& ticker);
+
+private:
+    std::string data_root_;
+    std::unordered_map<std::string, std::shared_ptr<const MappedPriceFile>> files_;
+    mutable std::mutex files_mutex_;
+    
+    /**
+     * @brief Rows [first, last) of a price file as records
+     */
+    std::vector<StockDataRecord> records(const MappedPriceFile& prices, size_t first, size_t last) const;
+    
+    static int32_t parse_date(const std::string& date);
+};
+
 /**
  * @brief Stock data provider factory
  */
@@ -1,6 +1,6 @@
 #pragma once
 
-#include \"node_processor.h\"
+#include "node_processor.h"
 
 namespace atlas {
 
@@ -18,17 +18,17 @@ public:
         int total_days,
         float node_weight,
         std::vector<DayData>& portfolio_history,
-        const std::vector<std::string>& date_range,
+        std::span<const int32_t> date_range,
         std::unordered_map<std::string, int>& flow_count,
         std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-        std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+        IndicatorCache& indicator_cache,
         std::unordered_map<std::string, std::vector<float>>& price_cache,
         const Strategy& strategy,
         bool live_execution = false,
         int global_cache_length = 0
     ) override;
     
-    std::string get_node_type() const override { return \"stock\"; }
+    std::string get_node_type() const override { return "stock"; }
     
 private:
     /**
@@ -1,6 +1,7 @@
 #pragma once
 
-#include \"types.h\"
+#include "types.h"
+#include "node_specs.h"
 #include <nlohmann/json.hpp>
 #include <string>
 #include <memory>
@@ -8,6 +9,8 @@
 
 namespace atlas {
 
+class NodeGraph;
+
 /**
  * @brief Represents a node in the strategy tree
  * Equivalent to Julia's node structure handling
@@ -23,6 +26,8 @@ struct StrategyNode {
     std::string hash;
     std::string parent_hash;
     std::string node_children_hash;
+    std::string function;       // Top-level function (allocation nodes)
+    NodeSpec spec;              // Typed properties, resolved by StrategyParser
     
     StrategyNode() = default;
     StrategyNode(const nlohmann::json& json_node);
@@ -40,6 +45,7 @@ struct Strategy {
     int period;
     std::string end_date;
     std::string strategy_hash;
+    std::shared_ptr<const NodeGraph> graph;     // Immutable node graph, built by StrategyParser
     
     Strategy() = default;
     Strategy(const nlohmann::json& json_strategy);
@@ -81,7 +87,37 @@ public:
      */
     StrategyNode parse_node(const nlohmann::json& json_node);
     
+    /**
+     * @brief Resolve typed specs for a node and its sequence descendants
+     * Branch nodes stored as JSON are resolved when the NodeGraph is built.
+     * @param node Node to resolve in place
+     * @throws StrategyParseError if any node has invalid properties
+     */
+    void resolve_specs(StrategyNode& node);
+    
+    /**
+     * @brief Parse the typed spec of a single node from its properties
+     * @param node Node to parse
+     * @return Typed node spec (std::monostate for folder, root and no-op nodes)
+     * @throws StrategyParseError if the node properties are invalid
+     */
+    NodeSpec parse_node_spec(const StrategyNode& node);
+    
 private:
+    /**
+     * @brief Parse one side of a condition
+     * @param operand_json Operand JSON (indicator, source, period, ...)
+     * @return Parsed operand
+     */
+    Operand parse_operand(const nlohmann::json& operand_json);
+    
+    /**
+     * @brief Parse a numeric property that may be encoded as a string
+     * @param value JSON number or numeric string
+     * @return Parsed value
+     */
+    float parse_number(const nlohmann::json& value);
+    
     /**
      * @brief Validate node structure
      * @param node Node to validate
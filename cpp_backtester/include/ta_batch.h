@@ -0,0 +1,104 @@
+#pragma once
+
+#include "aligned_allocator.h"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace atlas {
+
+class WorkStealingPool;
+
+namespace ta {
+
+/**
+ * @brief Tickers x days matrix stored one day per row
+ * Each row holds every ticker of one day contiguously, padded to 16 floats
+ * and 64-byte aligned, so batched kernels step through time while
+ * vectorizing across tickers. Padding lanes start at zero and are not part
+ * of any ticker's series.
+ */
+class TickerPanel {
+public:
+    TickerPanel() = default;
+    TickerPanel(size_t tickers, size_t days, float fill = 0.0f);
+
+    size_t tickers() const { return tickers_; }
+    size_t days() const { return days_; }
+    size_t stride() const { return stride_; }
+
+    float& operator()(size_t day, size_t ticker) { return data_[day * stride_ + ticker]; }
+    float operator()(size_t day, size_t ticker) const { return data_[day * stride_ + ticker]; }
+
+    float* row(size_t day) { return data_.data() + day * stride_; }
+    const float* row(size_t day) const { return data_.data() + day * stride_; }
+
+    /**
+     * @brief Copy one ticker's series in, oldest first
+     * @param ticker Column index
+     * @param values Exactly days() values
+     */
+    void set_series(size_t ticker, std::span<const float> values);
+
+    /**
+     * @brief Gather one ticker's series, oldest first
+     */
+    std::vector<float> series(size_t ticker) const;
+
+private:
+    size_t tickers_ = 0;
+    size_t days_ = 0;
+    size_t stride_ = 0;
+    std::vector<float, AlignedAllocator<float>> data_;
+};
+
+enum class IndicatorKind {
+    SMA,
+    EMA,
+    RSI,
+    STANDARD_DEVIATION,
+    RETURNS_STANDARD_DEVIATION,
+    CUMULATIVE_RETURN,
+    MAX_DRAWDOWN
+};
+
+/**
+ * @brief Indicator computed by the batched kernels
+ */
+struct IndicatorSpec {
+    IndicatorKind kind = IndicatorKind::SMA;
+    int period = 14;
+
+    bool operator==(const IndicatorSpec& other) const = default;
+};
+
+/**
+ * @brief Compute one indicator for every ticker of a price panel
+ * Output is day-aligned with the input and matches the TAFunctions result
+ * for each column: NaN until the first full window, and for RSI wherever
+ * the average loss is zero. RETURNS_STANDARD_DEVIATION at day d covers the
+ * returns ending at d, i.e. TAFunctions' value at index d - 1.
+ * CUMULATIVE_RETURN at day d compares d with d - period; MAX_DRAWDOWN
+ * covers the period prices ending at d.
+ * Rolling windows recover once a NaN leaves the window; EMA and RSI carry
+ * it forward, as the scalar recurrences do.
+ * @param prices Price panel
+ * @param spec Indicator and period
+ * @param pool Pool to spread ticker blocks over, or nullptr to run inline
+ * @return Indicator panel with the same shape as prices
+ */
+TickerPanel compute_indicator(const TickerPanel& prices, const IndicatorSpec& spec,
+                              WorkStealingPool* pool = nullptr);
+
+/**
+ * @brief Compute several indicators over the same panel in one parallel pass
+ * @param prices Price panel
+ * @param specs Indicators to compute
+ * @param pool Pool to spread (indicator, ticker block) tasks over, or nullptr
+ * @return One panel per spec, in order
+ */
+std::vector<TickerPanel> compute_indicators(const TickerPanel& prices, std::span<const IndicatorSpec> specs,
+                                            WorkStealingPool* pool = nullptr);
+
+} // namespace ta
+} // namespace atlas
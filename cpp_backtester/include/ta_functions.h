@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ta_batch.h"
 #include <vector>
 #include <string>
 #include <memory>
@@ -91,6 +92,14 @@ public:
      */
     static std::vector<float> calculate_rolling_max_drawdown(const std::vector<float>& returns, int period);
     
+    /**
+     * @brief Calculate rolling cumulative return, as TAFunctions.jl get_cumulative_return_of_data
+     * @param prices Vector of price or portfolio value data
+     * @param period Days the return spans
+     * @return Vector of percent returns, NaN for the first period values
+     */
+    static std::vector<float> calculate_rolling_cumulative_return(const std::vector<float>& prices, int period);
+    
     /**
      * @brief Calculate market cap weighting
      * @param market_caps Map of ticker to market cap
@@ -239,6 +248,41 @@ public:
                                                  int period, const std::string& end_date, 
                                                  bool live_data = false);
 
+    /**
+     * @brief Get one indicator for many tickers in a single batched pass
+     * Prices are fetched once per ticker into a panel and the indicator is
+     * computed across all tickers together (see ta::compute_indicator).
+     * @param tickers Stock ticker symbols
+     * @param spec Indicator and period
+     * @param length_data Number of data points needed per ticker
+     * @param end_date End date for data
+     * @param live_data Live data flag
+     * @param pool Pool to spread ticker blocks over, or nullptr
+     * @return One indicator result per ticker, in order
+     */
+    static std::vector<IndicatorResult> get_indicator_batch(const std::vector<std::string>& tickers,
+                                                            const ta::IndicatorSpec& spec, int length_data,
+                                                            const std::string& end_date,
+                                                            bool live_data = false,
+                                                            WorkStealingPool* pool = nullptr);
+
+    /**
+     * @brief Get an indicator's value at end_date from its persisted live state
+     * The first call for a (ticker, indicator, period) replays seed_length
+     * closes; later calls advance the state by one bar in O(1), and repeated
+     * calls for the same date re-price the live bar. The live bar is only
+     * committed to the saved state once its session has closed.
+     * @param ticker Stock ticker symbol
+     * @param spec Indicator and period
+     * @param end_date Date of the live bar
+     * @param seed_length Closes replayed before the live bar on first use
+     * @param session_closed Whether end_date's session has closed
+     * @return Single-value indicator result
+     */
+    static IndicatorResult get_live_indicator(const std::string& ticker, const ta::IndicatorSpec& spec,
+                                              const std::string& end_date, int seed_length = 1500,
+                                              bool session_closed = false);
+
 private:
     // Mock data provider - in real implementation, this would fetch from data source
     static std::vector<float> get_historical_prices(const std::string& ticker, 
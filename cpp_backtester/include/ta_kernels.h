@@ -0,0 +1,135 @@
+#pragma once
+
+#include "aligned_allocator.h"
+#include "cpu_features.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace atlas {
+namespace ta {
+
+/**
+ * @brief Window lengths with compile-time specialized kernels
+ * rolling_mean, rolling_stddev and wilder_averages dispatch these periods to
+ * template instantiations with the window and its reciprocal folded in. They
+ * agree with the generic kernels within kJuliaRelativeTolerance.
+ */
+inline constexpr int kSpecializedPeriods[] = {10, 14, 20, 50, 200};
+
+/**
+ * @brief Whether period currently dispatches to a specialized kernel
+ */
+bool has_specialized_kernel(int period);
+
+/**
+ * @brief Whether specialized kernels are enabled (the default)
+ */
+bool specialized_kernels();
+
+/**
+ * @brief Enable or disable the specialized kernels, e.g. to compare against the generic ones
+ * @param enabled Dispatch kSpecializedPeriods to their specializations
+ */
+void set_specialized_kernels(bool enabled);
+
+/**
+ * @brief Series with 64-byte aligned storage
+ */
+using Series = std::vector<float, AlignedAllocator<float>>;
+
+/**
+ * @brief Agreement with TAFunctions.jl (Float64) on the rolling kernels
+ * Window sums are accumulated in double over data shifted by its first value,
+ * so the only error left is the final rounding to float: results match the
+ * Julia reference within this relative tolerance (or 1e-4 absolute near zero).
+ */
+constexpr float kJuliaRelativeTolerance = 1e-5f;
+
+// Raw kernels. Windowed outputs hold n - period + 1 values; out[k] covers in[k, k + period).
+// Inputs with NaN or infinity fall back to per-window evaluation so a gap only affects
+// the windows that contain it, as in the direct computation.
+
+/**
+ * @brief O(n) rolling mean
+ * @param in Input values
+ * @param n Number of inputs
+ * @param period Window length
+ * @param out Output, n - period + 1 values
+ */
+void rolling_mean(const float* in, size_t n, int period, float* out);
+
+/**
+ * @brief O(n) rolling standard deviation
+ * Prefix sums are re-centered per block of outputs; the rare window they
+ * cannot resolve next to a large jump is recomputed in two passes.
+ * @param in Input values
+ * @param n Number of inputs
+ * @param period Window length
+ * @param sample Divide by period - 1 instead of period
+ * @param scale Factor applied to the result (100 for percent)
+ * @param out Output, n - period + 1 values
+ */
+void rolling_stddev(const float* in, size_t n, int period, bool sample, float scale, float* out);
+
+/**
+ * @brief Percent returns 100 * (p[i] - p[i-1]) / p[i-1]; 0 where p[i-1] is not positive
+ * @param prices Prices
+ * @param n Number of prices
+ * @param out Output, n - 1 values
+ */
+void percent_returns(const float* prices, size_t n, float* out);
+
+/**
+ * @brief EMA recurrence out[i] = in[i] * alpha + out[i-1] * (1 - alpha), seeded with seed
+ * @param in Input values
+ * @param n Number of inputs
+ * @param alpha Smoothing factor
+ * @param seed Value before in[0]
+ * @param out Output, n values
+ */
+void ema(const float* in, size_t n, float alpha, float seed, float* out);
+
+/**
+ * @brief Wilder-smoothed average gain and loss of a price series
+ * Index k corresponds to price index period + k: k = 0 holds the plain
+ * averages of the first period changes, later entries the smoothed values.
+ * @param prices Prices
+ * @param n Number of prices
+ * @param period Smoothing period
+ * @param avg_gain Output, n - period values
+ * @param avg_loss Output, n - period values
+ */
+void wilder_averages(const float* prices, size_t n, int period, float* avg_gain, float* avg_loss);
+
+/**
+ * @brief O(n) rolling maximum drawdown in percent
+ * out[k] equals TAFunctions::calculate_max_drawdown of prices[k, k + period).
+ * Series with non-positive prices fall back to per-window evaluation.
+ * @param prices Prices or portfolio values
+ * @param n Number of prices
+ * @param period Window length
+ * @param out Output, n - period + 1 values
+ */
+void rolling_max_drawdown(const float* prices, size_t n, int period, float* out);
+
+/**
+ * @brief Percent change over period days, 100 * (p[k + period] - p[k]) / p[k]; 0 where p[k] is not positive
+ * @param prices Prices or portfolio values
+ * @param n Number of prices
+ * @param period Days between the two prices
+ * @param out Output, n - period values
+ */
+void cumulative_return(const float* prices, size_t n, int period, float* out);
+
+// Aligned convenience wrappers over the raw kernels
+
+Series rolling_mean(std::span<const float> in, int period);
+Series rolling_stddev(std::span<const float> in, int period, bool sample = false, float scale = 1.0f);
+Series percent_returns(std::span<const float> prices);
+Series rolling_max_drawdown(std::span<const float> prices, int period);
+Series cumulative_return(std::span<const float> prices, int period);
+
+} // namespace ta
+} // namespace atlas
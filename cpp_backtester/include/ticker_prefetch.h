@@ -0,0 +1,94 @@
+#pragma once
+
+#include "indicator_planner.h"
+#include "series_cache.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+class WorkStealingPool;
+
+/**
+ * @brief One ticker load of a request's prefetch stage
+ * Times are offsets from TickerPrefetch::start.
+ */
+struct PrefetchEvent {
+    std::string ticker;
+    int days = 0;                               // Closes requested
+    size_t values = 0;                          // Closes delivered, possibly more from the shared cache
+    bool cached = false;                        // Served by the shared series cache
+    bool done = false;
+    std::chrono::microseconds queued{0};
+    std::chrono::microseconds started{0};
+    std::chrono::microseconds finished{0};
+    std::string error;
+};
+
+/**
+ * @brief Loads every ticker a request needs concurrently on an I/O pool
+ * start() queues one task per ticker of an IndicatorPlan and returns at
+ * once; wait() blocks only until the named ticker is loaded. A cold request
+ * thus pays roughly its slowest load instead of the sum of all of them. The
+ * destructor waits for loads still in flight.
+ */
+class TickerPrefetch {
+public:
+    /**
+     * @param io_pool Pool running the loads; must outlive this object
+     * @param loader Price source
+     * @param shared Cross-request cache consulted before loading, or nullptr
+     * @param as_of Last price date as YYYYMMDD; 0 bypasses the shared cache
+     */
+    TickerPrefetch(WorkStealingPool& io_pool, IndicatorPlanner::PriceLoader loader,
+                   SeriesCache* shared = nullptr, uint32_t as_of = 0);
+    ~TickerPrefetch();
+
+    TickerPrefetch(const TickerPrefetch&) = delete;
+    TickerPrefetch& operator=(const TickerPrefetch&) = delete;
+
+    /**
+     * @brief Queue a load of every planned ticker at its lookback
+     * @param plan Output of IndicatorPlanner::plan
+     */
+    void start(const IndicatorPlan& plan);
+
+    /**
+     * @brief Closes of a ticker, blocking until its load finishes
+     * @param ticker Ticker passed to start()
+     * @return Closes, oldest first; throws the loader's exception if the load failed
+     */
+    SeriesCache::Series wait(const std::string& ticker);
+
+    /**
+     * @brief Events of every queued load, in queue order
+     */
+    std::vector<PrefetchEvent> timeline() const;
+
+private:
+    struct Load {
+        PrefetchEvent event;
+        std::promise<SeriesCache::Series> promise;
+        std::shared_future<SeriesCache::Series> result;
+    };
+
+    std::chrono::microseconds elapsed() const;
+    void run(Load& load);
+
+    WorkStealingPool& io_pool_;
+    IndicatorPlanner::PriceLoader loader_;
+    SeriesCache* shared_;
+    uint32_t as_of_;
+    std::chrono::steady_clock::time_point started_;
+    std::deque<Load> loads_;                            // Stable addresses for in-flight tasks
+    std::unordered_map<std::string, Load*> by_ticker_;
+    mutable std::mutex events_mutex_;
+};
+
+} // namespace atlas
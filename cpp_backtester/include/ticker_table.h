@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace atlas {
+
+using TickerId = uint32_t;
+using CompactTickerId = uint16_t;
+
+/**
+ * @brief Normalize a ticker symbol the way the data files name it
+ * Dots become dashes (BRK.B -> BRK-B).
+ * @param ticker Ticker symbol
+ * @return Normalized symbol
+ */
+std::string normalize_ticker(std::string_view ticker);
+
+/**
+ * @brief Process-wide symbol table mapping normalized tickers to stable ids
+ * Ids are dense and assigned in first-seen order, so they can index arrays
+ * directly. Lookups (find, name, and intern of a known ticker) are lock-free:
+ * entries are never removed or moved, and the hash index is republished by
+ * pointer when it grows. Only first-time inserts take the writer mutex.
+ * instance() holds normalized tickers for data lookups; symbols() keeps exact
+ * spellings and backs StockInfo, whose output must echo the strategy's symbol.
+ */
+class TickerTable {
+public:
+    static constexpr TickerId kMaxTickers = 1u << 22;
+
+    explicit TickerTable(bool normalize = true);
+    ~TickerTable();
+
+    TickerTable(const TickerTable&) = delete;
+    TickerTable& operator=(const TickerTable&) = delete;
+
+    static TickerTable& instance();
+
+    /**
+     * @brief Table of exact, unnormalized symbols; id 0 is the empty symbol
+     */
+    static TickerTable& symbols();
+
+    /**
+     * @brief Id of a ticker, assigning the next id if it is new
+     * @param ticker Ticker symbol, normalized first unless normalization is off
+     * @return Stable id
+     */
+    TickerId intern(std::string_view ticker);
+
+    /**
+     * @brief Id of a ticker that has already been interned
+     * @param ticker Ticker symbol, normalized first unless normalization is off
+     * @return Id, or nullopt if the ticker is unknown
+     */
+    std::optional<TickerId> find(std::string_view ticker) const;
+
+    /**
+     * @brief Normalized symbol of an id
+     * @param id Ticker id
+     * @return Symbol; the reference stays valid for the table's lifetime
+     */
+    const std::string& name(TickerId id) const;
+
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Narrow an id to 16 bits for compact per-day storage
+     * @param id Ticker id
+     * @return Same id as 16 bits
+     */
+    static CompactTickerId compact(TickerId id);
+
+private:
+    struct Entry {
+        std::string name;
+        size_t hash = 0;
+        TickerId id = 0;
+    };
+
+    // Open-addressing index of entry pointers; immutable once replaced
+    struct Index {
+        explicit Index(size_t capacity);
+        size_t mask;
+        std::unique_ptr<std::atomic<const Entry*>[]> slots;
+    };
+
+    static constexpr size_t kSegmentBits = 12;
+    static constexpr size_t kSegmentSize = size_t(1) << kSegmentBits;
+    static constexpr size_t kMaxSegments = kMaxTickers / kSegmentSize;
+
+    const Entry* lookup(std::string_view ticker, size_t hash) const;
+    std::string_view prepare(std::string_view ticker, std::string& buffer) const;
+    static void insert_slot(Index& index, const Entry* entry);
+
+    std::unique_ptr<std::atomic<Entry*>[]> segments_;   // Fixed-size entry blocks, never moved
+    std::atomic<const Index*> index_;
+    std::vector<std::unique_ptr<Index>> indexes_;         // Current and retired indexes; readers may hold old ones
+    std::atomic<size_t> size_{0};
+    std::mutex write_mutex_;
+    bool normalize_;
+};
+
+} // namespace atlas
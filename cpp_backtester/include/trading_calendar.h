@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * @brief NYSE trading days as dense integer indices
+ * Equivalent to Julia's DataUtils.jl adjust_holidays / is_us_market_open,
+ * precomputed once into a sorted table of trading days for 1990-2100.
+ * Days are day numbers (days since 1970-01-01, as parse_civil_day returns);
+ * indices count trading days from the first one in the table. A second
+ * table maps every calendar day to the last trading index on or before it,
+ * so conversions both ways are single loads.
+ */
+class TradingCalendar {
+public:
+    static constexpr int kFirstYear = 1990;
+    static constexpr int kLastYear = 2100;
+
+    /**
+     * @brief Calendar built from the NYSE holiday rules
+     */
+    static const TradingCalendar& nyse();
+
+    /**
+     * @brief Market holidays of a year that fall on weekdays
+     * New Year's, Martin Luther King Jr. Day (from 1998), Washington's
+     * Birthday, Good Friday, Memorial Day, Juneteenth (from 2022),
+     * Independence Day, Labor Day, Thanksgiving and Christmas, observed on
+     * the nearest weekday (New Year's on a Saturday is not observed), plus
+     * unscheduled closings such as national days of mourning.
+     * @param year Calendar year
+     * @return Day numbers, sorted
+     */
+    static std::vector<int32_t> holidays(int year);
+
+    size_t size() const { return days_.size(); }
+    std::span<const int32_t> days() const { return days_; }
+
+    /**
+     * @brief First and last calendar day the table covers
+     */
+    int32_t first_day() const { return first_day_; }
+    int32_t last_day() const { return first_day_ + static_cast<int32_t>(on_or_before_.size()) - 1; }
+
+    bool covers(int32_t day) const { return day >= first_day() && day <= last_day(); }
+    bool is_trading_day(int32_t day) const;
+
+    /**
+     * @brief Index of a trading day
+     * @return Index, or -1 if day is not a trading day
+     */
+    int32_t index_of(int32_t day) const;
+
+    /**
+     * @brief Index of the last trading day on or before a day
+     * @return Index, or -1 if the day precedes the first trading day
+     */
+    int32_t index_on_or_before(int32_t day) const;
+
+    /**
+     * @brief Trading day at an index
+     */
+    int32_t day_at(int32_t index) const;
+
+    /**
+     * @brief Number of trading days in (from, to]; negative if to precedes from
+     */
+    int32_t trading_days_between(int32_t from, int32_t to) const;
+
+    /**
+     * @brief Last trading day strictly before a day
+     */
+    int32_t previous_trading_day(int32_t day) const;
+
+    /**
+     * @brief First trading day strictly after a day
+     */
+    int32_t next_trading_day(int32_t day) const;
+
+    /**
+     * @brief Indices of count consecutive trading days ending on or before a day
+     * @param end_day Last calendar day of the range
+     * @param count Number of trading days
+     * @return Indices, oldest first; throws std::out_of_range if the table is too short
+     */
+    std::vector<int32_t> range(int32_t end_day, int32_t count) const;
+
+    /**
+     * @brief Day number of a YYYY-MM-DD date; throws std::invalid_argument if malformed
+     */
+    static int32_t parse(std::string_view date);
+
+    /**
+     * @brief YYYY-MM-DD of the trading day at an index
+     */
+    std::string format(int32_t index) const;
+
+private:
+    TradingCalendar();
+
+    void check(int32_t day) const;
+
+    int32_t first_day_ = 0;
+    std::vector<int32_t> days_;             // Trading days, ascending
+    std::vector<int32_t> on_or_before_;     // Calendar day - first_day_ -> last trading index on or before, -1 if none
+};
+
+} // namespace atlas
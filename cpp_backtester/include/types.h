@@ -1,5 +1,7 @@
 #pragma once
 
+#include "small_vector.h"
+#include "ticker_table.h"
 #include <vector>
 #include <string>
 #include <memory>
@@ -15,19 +17,23 @@ class SubtreeContext;
 
 /**
  * @brief Represents a stock with its ticker and weight for portfolio allocation
- * Equivalent to Julia's StockInfo struct
+ * Equivalent to Julia's StockInfo struct. The ticker is held as its id in
+ * TickerTable::symbols(), which keeps the type 8 bytes and trivially copyable.
  */
 class StockInfo {
 public:
     StockInfo() = default;
     StockInfo(const std::string& ticker, float weight_tomorrow);
+    StockInfo(TickerId ticker_id, float weight_tomorrow)
+        : ticker_id_(ticker_id), weight_tomorrow_(weight_tomorrow) {}
     
     // Getters
-    const std::string& ticker() const { return ticker_; }
+    const std::string& ticker() const { return TickerTable::symbols().name(ticker_id_); }
+    TickerId ticker_id() const { return ticker_id_; }
     float weight_tomorrow() const { return weight_tomorrow_; }
     
     // Setters
-    void set_ticker(const std::string& ticker) { ticker_ = ticker; }
+    void set_ticker(const std::string& ticker) { ticker_id_ = TickerTable::symbols().intern(ticker); }
     void set_weight_tomorrow(float weight) { weight_tomorrow_ = weight; }
     
     // Equality comparison
@@ -35,22 +41,26 @@ public:
     bool operator!=(const StockInfo& other) const;
 
 private:
-    std::string ticker_;
+    TickerId ticker_id_{0};         // 0 is the empty symbol
     float weight_tomorrow_{0.0f};
 };
 
 /**
  * @brief Represents portfolio data for a single day
- * Equivalent to Julia's DayData struct
+ * Equivalent to Julia's DayData struct. Up to kInlineStocks positions are
+ * stored inline, so typical days never touch the heap.
  */
 class DayData {
 public:
+    static constexpr size_t kInlineStocks = 8;
+    using StockList = SmallVector<StockInfo, kInlineStocks>;
+
     DayData() = default;
-    explicit DayData(std::vector<StockInfo> stock_list);
+    explicit DayData(const std::vector<StockInfo>& stock_list);
     
     // Getters
-    const std::vector<StockInfo>& stock_list() const { return stock_list_; }
-    std::vector<StockInfo>& stock_list() { return stock_list_; }
+    const StockList& stock_list() const { return stock_list_; }
+    StockList& stock_list() { return stock_list_; }
     
     // Utility methods
     void add_stock(const StockInfo& stock);
@@ -63,7 +73,7 @@ public:
     bool operator!=(const DayData& other) const;
 
 private:
-    std::vector<StockInfo> stock_list_;
+    StockList stock_list_;
 };
 
 /**
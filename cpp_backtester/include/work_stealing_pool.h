@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * @brief Fixed-size thread pool with per-worker deques and work stealing
+ * Workers pop their own deque LIFO and steal FIFO from the others. Callers
+ * of parallel_for help run queued tasks while they wait, so nested
+ * parallel_for calls from inside a task cannot deadlock the pool.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Start the pool
+     * @param thread_count Number of worker threads, 0 for hardware concurrency
+     */
+    explicit WorkStealingPool(size_t thread_count);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t thread_count() const { return threads_.size(); }
+
+    /**
+     * @brief Run fn(i) for every i in [0, count) and wait for all of them
+     * The calling thread runs tasks too. If tasks throw, the exception of
+     * the lowest index is rethrown after every task has finished.
+     * @param count Number of tasks
+     * @param fn Task body
+     */
+    void parallel_for(size_t count, const std::function<void(size_t)>& fn);
+
+    /**
+     * @brief Queue a task without waiting for it
+     * The task must not throw. Tasks still queued when the pool is destroyed
+     * are dropped unrun.
+     * @param task Task body
+     */
+    void submit(std::function<void()> task);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    /**
+     * @brief Run one queued task, preferring the given queue
+     * @param home Queue to pop from first
+     * @return true if a task was run
+     */
+    bool try_run_one(size_t home);
+
+    void push(size_t home, std::function<void()> task);
+    void worker_loop(size_t index);
+
+    // Queue of the current thread: its worker index, or a shared slot for outside callers
+    size_t home_queue() const;
+
+    std::vector<std::unique_ptr<Queue>> queues_;    // One per worker plus one for outside callers
+    std::vector<std::thread> threads_;
+
+    // Idle workers and parallel_for callers with nothing to help with sleep on wake_;
+    // pushes wake one, the last task of a parallel_for wakes all
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_{0};                 // Tasks pushed and not yet popped
+    std::atomic<bool> stop_{false};
+};
+
+} // namespace atlas
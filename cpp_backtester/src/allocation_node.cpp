@@ -13,10 +13,10 @@ NodeResult AllocationNodeProcessor::process(
     int total_days,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution,
@@ -34,7 +34,10 @@ NodeResult AllocationNodeProcessor::process(
         }
         
         // Determine allocation function type
-        AllocationFunction alloc_func = parse_allocation_function(node.properties);
+        const auto* spec = std::get_if<AllocationSpec>(&node.spec);
+        AllocationFunction alloc_func = spec != nullptr ? spec->function
+            : !node.function.empty() ? parse_allocation_function(node.function)
+            : parse_allocation_function(node.properties);
         int min_days = total_days;
         
         switch (alloc_func) {
@@ -89,7 +92,8 @@ NodeResult AllocationNodeProcessor::process(
 
 bool AllocationNodeProcessor::validate_allocation_node(const StrategyNode& node) const {
     // Check if node has required properties
-    if (!node.properties.contains("function") && !node.properties.contains("allocation_function")) {
+    if (!std::holds_alternative<AllocationSpec>(node.spec) && node.function.empty() &&
+        !node.properties.contains("function") && !node.properties.contains("allocation_function")) {
         return false;
     }
     
@@ -101,7 +105,7 @@ bool AllocationNodeProcessor::validate_allocation_node(const StrategyNode& node)
     return true;
 }
 
-AllocationFunction AllocationNodeProcessor::parse_allocation_function(const nlohmann::json& properties) const {
+AllocationFunction AllocationNodeProcessor::parse_allocation_function(const nlohmann::json& properties) {
     std::string function_name;
     
     if (properties.contains("function")) {
@@ -112,6 +116,10 @@ AllocationFunction AllocationNodeProcessor::parse_allocation_function(const nloh
         throw AllocationNodeError("No allocation function specified");
     }
     
+    return parse_allocation_function(function_name);
+}
+
+AllocationFunction AllocationNodeProcessor::parse_allocation_function(const std::string& function_name) {
     if (function_name == "Equal Allocation" || function_name == "equal") {
         return AllocationFunction::EQUAL_ALLOCATION;
     } else if (function_name == "Inverse Volatility" || function_name == "inverse_volatility") {
@@ -131,7 +139,7 @@ int AllocationNodeProcessor::process_equal_allocation(
     int total_days,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
     const Strategy& strategy,
@@ -196,10 +204,10 @@ int AllocationNodeProcessor::process_inverse_volatility(
     int total_days,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution,
@@ -286,10 +294,10 @@ int AllocationNodeProcessor::process_market_cap(
     int total_days,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution
@@ -478,10 +486,10 @@ int AllocationNodeProcessor::process_children(
     int total_days,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution,
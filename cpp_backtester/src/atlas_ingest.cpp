@@ -0,0 +1,99 @@
+#include "price_ingest.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace atlas;
+
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [--append] [--threads N] <input>... <output_root>" << std::endl;
+    std::cout << "  input: CSV file of daily bars named <TICKER>.csv, or a directory of them" << std::endl;
+    std::cout << "  output_root: Directory for <TICKER>.apx price files and manifest.json" << std::endl;
+    std::cout << "  --append: Add rows past each file's last day without rewriting history" << std::endl;
+    std::cout << "  --threads N: Worker threads (default: hardware concurrency)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Example:" << std::endl;
+    std::cout << "  " << program_name << " --append exports/ ./data" << std::endl;
+}
+
+std::vector<std::string> expand_inputs(const std::vector<std::string>& paths) {
+    std::vector<std::string> inputs;
+    for (const auto& path : paths) {
+        if (!std::filesystem::is_directory(path)) {
+            inputs.push_back(path);
+            continue;
+        }
+        std::vector<std::string> files;
+        for (const auto& entry : std::filesystem::directory_iterator(path)) {
+            const auto extension = entry.path().extension();
+            if (entry.is_regular_file() && (extension == ".csv" || extension == ".parquet")) {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        inputs.insert(inputs.end(), files.begin(), files.end());
+    }
+    return inputs;
+}
+
+int main(int argc, char* argv[]) {
+    IngestOptions options;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--append") {
+            options.append = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = static_cast<size_t>(std::stoul(argv[++i]));
+        } else if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() < 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    options.output_root = paths.back();
+    paths.pop_back();
+
+    try {
+        const auto start = std::chrono::steady_clock::now();
+        const auto inputs = expand_inputs(paths);
+        const auto reports = ingest_price_files(inputs, options);
+
+        size_t failed = 0;
+        size_t written = 0;
+        size_t already_stored = 0;
+        for (const auto& report : reports) {
+            if (!report.ok()) {
+                ++failed;
+                std::cerr << report.source << ": " << report.error << std::endl;
+                continue;
+            }
+            written += report.written;
+            already_stored += report.already_stored;
+        }
+        const auto manifest = write_price_manifest(options.output_root);
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+
+        std::cout << "Ingested " << (reports.size() - failed) << " of " << reports.size() << " files, "
+                  << written << " rows " << (options.append ? "appended" : "written")
+                  << " in " << elapsed.count() << " ms" << std::endl;
+        if (already_stored > 0) {
+            std::cout << already_stored << " rows dated on or before a file's last day were already stored"
+                      << " and left unchanged" << std::endl;
+        }
+        std::cout << "Manifest lists " << manifest["tickers"].size() << " tickers" << std::endl;
+        return failed == 0 ? 0 : 2;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
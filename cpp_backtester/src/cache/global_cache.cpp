@@ -1,4 +1,6 @@
 #include "global_cache.h"
+#include "trading_calendar.h"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -157,8 +159,7 @@ bool GlobalCache::cache_data(const std::string& hash,
 }
 
 GlobalCache::CacheDataResult GlobalCache::get_cached_data(const std::string& hash, 
-                                                          const std::string& end_date, 
-                                                          bool live_data) {
+                                                          const std::string& end_date) {
     CacheDataResult result;
     result.cached_response = nullptr;
     result.uncalculated_days = 0;
@@ -187,7 +188,7 @@ GlobalCache::CacheDataResult GlobalCache::get_cached_data(const std::string& has
         }
         
         // Calculate uncalculated trading days
-        result.uncalculated_days = get_trading_days("SPY", last_cached_date_str, end_date, live_data);
+        result.uncalculated_days = get_trading_days(last_cached_date_str, end_date);
         if (result.uncalculated_days == 0) {
             result.cached_response = std::move(cached_response);
             result.cache_present = true;
@@ -207,6 +208,7 @@ GlobalCache::CacheDataResult GlobalCache::get_cached_data(const std::string& has
 void GlobalCache::clear_cache() {
     flow_cache_.clear();
     results_cache_.clear();
+    indicator_states_.clear();
 }
 
 void GlobalCache::clear_expired_entries(std::chrono::seconds max_age) {
@@ -259,7 +261,13 @@ bool GlobalCache::save_cache_to_file(const std::string& cache_dir) {
         }
         
         std::string results_cache_file = cache_dir + "/results_cache.json";
-        return write_json_to_file(results_cache_file, results_cache_json);
+        if (!write_json_to_file(results_cache_file, results_cache_json)) {
+            return false;
+        }
+        
+        // Save indicator states
+        std::string indicator_state_file = cache_dir + "/indicator_states.json";
+        return write_json_to_file(indicator_state_file, indicator_states_.to_json());
         
     } catch (const std::exception& e) {
         std::cerr << "Failed to save cache to file: " << e.what() << std::endl;
@@ -307,6 +315,15 @@ bool GlobalCache::load_cache_from_file(const std::string& cache_dir) {
             }
         }
         
+        // Load indicator states
+        std::string indicator_state_file = cache_dir + "/indicator_states.json";
+        if (std::filesystem::exists(indicator_state_file)) {
+            auto state_json = read_json_from_file(indicator_state_file);
+            if (state_json) {
+                indicator_states_.load_json(*state_json);
+            }
+        }
+        
         return true;
         
     } catch (const std::exception& e) {
@@ -373,26 +390,14 @@ std::unique_ptr<nlohmann::json> GlobalCache::read_json_from_file(const std::stri
     }
 }
 
-int GlobalCache::get_trading_days(const std::string& symbol, const std::string& start_date, 
-                                 const std::string& end_date, bool live_data) const {
-    // Placeholder implementation - in a real system, this would:
-    // 1. Parse the dates
-    // 2. Query a market calendar or data provider
-    // 3. Count business days excluding holidays
-    // 4. Account for live_data flag
-    
-    // For now, return a simple approximation
-    // This would need proper date parsing and market calendar integration
-    return 5; // Placeholder value
+int GlobalCache::get_trading_days(const std::string& start_date, const std::string& end_date) const {
+    const auto& calendar = TradingCalendar::nyse();
+    const int days = calendar.trading_days_between(TradingCalendar::parse(start_date), TradingCalendar::parse(end_date));
+    return std::max(days, 0);
 }
 
 bool GlobalCache::is_date_greater_equal(const std::string& date1, const std::string& date2) const {
-    // Placeholder implementation - in a real system, this would:
-    // 1. Parse both date strings (e.g., "2024-11-25")
-    // 2. Compare them properly
-    
-    // For now, use string comparison (works for ISO format YYYY-MM-DD)
-    return date1 >= date2;
+    return TradingCalendar::parse(date1) >= TradingCalendar::parse(date2);
 }
 
 } // namespace atlas
\ No newline at end of file
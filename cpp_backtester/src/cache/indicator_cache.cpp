@@ -0,0 +1,36 @@
+#include "indicator_cache.h"
+#include <algorithm>
+
+namespace atlas {
+
+IndicatorKey IndicatorKey::of(std::string_view source, const ta::IndicatorSpec& spec) {
+    return IndicatorKey{TickerTable::instance().intern(source), spec.kind, spec.period};
+}
+
+size_t IndicatorKeyHash::operator()(const IndicatorKey& key) const noexcept {
+    // Pack the fields into one word and finish with the splitmix64 mixer
+    uint64_t h = (static_cast<uint64_t>(key.ticker) << 32)
+               ^ (static_cast<uint64_t>(static_cast<uint32_t>(key.period)) << 8)
+               ^ static_cast<uint64_t>(key.kind);
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return static_cast<size_t>(h);
+}
+
+std::optional<std::span<const float>> IndicatorCache::find(const IndicatorKey& key, size_t days) const {
+    auto it = series_.find(key);
+    if (it == series_.end()) {
+        return std::nullopt;
+    }
+    return tail(it->second, days);
+}
+
+std::span<const float> IndicatorCache::insert(const IndicatorKey& key, std::vector<float> values, size_t days) {
+    auto it = series_.try_emplace(key, std::move(values)).first;
+    return tail(it->second, days);
+}
+
+} // namespace atlas
@@ -0,0 +1,245 @@
+#include "series_cache.h"
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+
+namespace atlas {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t mix(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+} // namespace
+
+struct SeriesCache::Shard {
+    struct Entry {
+        SeriesKey key;
+        Series values;
+        size_t bytes = 0;
+        Clock::time_point inserted;
+        std::atomic<bool> referenced{true};     // New entries get one sweep of grace
+    };
+
+    // Bookkeeping charged to each entry on top of its floats
+    static constexpr size_t kEntryOverhead = sizeof(Entry) + sizeof(std::vector<float>) + 64;
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<SeriesKey, Entry*, SeriesKeyHash> index;
+    std::vector<std::unique_ptr<Entry>> ring;  // CLOCK order; new entries go just behind the hand
+    size_t hand = 0;
+    size_t bytes = 0;
+    size_t budget = 0;
+
+    void remove(size_t slot) {
+        bytes -= ring[slot]->bytes;
+        index.erase(ring[slot]->key);
+        ring.erase(ring.begin() + static_cast<std::ptrdiff_t>(slot));
+        if (hand > slot) {
+            --hand;
+        }
+        if (hand >= ring.size()) {
+            hand = 0;
+        }
+    }
+};
+
+SeriesKey SeriesKey::price(TickerId ticker, uint32_t as_of) {
+    SeriesKey key;
+    key.kind = Kind::PRICE;
+    key.ticker = ticker;
+    key.as_of = as_of;
+    return key;
+}
+
+SeriesKey SeriesKey::indicator_of(const IndicatorKey& indicator, uint32_t as_of, size_t days) {
+    SeriesKey key;
+    key.kind = Kind::INDICATOR;
+    key.indicator = indicator.kind;
+    key.ticker = indicator.ticker;
+    key.period = indicator.period;
+    key.as_of = as_of;
+    key.days = static_cast<uint32_t>(days);
+    return key;
+}
+
+size_t SeriesKeyHash::operator()(const SeriesKey& key) const noexcept {
+    const uint64_t identity = (static_cast<uint64_t>(key.ticker) << 32)
+                            ^ (static_cast<uint64_t>(static_cast<uint32_t>(key.period)) << 16)
+                            ^ (static_cast<uint64_t>(key.indicator) << 8)
+                            ^ static_cast<uint64_t>(key.kind);
+    const uint64_t extent = (static_cast<uint64_t>(key.as_of) << 32) | key.days;
+    return static_cast<size_t>(mix(mix(identity) ^ extent));
+}
+
+SeriesCache::SeriesCache() : SeriesCache(Options{}) {}
+
+SeriesCache::SeriesCache(const Options& options) {
+    reset(options);
+}
+
+SeriesCache::~SeriesCache() = default;
+
+SeriesCache& SeriesCache::instance() {
+    static SeriesCache instance;
+    return instance;
+}
+
+SeriesCache::Shard& SeriesCache::shard(const SeriesKey& key) {
+    return *shards_[SeriesKeyHash{}(key) % shards_.size()];
+}
+
+SeriesCache::Series SeriesCache::find(const SeriesKey& key) {
+    auto& s = shard(key);
+    std::shared_lock lock(s.mutex);
+
+    auto it = s.index.find(key);
+    if (it == s.index.end() || Clock::now() - it->second->inserted > options_.max_age) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    it->second->referenced.store(true, std::memory_order_relaxed);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return it->second->values;
+}
+
+SeriesCache::Series SeriesCache::insert(const SeriesKey& key, std::vector<float> values) {
+    const size_t bytes = values.size() * sizeof(float) + Shard::kEntryOverhead;
+    auto series = std::make_shared<const std::vector<float>>(std::move(values));
+
+    auto& s = shard(key);
+    if (bytes > s.budget) {
+        return series;
+    }
+
+    std::unique_lock lock(s.mutex);
+    const auto now = Clock::now();
+
+    // CLOCK sweep: expired and unreferenced entries go, referenced ones get a second chance
+    auto make_room = [&](size_t needed) {
+        while (s.bytes + needed > s.budget && !s.ring.empty()) {
+            if (s.hand >= s.ring.size()) {
+                s.hand = 0;
+            }
+            Shard::Entry& entry = *s.ring[s.hand];
+            if (now - entry.inserted > options_.max_age) {
+                s.remove(s.hand);
+                expirations_.fetch_add(1, std::memory_order_relaxed);
+            } else if (entry.referenced.exchange(false, std::memory_order_relaxed)) {
+                ++s.hand;
+            } else {
+                s.remove(s.hand);
+                evictions_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    auto it = s.index.find(key);
+    if (it != s.index.end()) {
+        Shard::Entry& entry = *it->second;
+        s.bytes += bytes - entry.bytes;
+        entry.values = series;
+        entry.bytes = bytes;
+        entry.inserted = now;
+        entry.referenced.store(true, std::memory_order_relaxed);
+        make_room(0);
+    } else {
+        make_room(bytes);
+        auto entry = std::make_unique<Shard::Entry>();
+        entry->key = key;
+        entry->values = series;
+        entry->bytes = bytes;
+        entry->inserted = now;
+        s.index.emplace(key, entry.get());
+        s.hand = std::min(s.hand, s.ring.size());
+        s.ring.insert(s.ring.begin() + static_cast<std::ptrdiff_t>(s.hand), std::move(entry));
+        ++s.hand;
+        s.bytes += bytes;
+    }
+    insertions_.fetch_add(1, std::memory_order_relaxed);
+    return series;
+}
+
+size_t SeriesCache::erase_expired() {
+    const auto now = Clock::now();
+    size_t erased = 0;
+    for (auto& s : shards_) {
+        std::unique_lock lock(s->mutex);
+        for (size_t slot = 0; slot < s->ring.size();) {
+            if (now - s->ring[slot]->inserted > options_.max_age) {
+                s->remove(slot);
+                ++erased;
+            } else {
+                ++slot;
+            }
+        }
+    }
+    expirations_.fetch_add(erased, std::memory_order_relaxed);
+    return erased;
+}
+
+void SeriesCache::reset(const Options& options) {
+    options_ = options;
+    options_.shards = std::max<size_t>(options_.shards, 1);
+
+    shards_.clear();
+    for (size_t i = 0; i < options_.shards; ++i) {
+        auto s = std::make_unique<Shard>();
+        s->budget = options_.byte_budget / options_.shards;
+        shards_.push_back(std::move(s));
+    }
+    hits_ = 0;
+    misses_ = 0;
+    insertions_ = 0;
+    evictions_ = 0;
+    expirations_ = 0;
+}
+
+void SeriesCache::clear() {
+    for (auto& s : shards_) {
+        std::unique_lock lock(s->mutex);
+        s->index.clear();
+        s->ring.clear();
+        s->hand = 0;
+        s->bytes = 0;
+    }
+}
+
+SeriesCacheStats SeriesCache::stats() const {
+    SeriesCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.insertions = insertions_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.expirations = expirations_.load(std::memory_order_relaxed);
+    for (const auto& s : shards_) {
+        std::shared_lock lock(s->mutex);
+        stats.entries += s->ring.size();
+        stats.bytes += s->bytes;
+    }
+    return stats;
+}
+
+uint32_t SeriesCache::date_key(std::string_view date) {
+    if (date.size() != 10 || date[4] != '-' || date[7] != '-') {
+        return 0;
+    }
+    uint32_t key = 0;
+    for (size_t i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+        if (!std::isdigit(static_cast<unsigned char>(date[i]))) {
+            return 0;
+        }
+        key = key * 10 + static_cast<uint32_t>(date[i] - '0');
+    }
+    return key;
+}
+
+} // namespace atlas
@@ -1,11 +1,14 @@
 #include "subtree_cache.h"
+#include "trading_calendar.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <cstring>
-#include <regex>
+#include <map>
+#include <set>
+#include <stdexcept>
 
 namespace atlas {
 
@@ -324,18 +327,17 @@ void SubtreeCache::set_cache_directory(const std::string& cache_dir) {
 
 uint32_t SubtreeCache::date_to_int(const std::string& date_str) const {
     // Parse date string in format "YYYY-MM-DD"
-    std::regex date_regex(R"((\d{4})-(\d{2})-(\d{2}))");
-    std::smatch matches;
-    
-    if (std::regex_match(date_str, matches, date_regex)) {
-        uint32_t year = std::stoul(matches[1].str());
-        uint32_t month = std::stoul(matches[2].str());
-        uint32_t day = std::stoul(matches[3].str());
-        
-        return (year << 16) | (month << 8) | day;
+    if (!validate_date_string(date_str)) {
+        throw SubtreeCacheError("Invalid date format: " + date_str);
     }
-    
-    throw SubtreeCacheError("Invalid date format: " + date_str);
+    auto digits = [&](size_t pos, size_t count) {
+        uint32_t value = 0;
+        for (size_t i = pos; i < pos + count; ++i) {
+            value = value * 10 + static_cast<uint32_t>(date_str[i] - '0');
+        }
+        return value;
+    };
+    return (digits(0, 4) << 16) | (digits(5, 2) << 8) | digits(8, 2);
 }
 
 std::string SubtreeCache::int_to_date(uint32_t date_int) const {
@@ -541,8 +543,13 @@ bool SubtreeCache::validate_portfolio_entry(const PortfolioEntry& entry) const {
 }
 
 bool SubtreeCache::validate_date_string(const std::string& date_str) const {
-    std::regex date_regex(R"(\d{4}-\d{2}-\d{2})");
-    return std::regex_match(date_str, date_regex);
+    if (date_str.size() != 10) return false;
+    try {
+        TradingCalendar::parse(date_str);
+        return true;
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
 }
 
 } // namespace atlas
\ No newline at end of file
@@ -0,0 +1,361 @@
+#include "active_mask.h"
+#include "cpu_features.h"
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ATLAS_MASK_X86 1
+#endif
+
+namespace atlas {
+
+namespace {
+
+using Word = ActiveMask::Word;
+constexpr size_t kWordBits = ActiveMask::kWordBits;
+
+// Word-wise kernels. The AVX2 and AVX-512 bodies are compiled for their
+// targets regardless of -march and picked at runtime by simd_level(),
+// like the TA kernels, so default builds still get the vector paths.
+
+enum class MaskOp { AND, OR, AND_NOT };
+
+template <MaskOp Op>
+Word scalar_op(Word a, Word b) {
+    switch (Op) {
+        case MaskOp::AND: return a & b;
+        case MaskOp::OR: return a | b;
+        case MaskOp::AND_NOT: return a & ~b;
+    }
+    return a;
+}
+
+template <MaskOp Op>
+void apply_words_scalar(Word* dst, const Word* src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = scalar_op<Op>(dst[i], src[i]);
+    }
+}
+
+size_t popcount_words_scalar(const Word* words, size_t n) {
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        total += static_cast<size_t>(std::popcount(words[i]));
+    }
+    return total;
+}
+
+bool any_words_scalar(const Word* words, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (words[i] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(ATLAS_MASK_X86)
+
+template <MaskOp Op>
+__attribute__((target("avx2")))
+void apply_words_avx2(Word* dst, const Word* src, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i r = Op == MaskOp::AND ? _mm256_and_si256(a, b)
+                  : Op == MaskOp::OR  ? _mm256_or_si256(a, b)
+                                      : _mm256_andnot_si256(b, a);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+    }
+    apply_words_scalar<Op>(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2")))
+bool any_words_avx2(const Word* words, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        if (!_mm256_testz_si256(v, v)) {
+            return true;
+        }
+    }
+    return any_words_scalar(words + i, n - i);
+}
+
+template <MaskOp Op>
+__attribute__((target("avx512f")))
+void apply_words_avx512(Word* dst, const Word* src, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i a = _mm512_loadu_si512(dst + i);
+        __m512i b = _mm512_loadu_si512(src + i);
+        // a & ~b via xor: GCC 12's _mm512_andnot_si512 reads an undefined pass-through under -Werror
+        __m512i r = Op == MaskOp::AND ? _mm512_and_si512(a, b)
+                  : Op == MaskOp::OR  ? _mm512_or_si512(a, b)
+                                      : _mm512_and_si512(a, _mm512_xor_si512(b, _mm512_set1_epi64(-1)));
+        _mm512_storeu_si512(dst + i, r);
+    }
+    apply_words_scalar<Op>(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+bool any_words_avx512(const Word* words, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i v = _mm512_loadu_si512(words + i);
+        if (_mm512_test_epi64_mask(v, v) != 0) {
+            return true;
+        }
+    }
+    return any_words_scalar(words + i, n - i);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+size_t popcount_words_avx512(const Word* words, size_t n) {
+    __m512i sum = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+    }
+    // Lane sum through memory; _mm512_reduce_add_epi64 trips the same GCC 12 warning
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, sum);
+    size_t total = popcount_words_scalar(words + i, n - i);
+    for (uint64_t lane : lanes) {
+        total += static_cast<size_t>(lane);
+    }
+    return total;
+}
+
+#endif
+
+template <MaskOp Op>
+void apply_words(Word* dst, const Word* src, size_t n) {
+#if defined(ATLAS_MASK_X86)
+    switch (simd_level()) {
+        case SimdLevel::AVX512: return apply_words_avx512<Op>(dst, src, n);
+        case SimdLevel::AVX2: return apply_words_avx2<Op>(dst, src, n);
+        case SimdLevel::SCALAR: break;
+    }
+#endif
+    apply_words_scalar<Op>(dst, src, n);
+}
+
+size_t popcount_words(const Word* words, size_t n) {
+#if defined(ATLAS_MASK_X86)
+    // Without VPOPCNTDQ the scalar popcnt loop beats emulating it in vector registers
+    if (simd_level() == SimdLevel::AVX512 && has_avx512_vpopcntdq()) {
+        return popcount_words_avx512(words, n);
+    }
+#endif
+    return popcount_words_scalar(words, n);
+}
+
+bool any_words(const Word* words, size_t n) {
+#if defined(ATLAS_MASK_X86)
+    switch (simd_level()) {
+        case SimdLevel::AVX512: return any_words_avx512(words, n);
+        case SimdLevel::AVX2: return any_words_avx2(words, n);
+        case SimdLevel::SCALAR: break;
+    }
+#endif
+    return any_words_scalar(words, n);
+}
+
+} // namespace
+
+ActiveMask::ActiveMask(size_t size, bool value, allocator_type alloc)
+    : words_(words_for(size), value ? ~Word(0) : Word(0), alloc), size_(size) {
+    clear_tail();
+}
+
+ActiveMask::ActiveMask(const ActiveMaskView& view, allocator_type alloc)
+    : words_(words_for(view.size()), alloc), size_(view.size()) {
+    for (size_t w = 0; w < words_.size(); ++w) {
+        words_[w] = view.word(w);
+    }
+}
+
+ActiveMask ActiveMask::from_bools(const std::vector<bool>& bools, allocator_type alloc) {
+    ActiveMask mask(bools.size(), false, alloc);
+    for (size_t i = 0; i < bools.size(); ++i) {
+        if (bools[i]) {
+            mask.words_[i / kWordBits] |= Word(1) << (i % kWordBits);
+        }
+    }
+    return mask;
+}
+
+std::vector<bool> ActiveMask::to_bools() const {
+    std::vector<bool> bools(size_, false);
+    for_each_set([&bools](size_t index) { bools[index] = true; });
+    return bools;
+}
+
+void ActiveMask::set(size_t index, bool value) {
+    const Word bit = Word(1) << (index % kWordBits);
+    if (value) {
+        words_[index / kWordBits] |= bit;
+    } else {
+        words_[index / kWordBits] &= ~bit;
+    }
+}
+
+void ActiveMask::fill(bool value) {
+    std::fill(words_.begin(), words_.end(), value ? ~Word(0) : Word(0));
+    clear_tail();
+}
+
+void ActiveMask::resize(size_t size, bool value) {
+    const size_t old_size = size_;
+    words_.resize(words_for(size), value ? ~Word(0) : Word(0));
+    size_ = size;
+
+    // Bits of the old last word past old_size were zero; set them when growing with ones
+    if (value && size > old_size && old_size % kWordBits != 0) {
+        words_[old_size / kWordBits] |= ~Word(0) << (old_size % kWordBits);
+    }
+    clear_tail();
+}
+
+ActiveMask& ActiveMask::operator&=(const ActiveMask& other) {
+    if (other.size_ != size_) {
+        throw std::invalid_argument("ActiveMask size mismatch");
+    }
+    apply_words<MaskOp::AND>(words_.data(), other.words_.data(), words_.size());
+    return *this;
+}
+
+ActiveMask& ActiveMask::operator|=(const ActiveMask& other) {
+    if (other.size_ != size_) {
+        throw std::invalid_argument("ActiveMask size mismatch");
+    }
+    apply_words<MaskOp::OR>(words_.data(), other.words_.data(), words_.size());
+    return *this;
+}
+
+ActiveMask& ActiveMask::and_not(const ActiveMask& other) {
+    if (other.size_ != size_) {
+        throw std::invalid_argument("ActiveMask size mismatch");
+    }
+    apply_words<MaskOp::AND_NOT>(words_.data(), other.words_.data(), words_.size());
+    return *this;
+}
+
+ActiveMask& ActiveMask::flip() {
+    for (auto& word : words_) {
+        word = ~word;
+    }
+    clear_tail();
+    return *this;
+}
+
+size_t ActiveMask::count() const {
+    return popcount_words(words_.data(), words_.size());
+}
+
+bool ActiveMask::any() const {
+    return any_words(words_.data(), words_.size());
+}
+
+size_t ActiveMask::first_set() const {
+    for (size_t w = 0; w < words_.size(); ++w) {
+        if (words_[w] != 0) {
+            return w * kWordBits + static_cast<size_t>(std::countr_zero(words_[w]));
+        }
+    }
+    return npos;
+}
+
+size_t ActiveMask::last_set() const {
+    for (size_t w = words_.size(); w-- > 0;) {
+        if (words_[w] != 0) {
+            return w * kWordBits + kWordBits - 1 - static_cast<size_t>(std::countl_zero(words_[w]));
+        }
+    }
+    return npos;
+}
+
+ActiveMaskView ActiveMask::view() const {
+    return ActiveMaskView(*this, 0, size_, false);
+}
+
+ActiveMaskView ActiveMask::view(std::ptrdiff_t offset, size_t size, bool fill) const {
+    return ActiveMaskView(*this, offset, size, fill);
+}
+
+void ActiveMask::clear_tail() {
+    if (size_ % kWordBits != 0) {
+        words_.back() &= (Word(1) << (size_ % kWordBits)) - 1;
+    }
+}
+
+bool ActiveMaskView::test(size_t index) const {
+    const std::ptrdiff_t source = offset_ + static_cast<std::ptrdiff_t>(index);
+    if (source < 0 || source >= static_cast<std::ptrdiff_t>(mask_->size())) {
+        return fill_;
+    }
+    return mask_->test(static_cast<size_t>(source));
+}
+
+ActiveMask::Word ActiveMaskView::word(size_t k) const {
+    const size_t begin = k * kWordBits;
+    if (begin >= size_) {
+        return 0;
+    }
+
+    const size_t bits = std::min(kWordBits, size_ - begin);
+    const Word valid = bits == kWordBits ? ~Word(0) : (Word(1) << bits) - 1;
+    const std::ptrdiff_t source = offset_ + static_cast<std::ptrdiff_t>(begin);
+    const auto mask_size = static_cast<std::ptrdiff_t>(mask_->size());
+    const auto span_end = source + static_cast<std::ptrdiff_t>(bits);
+
+    // Entirely outside the mask: all fill
+    if (span_end <= 0 || source >= mask_size) {
+        return fill_ ? valid : 0;
+    }
+
+    // Entirely inside the mask: funnel-shift two source words
+    if (source >= 0 && span_end <= mask_size) {
+        const auto start = static_cast<size_t>(source);
+        const size_t w = start / kWordBits;
+        const size_t shift = start % kWordBits;
+        Word result = mask_->data()[w] >> shift;
+        if (shift != 0 && w + 1 < mask_->word_count()) {
+            result |= mask_->data()[w + 1] << (kWordBits - shift);
+        }
+        return result & valid;
+    }
+
+    // Straddles a mask boundary
+    Word result = 0;
+    for (size_t i = 0; i < bits; ++i) {
+        if (test(begin + i)) {
+            result |= Word(1) << i;
+        }
+    }
+    return result;
+}
+
+size_t ActiveMaskView::count() const {
+    size_t total = 0;
+    const size_t words = (size_ + kWordBits - 1) / kWordBits;
+    for (size_t w = 0; w < words; ++w) {
+        total += static_cast<size_t>(std::popcount(word(w)));
+    }
+    return total;
+}
+
+bool ActiveMaskView::any() const {
+    const size_t words = (size_ + kWordBits - 1) / kWordBits;
+    for (size_t w = 0; w < words; ++w) {
+        if (word(w) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace atlas
@@ -0,0 +1,78 @@
+#include "civil_day.h"
+#include <cstdio>
+
+namespace atlas {
+
+namespace {
+
+// Howard Hinnant's days_from_civil / civil_from_days
+int32_t days_from_civil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int>(doe) - 719468;
+}
+
+void civil_from_days(int32_t z, int& y, unsigned& m, unsigned& d) {
+    z += 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int>(yoe) + era * 400 + (m <= 2);
+}
+
+} // namespace
+
+int32_t civil_day(int year, unsigned month, unsigned day) {
+    return days_from_civil(year, month, day);
+}
+
+unsigned days_in_month(int year, unsigned month) {
+    static constexpr unsigned kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    return month == 2 && leap ? 29 : kDays[(month - 1) % 12];
+}
+
+std::optional<int32_t> parse_civil_day(std::string_view date) {
+    if (date.size() < 10 || date[4] != '-' || date[7] != '-') {
+        return std::nullopt;
+    }
+    int fields[3] = {0, 0, 0};
+    const size_t starts[3] = {0, 5, 8};
+    const size_t lengths[3] = {4, 2, 2};
+    for (int f = 0; f < 3; ++f) {
+        for (size_t i = starts[f]; i < starts[f] + lengths[f]; ++i) {
+            if (date[i] < '0' || date[i] > '9') {
+                return std::nullopt;
+            }
+            fields[f] = fields[f] * 10 + (date[i] - '0');
+        }
+    }
+
+    // Reject dates that do not round-trip, such as 2023-02-30
+    const int32_t day = days_from_civil(fields[0], static_cast<unsigned>(fields[1]), static_cast<unsigned>(fields[2]));
+    int y;
+    unsigned m, d;
+    civil_from_days(day, y, m, d);
+    if (fields[1] < 1 || fields[1] > 12 || y != fields[0] || m != static_cast<unsigned>(fields[1]) || d != static_cast<unsigned>(fields[2])) {
+        return std::nullopt;
+    }
+    return day;
+}
+
+std::string format_civil_day(int32_t day) {
+    int y;
+    unsigned m, d;
+    civil_from_days(day, y, m, d);
+    char buffer[32];    // Room for any int year, which keeps -Wformat-truncation quiet
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u", y, m, d);
+    return buffer;
+}
+
+} // namespace atlas
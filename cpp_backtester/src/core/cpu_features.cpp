@@ -0,0 +1,49 @@
+#include "cpu_features.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ATLAS_CPU_X86 1
+#endif
+
+namespace atlas {
+
+namespace {
+
+std::atomic<SimdLevel>& active_level() {
+    static std::atomic<SimdLevel> level{detected_simd_level()};
+    return level;
+}
+
+} // namespace
+
+SimdLevel detected_simd_level() {
+#if defined(ATLAS_CPU_X86)
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+SimdLevel simd_level() {
+    return active_level().load(std::memory_order_relaxed);
+}
+
+void set_simd_level(SimdLevel level) {
+    active_level().store(std::min(level, detected_simd_level()), std::memory_order_relaxed);
+}
+
+bool has_avx512_vpopcntdq() {
+#if defined(ATLAS_CPU_X86)
+    static const bool supported = __builtin_cpu_supports("avx512vpopcntdq");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+} // namespace atlas
@@ -1,10 +1,10 @@
-#include \"types.h\"
+#include "types.h"
 #include <algorithm>
 
 namespace atlas {
 
-DayData::DayData(std::vector<StockInfo> stock_list)
-    : stock_list_(std::move(stock_list)) {}
+DayData::DayData(const std::vector<StockInfo>& stock_list)
+    : stock_list_(stock_list.begin(), stock_list.end()) {}
 
 void DayData::add_stock(const StockInfo& stock) {
     stock_list_.push_back(stock);
@@ -19,18 +19,18 @@ bool DayData::operator==(const DayData& other) const {
         return false;
     }
     
-    // Sort both lists by ticker for comparison (like Julia implementation)
+    // Sort both lists by ticker for comparison (like Julia implementation); equal ids mean equal tickers
     auto this_sorted = stock_list_;
     auto other_sorted = other.stock_list_;
     
     std::sort(this_sorted.begin(), this_sorted.end(),
               [](const StockInfo& a, const StockInfo& b) {
-                  return a.ticker() < b.ticker();
+                  return a.ticker_id() < b.ticker_id();
               });
     
     std::sort(other_sorted.begin(), other_sorted.end(),
               [](const StockInfo& a, const StockInfo& b) {
-                  return a.ticker() < b.ticker();
+                  return a.ticker_id() < b.ticker_id();
               });
     
     return this_sorted == other_sorted;
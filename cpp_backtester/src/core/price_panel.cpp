@@ -0,0 +1,127 @@
+#include "price_panel.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace atlas {
+
+namespace {
+
+constexpr size_t kColumnAlignment = 16;     // Floats per 64-byte line
+constexpr float kMissing = std::numeric_limits<float>::quiet_NaN();
+
+} // namespace
+
+PricePanel::PricePanel(std::vector<int32_t> calendar, std::vector<std::string> tickers)
+    : calendar_(std::move(calendar)), tickers_(std::move(tickers)) {
+    if (!std::is_sorted(calendar_.begin(), calendar_.end())
+        || std::adjacent_find(calendar_.begin(), calendar_.end()) != calendar_.end()) {
+        throw std::invalid_argument("PricePanel calendar must be strictly increasing");
+    }
+    for (size_t t = 0; t < tickers_.size(); ++t) {
+        if (!columns_.emplace(tickers_[t], t).second) {
+            throw std::invalid_argument("PricePanel ticker listed twice: " + tickers_[t]);
+        }
+    }
+    stride_ = (calendar_.size() + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+    words_ = (calendar_.size() + 63) / 64;
+    data_.assign(stride_ * tickers_.size(), kMissing);
+    validity_.assign(words_ * tickers_.size(), 0);
+    first_valid_.assign(tickers_.size(), kNoValid);
+    last_valid_.assign(tickers_.size(), kNoValid);
+}
+
+size_t PricePanel::column_of(const std::string& ticker) const {
+    auto it = columns_.find(ticker);
+    return it == columns_.end() ? kNoValid : it->second;
+}
+
+size_t PricePanel::index_of(int32_t day) const {
+    const auto it = std::upper_bound(calendar_.begin(), calendar_.end(), day);
+    return it == calendar_.begin() ? kNoValid : static_cast<size_t>(it - calendar_.begin()) - 1;
+}
+
+void PricePanel::set_series(size_t ticker, std::span<const int32_t> days, std::span<const float> values) {
+    if (ticker >= tickers_.size() || days.size() != values.size()) {
+        throw std::out_of_range("PricePanel series does not match panel shape");
+    }
+
+    float* column = data_.data() + ticker * stride_;
+    uint64_t* bits = validity_.data() + ticker * words_;
+    std::fill_n(column, calendar_.size(), kMissing);
+    std::fill_n(bits, words_, 0);
+    first_valid_[ticker] = kNoValid;
+    last_valid_[ticker] = kNoValid;
+
+    // Merge walk from the first row inside the calendar
+    size_t row = static_cast<size_t>(std::lower_bound(days.begin(), days.end(), calendar_.empty() ? 0 : calendar_.front()) - days.begin());
+    size_t day = 0;
+    while (row < days.size() && day < calendar_.size()) {
+        if (days[row] < calendar_[day]) {
+            ++row;
+        } else if (days[row] > calendar_[day]) {
+            ++day;
+        } else {
+            column[day] = values[row];
+            bits[day / 64] |= uint64_t(1) << (day % 64);
+            if (first_valid_[ticker] == kNoValid) {
+                first_valid_[ticker] = day;
+            }
+            last_valid_[ticker] = day;
+            ++row;
+            ++day;
+        }
+    }
+    if (forward_filled_) {
+        forward_filled_ = false;
+        forward_fill();
+    }
+}
+
+void PricePanel::forward_fill() {
+    for (size_t t = 0; t < tickers_.size(); ++t) {
+        if (first_valid_[t] == kNoValid) {
+            continue;
+        }
+        float* column = data_.data() + t * stride_;
+        for (size_t d = first_valid_[t] + 1; d < calendar_.size(); ++d) {
+            if (!valid(t, d)) {
+                column[d] = column[d - 1];
+            }
+        }
+    }
+    forward_filled_ = true;
+}
+
+std::span<const float> PricePanel::valid_series(size_t ticker) const {
+    if (first_valid_[ticker] == kNoValid) {
+        return {};
+    }
+    return series(ticker).subspan(first_valid_[ticker], last_valid_[ticker] - first_valid_[ticker] + 1);
+}
+
+std::pair<size_t, size_t> PricePanel::common_range() const {
+    size_t first = 0;
+    size_t last = calendar_.size();
+    for (size_t t = 0; t < tickers_.size(); ++t) {
+        if (first_valid_[t] == kNoValid) {
+            return {0, 0};
+        }
+        first = std::max(first, first_valid_[t]);
+        last = std::min(last, last_valid_[t] + 1);
+    }
+    return first < last ? std::pair{first, last} : std::pair<size_t, size_t>{0, 0};
+}
+
+ta::TickerPanel PricePanel::window(size_t first, size_t count) const {
+    if (first + count > calendar_.size()) {
+        throw std::out_of_range("PricePanel window exceeds the calendar");
+    }
+    ta::TickerPanel panel(tickers_.size(), count);
+    for (size_t t = 0; t < tickers_.size(); ++t) {
+        panel.set_series(t, series(t).subspan(first, count));
+    }
+    return panel;
+}
+
+} // namespace atlas
@@ -0,0 +1,43 @@
+#include "run_arena.h"
+#include <algorithm>
+
+namespace atlas {
+
+void* RunArena::CountingResource::do_allocate(size_t bytes, size_t alignment) {
+    allocated += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void RunArena::CountingResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+RunArena::RunArena(size_t block_bytes)
+    : block_bytes_(std::max<size_t>(block_bytes, 1)) {
+    rebuild();
+}
+
+RunArena& RunArena::local() {
+    thread_local RunArena arena;
+    return arena;
+}
+
+void RunArena::reset() {
+    const size_t needed = block_bytes_ + upstream_.allocated;
+    resource_->release();
+    upstream_.allocated = 0;
+
+    // Size the block to this run's high-water mark so the next run fits in it
+    if (needed > block_bytes_ && block_bytes_ < kMaxRetainedBytes) {
+        block_bytes_ = std::min(needed, kMaxRetainedBytes);
+        rebuild();
+    }
+}
+
+void RunArena::rebuild() {
+    resource_.reset();
+    block_ = std::make_unique_for_overwrite<std::byte[]>(block_bytes_);
+    resource_.emplace(block_.get(), block_bytes_, &upstream_);
+}
+
+} // namespace atlas
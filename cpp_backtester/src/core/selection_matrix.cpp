@@ -0,0 +1,83 @@
+#include "selection_matrix.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace atlas {
+
+namespace {
+
+// Branch counts up to this use the insertion buffer
+constexpr size_t kSmallSelection = 16;
+
+// Map float bits onto unsigned integers with the same order (-0.0 < 0.0)
+uint32_t ordered_bits(float value) {
+    const uint32_t bits = std::bit_cast<uint32_t>(value);
+    return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+}
+
+} // namespace
+
+SelectionMatrix::SelectionMatrix(size_t days, size_t k)
+    : k_(k), indices_(days * k), counts_(days, 0) {}
+
+SelectionMatrix SelectionMatrix::from_rows(const std::vector<std::vector<int>>& rows) {
+    size_t k = 0;
+    for (const auto& row : rows) {
+        k = std::max(k, row.size());
+    }
+    SelectionMatrix matrix(rows.size(), k);
+    for (size_t day = 0; day < rows.size(); ++day) {
+        std::copy(rows[day].begin(), rows[day].end(), matrix.row_data(day));
+        matrix.set_count(day, rows[day].size());
+    }
+    return matrix;
+}
+
+uint64_t selection_key(float score, uint32_t branch, bool descending) {
+    if (!std::isfinite(score)) {
+        score = 0.0f;
+    }
+    const uint32_t rank = descending ? ~ordered_bits(score) : ordered_bits(score);
+    return (static_cast<uint64_t>(rank) << 32) | branch;
+}
+
+size_t select_top_k(uint64_t* keys, size_t n, size_t k, int32_t* out) {
+    k = std::min(k, n);
+    if (k == 0) {
+        return 0;
+    }
+
+    if (n <= kSmallSelection) {
+        // Keep the best k seen so far in order; each key shifts at most k slots
+        uint64_t best[kSmallSelection];
+        size_t filled = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t key = keys[i];
+            if (filled == k && key >= best[k - 1]) {
+                continue;
+            }
+            size_t slot = filled < k ? filled++ : k - 1;
+            while (slot > 0 && best[slot - 1] > key) {
+                best[slot] = best[slot - 1];
+                --slot;
+            }
+            best[slot] = key;
+        }
+        for (size_t i = 0; i < k; ++i) {
+            out[i] = static_cast<int32_t>(best[i] & 0xffffffffu);
+        }
+        return k;
+    }
+
+    if (k < n) {
+        std::nth_element(keys, keys + k - 1, keys + n);
+    }
+    std::sort(keys, keys + k);
+    for (size_t i = 0; i < k; ++i) {
+        out[i] = static_cast<int32_t>(keys[i] & 0xffffffffu);
+    }
+    return k;
+}
+
+} // namespace atlas
@@ -1,13 +1,13 @@
-#include \"types.h\"
+#include "types.h"
 #include <algorithm>
 
 namespace atlas {
 
 StockInfo::StockInfo(const std::string& ticker, float weight_tomorrow)
-    : ticker_(ticker), weight_tomorrow_(weight_tomorrow) {}
+    : ticker_id_(TickerTable::symbols().intern(ticker)), weight_tomorrow_(weight_tomorrow) {}
 
 bool StockInfo::operator==(const StockInfo& other) const {
-    return ticker_ == other.ticker_ && 
+    return ticker_id_ == other.ticker_id_ && 
            std::abs(weight_tomorrow_ - other.weight_tomorrow_) < 1e-6f;
 }
 
@@ -0,0 +1,158 @@
+#include "ticker_table.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace atlas {
+
+namespace {
+
+constexpr size_t kInitialCapacity = 1024;
+
+size_t hash_ticker(std::string_view ticker) {
+    return std::hash<std::string_view>{}(ticker);
+}
+
+} // namespace
+
+std::string normalize_ticker(std::string_view ticker) {
+    std::string normalized(ticker);
+    std::replace(normalized.begin(), normalized.end(), '.', '-');
+    return normalized;
+}
+
+TickerTable::Index::Index(size_t capacity)
+    : mask(capacity - 1), slots(std::make_unique<std::atomic<const Entry*>[]>(capacity)) {
+    for (size_t i = 0; i < capacity; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+TickerTable::TickerTable(bool normalize)
+    : segments_(std::make_unique<std::atomic<Entry*>[]>(kMaxSegments)), normalize_(normalize) {
+    for (size_t i = 0; i < kMaxSegments; ++i) {
+        segments_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    indexes_.push_back(std::make_unique<Index>(kInitialCapacity));
+    index_.store(indexes_.back().get(), std::memory_order_release);
+}
+
+TickerTable::~TickerTable() {
+    for (size_t i = 0; i < kMaxSegments; ++i) {
+        delete[] segments_[i].load(std::memory_order_relaxed);
+    }
+}
+
+TickerTable& TickerTable::instance() {
+    static TickerTable instance;
+    return instance;
+}
+
+TickerTable& TickerTable::symbols() {
+    // Exact spellings; the empty symbol takes id 0 so default StockInfo needs no lookup
+    struct SymbolTable : TickerTable {
+        SymbolTable() : TickerTable(false) { intern(""); }
+    };
+    static SymbolTable symbols;
+    return symbols;
+}
+
+std::string_view TickerTable::prepare(std::string_view ticker, std::string& buffer) const {
+    // Only symbols with a dot need a normalized copy
+    if (!normalize_ || ticker.find('.') == std::string_view::npos) {
+        return ticker;
+    }
+    buffer = normalize_ticker(ticker);
+    return buffer;
+}
+
+const TickerTable::Entry* TickerTable::lookup(std::string_view ticker, size_t hash) const {
+    const Index* index = index_.load(std::memory_order_acquire);
+    for (size_t slot = hash & index->mask;; slot = (slot + 1) & index->mask) {
+        const Entry* entry = index->slots[slot].load(std::memory_order_acquire);
+        if (!entry) {
+            return nullptr;
+        }
+        if (entry->hash == hash && entry->name == ticker) {
+            return entry;
+        }
+    }
+}
+
+void TickerTable::insert_slot(Index& index, const Entry* entry) {
+    size_t slot = entry->hash & index.mask;
+    while (index.slots[slot].load(std::memory_order_relaxed)) {
+        slot = (slot + 1) & index.mask;
+    }
+    index.slots[slot].store(entry, std::memory_order_release);
+}
+
+TickerId TickerTable::intern(std::string_view ticker) {
+    std::string normalized;
+    ticker = prepare(ticker, normalized);
+
+    const size_t hash = hash_ticker(ticker);
+    if (const Entry* entry = lookup(ticker, hash)) {
+        return entry->id;
+    }
+
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    if (const Entry* entry = lookup(ticker, hash)) {
+        return entry->id;
+    }
+
+    const size_t id = size_.load(std::memory_order_relaxed);
+    if (id >= kMaxTickers) {
+        throw std::length_error("TickerTable is full");
+    }
+
+    Entry* segment = segments_[id >> kSegmentBits].load(std::memory_order_relaxed);
+    if (!segment) {
+        segment = new Entry[kSegmentSize];
+        segments_[id >> kSegmentBits].store(segment, std::memory_order_release);
+    }
+    Entry& entry = segment[id & (kSegmentSize - 1)];
+    entry.name = std::string(ticker);
+    entry.hash = hash;
+    entry.id = static_cast<TickerId>(id);
+
+    // Keep the index at most half full; readers on the old index still see every older entry
+    const Index* current = index_.load(std::memory_order_relaxed);
+    if ((id + 1) * 2 > current->mask + 1) {
+        auto grown = std::make_unique<Index>((current->mask + 1) * 2);
+        for (size_t i = 0; i < id; ++i) {
+            insert_slot(*grown, &segments_[i >> kSegmentBits].load(std::memory_order_relaxed)[i & (kSegmentSize - 1)]);
+        }
+        indexes_.push_back(std::move(grown));
+        index_.store(indexes_.back().get(), std::memory_order_release);
+    }
+
+    // Publish the id before the index slot so name(find(x)) is always valid
+    size_.store(id + 1, std::memory_order_release);
+    insert_slot(*indexes_.back(), &entry);
+    return entry.id;
+}
+
+std::optional<TickerId> TickerTable::find(std::string_view ticker) const {
+    std::string normalized;
+    ticker = prepare(ticker, normalized);
+
+    const Entry* entry = lookup(ticker, hash_ticker(ticker));
+    return entry ? std::optional<TickerId>(entry->id) : std::nullopt;
+}
+
+const std::string& TickerTable::name(TickerId id) const {
+    if (id >= size_.load(std::memory_order_acquire)) {
+        throw std::out_of_range("Unknown ticker id " + std::to_string(id));
+    }
+    return segments_[id >> kSegmentBits].load(std::memory_order_acquire)[id & (kSegmentSize - 1)].name;
+}
+
+CompactTickerId TickerTable::compact(TickerId id) {
+    if (id > UINT16_MAX) {
+        throw std::out_of_range("Ticker id " + std::to_string(id) + " does not fit in 16 bits");
+    }
+    return static_cast<CompactTickerId>(id);
+}
+
+} // namespace atlas
@@ -0,0 +1,210 @@
+#include "trading_calendar.h"
+#include "civil_day.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace atlas {
+
+namespace {
+
+constexpr unsigned kSunday = 0;
+constexpr unsigned kMonday = 1;
+constexpr unsigned kThursday = 4;
+constexpr unsigned kFriday = 5;
+constexpr unsigned kSaturday = 6;
+
+unsigned weekday(int32_t day) {
+    return static_cast<unsigned>(((day % 7) + 11) % 7);     // 1970-01-01 was a Thursday
+}
+
+// nth (1-based) given weekday of a month; n = -1 for the last one
+int32_t nth_weekday(int year, unsigned month, unsigned wd, int n) {
+    if (n < 0) {
+        const int32_t last = civil_day(year, month, days_in_month(year, month));
+        return last - static_cast<int32_t>((weekday(last) + 7 - wd) % 7);
+    }
+    const int32_t first = civil_day(year, month, 1);
+    return first + static_cast<int32_t>((wd + 7 - weekday(first)) % 7) + 7 * (n - 1);
+}
+
+// Anonymous Gregorian algorithm (Meeus/Jones/Butcher)
+int32_t easter_sunday(int year) {
+    const int a = year % 19;
+    const int b = year / 100;
+    const int c = year % 100;
+    const int d = b / 4;
+    const int e = b % 4;
+    const int f = (b + 8) / 25;
+    const int g = (b - f + 1) / 3;
+    const int h = (19 * a + b - d - g + 15) % 30;
+    const int i = c / 4;
+    const int k = c % 4;
+    const int l = (32 + 2 * e + 2 * i - h - k) % 7;
+    const int m = (a + 11 * h + 22 * l) / 451;
+    const int month = (h + l - 7 * m + 114) / 31;
+    const int day = (h + l - 7 * m + 114) % 31 + 1;
+    return civil_day(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+}
+
+// Saturday holidays close the Friday before, Sunday holidays the Monday after
+int32_t observed(int32_t day) {
+    switch (weekday(day)) {
+        case kSaturday: return day - 1;
+        case kSunday: return day + 1;
+        default: return day;
+    }
+}
+
+// Closings outside the holiday rules
+constexpr const char* kUnscheduledClosings[] = {
+    "1994-04-27",   // President Nixon's funeral
+    "2001-09-11", "2001-09-12", "2001-09-13", "2001-09-14",
+    "2004-06-11",   // President Reagan's funeral
+    "2007-01-02",   // President Ford's funeral
+    "2012-10-29", "2012-10-30",     // Hurricane Sandy
+    "2018-12-05",   // President G.H.W. Bush's funeral
+    "2025-01-09",   // President Carter's funeral
+};
+
+} // namespace
+
+const TradingCalendar& TradingCalendar::nyse() {
+    static const TradingCalendar calendar;
+    return calendar;
+}
+
+std::vector<int32_t> TradingCalendar::holidays(int year) {
+    std::vector<int32_t> days;
+
+    // New Year's Day on a Saturday would close December 31 of the prior year; NYSE does not observe it
+    const int32_t new_year = civil_day(year, 1, 1);
+    if (weekday(new_year) != kSaturday) {
+        days.push_back(observed(new_year));
+    }
+    if (year >= 1998) {
+        days.push_back(nth_weekday(year, 1, kMonday, 3));
+    }
+    days.push_back(nth_weekday(year, 2, kMonday, 3));
+    days.push_back(easter_sunday(year) - 2);
+    days.push_back(nth_weekday(year, 5, kMonday, -1));
+    if (year >= 2022) {
+        days.push_back(observed(civil_day(year, 6, 19)));
+    }
+    days.push_back(observed(civil_day(year, 7, 4)));
+    days.push_back(nth_weekday(year, 9, kMonday, 1));
+    days.push_back(nth_weekday(year, 11, kThursday, 4));
+    days.push_back(observed(civil_day(year, 12, 25)));
+
+    for (const char* date : kUnscheduledClosings) {
+        if (std::stoi(std::string(date, 4)) == year) {
+            days.push_back(*parse_civil_day(date));
+        }
+    }
+
+    std::sort(days.begin(), days.end());
+    days.erase(std::unique(days.begin(), days.end()), days.end());
+    return days;
+}
+
+TradingCalendar::TradingCalendar() {
+    first_day_ = civil_day(kFirstYear, 1, 1);
+    const int32_t end = civil_day(kLastYear, 12, 31);
+
+    std::vector<int32_t> closed;
+    for (int year = kFirstYear; year <= kLastYear; ++year) {
+        auto year_holidays = holidays(year);
+        closed.insert(closed.end(), year_holidays.begin(), year_holidays.end());
+    }
+
+    days_.reserve(static_cast<size_t>(end - first_day_) * 5 / 7 + 1);
+    on_or_before_.resize(static_cast<size_t>(end - first_day_) + 1);
+    auto holiday = closed.begin();
+    for (int32_t day = first_day_; day <= end; ++day) {
+        while (holiday != closed.end() && *holiday < day) {
+            ++holiday;
+        }
+        const unsigned wd = weekday(day);
+        const bool open = wd >= kMonday && wd <= kFriday && (holiday == closed.end() || *holiday != day);
+        if (open) {
+            days_.push_back(day);
+        }
+        on_or_before_[static_cast<size_t>(day - first_day_)] = static_cast<int32_t>(days_.size()) - 1;
+    }
+}
+
+void TradingCalendar::check(int32_t day) const {
+    if (!covers(day)) {
+        throw std::out_of_range("Date " + format_civil_day(day) + " is outside the trading calendar");
+    }
+}
+
+bool TradingCalendar::is_trading_day(int32_t day) const {
+    return index_of(day) >= 0;
+}
+
+int32_t TradingCalendar::index_of(int32_t day) const {
+    if (!covers(day)) {
+        return -1;
+    }
+    const int32_t index = on_or_before_[static_cast<size_t>(day - first_day_)];
+    return index >= 0 && days_[static_cast<size_t>(index)] == day ? index : -1;
+}
+
+int32_t TradingCalendar::index_on_or_before(int32_t day) const {
+    if (day > last_day()) {
+        return static_cast<int32_t>(days_.size()) - 1;
+    }
+    return day < first_day_ ? -1 : on_or_before_[static_cast<size_t>(day - first_day_)];
+}
+
+int32_t TradingCalendar::day_at(int32_t index) const {
+    if (index < 0 || static_cast<size_t>(index) >= days_.size()) {
+        throw std::out_of_range("Trading day index " + std::to_string(index) + " is outside the trading calendar");
+    }
+    return days_[static_cast<size_t>(index)];
+}
+
+int32_t TradingCalendar::trading_days_between(int32_t from, int32_t to) const {
+    check(from);
+    check(to);
+    return index_on_or_before(to) - index_on_or_before(from);
+}
+
+int32_t TradingCalendar::previous_trading_day(int32_t day) const {
+    check(day);
+    return day_at(index_on_or_before(day - 1));
+}
+
+int32_t TradingCalendar::next_trading_day(int32_t day) const {
+    check(day);
+    return day_at(index_on_or_before(day) + 1);
+}
+
+std::vector<int32_t> TradingCalendar::range(int32_t end_day, int32_t count) const {
+    check(end_day);
+    const int32_t last = index_on_or_before(end_day);
+    if (count < 0 || last + 1 < count) {
+        throw std::out_of_range("Trading calendar has fewer than " + std::to_string(count) +
+                                " days before " + format_civil_day(end_day));
+    }
+    std::vector<int32_t> indices(static_cast<size_t>(count));
+    for (int32_t i = 0; i < count; ++i) {
+        indices[static_cast<size_t>(i)] = last - count + 1 + i;
+    }
+    return indices;
+}
+
+int32_t TradingCalendar::parse(std::string_view date) {
+    auto day = parse_civil_day(date);
+    if (!day) {
+        throw std::invalid_argument("Invalid date: " + std::string(date));
+    }
+    return *day;
+}
+
+std::string TradingCalendar::format(int32_t index) const {
+    return format_civil_day(day_at(index));
+}
+
+} // namespace atlas
@@ -0,0 +1,270 @@
+#include "price_ingest.h"
+#include "civil_day.h"
+#include "price_store.h"
+#include "stock_data_provider.h"
+#include "ticker_table.h"
+#include "work_stealing_pool.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <set>
+
+namespace atlas {
+
+namespace {
+
+constexpr uint64_t kAsciiZeros = 0x3030303030303030ull;
+constexpr uint64_t kHighBits = 0x8080808080808080ull;
+
+std::string_view trim(std::string_view field) {
+    while (!field.empty() && (field.front() == ' ' || field.front() == '"')) {
+        field.remove_prefix(1);
+    }
+    while (!field.empty() && (field.back() == ' ' || field.back() == '"' || field.back() == '\r')) {
+        field.remove_suffix(1);
+    }
+    return field;
+}
+
+void split_fields(std::string_view line, std::vector<std::string_view>& fields) {
+    fields.clear();
+    size_t start = 0;
+    for (size_t comma; (comma = line.find(',', start)) != std::string_view::npos; start = comma + 1) {
+        fields.push_back(trim(line.substr(start, comma - start)));
+    }
+    fields.push_back(trim(line.substr(start)));
+}
+
+std::optional<float> parse_float(std::string_view field) {
+    float value = 0.0f;
+    const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+    if (field.empty() || error != std::errc() || end != field.data() + field.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+int find_column(const std::vector<std::string>& names, std::initializer_list<std::string_view> candidates) {
+    for (auto candidate : candidates) {
+        auto it = std::find(names.begin(), names.end(), candidate);
+        if (it != names.end()) {
+            return static_cast<int>(it - names.begin());
+        }
+    }
+    return -1;
+}
+
+IngestReport ingest_one(const std::string& source, const IngestOptions& options) {
+    IngestReport report;
+    report.source = source;
+    const std::filesystem::path path(source);
+    report.ticker = normalize_ticker(path.stem().string());
+
+    try {
+        if (path.extension() == ".parquet") {
+            throw StockDataError("Parquet input needs a Parquet reader, which this build does not include: " + source);
+        }
+        if (path.extension() != ".csv") {
+            throw StockDataError("Unsupported input format: " + source);
+        }
+
+        const DailyBars bars = read_price_csv(source);
+        report.rows = bars.days.size();
+        report.skipped = bars.skipped;
+
+        const std::string target = MappedStockDataProvider::price_file_path(options.output_root, report.ticker);
+        if (options.append) {
+            const auto appended = append_price_file(target, bars.days, bars.closes, bars.volumes);
+            report.written = appended.appended;
+            report.already_stored = appended.skipped;
+        } else {
+            write_price_file(target, bars.days, bars.closes, bars.volumes, price_file_capacity(bars.days.size()));
+            report.written = bars.days.size();
+        }
+    } catch (const std::exception& e) {
+        report.error = e.what();
+    }
+    return report;
+}
+
+} // namespace
+
+size_t parse_civil_days(std::span<const std::string_view> dates, std::span<int32_t> days) {
+    for (size_t i = 0; i < dates.size(); ++i) {
+        const std::string_view date = dates[i];
+        if (date.size() < 10 || date[4] != '-' || date[7] != '-') {
+            return i;
+        }
+
+        // YYYYMMDD as eight ASCII bytes, first digit in the low byte
+        char packed[8];
+        std::memcpy(packed, date.data(), 4);
+        std::memcpy(packed + 4, date.data() + 5, 2);
+        std::memcpy(packed + 6, date.data() + 8, 2);
+        uint64_t chunk;
+        std::memcpy(&chunk, packed, sizeof(chunk));
+
+        // A byte is a digit iff neither b - '0' borrows nor b + 0x46 reaches 0x80
+        if (((chunk - kAsciiZeros) | (chunk + 0x4646464646464646ull)) & kHighBits) {
+            return i;
+        }
+
+        // Combine adjacent digits pairwise: 2 -> 4 -> 8 digits per lane
+        uint64_t value = chunk - kAsciiZeros;
+        value = (value * 10 + (value >> 8)) & 0x00FF00FF00FF00FFull;
+        value = (value * 100 + (value >> 16)) & 0x0000FFFF0000FFFFull;
+        value = (value * 10000 + (value >> 32)) & 0xFFFFFFFFull;
+
+        const int year = static_cast<int>(value / 10000);
+        const unsigned month = static_cast<unsigned>(value / 100 % 100);
+        const unsigned day = static_cast<unsigned>(value % 100);
+        if (month < 1 || month > 12 || day < 1 || day > days_in_month(year, month)) {
+            return i;
+        }
+        days[i] = civil_day(year, month, day);
+    }
+    return dates.size();
+}
+
+DailyBars read_price_csv(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw StockDataError("Cannot read " + path);
+    }
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::vector<std::string_view> lines;
+    for (size_t start = 0; start < text.size();) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string_view line = trim(std::string_view(text).substr(start, end - start));
+        if (!line.empty()) {
+            lines.push_back(line);
+        }
+        start = end + 1;
+    }
+    if (lines.empty()) {
+        throw StockDataError("Empty price file " + path);
+    }
+
+    std::vector<std::string_view> fields;
+    split_fields(lines.front(), fields);
+    std::vector<std::string> names;
+    for (auto field : fields) {
+        std::string name(field);
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        names.push_back(std::move(name));
+    }
+    const int date_column = find_column(names, {"date", "timestamp"});
+    const int close_column = find_column(names, {"adjusted_close", "adj_close", "adj close", "close"});
+    const int volume_column = find_column(names, {"volume"});
+    if (date_column < 0 || close_column < 0) {
+        throw StockDataError("No date or close column in " + path);
+    }
+    const size_t width = static_cast<size_t>(std::max({date_column, close_column, volume_column})) + 1;
+
+    // Split and convert numbers first, then convert all dates in one pass
+    DailyBars bars;
+    std::vector<std::string_view> dates;
+    dates.reserve(lines.size());
+    bars.closes.reserve(lines.size());
+    bars.volumes.reserve(lines.size());
+    for (size_t row = 1; row < lines.size(); ++row) {
+        split_fields(lines[row], fields);
+        if (fields.size() < width) {
+            throw StockDataError("Row " + std::to_string(row + 1) + " of " + path + " has too few columns");
+        }
+        const auto close = parse_float(fields[static_cast<size_t>(close_column)]);
+        if (!close) {
+            ++bars.skipped;
+            continue;
+        }
+        dates.push_back(fields[static_cast<size_t>(date_column)]);
+        bars.closes.push_back(*close);
+        bars.volumes.push_back(volume_column < 0 ? 0.0f : parse_float(fields[static_cast<size_t>(volume_column)]).value_or(0.0f));
+    }
+
+    bars.days.resize(dates.size());
+    const size_t parsed = parse_civil_days(dates, bars.days);
+    if (parsed < dates.size()) {
+        throw StockDataError("Invalid date '" + std::string(dates[parsed]) + "' in " + path);
+    }
+    for (size_t i = 1; i < bars.days.size(); ++i) {
+        if (bars.days[i] <= bars.days[i - 1]) {
+            throw StockDataError("Date " + std::string(dates[i]) + " does not follow " + std::string(dates[i - 1]) + " in " + path);
+        }
+    }
+    return bars;
+}
+
+std::vector<IngestReport> ingest_price_files(const std::vector<std::string>& inputs, const IngestOptions& options) {
+    std::filesystem::create_directories(options.output_root);
+
+    // Two sources for one ticker would race on the same price file
+    std::vector<IngestReport> reports(inputs.size());
+    std::set<std::string> seen;
+    std::vector<size_t> work;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const std::string ticker = normalize_ticker(std::filesystem::path(inputs[i]).stem().string());
+        if (!seen.insert(ticker).second) {
+            reports[i].source = inputs[i];
+            reports[i].ticker = ticker;
+            reports[i].error = "Another input already provides " + ticker;
+            continue;
+        }
+        work.push_back(i);
+    }
+
+    WorkStealingPool pool(options.threads);
+    pool.parallel_for(work.size(), [&](size_t w) {
+        reports[work[w]] = ingest_one(inputs[work[w]], options);
+    });
+    return reports;
+}
+
+nlohmann::json write_price_manifest(const std::string& data_root) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(data_root)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".apx") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    nlohmann::json tickers = nlohmann::json::object();
+    for (const auto& file : files) {
+        const auto prices = MappedPriceFile::open(file.string());
+        nlohmann::json entry;
+        entry["file"] = file.filename().string();
+        entry["rows"] = prices->rows();
+        if (prices->rows() > 0) {
+            entry["first_date"] = format_civil_day(prices->first_day());
+            entry["last_date"] = format_civil_day(prices->last_day());
+        }
+        tickers[file.stem().string()] = std::move(entry);
+    }
+
+    nlohmann::json manifest;
+    manifest["format_version"] = PriceFileHeader::kVersion;
+    manifest["tickers"] = std::move(tickers);
+
+    const std::string path = data_root + "/manifest.json";
+    {
+        std::ofstream out(path + ".tmp", std::ios::trunc);
+        out << manifest.dump(2) << '\n';
+        if (!out.flush()) {
+            throw StockDataError("Cannot write " + path);
+        }
+    }
+    std::filesystem::rename(path + ".tmp", path);
+    return manifest;
+}
+
+} // namespace atlas
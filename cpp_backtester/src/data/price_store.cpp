@@ -0,0 +1,262 @@
+#include "price_store.h"
+#include "stock_data_provider.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace atlas {
+
+namespace {
+
+constexpr uint64_t kColumnAlignment = 64;
+
+uint64_t align_up(uint64_t offset) {
+    return (offset + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+}
+
+bool column_fits(uint64_t offset, uint64_t bytes, uint64_t size) {
+    return offset % kColumnAlignment == 0 && offset <= size && bytes <= size - offset;
+}
+
+// Calendar days covered by capacity rows: trading days plus weekends and holidays
+uint64_t index_slots_for(uint64_t span, uint64_t spare_rows) {
+    return span + spare_rows * 3 / 2 + 7;
+}
+
+void check_rows(const std::string& path, std::span<const int32_t> days, std::span<const float> closes, std::span<const float> volumes) {
+    if (closes.size() != days.size() || volumes.size() != days.size()) {
+        throw StockDataError("Price columns differ in length for " + path);
+    }
+    for (size_t i = 1; i < days.size(); ++i) {
+        if (days[i] <= days[i - 1]) {
+            throw StockDataError("Price rows are not in strictly increasing date order for " + path);
+        }
+    }
+}
+
+void write_fully(int fd, uint64_t offset, const void* data, size_t bytes, const std::string& path) {
+    const char* cursor = static_cast<const char*>(data);
+    while (bytes > 0) {
+        const ssize_t written = ::pwrite(fd, cursor, bytes, static_cast<off_t>(offset));
+        if (written <= 0) {
+            throw StockDataError("Cannot write price file " + path);
+        }
+        cursor += written;
+        offset += static_cast<uint64_t>(written);
+        bytes -= static_cast<size_t>(written);
+    }
+}
+
+} // namespace
+
+void write_price_file(
+    const std::string& path,
+    std::span<const int32_t> days,
+    std::span<const float> closes,
+    std::span<const float> volumes,
+    size_t capacity
+) {
+    check_rows(path, days, closes, volumes);
+
+    const size_t rows = days.size();
+    capacity = std::max(capacity, rows);
+    PriceFileHeader header;
+    std::memcpy(header.magic, PriceFileHeader::kMagic, sizeof(header.magic));
+    header.version = PriceFileHeader::kVersion;
+    header.rows = static_cast<uint32_t>(rows);
+    header.capacity = static_cast<uint32_t>(capacity);
+    header.first_day = rows ? days.front() : 0;
+    header.last_day = rows ? days.back() : 0;
+
+    // rows_through() for every calendar day the file spans
+    std::vector<uint32_t> index(rows ? static_cast<size_t>(header.last_day - header.first_day) + 1 : 0);
+    for (size_t slot = 0, row = 0; slot < index.size(); ++slot) {
+        while (row < rows && days[row] <= header.first_day + static_cast<int32_t>(slot)) {
+            ++row;
+        }
+        index[slot] = static_cast<uint32_t>(row);
+    }
+    header.index_capacity = static_cast<uint32_t>(rows ? index_slots_for(index.size(), capacity - rows) : 0);
+
+    header.days_offset = align_up(sizeof(PriceFileHeader));
+    header.close_offset = align_up(header.days_offset + capacity * sizeof(int32_t));
+    header.volume_offset = align_up(header.close_offset + capacity * sizeof(float));
+    header.index_offset = align_up(header.volume_offset + capacity * sizeof(float));
+    header.file_size = header.index_offset + uint64_t(header.index_capacity) * sizeof(uint32_t);
+
+    // Write beside the target and rename, so a reader never maps a partial file
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw StockDataError("Cannot write price file " + temp_path);
+        }
+        auto write_at = [&](uint64_t offset, const void* data, size_t bytes) {
+            static const char zeros[kColumnAlignment] = {};
+            for (uint64_t pos = static_cast<uint64_t>(out.tellp()); pos < offset; pos = static_cast<uint64_t>(out.tellp())) {
+                out.write(zeros, static_cast<std::streamsize>(std::min(offset - pos, kColumnAlignment)));
+            }
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        };
+        write_at(0, &header, sizeof(header));
+        write_at(header.days_offset, days.data(), rows * sizeof(int32_t));
+        write_at(header.close_offset, closes.data(), rows * sizeof(float));
+        write_at(header.volume_offset, volumes.data(), rows * sizeof(float));
+        write_at(header.index_offset, index.data(), index.size() * sizeof(uint32_t));
+        write_at(header.file_size, nullptr, 0);
+        if (!out.flush()) {
+            throw StockDataError("Cannot write price file " + temp_path);
+        }
+    }
+    std::filesystem::rename(temp_path, path);
+}
+
+PriceAppendResult append_price_file(
+    const std::string& path,
+    std::span<const int32_t> days,
+    std::span<const float> closes,
+    std::span<const float> volumes
+) {
+    check_rows(path, days, closes, volumes);
+    if (!std::filesystem::exists(path)) {
+        write_price_file(path, days, closes, volumes, price_file_capacity(days.size()));
+        return {days.size(), 0};
+    }
+
+    const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        throw StockDataError("Cannot open price file " + path);
+    }
+    struct FdCloser {
+        int fd;
+        ~FdCloser() { ::close(fd); }
+    } closer{fd};
+
+    PriceFileHeader header;
+    if (::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))
+        || std::memcmp(header.magic, PriceFileHeader::kMagic, sizeof(header.magic)) != 0
+        || header.version != PriceFileHeader::kVersion) {
+        throw StockDataError("Malformed price file: " + path);
+    }
+
+    // Rows up to the stored last day are history and are never rewritten
+    size_t skip = 0;
+    if (header.rows > 0) {
+        skip = static_cast<size_t>(std::upper_bound(days.begin(), days.end(), header.last_day) - days.begin());
+    }
+    const size_t added = days.size() - skip;
+    if (added == 0) {
+        return {0, skip};
+    }
+
+    const size_t rows = header.rows;
+    const uint64_t slots = static_cast<uint64_t>(int64_t(days.back()) - (rows ? header.first_day : days[skip])) + 1;
+    if (rows == 0 || rows + added > header.capacity || slots > header.index_capacity) {
+        auto file = MappedPriceFile::open(path);
+        std::vector<int32_t> all_days(file->days().begin(), file->days().end());
+        std::vector<float> all_closes(file->closes().begin(), file->closes().end());
+        std::vector<float> all_volumes(file->volumes().begin(), file->volumes().end());
+        all_days.insert(all_days.end(), days.begin() + skip, days.end());
+        all_closes.insert(all_closes.end(), closes.begin() + skip, closes.end());
+        all_volumes.insert(all_volumes.end(), volumes.begin() + skip, volumes.end());
+        write_price_file(path, all_days, all_closes, all_volumes, price_file_capacity(all_days.size()));
+        return {added, skip};
+    }
+
+    write_fully(fd, header.days_offset + rows * sizeof(int32_t), days.data() + skip, added * sizeof(int32_t), path);
+    write_fully(fd, header.close_offset + rows * sizeof(float), closes.data() + skip, added * sizeof(float), path);
+    write_fully(fd, header.volume_offset + rows * sizeof(float), volumes.data() + skip, added * sizeof(float), path);
+
+    // Index slots from the day after the old last day through the new one
+    const size_t first_slot = static_cast<size_t>(header.last_day - header.first_day) + 1;
+    std::vector<uint32_t> index(static_cast<size_t>(slots) - first_slot);
+    for (size_t slot = 0, row = skip; slot < index.size(); ++slot) {
+        const int32_t day = header.last_day + 1 + static_cast<int32_t>(slot);
+        while (row < days.size() && days[row] <= day) {
+            ++row;
+        }
+        index[slot] = static_cast<uint32_t>(rows + row - skip);
+    }
+    write_fully(fd, header.index_offset + first_slot * sizeof(uint32_t), index.data(), index.size() * sizeof(uint32_t), path);
+
+    // Publish the rows only once their data is in place: last_day is for
+    // the next append, readers go by rows, which is stored last
+    void* mapped = ::mmap(nullptr, sizeof(PriceFileHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        throw StockDataError("Cannot map price file: " + path);
+    }
+    auto* published = static_cast<PriceFileHeader*>(mapped);
+    published->last_day = days.back();
+    std::atomic_ref<uint32_t>(published->rows).store(static_cast<uint32_t>(rows + added), std::memory_order_release);
+    ::munmap(mapped, sizeof(PriceFileHeader));
+    return {added, skip};
+}
+
+std::shared_ptr<const MappedPriceFile> MappedPriceFile::open(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw StockDataError("Price file not found: " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(PriceFileHeader)) {
+        ::close(fd);
+        throw StockDataError("Price file is truncated: " + path);
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw StockDataError("Cannot map price file: " + path);
+    }
+    std::shared_ptr<const MappedPriceFile> file(new MappedPriceFile(data, size));
+
+    // Everything but rows and last_day is fixed once the file is renamed
+    // into place; an append may be publishing rows meanwhile
+    const auto& header = file->header();
+    const uint64_t capacity = header.capacity;
+    const uint32_t rows = file->published_rows();
+    bool valid = std::memcmp(header.magic, PriceFileHeader::kMagic, sizeof(header.magic)) == 0
+        && header.version == PriceFileHeader::kVersion
+        && header.file_size == size
+        && rows <= capacity
+        && column_fits(header.days_offset, capacity * sizeof(int32_t), size)
+        && column_fits(header.close_offset, capacity * sizeof(float), size)
+        && column_fits(header.volume_offset, capacity * sizeof(float), size)
+        && column_fits(header.index_offset, uint64_t(header.index_capacity) * sizeof(uint32_t), size);
+    if (valid && rows > 0) {
+        const int32_t last_day = file->column<int32_t>(header.days_offset, rows).back();
+        valid = last_day >= header.first_day
+            && static_cast<uint64_t>(int64_t(last_day) - header.first_day) + 1 <= header.index_capacity;
+    }
+    if (!valid) {
+        throw StockDataError("Malformed price file: " + path);
+    }
+    return file;
+}
+
+MappedPriceFile::~MappedPriceFile() {
+    ::munmap(const_cast<void*>(data_), size_);
+}
+
+size_t MappedPriceFile::rows_through(int32_t day) const {
+    // Index slots before the last published row were written before it
+    const auto& h = header();
+    const uint32_t rows = published_rows();
+    if (rows == 0 || day < h.first_day) {
+        return 0;
+    }
+    if (day >= column<int32_t>(h.days_offset, rows).back()) {
+        return rows;
+    }
+    const auto* index = reinterpret_cast<const uint32_t*>(static_cast<const char*>(data_) + h.index_offset);
+    return index[day - h.first_day];
+}
+
+} // namespace atlas
@@ -1,4 +1,6 @@
 #include "stock_data_provider.h"
+#include "civil_day.h"
+#include "ticker_table.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -11,6 +13,26 @@
 
 namespace atlas {
 
+// PriceHistory implementation
+size_t PriceHistory::rows_through(int32_t day) const {
+    return static_cast<size_t>(std::upper_bound(days.begin(), days.end(), day) - days.begin());
+}
+
+PriceSlice::PriceSlice(std::shared_ptr<const PriceHistory> h, size_t first, size_t last)
+    : history(std::move(h)),
+      days(std::span<const int32_t>(history->days).subspan(first, last - first)),
+      closes(std::span<const float>(history->closes).subspan(first, last - first)),
+      volumes(std::span<const float>(history->volumes).subspan(first, last - first)) {}
+
+std::vector<StockDataRecord> PriceSlice::records() const {
+    std::vector<StockDataRecord> results;
+    results.reserve(size());
+    for (size_t row = 0; row < size(); ++row) {
+        results.emplace_back(format_civil_day(days[row]), closes[row], volumes[row]);
+    }
+    return results;
+}
+
 // DatabaseManager implementation
 DatabaseManager& DatabaseManager::instance() {
     static DatabaseManager instance;
@@ -160,42 +182,7 @@ std::vector<StockDataRecord> StockDataProvider::get_historical_data(
     const std::string& ticker, int period, const std::string& end_date) {
     
     try {
-        std::string mapped_ticker = map_ticker(ticker);
-        std::string cache_key = mapped_ticker + "_" + std::to_string(period) + "_" + end_date;
-        
-        // Check cache first
-        auto cached_data = get_cached_data(cache_key);
-        if (cached_data) {
-            return *cached_data;
-        }
-        
-        std::string file_path = get_data_file_path(mapped_ticker);
-        
-        if (!std::filesystem::exists(file_path)) {
-            throw StockDataError("Stock data file not found for symbol " + mapped_ticker + 
-                                " at path: " + file_path);
-        }
-        
-        // Build SQL query for DuckDB parquet reading
-        std::ostringstream query_ss;
-        query_ss << "WITH latest_records AS ("
-                 << "    SELECT adjusted_close, date"
-                 << "    FROM read_parquet('" << file_path << "')"
-                 << "    WHERE date <= '" << end_date << "'"
-                 << "    ORDER BY date DESC"
-                 << "    LIMIT " << period
-                 << ") "
-                 << "SELECT adjusted_close, date"
-                 << " FROM latest_records"
-                 << " ORDER BY date ASC";
-        
-        auto results = execute_parquet_query(query_ss.str());
-        
-        // Update cache
-        update_cache(cache_key, results);
-        
-        return results;
-        
+        return get_history_slice(ticker, period, end_date).records();
     } catch (const std::exception& e) {
         throw StockDataError("Error in get_historical_data: " + std::string(e.what()));
     }
@@ -205,35 +192,7 @@ std::vector<StockDataRecord> StockDataProvider::get_historical_data_range(
     const std::string& ticker, const std::string& start_date, const std::string& end_date) {
     
     try {
-        std::string mapped_ticker = map_ticker(ticker);
-        std::string cache_key = mapped_ticker + "_range_" + start_date + "_" + end_date;
-        
-        // Check cache first
-        auto cached_data = get_cached_data(cache_key);
-        if (cached_data) {
-            return *cached_data;
-        }
-        
-        std::string file_path = get_data_file_path(mapped_ticker);
-        
-        if (!std::filesystem::exists(file_path)) {
-            throw StockDataError("Stock data file not found for symbol " + mapped_ticker);
-        }
-        
-        // Build SQL query
-        std::ostringstream query_ss;
-        query_ss << "SELECT adjusted_close, date"
-                 << " FROM read_parquet('" << file_path << "')"
-                 << " WHERE date >= '" << start_date << "' AND date <= '" << end_date << "'"
-                 << " ORDER BY date ASC";
-        
-        auto results = execute_parquet_query(query_ss.str());
-        
-        // Update cache
-        update_cache(cache_key, results);
-        
-        return results;
-        
+        return get_history_slice_range(ticker, start_date, end_date).records();
     } catch (const std::exception& e) {
         throw StockDataError("Error in get_historical_data_range: " + std::string(e.what()));
     }
@@ -243,38 +202,13 @@ std::vector<StockDataRecord> StockDataProvider::get_historical_data_until_end_da
     const std::string& ticker, const std::string& end_date, bool live_data) {
     
     try {
-        std::string mapped_ticker = map_ticker(ticker);
-        std::string cache_key = mapped_ticker + "_until_" + end_date + "_" + (live_data ? "live" : "hist");
-        
-        // Check cache first
-        auto cached_data = get_cached_data(cache_key);
-        if (cached_data && !live_data) { // Don't use cache for live data
-            return *cached_data;
-        }
-        
-        std::string file_path = get_data_file_path(mapped_ticker);
-        
-        if (!std::filesystem::exists(file_path)) {
-            throw StockDataError("Stock data file not found for symbol " + mapped_ticker);
-        }
-        
-        // Build SQL query
-        std::ostringstream query_ss;
-        query_ss << "SELECT adjusted_close, date"
-                 << " FROM read_parquet('" << file_path << "')"
-                 << " WHERE date <= '" << end_date << "'"
-                 << " ORDER BY date ASC";
-        
-        auto results = execute_parquet_query(query_ss.str());
+        auto results = get_history_slice_until(ticker, end_date).records();
         
         if (live_data) {
-            auto live_data_record = get_live_data(mapped_ticker);
+            auto live_data_record = get_live_data(ticker);
             results = combine_data(results, live_data_record);
         }
         
-        // Update cache
-        update_cache(cache_key, results);
-        
         return results;
         
     } catch (const std::exception& e) {
@@ -282,6 +216,77 @@ std::vector<StockDataRecord> StockDataProvider::get_historical_data_until_end_da
     }
 }
 
+PriceSlice StockDataProvider::get_history_slice(
+    const std::string& ticker, int period, const std::string& end_date) {
+    
+    auto history = get_full_history(ticker);
+    const size_t last = history->rows_through(parse_date(end_date));
+    const size_t count = std::min(static_cast<size_t>(std::max(period, 0)), last);
+    return PriceSlice(std::move(history), last - count, last);
+}
+
+PriceSlice StockDataProvider::get_history_slice_range(
+    const std::string& ticker, const std::string& start_date, const std::string& end_date) {
+    
+    auto history = get_full_history(ticker);
+    const size_t first = history->rows_through(parse_date(start_date) - 1);
+    const size_t last = history->rows_through(parse_date(end_date));
+    return PriceSlice(std::move(history), first, std::max(first, last));
+}
+
+PriceSlice StockDataProvider::get_history_slice_until(
+    const std::string& ticker, const std::string& end_date) {
+    
+    auto history = get_full_history(ticker);
+    const size_t last = history->rows_through(parse_date(end_date));
+    return PriceSlice(std::move(history), 0, last);
+}
+
+std::shared_ptr<const PriceHistory> StockDataProvider::get_full_history(const std::string& ticker) {
+    const std::string mapped_ticker = map_ticker(ticker);
+    const std::string file_path = get_data_file_path(mapped_ticker);
+    
+    std::error_code ec;
+    const auto modified = std::filesystem::last_write_time(file_path, ec);
+    if (ec) {
+        throw StockDataError("Stock data file not found for symbol " + mapped_ticker +
+                            " at path: " + file_path);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto it = history_cache_.find(mapped_ticker);
+        if (it != history_cache_.end() && it->second.modified == modified) {
+            return it->second.history;
+        }
+    }
+    
+    // Query outside the lock so loads of different tickers overlap
+    auto history = load_full_history(mapped_ticker, file_path);
+    
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto& entry = history_cache_[mapped_ticker];
+    if (!entry.history || entry.modified != modified) {
+        entry.history = std::move(history);
+        entry.modified = modified;
+    }
+    return entry.history;
+}
+
+void StockDataProvider::invalidate_cache(const std::string& ticker) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (ticker.empty()) {
+        history_cache_.clear();
+        live_data_cache_.clear();
+        live_timestamps_.clear();
+        return;
+    }
+    const std::string mapped_ticker = map_ticker(ticker);
+    history_cache_.erase(mapped_ticker);
+    live_data_cache_.erase(mapped_ticker);
+    live_timestamps_.erase(mapped_ticker);
+}
+
 std::optional<LiveDataRecord> StockDataProvider::get_live_data(const std::string& ticker) {
     try {
         std::string mapped_ticker = map_ticker(ticker);
@@ -403,14 +408,8 @@ std::vector<float> StockDataProvider::calculate_delta_percentages(const std::vec
 // Private helper methods
 
 std::string StockDataProvider::map_ticker(const std::string& ticker) const {
-    // Implement ticker mapping logic (e.g., FNGU to FNGA)
-    // For now, just return the original ticker
-    std::string mapped = ticker;
-    
-    // Replace dots with dashes for file system compatibility
-    std::replace(mapped.begin(), mapped.end(), '.', '-');
-    
-    return mapped;
+    // Same normalization the ticker table interns under
+    return normalize_ticker(ticker);
 }
 
 std::string StockDataProvider::get_data_file_path(const std::string& ticker) const {
@@ -486,56 +485,63 @@ std::vector<StockDataRecord> StockDataProvider::combine_data(
     return combined;
 }
 
-bool StockDataProvider::is_cache_valid(const std::string& cache_key) const {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
+std::shared_ptr<const PriceHistory> StockDataProvider::load_full_history(
+    const std::string& ticker, const std::string& file_path) {
     
-    auto it = cache_timestamps_.find(cache_key);
-    if (it == cache_timestamps_.end()) {
-        return false;
+    std::ostringstream query_ss;
+    query_ss << "SELECT adjusted_close, volume, date"
+             << " FROM read_parquet('" << file_path << "')"
+             << " ORDER BY date ASC";
+    
+    auto rows = execute_parquet_query(query_ss.str());
+    
+    auto history = std::make_shared<PriceHistory>();
+    history->days.reserve(rows.size());
+    history->closes.reserve(rows.size());
+    history->volumes.reserve(rows.size());
+    for (const auto& row : rows) {
+        auto day = parse_civil_day(row.date);
+        if (!day) {
+            throw StockDataError("Invalid date " + row.date + " in stock data for symbol " + ticker);
+        }
+        history->days.push_back(*day);
+        history->closes.push_back(row.adjusted_close);
+        history->volumes.push_back(row.volume);
     }
     
-    auto now = std::chrono::steady_clock::now();
-    return (now - it->second) < CACHE_TIMEOUT;
+    for (size_t i = 1; i < history->days.size(); ++i) {
+        if (history->days[i] <= history->days[i - 1]) {
+            throw StockDataError("Stock data for symbol " + ticker + " is not strictly increasing in date at " + rows[i].date);
+        }
+    }
+    
+    return history;
 }
 
-void StockDataProvider::update_cache(const std::string& cache_key, 
-                                    const std::vector<StockDataRecord>& data) {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    data_cache_[cache_key] = data;
-    cache_timestamps_[cache_key] = std::chrono::steady_clock::now();
+int32_t StockDataProvider::parse_date(const std::string& date) {
+    auto day = parse_civil_day(date);
+    if (!day) {
+        throw StockDataError("Invalid date: " + date);
+    }
+    return *day;
 }
 
 void StockDataProvider::update_live_cache(const std::string& ticker, 
                                          const LiveDataRecord& live_data) {
     std::lock_guard<std::mutex> lock(cache_mutex_);
     live_data_cache_[ticker] = live_data;
-    cache_timestamps_[ticker + "_live"] = std::chrono::steady_clock::now();
-}
-
-std::optional<std::vector<StockDataRecord>> StockDataProvider::get_cached_data(
-    const std::string& cache_key) {
-    
-    if (!is_cache_valid(cache_key)) {
-        return std::nullopt;
-    }
-    
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    auto it = data_cache_.find(cache_key);
-    if (it != data_cache_.end()) {
-        return it->second;
-    }
-    
-    return std::nullopt;
+    live_timestamps_[ticker] = std::chrono::steady_clock::now();
 }
 
 std::optional<LiveDataRecord> StockDataProvider::get_cached_live_data(const std::string& ticker) {
-    std::string cache_key = ticker + "_live";
+    std::lock_guard<std::mutex> lock(cache_mutex_);
     
-    if (!is_cache_valid(cache_key)) {
+    auto stamp = live_timestamps_.find(ticker);
+    if (stamp == live_timestamps_.end() ||
+        std::chrono::steady_clock::now() - stamp->second >= LIVE_CACHE_TIMEOUT) {
         return std::nullopt;
     }
     
-    std::lock_guard<std::mutex> lock(cache_mutex_);
     auto it = live_data_cache_.find(ticker);
     if (it != live_data_cache_.end()) {
         return it->second;
@@ -619,12 +625,104 @@ float MockStockDataProvider::get_base_price(const std::string& ticker) const {
     else return 100.0f;
 }
 
+// MappedStockDataProvider implementation
+MappedStockDataProvider::MappedStockDataProvider(const std::string& data_root)
+    : data_root_(data_root) {}
+
+std::vector<StockDataRecord> MappedStockDataProvider::get_historical_data(
+    const std::string& ticker, int period, const std::string& end_date) {
+    
+    auto prices = file(ticker);
+    const size_t last = prices->rows_through(parse_date(end_date));
+    const size_t count = std::min(static_cast<size_t>(std::max(period, 0)), last);
+    return records(*prices, last - count, last);
+}
+
+std::vector<StockDataRecord> MappedStockDataProvider::get_historical_data_range(
+    const std::string& ticker, const std::string& start_date, const std::string& end_date) {
+    
+    auto prices = file(ticker);
+    const size_t first = prices->rows_through(parse_date(start_date) - 1);
+    const size_t last = prices->rows_through(parse_date(end_date));
+    return records(*prices, first, std::max(first, last));
+}
+
+std::optional<LiveDataRecord> MappedStockDataProvider::get_live_data(const std::string& /*ticker*/) {
+    return std::nullopt;
+}
+
+std::vector<StockDataRecord> MappedStockDataProvider::get_market_cap_data(
+    const std::string& ticker, const std::string& /*date*/, int /*period*/) {
+    
+    throw StockDataError("Market cap data is not available from price files (symbol " + ticker + ")");
+}
+
+std::span<const float> MappedStockDataProvider::get_closes(
+    const std::string& ticker, int period, const std::string& end_date) {
+    
+    return file(ticker)->closes_through(parse_date(end_date), static_cast<size_t>(std::max(period, 0)));
+}
+
+PricePanel MappedStockDataProvider::load_panel(
+    const std::vector<std::string>& tickers, std::vector<int32_t> calendar, bool forward_fill) {
+    
+    PricePanel panel(std::move(calendar), tickers);
+    for (size_t t = 0; t < tickers.size(); ++t) {
+        const auto prices = file(tickers[t]);
+        panel.set_series(t, prices->days(), prices->closes());
+    }
+    if (forward_fill) {
+        panel.forward_fill();
+    }
+    return panel;
+}
+
+std::shared_ptr<const MappedPriceFile> MappedStockDataProvider::file(const std::string& ticker) {
+    const std::string mapped_ticker = normalize_ticker(ticker);
+    
+    std::lock_guard<std::mutex> lock(files_mutex_);
+    auto it = files_.find(mapped_ticker);
+    if (it == files_.end()) {
+        it = files_.emplace(mapped_ticker, MappedPriceFile::open(price_file_path(data_root_, mapped_ticker))).first;
+    }
+    return it->second;
+}
+
+std::string MappedStockDataProvider::price_file_path(const std::string& data_root, const std::string& ticker) {
+    return data_root + "/" + ticker + ".apx";
+}
+
+std::vector<StockDataRecord> MappedStockDataProvider::records(
+    const MappedPriceFile& prices, size_t first, size_t last) const {
+    
+    const auto days = prices.days();
+    const auto closes = prices.closes();
+    const auto volumes = prices.volumes();
+    
+    std::vector<StockDataRecord> results;
+    results.reserve(last - first);
+    for (size_t row = first; row < last; ++row) {
+        results.emplace_back(format_civil_day(days[row]), closes[row], volumes[row]);
+    }
+    return results;
+}
+
+int32_t MappedStockDataProvider::parse_date(const std::string& date) {
+    auto day = parse_civil_day(date);
+    if (!day) {
+        throw StockDataError("Invalid date: " + date);
+    }
+    return *day;
+}
+
 // StockDataProviderFactory implementation
 std::unique_ptr<IStockDataProvider> StockDataProviderFactory::create_provider(
     const std::string& provider_type, const std::string& data_root) {
     
     if (provider_type == "parquet") {
         return std::make_unique<StockDataProvider>(data_root);
+    } else if (provider_type == "mmap") {
+        return std::make_unique<MappedStockDataProvider>(data_root);
     } else if (provider_type == "mock") {
         return std::make_unique<MockStockDataProvider>();
     } else {
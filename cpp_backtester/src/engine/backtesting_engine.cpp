@@ -1,12 +1,13 @@
-#include \"backtesting_engine.h\"
-#include \"stock_node.h\"
-#include \"conditional_node.h\"
-#include \"sort_node.h\"
-#include \"allocation_node.h\"
+#include "backtesting_engine.h"
+#include "stock_node.h"
+#include "conditional_node.h"
+#include "sort_node.h"
+#include "allocation_node.h"
+#include "plan_executor.h"
+#include "trading_calendar.h"
 #include <algorithm>
+#include <optional>
 #include <stdexcept>
-#include <iomanip>
-#include <sstream>
 #include <nlohmann/json.hpp>
 
 namespace atlas {
@@ -16,40 +17,62 @@ BacktestingEngine::BacktestingEngine() {
 }
 
 void BacktestingEngine::initialize_processors() {
-    processors_[\"stock\"] = std::make_unique<StockNodeProcessor>();
-    processors_[\"condition\"] = std::make_unique<ConditionalNodeProcessor>();
-    processors_[\"Sort\"] = std::make_unique<SortNodeProcessor>();
-    processors_[\"allocation\"] = std::make_unique<AllocationNodeProcessor>();
+    processors_["stock"] = std::make_unique<StockNodeProcessor>();
+    processors_["condition"] = std::make_unique<ConditionalNodeProcessor>();
+    processors_["Sort"] = std::make_unique<SortNodeProcessor>();
+    processors_["allocation"] = std::make_unique<AllocationNodeProcessor>();
 }
 
 BacktestResult BacktestingEngine::execute_backtest(const BacktestParams& params) {
     auto start_time = std::chrono::high_resolution_clock::now();
     BacktestResult result;
     
+    // Outlives the try block so the load timeline is reported on success and on failure alike
+    std::optional<TickerPrefetch> loads;
+    
     try {
         // Validate parameters
         if (!validate_params(params)) {
-            result.error_message = \"Invalid backtest parameters\";
+            result.error_message = "Invalid backtest parameters";
             return result;
         }
         
+        // Compile the strategy tree once, then run the flat plan
+        ExecutionPlan plan = compiler_.compile(params.strategy);
+        
+        // Load each ticker once and compute every condition indicator up front,
+        // reusing series earlier requests left in the process-wide cache
+        auto indicators = IndicatorPlanner::plan(plan, params.period);
+        if (!params.live_execution) {
+            indicators.as_of = SeriesCache::date_key(params.end_date);
+        }
+        
+        // Start every ticker's load at once; planning then waits on one ticker at a time
+        if (price_loader_) {
+            if (!io_pool_) {
+                io_pool_ = std::make_unique<WorkStealingPool>(prefetch_threads_);
+            }
+            loads.emplace(*io_pool_, price_loader_, &SeriesCache::instance(), indicators.as_of);
+            loads->start(indicators);
+        }
+        
         // Initialize data structures
-        auto date_range = generate_date_range(params.period, params.end_date, params.live_execution);
+        auto date_range = generate_date_range(params.period, params.end_date);
         auto portfolio_history = initialize_portfolio_history(params.period);
         
         std::vector<bool> active_mask(params.period, true);
         std::unordered_map<std::string, int> flow_count;
         std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-        std::unordered_map<std::string, std::vector<float>> indicator_cache;
+        IndicatorCache indicator_cache;
         std::unordered_map<std::string, std::vector<float>> price_cache;
         
-        // Execute post-order DFS
-        int processed_days = post_order_dfs(
-            params.strategy.root,
-            active_mask,
-            params.period,
-            1.0f, // Root node weight
-            portfolio_history,
+        // Compute the indicators, taking each ticker's prices as its load completes
+        IndicatorPlanner::prefetch(
+            indicators, price_loader_, indicator_cache, price_cache, nullptr, &SeriesCache::instance(),
+            loads ? &*loads : nullptr
+        );
+        
+        PlanExecutionContext context{
             date_range,
             flow_count,
             flow_stocks,
@@ -58,6 +81,15 @@ BacktestResult BacktestingEngine::execute_backtest(const BacktestParams& params)
             params.strategy,
             params.live_execution,
             params.global_cache_length
+        };
+        
+        int processed_days = executor_.execute(
+            plan,
+            active_mask,
+            params.period,
+            1.0f, // Root node weight
+            portfolio_history,
+            context
         );
         
         if (processed_days > 0) {
@@ -66,11 +98,15 @@ BacktestResult BacktestingEngine::execute_backtest(const BacktestParams& params)
             result.flow_stocks = std::move(flow_stocks);
             result.success = true;
         } else {
-            result.error_message = \"No days were processed\";
+            result.error_message = "No days were processed";
         }
         
     } catch (const std::exception& e) {
-        result.error_message = \"Backtest execution error: \" + std::string(e.what());
+        result.error_message = "Backtest execution error: " + std::string(e.what());
+    }
+    
+    if (loads) {
+        result.prefetch_timeline = loads->timeline();
     }
     
     auto end_time = std::chrono::high_resolution_clock::now();
@@ -98,8 +134,8 @@ std::string BacktestingEngine::handle_backtesting_api(const std::string& json_re
         
         // Create response JSON
         nlohmann::json response;
-        response[\"success\"] = result.success;
-        response[\"execution_time_ms\"] = result.execution_time.count();
+        response["success"] = result.success;
+        response["execution_time_ms"] = result.execution_time.count();
         
         if (result.success) {
             // Convert portfolio history to JSON
@@ -108,24 +144,37 @@ std::string BacktestingEngine::handle_backtesting_api(const std::string& json_re
                 nlohmann::json day_json = nlohmann::json::array();
                 for (const auto& stock : day.stock_list()) {
                     nlohmann::json stock_json;
-                    stock_json[\"ticker\"] = stock.ticker();
-                    stock_json[\"weight\"] = stock.weight_tomorrow();
+                    stock_json["ticker"] = stock.ticker();
+                    stock_json["weight"] = stock.weight_tomorrow();
                     day_json.push_back(stock_json);
                 }
                 portfolio_json.push_back(day_json);
             }
-            response[\"portfolio_history\"] = portfolio_json;
-            response[\"flow_count\"] = result.flow_count;
+            response["portfolio_history"] = portfolio_json;
+            response["flow_count"] = result.flow_count;
+            
+            nlohmann::json timeline_json = nlohmann::json::array();
+            for (const auto& event : result.prefetch_timeline) {
+                nlohmann::json event_json;
+                event_json["ticker"] = event.ticker;
+                event_json["days"] = event.days;
+                event_json["cached"] = event.cached;
+                event_json["queued_us"] = event.queued.count();
+                event_json["started_us"] = event.started.count();
+                event_json["finished_us"] = event.finished.count();
+                timeline_json.push_back(event_json);
+            }
+            response["prefetch_timeline"] = timeline_json;
         } else {
-            response[\"error\"] = result.error_message;
+            response["error"] = result.error_message;
         }
         
         return response.dump();
         
     } catch (const std::exception& e) {
         nlohmann::json error_response;
-        error_response[\"success\"] = false;
-        error_response[\"error\"] = \"API error: \" + std::string(e.what());
+        error_response["success"] = false;
+        error_response["error"] = "API error: " + std::string(e.what());
         return error_response.dump();
     }
 }
@@ -136,10 +185,10 @@ int BacktestingEngine::post_order_dfs(
     int common_data_span,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution,
@@ -147,14 +196,14 @@ int BacktestingEngine::post_order_dfs(
 ) {
     try {
         if (node.type.empty()) {
-            throw std::runtime_error(\"Node missing required 'type' field\");
+            throw std::runtime_error("Node missing required 'type' field");
         }
         
         int processed_days = common_data_span;
         
         // Process different node types
-        if (node.type == \"stock\") {
-            auto processor_it = processors_.find(\"stock\");
+        if (node.type == "stock") {
+            auto processor_it = processors_.find("stock");
             if (processor_it != processors_.end()) {
                 auto result = processor_it->second->process(
                     node, active_mask, common_data_span, node_weight,
@@ -164,14 +213,14 @@ int BacktestingEngine::post_order_dfs(
                 if (result.success) {
                     processed_days = result.processed_days;
                 } else {
-                    throw std::runtime_error(\"Stock node processing failed: \" + result.error_message);
+                    throw std::runtime_error("Stock node processing failed: " + result.error_message);
                 }
             } else {
-                throw std::runtime_error(\"No processor found for stock node\");
+                throw std::runtime_error("No processor found for stock node");
             }
         }
-        else if (node.type == \"condition\") {
-            auto processor_it = processors_.find(\"condition\");
+        else if (node.type == "condition") {
+            auto processor_it = processors_.find("condition");
             if (processor_it != processors_.end()) {
                 auto result = processor_it->second->process(
                     node, active_mask, common_data_span, node_weight,
@@ -181,14 +230,14 @@ int BacktestingEngine::post_order_dfs(
                 if (result.success) {
                     processed_days = result.processed_days;
                 } else {
-                    throw std::runtime_error(\"Conditional node processing failed: \" + result.error_message);
+                    throw std::runtime_error("Conditional node processing failed: " + result.error_message);
                 }
             } else {
-                throw std::runtime_error(\"No processor found for conditional node\");
+                throw std::runtime_error("No processor found for conditional node");
             }
         }
-        else if (node.type == \"Sort\") {
-            auto processor_it = processors_.find(\"Sort\");
+        else if (node.type == "Sort") {
+            auto processor_it = processors_.find("Sort");
             if (processor_it != processors_.end()) {
                 auto result = processor_it->second->process(
                     node, active_mask, common_data_span, node_weight,
@@ -198,14 +247,14 @@ int BacktestingEngine::post_order_dfs(
                 if (result.success) {
                     processed_days = result.processed_days;
                 } else {
-                    throw std::runtime_error(\"Sort node processing failed: \" + result.error_message);
+                    throw std::runtime_error("Sort node processing failed: " + result.error_message);
                 }
             } else {
-                throw std::runtime_error(\"No processor found for sort node\");
+                throw std::runtime_error("No processor found for sort node");
             }
         }
-        else if (node.type == \"allocation\") {
-            auto processor_it = processors_.find(\"allocation\");
+        else if (node.type == "allocation") {
+            auto processor_it = processors_.find("allocation");
             if (processor_it != processors_.end()) {
                 auto result = processor_it->second->process(
                     node, active_mask, common_data_span, node_weight,
@@ -215,13 +264,13 @@ int BacktestingEngine::post_order_dfs(
                 if (result.success) {
                     processed_days = result.processed_days;
                 } else {
-                    throw std::runtime_error(\"Allocation node processing failed: \" + result.error_message);
+                    throw std::runtime_error("Allocation node processing failed: " + result.error_message);
                 }
             } else {
-                throw std::runtime_error(\"No processor found for allocation node\");
+                throw std::runtime_error("No processor found for allocation node");
             }
         }
-        else if (node.type == \"folder\" || node.type == \"root\") {
+        else if (node.type == "folder" || node.type == "root") {
             processed_days = process_folder_node(
                 node, active_mask, common_data_span, node_weight,
                 portfolio_history, date_range, flow_count, flow_stocks,
@@ -229,13 +278,13 @@ int BacktestingEngine::post_order_dfs(
             );
         }
         else {
-            throw std::runtime_error(\"Unknown node type: \" + node.type);
+            throw std::runtime_error("Unknown node type: " + node.type);
         }
         
         return processed_days;
         
     } catch (const std::exception& e) {
-        throw std::runtime_error(\"Post-order DFS error: \" + std::string(e.what()));
+        throw std::runtime_error("Post-order DFS error: " + std::string(e.what()));
     }
 }
 
@@ -245,10 +294,10 @@ int BacktestingEngine::process_folder_node(
     int common_data_span,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution,
@@ -264,14 +313,14 @@ int BacktestingEngine::process_folder_node(
     // Count non-comment nodes
     int nodes_length = 0;
     for (const auto& seq_node : node.sequence) {
-        if (seq_node.type != \"comment\") {
+        if (seq_node.type != "comment") {
             nodes_length++;
         }
     }
     
     // Process each child node
     for (const auto& seq_node : node.sequence) {
-        if (seq_node.type != \"comment\") {
+        if (seq_node.type != "comment") {
             float child_weight = nodes_length > 0 ? node_weight / nodes_length : node_weight;
             
             folder_node_span = post_order_dfs(
@@ -295,23 +344,9 @@ int BacktestingEngine::process_folder_node(
     return folder_node_span;
 }
 
-std::vector<std::string> BacktestingEngine::generate_date_range(
-    int period,
-    const std::string& end_date,
-    bool live_execution
-) {
-    // Simple implementation - just generate consecutive dates
-    // In a real implementation, this would handle business days, holidays, etc.
-    std::vector<std::string> dates;
-    dates.reserve(period);
-    
-    for (int i = period - 1; i >= 0; --i) {
-        std::ostringstream oss;
-        oss << end_date << \"-\" << std::setfill('0') << std::setw(3) << i;
-        dates.push_back(oss.str());
-    }
-    
-    return dates;
+std::vector<int32_t> BacktestingEngine::generate_date_range(int period, const std::string& end_date) const {
+    const auto& calendar = TradingCalendar::nyse();
+    return calendar.range(TradingCalendar::parse(end_date), period);
 }
 
 std::vector<DayData> BacktestingEngine::initialize_portfolio_history(int period) {
@@ -341,4 +376,4 @@ bool BacktestingEngine::validate_params(const BacktestParams& params) const {
     return true;
 }
 
-} // namespace atlas", "original_text": "", "replace_all": false}]
\ No newline at end of file
+} // namespace atlas
\ No newline at end of file
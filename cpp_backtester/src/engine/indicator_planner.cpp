@@ -0,0 +1,246 @@
+#include "indicator_planner.h"
+#include "execution_plan.h"
+#include "ticker_prefetch.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+namespace atlas {
+
+namespace {
+
+constexpr int kDefaultSmaPeriod = 20;   // ConditionalNodeProcessor's default when no period is given
+
+/**
+ * @brief Largest span each instruction is evaluated over
+ * A shared subtree can be reached under several spans; the largest wins.
+ */
+void collect_spans(const ExecutionPlan& plan, uint32_t index, int days, std::vector<int>& spans) {
+    if (spans[index] >= days) {
+        return;
+    }
+    spans[index] = days;
+
+    const auto& instruction = plan.instructions[index];
+    const int child_days = instruction.kind == NodeKind::SORT ? days + instruction.sort_padding() : days;
+    for (uint32_t g = 0; g < instruction.group_count; ++g) {
+        const auto& group = plan.group(instruction, g);
+        for (uint32_t c = 0; c < group.child_count; ++c) {
+            collect_spans(plan, plan.children[group.first_child + c], child_days, spans);
+        }
+    }
+}
+
+} // namespace
+
+IndicatorKey IndicatorRequest::cache_key() const {
+    return IndicatorKey::of(source, *IndicatorPlanner::batch_spec(indicator, period));
+}
+
+std::optional<ta::IndicatorSpec> IndicatorPlanner::batch_spec(const std::string& indicator, int period) {
+    if (indicator == "Simple Moving Average of Price") {
+        return ta::IndicatorSpec{ta::IndicatorKind::SMA, period > 0 ? period : kDefaultSmaPeriod};
+    }
+    if (period <= 0) {
+        return std::nullopt;
+    }
+    if (indicator == "Relative Strength Index") {
+        return ta::IndicatorSpec{ta::IndicatorKind::RSI, period};
+    }
+    if (indicator == "Exponential Moving Average of Price") {
+        return ta::IndicatorSpec{ta::IndicatorKind::EMA, period};
+    }
+    if (indicator == "Standard Deviation of Price") {
+        return ta::IndicatorSpec{ta::IndicatorKind::STANDARD_DEVIATION, period};
+    }
+    if (indicator == "Standard Deviation of Return" && period >= 2) {
+        return ta::IndicatorSpec{ta::IndicatorKind::RETURNS_STANDARD_DEVIATION, period};
+    }
+    if (indicator == "Cumulative Return") {
+        return ta::IndicatorSpec{ta::IndicatorKind::CUMULATIVE_RETURN, period};
+    }
+    if (indicator == "Max Drawdown") {
+        return ta::IndicatorSpec{ta::IndicatorKind::MAX_DRAWDOWN, period};
+    }
+    return std::nullopt;
+}
+
+int IndicatorPlanner::warmup(const ta::IndicatorSpec& spec) {
+    switch (spec.kind) {
+        case ta::IndicatorKind::RSI:
+        case ta::IndicatorKind::CUMULATIVE_RETURN: return spec.period;
+        case ta::IndicatorKind::RETURNS_STANDARD_DEVIATION: return spec.period + 1;
+        default: return spec.period - 1;
+    }
+}
+
+int IndicatorPlanner::lookback(const std::string& indicator, int period, int total_days) {
+    auto spec = batch_spec(indicator, period);
+    return spec ? total_days + warmup(*spec) : total_days;
+}
+
+std::vector<float> IndicatorPlanner::compute(const ta::IndicatorSpec& spec, std::span<const float> prices) {
+    ta::TickerPanel panel(1, prices.size());
+    panel.set_series(0, prices);
+    auto values = ta::compute_indicator(panel, spec).series(0);
+    values.erase(values.begin(), values.begin() + std::min<size_t>(warmup(spec), values.size()));
+    return values;
+}
+
+std::vector<float> IndicatorPlanner::placeholder_prices(int days) {
+    std::vector<float> prices;
+    prices.reserve(std::max(days, 0));
+    for (int i = 0; i < days; ++i) {
+        prices.push_back(100.0f + i * 0.1f); // Simple increasing price
+    }
+    return prices;
+}
+
+IndicatorPlan IndicatorPlanner::plan(const ExecutionPlan& plan, int total_days) {
+    IndicatorPlan result;
+    result.total_days = total_days;
+    if (plan.empty()) {
+        return result;
+    }
+
+    std::vector<int> spans(plan.size(), -1);
+    collect_spans(plan, plan.root_index, total_days, spans);
+
+    std::unordered_map<IndicatorKey, size_t, IndicatorKeyHash> request_index;
+    auto add = [&](const Operand& operand, int days) {
+        if (operand.is_constant() || operand.source.empty()) {
+            return;
+        }
+        const bool is_price = operand.indicator == "current price";
+        if (!is_price && !batch_spec(operand.indicator, operand.period)) {
+            return;
+        }
+
+        const int days_needed = lookback(operand.indicator, operand.period, days);
+        if (!is_price) {
+            IndicatorRequest request{operand.source, operand.indicator, operand.period, days_needed};
+            auto [index, inserted] = request_index.emplace(request.cache_key(), result.requests.size());
+            if (inserted) {
+                result.requests.push_back(std::move(request));
+            } else {
+                auto& existing = result.requests[index->second];
+                existing.days = std::max(existing.days, days_needed);
+            }
+        }
+
+        auto [it, inserted] = result.lookback.emplace(operand.source, days_needed);
+        if (inserted) {
+            result.tickers.push_back(operand.source);
+        } else {
+            it->second = std::max(it->second, days_needed);
+        }
+    };
+
+    for (size_t i = 0; i < plan.size(); ++i) {
+        const auto& instruction = plan.instructions[i];
+        if (instruction.kind != NodeKind::CONDITION || spans[i] < 0) {
+            continue;
+        }
+        const auto* condition = std::get_if<ConditionSpec>(&instruction.spec);
+        if (condition == nullptr) {
+            continue;
+        }
+        add(condition->x, spans[i]);
+        add(condition->y, spans[i]);
+    }
+    return result;
+}
+
+SeriesCache::Series IndicatorPlanner::load_prices(
+    const std::string& ticker,
+    int days,
+    const PriceLoader& loader,
+    SeriesCache* shared,
+    uint32_t as_of,
+    bool* cached
+) {
+    if (cached) {
+        *cached = false;
+    }
+    if (!loader) {
+        return std::make_shared<const std::vector<float>>(placeholder_prices(days));
+    }
+    if (!shared || as_of == 0) {
+        return std::make_shared<const std::vector<float>>(loader(ticker, days));
+    }
+
+    const auto key = SeriesKey::price(TickerTable::instance().intern(ticker), as_of);
+    if (auto series = shared->find(key); series && series->size() >= static_cast<size_t>(days)) {
+        if (cached) {
+            *cached = true;
+        }
+        return series;
+    }
+    return shared->insert(key, loader(ticker, days));
+}
+
+void IndicatorPlanner::prefetch(
+    const IndicatorPlan& plan,
+    const PriceLoader& loader,
+    IndicatorCache& indicator_cache,
+    std::unordered_map<std::string, std::vector<float>>& price_cache,
+    WorkStealingPool* pool,
+    SeriesCache* shared,
+    TickerPrefetch* loads
+) {
+    if (!loader || plan.as_of == 0) {
+        shared = nullptr;
+    }
+
+    // One load per ticker at its largest lookback, unless a longer history is already shared
+    for (const auto& ticker : plan.tickers) {
+        const int days = plan.lookback.at(ticker);
+        const auto series = loads ? loads->wait(ticker) : load_prices(ticker, days, loader, shared, plan.as_of);
+        auto tail = IndicatorCache::tail(*series, days);
+        price_cache[ticker].assign(tail.begin(), tail.end());
+    }
+
+    // Batch requests sharing a kernel spec and history length into one panel; each runs over its own lookback
+    std::map<std::tuple<int, int, size_t>, std::vector<const IndicatorRequest*>> batches;
+    for (const auto& request : plan.requests) {
+        if (indicator_cache.contains(request.cache_key())) {
+            continue;
+        }
+        const auto spec = *batch_spec(request.indicator, request.period);
+        const size_t days = IndicatorCache::tail(price_cache.at(request.source), request.days).size();
+        if (shared) {
+            if (auto cached = shared->find(SeriesKey::indicator_of(request.cache_key(), plan.as_of, days))) {
+                indicator_cache.insert(request.cache_key(), *cached, cached->size());
+                continue;
+            }
+        }
+        batches[{static_cast<int>(spec.kind), spec.period, days}].push_back(&request);
+    }
+
+    for (const auto& [batch_key, requests] : batches) {
+        const auto spec = *batch_spec(requests.front()->indicator, requests.front()->period);
+        const size_t days = std::get<2>(batch_key);
+        if (days < static_cast<size_t>(warmup(spec)) + 1) {
+            continue;   // Too little history; the lazy path reports it
+        }
+
+        ta::TickerPanel prices(requests.size(), days);
+        for (size_t t = 0; t < requests.size(); ++t) {
+            prices.set_series(t, IndicatorCache::tail(price_cache.at(requests[t]->source), days));
+        }
+        auto values = ta::compute_indicator(prices, spec, pool);
+
+        const size_t first = static_cast<size_t>(warmup(spec));
+        for (size_t t = 0; t < requests.size(); ++t) {
+            auto series = values.series(t);
+            series.erase(series.begin(), series.begin() + first);
+            const size_t count = series.size();
+            if (shared) {
+                shared->insert(SeriesKey::indicator_of(requests[t]->cache_key(), plan.as_of, days), series);
+            }
+            indicator_cache.insert(requests[t]->cache_key(), std::move(series), count);
+        }
+    }
+}
+
+} // namespace atlas
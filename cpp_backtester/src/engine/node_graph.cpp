@@ -0,0 +1,147 @@
+#include "node_graph.h"
+#include <algorithm>
+
+namespace atlas {
+
+NodeKind resolve_node_kind(const std::string& type) {
+    if (type == "stock") return NodeKind::STOCK;
+    if (type == "condition") return NodeKind::CONDITION;
+    if (type == "Sort") return NodeKind::SORT;
+    if (type == "allocation") return NodeKind::ALLOCATION;
+    if (type == "folder") return NodeKind::FOLDER;
+    if (type == "root") return NodeKind::ROOT;
+    if (type == "comment" || type == "icon" || type == "interruptingIcon") return NodeKind::NOOP;
+
+    throw StrategyParseError("Unknown node type: " + type);
+}
+
+std::span<const GraphNode* const> GraphNode::branch(std::string_view name) const {
+    auto it = std::find_if(branches.begin(), branches.end(),
+        [name](const GraphBranch& branch) { return branch.name == name; });
+    return it == branches.end() ? std::span<const GraphNode* const>() : it->nodes;
+}
+
+std::shared_ptr<const NodeGraph> NodeGraph::build(const StrategyNode& root) {
+    if (root.type.empty()) {
+        throw StrategyParseError("Node missing required 'type' field");
+    }
+
+    std::shared_ptr<NodeGraph> graph(new NodeGraph());
+    graph->root_source_ = root;
+
+    StrategyParser parser;
+    resolve_missing_specs(graph->root_source_, parser);
+    std::vector<PendingNode> pending;
+    graph->collect(graph->root_source_, 0, parser, pending);
+
+    // Size the arena up front so the spans and pointers handed out below stay valid
+    size_t branch_count = 0;
+    size_t child_count = 0;
+    for (const auto& record : pending) {
+        branch_count += record.branches.size();
+        for (const auto& [name, children] : record.branches) {
+            child_count += children.size();
+        }
+    }
+    graph->nodes_.resize(pending.size());
+    graph->branches_.reserve(branch_count);
+    graph->children_.reserve(child_count);
+    graph->by_hash_.reserve(pending.size());
+
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const auto& record = pending[i];
+        auto& node = graph->nodes_[i];
+        node.kind = record.kind;
+        node.source = record.source;
+        node.parent = i == 0 ? nullptr : &graph->nodes_[record.parent];
+
+        const size_t first_branch = graph->branches_.size();
+        for (const auto& [name, children] : record.branches) {
+            const size_t first_child = graph->children_.size();
+            for (uint32_t child : children) {
+                graph->children_.push_back(&graph->nodes_[child]);
+            }
+            graph->branches_.push_back(GraphBranch{
+                name, std::span<const GraphNode* const>(graph->children_.data() + first_child, children.size())
+            });
+        }
+        node.branches = std::span<const GraphBranch>(
+            graph->branches_.data() + first_branch, record.branches.size()
+        );
+
+        if (!node.hash().empty()) {
+            graph->by_hash_.emplace(node.hash(), &node);
+        }
+    }
+
+    return graph;
+}
+
+const GraphNode* NodeGraph::find(const std::string& hash) const {
+    auto it = by_hash_.find(hash);
+    return it == by_hash_.end() ? nullptr : it->second;
+}
+
+uint32_t NodeGraph::collect(
+    const StrategyNode& node,
+    uint32_t parent,
+    StrategyParser& parser,
+    std::vector<PendingNode>& pending
+) {
+    const auto index = static_cast<uint32_t>(pending.size());
+    pending.push_back(PendingNode{&node, resolve_node_kind(node.type), parent, {}});
+
+    std::vector<std::pair<std::string, std::vector<const StrategyNode*>>> branches;
+    if (!node.sequence.empty() || pending[index].kind == NodeKind::ROOT || pending[index].kind == NodeKind::FOLDER) {
+        std::vector<const StrategyNode*> sequence;
+        sequence.reserve(node.sequence.size());
+        for (const auto& child : node.sequence) {
+            sequence.push_back(&child);
+        }
+        branches.emplace_back("sequence", std::move(sequence));
+    }
+    if (node.branches.is_object()) {
+        for (const auto& [key, nodes_json] : node.branches.items()) {
+            branches.emplace_back(key, materialize(nodes_json, parser));
+        }
+    }
+
+    // Children are collected after the parent so the arena stays in pre-order
+    for (auto& [name, children] : branches) {
+        std::vector<uint32_t> indices;
+        indices.reserve(children.size());
+        for (const auto* child : children) {
+            indices.push_back(collect(*child, index, parser, pending));
+        }
+        pending[index].branches.emplace_back(std::move(name), std::move(indices));
+    }
+
+    return index;
+}
+
+std::vector<const StrategyNode*> NodeGraph::materialize(const nlohmann::json& nodes_json, StrategyParser& parser) {
+    std::vector<const StrategyNode*> nodes;
+    if (!nodes_json.is_array()) {
+        return nodes;
+    }
+
+    nodes.reserve(nodes_json.size());
+    for (const auto& node_json : nodes_json) {
+        auto& node = branch_sources_.emplace_back(node_json);
+        resolve_missing_specs(node, parser);
+        nodes.push_back(&node);
+    }
+
+    return nodes;
+}
+
+void NodeGraph::resolve_missing_specs(StrategyNode& node, StrategyParser& parser) {
+    if (std::holds_alternative<std::monostate>(node.spec)) {
+        node.spec = parser.parse_node_spec(node);
+    }
+    for (auto& child : node.sequence) {
+        resolve_missing_specs(child, parser);
+    }
+}
+
+} // namespace atlas
@@ -0,0 +1,243 @@
+#include "execution_plan.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace atlas {
+
+ExecutionPlan PlanCompiler::compile(const Strategy& strategy) {
+    return strategy.graph ? compile(strategy.graph) : compile(strategy.root);
+}
+
+ExecutionPlan PlanCompiler::compile(const StrategyNode& root) {
+    std::shared_ptr<const NodeGraph> graph;
+    try {
+        graph = NodeGraph::build(root);
+    } catch (const std::exception& e) {
+        throw PlanCompileError(e.what());
+    }
+    return compile(std::move(graph));
+}
+
+ExecutionPlan PlanCompiler::compile(std::shared_ptr<const NodeGraph> graph) {
+    if (!graph || graph->size() == 0) {
+        throw PlanCompileError("Empty node graph");
+    }
+
+    ExecutionPlan plan;
+    subtree_index_.clear();
+    int32_t root_alias = -1;
+    plan.root_index = lower_node(graph->root(), plan, root_alias);
+    subtree_index_.clear();
+    plan.graph = std::move(graph);
+    return plan;
+}
+
+uint32_t PlanCompiler::lower_node(const GraphNode& node, ExecutionPlan& plan, int32_t& alias) {
+    alias = -1;
+
+    // Identical subtrees share one lowered copy; a reuse keeps its own node hashes for flow data
+    if (const GraphNode* lowered = find_shared_subtree(node)) {
+        const uint32_t shared = subtree_index_.at(node.source->node_children_hash).index;
+        auto& canonical = plan.instructions[shared];
+        if (canonical.shared_index < 0) {
+            canonical.shared_index = static_cast<int32_t>(plan.shared_subtree_count++);
+        }
+
+        HashAlias hashes;
+        collect_aliases(*lowered, node, hashes);
+        if (!hashes.empty()) {
+            alias = static_cast<int32_t>(plan.hash_aliases.size());
+            plan.hash_aliases.push_back(std::move(hashes));
+        }
+        return shared;
+    }
+
+    const auto first_descendant = static_cast<uint32_t>(plan.instructions.size());
+    PlanInstruction instruction;
+    instruction.kind = node.kind;
+    instruction.node = node.source;
+    instruction.spec = node.spec();
+
+    // Lower every branch before emitting the groups so this node's groups stay contiguous
+    std::vector<float> weights;
+    auto branches = collect_branches(node, instruction, weights);
+
+    std::vector<std::vector<std::pair<uint32_t, int32_t>>> lowered;
+    lowered.reserve(branches.size());
+    for (const auto& branch : branches) {
+        lowered.push_back(lower_branch(branch, plan));
+    }
+
+    instruction.first_group = static_cast<uint32_t>(plan.groups.size());
+    instruction.group_count = static_cast<uint32_t>(lowered.size());
+    for (size_t i = 0; i < lowered.size(); ++i) {
+        ChildGroup group;
+        group.first_child = static_cast<uint32_t>(plan.children.size());
+        group.child_count = static_cast<uint32_t>(lowered[i].size());
+        group.weight = weights[i];
+        plan.groups.push_back(group);
+        for (const auto& [child, child_alias] : lowered[i]) {
+            plan.children.push_back(child);
+            plan.child_aliases.push_back(child_alias);
+        }
+    }
+
+    // Sort candidates are evaluated into private buffers before selection
+    if (instruction.kind == NodeKind::SORT) {
+        instruction.result_slot = static_cast<int32_t>(plan.result_slot_count);
+        plan.result_slot_count += instruction.group_count;
+    }
+
+    // Post-order keeps a subtree contiguous, ending at its root
+    instruction.subtree_size = static_cast<uint32_t>(plan.instructions.size()) - first_descendant + 1;
+
+    plan.instructions.push_back(std::move(instruction));
+    const auto index = static_cast<uint32_t>(plan.instructions.size() - 1);
+
+    if (deduplicate_subtrees_ && !node.source->node_children_hash.empty()) {
+        subtree_index_.emplace(node.source->node_children_hash, LoweredSubtree{index, &node});
+    }
+    return index;
+}
+
+const GraphNode* PlanCompiler::find_shared_subtree(const GraphNode& node) const {
+    // Leaves are cheaper to evaluate than to replay
+    if (!deduplicate_subtrees_ || node.kind == NodeKind::ROOT || node.kind == NodeKind::STOCK ||
+        node.source->node_children_hash.empty()) {
+        return nullptr;
+    }
+
+    auto it = subtree_index_.find(node.source->node_children_hash);
+    if (it == subtree_index_.end()) {
+        return nullptr;
+    }
+
+    // The children hash covers the descendants; the node itself must match too
+    const auto& candidate = *it->second.node->source;
+    const auto& source = *node.source;
+    if (candidate.type != source.type || candidate.function != source.function ||
+        candidate.properties != source.properties) {
+        return nullptr;
+    }
+    return it->second.node;
+}
+
+void PlanCompiler::collect_aliases(const GraphNode& lowered, const GraphNode& reuse, HashAlias& alias) {
+    if (!lowered.hash().empty() && lowered.hash() != reuse.hash()) {
+        alias.emplace(lowered.hash(), reuse.hash());
+    }
+
+    // Equal children hashes mean equal shapes; pair branches by name and nodes by position
+    for (const auto& branch : lowered.branches) {
+        const auto reuse_nodes = reuse.branch(branch.name);
+        for (size_t i = 0; i < branch.nodes.size() && i < reuse_nodes.size(); ++i) {
+            collect_aliases(*branch.nodes[i], *reuse_nodes[i], alias);
+        }
+    }
+}
+
+std::vector<std::pair<uint32_t, int32_t>> PlanCompiler::lower_branch(
+    std::span<const GraphNode* const> nodes,
+    ExecutionPlan& plan
+) {
+    std::vector<std::pair<uint32_t, int32_t>> indices;
+    indices.reserve(nodes.size());
+
+    for (const auto* child : nodes) {
+        if (child->kind == NodeKind::NOOP) {
+            continue;
+        }
+        int32_t alias = -1;
+        const uint32_t index = lower_node(*child, plan, alias);
+        indices.emplace_back(index, alias);
+    }
+
+    return indices;
+}
+
+std::vector<std::span<const GraphNode* const>> PlanCompiler::collect_branches(
+    const GraphNode& node,
+    PlanInstruction& instruction,
+    std::vector<float>& weights
+) {
+    std::vector<std::span<const GraphNode* const>> branches;
+
+    switch (instruction.kind) {
+        case NodeKind::ROOT:
+        case NodeKind::FOLDER:
+            branches.push_back(node.branch("sequence"));
+            weights.push_back(1.0f);
+            break;
+        case NodeKind::CONDITION: {
+            if (!node.source->branches.contains("true") || !node.source->branches.contains("false")) {
+                throw PlanCompileError("Conditional node missing true/false branches");
+            }
+            branches.push_back(node.branch("true"));
+            branches.push_back(node.branch("false"));
+            weights.assign(2, 1.0f);
+            break;
+        }
+        case NodeKind::SORT: {
+            // Every non-icon node across all branch lists is a separate candidate
+            for (const auto& branch : node.branches) {
+                for (size_t i = 0; i < branch.nodes.size(); ++i) {
+                    const auto* candidate = branch.nodes[i];
+                    if (candidate->kind == NodeKind::NOOP) {
+                        continue;
+                    }
+                    if (candidate->kind == NodeKind::FOLDER) {
+                        instruction.has_folder_branch = true;
+                    }
+                    branches.push_back(branch.nodes.subspan(i, 1));
+                    weights.push_back(1.0f);
+                }
+            }
+            if (branches.empty()) {
+                throw PlanCompileError("Sort node has no branches");
+            }
+            if (instruction.sort().selection_count > static_cast<int>(branches.size())) {
+                throw PlanCompileError("Selection count exceeds available branches");
+            }
+            break;
+        }
+        case NodeKind::ALLOCATION: {
+            // Volatility and market cap weights depend on price data and stay with the processor
+            const auto& spec = instruction.allocation();
+            if (spec.function != AllocationFunction::EQUAL_ALLOCATION &&
+                spec.function != AllocationFunction::ALLOCATION) {
+                break;
+            }
+            if (node.branches.empty()) {
+                throw PlanCompileError("Allocation node has no branches");
+            }
+
+            for (const auto& branch : node.branches) {
+                const auto& key = branch.name;
+                branches.push_back(branch.nodes);
+                if (spec.function == AllocationFunction::EQUAL_ALLOCATION) {
+                    weights.push_back(1.0f / static_cast<float>(node.branches.size()));
+                    continue;
+                }
+
+                // Value keys are the branch name, optionally with a "(w%)" suffix
+                auto weight = std::find_if(spec.weights.begin(), spec.weights.end(),
+                    [&key](const auto& entry) { return entry.first == key; });
+                if (weight == spec.weights.end()) {
+                    weight = std::find_if(spec.weights.begin(), spec.weights.end(),
+                        [&key](const auto& entry) { return entry.first.rfind(key, 0) == 0; });
+                }
+                if (weight == spec.weights.end()) {
+                    throw PlanCompileError("No allocation value for branch: " + key);
+                }
+                weights.push_back(weight->second);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return branches;
+}
+
+} // namespace atlas
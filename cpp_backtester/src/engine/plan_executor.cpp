@@ -0,0 +1,698 @@
+#include "plan_executor.h"
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+
+namespace atlas {
+
+PlanExecutor::PlanExecutor(const ParallelOptions& options) {
+    set_parallel_options(options);
+}
+
+void PlanExecutor::set_parallel_options(const ParallelOptions& options) {
+    if (!pool_ || options.thread_count != options_.thread_count) {
+        pool_.reset();
+        if (options.thread_count != 1) {
+            pool_ = std::make_unique<WorkStealingPool>(options.thread_count);
+        }
+    }
+    options_ = options;
+}
+
+int PlanExecutor::execute(
+    const ExecutionPlan& plan,
+    std::vector<bool>& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    return execute(
+        plan, ActiveMask::from_bools(active_mask), total_days, node_weight, portfolio_history, context
+    );
+}
+
+int PlanExecutor::execute(
+    const ExecutionPlan& plan,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    if (plan.empty()) {
+        throw NodeProcessingError("Cannot execute an empty plan");
+    }
+
+    PlanRunState run;
+    run.result_slots.assign(plan.result_slot_count, {});
+    run.shared.reserve(plan.shared_subtree_count);
+    for (uint32_t i = 0; i < plan.shared_subtree_count; ++i) {
+        run.shared.push_back(std::make_unique<SharedSubtreeState>());
+    }
+    run.lazy_caches = pool_ && has_lazy_caches(plan, context);
+
+    // Scratch masks and task lists of this run come from the thread's arena and are dropped together
+    RunArena::Scope arena_scope(RunArena::local());
+    PlanExecutionContext run_context = context;
+    if (!run_context.arena) {
+        run_context.arena = RunArena::local().resource();
+    }
+    run_context.slots = run.result_slots;
+    run_context.run = &run;
+
+    return execute_instruction(
+        plan, plan.root(), nullptr, active_mask, total_days, node_weight, portfolio_history, run_context
+    );
+}
+
+int PlanExecutor::execute_instruction(
+    const ExecutionPlan& plan,
+    const PlanInstruction& instruction,
+    const HashAlias* alias,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    if (instruction.shared_index >= 0) {
+        return execute_shared(
+            plan, instruction, alias, active_mask, total_days, node_weight, portfolio_history, context
+        );
+    }
+    return execute_node(plan, instruction, active_mask, total_days, node_weight, portfolio_history, context);
+}
+
+int PlanExecutor::execute_node(
+    const ExecutionPlan& plan,
+    const PlanInstruction& instruction,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    switch (instruction.kind) {
+        case NodeKind::ROOT:
+        case NodeKind::FOLDER: {
+            if (!instruction.node->hash.empty()) {
+                context.flow_count[instruction.node->hash]++;
+            }
+            if (instruction.group_count == 0) {
+                return total_days;
+            }
+            return execute_group(
+                plan, plan.group(instruction, 0), active_mask, total_days, node_weight,
+                portfolio_history, context
+            );
+        }
+        case NodeKind::STOCK:
+            return execute_stock(instruction, active_mask, total_days, node_weight, portfolio_history, context);
+        case NodeKind::CONDITION:
+            return execute_condition(
+                plan, instruction, active_mask, total_days, node_weight, portfolio_history, context
+            );
+        case NodeKind::SORT:
+            return execute_sort(
+                plan, instruction, active_mask, total_days, node_weight, portfolio_history, context
+            );
+        case NodeKind::ALLOCATION:
+            return execute_allocation(
+                plan, instruction, active_mask, total_days, node_weight, portfolio_history, context
+            );
+        case NodeKind::NOOP:
+            return total_days;
+    }
+
+    return total_days;
+}
+
+int PlanExecutor::execute_group(
+    const ExecutionPlan& plan,
+    const ChildGroup& group,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    if (group.child_count == 0) {
+        return total_days;
+    }
+
+    float child_weight = node_weight * group.weight / static_cast<float>(group.child_count);
+    int span = total_days;
+
+    uint32_t work = 0;
+    for (uint32_t i = 0; i < group.child_count; ++i) {
+        work += plan.child(group, i).subtree_size;
+    }
+
+    // Siblings write disjoint contributions, so each can fill a private buffer
+    if (should_fork(group.child_count, work)) {
+        std::pmr::vector<PlanTask> tasks(group.child_count, context.memory());
+        run_tasks(tasks, context, [&](size_t i, PlanTask& task, PlanExecutionContext& local) {
+            task.buffer.assign(portfolio_history.size(), DayData());
+            task.frame = &task.buffer;
+            const auto index = static_cast<uint32_t>(i);
+            return execute_instruction(
+                plan, plan.child(group, index), plan.alias(group, index), active_mask, total_days, child_weight,
+                task.buffer, local
+            );
+        });
+        for (auto& task : tasks) {
+            merge_task(task, &portfolio_history, context);
+            span = std::min(span, task.span);
+        }
+        return span;
+    }
+
+    for (uint32_t i = 0; i < group.child_count; ++i) {
+        span = std::min(span, execute_instruction(
+            plan, plan.child(group, i), plan.alias(group, i), active_mask, total_days, child_weight,
+            portfolio_history, context
+        ));
+    }
+
+    return span;
+}
+
+int PlanExecutor::execute_stock(
+    const PlanInstruction& instruction,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    const auto& hash = instruction.node->hash;
+    if (!hash.empty()) {
+        context.flow_count[hash]++;
+    }
+
+    // Julia-style indexing from the end of the portfolio history
+    const int offset = static_cast<int>(portfolio_history.size()) - total_days;
+    const StockInfo stock(instruction.stock().symbol, node_weight);
+    active_mask.for_each_set([&](size_t day) {
+        int portfolio_idx = offset + static_cast<int>(day);
+        if (portfolio_idx < 0 || portfolio_idx >= static_cast<int>(portfolio_history.size())) {
+            throw NodeProcessingError("Invalid portfolio index: " + std::to_string(portfolio_idx));
+        }
+        portfolio_history[portfolio_idx].add_stock(stock);
+    });
+
+    if (!hash.empty()) {
+        record_flow(context, hash, portfolio_history, portfolio_history);
+    }
+
+    return total_days;
+}
+
+int PlanExecutor::execute_condition(
+    const ExecutionPlan& plan,
+    const PlanInstruction& instruction,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    const auto& hash = instruction.node->hash;
+    if (!hash.empty()) {
+        context.flow_count[hash]++;
+    }
+
+    const ActiveMask condition_mask = evaluate_condition(instruction, total_days, context);
+
+    const int effective_days = static_cast<int>(condition_mask.size());
+    if (effective_days == 0) {
+        throw ConditionalNodeError("No effective days after condition evaluation");
+    }
+
+    // Align condition result with the end of the active mask
+    const auto start_offset = std::max<std::ptrdiff_t>(
+        0, static_cast<std::ptrdiff_t>(active_mask.size()) - effective_days
+    );
+    ActiveMask true_mask(active_mask.view(start_offset, effective_days), context.memory());
+    ActiveMask false_mask(true_mask, context.memory());
+    true_mask &= condition_mask;
+    false_mask.and_not(condition_mask);
+
+    int true_span = effective_days;
+    int false_span = effective_days;
+    if (should_fork(instruction.group_count, instruction.subtree_size - 1)) {
+        const ActiveMask* group_masks[] = {&true_mask, &false_mask};
+        true_span = fork_groups(
+            plan, instruction, group_masks, effective_days, node_weight, portfolio_history, context
+        );
+    } else {
+        true_span = execute_group(
+            plan, plan.group(instruction, 0), true_mask, effective_days, node_weight, portfolio_history, context
+        );
+        false_span = execute_group(
+            plan, plan.group(instruction, 1), false_mask, effective_days, node_weight, portfolio_history, context
+        );
+    }
+
+    if (!hash.empty()) {
+        record_flow(context, hash, portfolio_history, portfolio_history);
+    }
+
+    return std::min({true_span, false_span, effective_days});
+}
+
+int PlanExecutor::execute_sort(
+    const ExecutionPlan& plan,
+    const PlanInstruction& instruction,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    // Folder candidates need extra history for the sort window and indicator warm-up
+    const auto& spec = instruction.sort();
+    int span = total_days;
+    ActiveMaskView sort_mask = active_mask.view();
+    if (instruction.has_folder_branch) {
+        span += instruction.sort_padding();
+
+        // Padding days are active; the original mask is end-aligned inside the view
+        const auto padding = std::max<std::ptrdiff_t>(0, span - static_cast<std::ptrdiff_t>(active_mask.size()));
+        sort_mask = active_mask.view(-padding, span, true);
+    }
+
+    // Each candidate runs over the full span at unit weight into its own slot
+    int common_span = span;
+    const ActiveMask candidate_mask(span, true, context.memory());
+    if (should_fork(instruction.group_count, instruction.subtree_size - 1)) {
+        // Candidates already write into private slots; tasks only isolate their flow data
+        std::pmr::vector<PlanTask> tasks(instruction.group_count, context.memory());
+        run_tasks(tasks, context, [&](size_t g, PlanTask&, PlanExecutionContext& local) {
+            auto& slot = context.slots[instruction.result_slot + g];
+            slot.assign(span, DayData());
+            return execute_group(
+                plan, plan.group(instruction, static_cast<uint32_t>(g)), candidate_mask, span, 1.0f, slot, local
+            );
+        });
+        for (auto& task : tasks) {
+            merge_task(task, nullptr, context);
+            common_span = std::min(common_span, task.span);
+        }
+    } else {
+        for (uint32_t g = 0; g < instruction.group_count; ++g) {
+            auto& slot = context.slots[instruction.result_slot + g];
+            slot.assign(span, DayData());
+
+            common_span = std::min(common_span, execute_group(
+                plan, plan.group(instruction, g), candidate_mask, span, 1.0f, slot, context
+            ));
+        }
+    }
+
+    std::span<const std::vector<DayData>> candidates(
+        context.slots.data() + instruction.result_slot, instruction.group_count
+    );
+
+    // Metrics come from the candidates' own histories and leave the run caches untouched
+    auto metrics = sort_processor_.calculate_branch_metrics(
+        candidates, context.date_range, spec.sort_function, spec.window,
+        context.indicator_cache, context.price_cache, context.live_execution
+    );
+
+    // Selection days are counted below, where a task can keep them per day; the processor's count is dropped
+    std::unordered_map<std::string, int> processor_count;
+    auto selection_indices = sort_processor_.calculate_selection_indices(
+        metrics, sort_mask, common_span, spec.select_function,
+        spec.selection_count, *instruction.node, processor_count
+    );
+
+    sort_processor_.update_portfolio_history(
+        portfolio_history, candidates, selection_indices, node_weight, common_span, spec.selection_count
+    );
+
+    if (!instruction.node->hash.empty()) {
+        const auto start = std::max<std::ptrdiff_t>(0, static_cast<std::ptrdiff_t>(sort_mask.size()) - common_span);
+        record_flow_days(
+            context, instruction.node->hash, sort_mask.subview(start, common_span), portfolio_history
+        );
+        record_flow(context, instruction.node->hash, portfolio_history, portfolio_history);
+    }
+
+    return common_span;
+}
+
+int PlanExecutor::execute_allocation(
+    const ExecutionPlan& plan,
+    const PlanInstruction& instruction,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    // Inverse volatility and market cap are not lowered; fall back to the processor
+    if (instruction.group_count == 0) {
+        auto legacy_mask = active_mask.to_bools();
+        auto cache_lock = lock_caches(context);
+        auto result = allocation_processor_.process(
+            *instruction.node, legacy_mask, total_days, node_weight, portfolio_history,
+            context.date_range, context.flow_count, context.flow_stocks,
+            context.indicator_cache, context.price_cache, context.strategy,
+            context.live_execution, context.global_cache_length
+        );
+        if (!result.success) {
+            throw AllocationNodeError(result.error_message);
+        }
+        return result.processed_days;
+    }
+
+    const auto& hash = instruction.node->hash;
+    if (!hash.empty()) {
+        context.flow_count[hash]++;
+    }
+
+    int span = total_days;
+    if (should_fork(instruction.group_count, instruction.subtree_size - 1)) {
+        std::pmr::vector<const ActiveMask*> group_masks(instruction.group_count, &active_mask, context.memory());
+        span = fork_groups(plan, instruction, group_masks, total_days, node_weight, portfolio_history, context);
+    } else {
+        for (uint32_t g = 0; g < instruction.group_count; ++g) {
+            span = std::min(span, execute_group(
+                plan, plan.group(instruction, g), active_mask, total_days, node_weight, portfolio_history, context
+            ));
+        }
+    }
+
+    if (!hash.empty()) {
+        record_flow(context, hash, portfolio_history, portfolio_history);
+    }
+
+    return span;
+}
+
+int PlanExecutor::execute_shared(
+    const ExecutionPlan& plan,
+    const PlanInstruction& instruction,
+    const HashAlias* alias,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    auto& state = *context.run->shared[instruction.shared_index];
+    SharedSubtreeState::Result* cached = nullptr;
+    bool evaluate = false;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto [it, inserted] = state.results.try_emplace(total_days);
+        if (inserted) {
+            evaluate = true;
+        }
+        if (inserted || it->second.ready) {
+            cached = &it->second;
+        }
+    }
+
+    SharedSubtreeState::Result local;
+    const SharedSubtreeState::Result* result = cached;
+    if (evaluate || !result) {
+        // Unit evaluation: weight 1 over every day, captured like a task with its own sort slots, since
+        // another span of this subtree or a private copy may be evaluating at the same time
+        auto& capture = local.capture;
+        std::pmr::vector<std::vector<DayData>> slots(plan.result_slot_count, context.memory());
+        PlanExecutionContext unit{
+            context.date_range, capture.flow_count, capture.flow_stocks, context.indicator_cache,
+            context.price_cache, context.strategy, context.live_execution, context.global_cache_length,
+            &capture, context.arena, slots, context.run
+        };
+        const ActiveMask all_days(total_days, true, context.memory());
+        capture.buffer.assign(total_days, DayData());
+        capture.frame = &capture.buffer;
+        capture.span = execute_node(plan, instruction, all_days, total_days, 1.0f, capture.buffer, unit);
+        capture.frame = nullptr;
+
+        if (evaluate) {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            *cached = std::move(local);
+            cached->ready = true;
+        } else {
+            result = &local;
+        }
+    }
+
+    // Every caller replays the capture under its own mask, weight and node hashes
+    const PlanTask& capture = result->capture;
+    const auto caller_hash = [alias](const std::string& hash) -> const std::string& {
+        if (alias) {
+            auto it = alias->find(hash);
+            if (it != alias->end()) {
+                return it->second;
+            }
+        }
+        return hash;
+    };
+
+    // End-aligned, as SubtreeCache::set_portfolio_history does
+    const auto replay = [&](const std::vector<DayData>& source, std::vector<DayData>& target) {
+        const size_t length = std::min({active_mask.size(), source.size(), target.size()});
+        for (size_t i = 0; i < length; ++i) {
+            if (!active_mask[active_mask.size() - 1 - i]) {
+                continue;
+            }
+            auto& day = target[target.size() - 1 - i];
+            for (const auto& stock : source[source.size() - 1 - i].stock_list()) {
+                day.add_stock(StockInfo(stock.ticker_id(), stock.weight_tomorrow() * node_weight));
+            }
+        }
+    };
+
+    // Flow data first: the serial run recorded it before the subtree's weights reached this buffer
+    for (const auto& [hash, count] : capture.flow_count) {
+        const auto& target = caller_hash(hash);
+        if (!target.empty()) {
+            context.flow_count[target] += count;
+        }
+    }
+    for (const auto& counted : capture.day_counts) {
+        const auto& target = caller_hash(counted.hash);
+        if (target.empty()) {
+            continue;
+        }
+        ActiveMask days(portfolio_history.size(), false, context.memory());
+        const size_t length = std::min({active_mask.size(), counted.days.size(), days.size()});
+        for (size_t i = 0; i < length; ++i) {
+            if (active_mask[active_mask.size() - 1 - i] && counted.days[counted.days.size() - 1 - i]) {
+                days.set(days.size() - 1 - i);
+            }
+        }
+        record_flow_days(context, target, days.view(), portfolio_history);
+    }
+    for (const auto& snapshot : capture.snapshots) {
+        const auto& target = caller_hash(snapshot.hash);
+        if (target.empty()) {
+            continue;
+        }
+        if (!snapshot.relative) {
+            record_flow(context, target, snapshot.history, snapshot.history);
+            continue;
+        }
+        std::vector<DayData> combined = portfolio_history;
+        replay(snapshot.history, combined);
+        record_flow(context, target, combined, portfolio_history);
+    }
+    for (const auto& [hash, history] : capture.flow_stocks) {
+        const auto& target = caller_hash(hash);
+        if (!target.empty()) {
+            record_flow(context, target, history, history);
+        }
+    }
+
+    replay(capture.buffer, portfolio_history);
+    return capture.span;
+}
+
+int PlanExecutor::fork_groups(
+    const ExecutionPlan& plan,
+    const PlanInstruction& instruction,
+    std::span<const ActiveMask* const> group_masks,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    PlanExecutionContext& context
+) {
+    std::pmr::vector<PlanTask> tasks(instruction.group_count, context.memory());
+    run_tasks(tasks, context, [&](size_t g, PlanTask& task, PlanExecutionContext& local) {
+        task.buffer.assign(portfolio_history.size(), DayData());
+        task.frame = &task.buffer;
+        return execute_group(
+            plan, plan.group(instruction, static_cast<uint32_t>(g)), *group_masks[g], total_days, node_weight,
+            task.buffer, local
+        );
+    });
+
+    int span = total_days;
+    for (auto& task : tasks) {
+        merge_task(task, &portfolio_history, context);
+        span = std::min(span, task.span);
+    }
+    return span;
+}
+
+void PlanExecutor::run_tasks(
+    std::span<PlanTask> tasks,
+    PlanExecutionContext& context,
+    const std::function<int(size_t, PlanTask&, PlanExecutionContext&)>& body
+) {
+    pool_->parallel_for(tasks.size(), [&](size_t i) {
+        // Arenas are per thread; a task allocates from the one of the thread running it
+        auto& arena = RunArena::local();
+        RunArena::Scope arena_scope(arena);
+        auto& task = tasks[i];
+        PlanExecutionContext local{
+            context.date_range, task.flow_count, task.flow_stocks, context.indicator_cache, context.price_cache,
+            context.strategy, context.live_execution, context.global_cache_length, &task, arena.resource(),
+            context.slots, context.run
+        };
+        task.span = body(i, task, local);
+    });
+}
+
+void PlanExecutor::merge_task(PlanTask& task, std::vector<DayData>* target, PlanExecutionContext& context) {
+    for (const auto& [hash, count] : task.flow_count) {
+        context.flow_count[hash] += count;
+    }
+    for (const auto& counted : task.day_counts) {
+        if (target) {
+            record_flow_days(context, counted.hash, counted.days.view(), *target);
+        } else if (const auto count = counted.days.count()) {
+            context.flow_count[counted.hash] += static_cast<int>(count);
+        }
+    }
+
+    // Snapshots go first: the serial run took them before this task's buffer reached the target
+    for (auto& snapshot : task.snapshots) {
+        if (!snapshot.relative || !target) {
+            record_flow(context, snapshot.hash, snapshot.history, snapshot.history);
+            continue;
+        }
+
+        std::vector<DayData> combined = *target;
+        for (size_t day = 0; day < combined.size() && day < snapshot.history.size(); ++day) {
+            for (const auto& stock : snapshot.history[day].stock_list()) {
+                combined[day].add_stock(stock);
+            }
+        }
+        record_flow(context, snapshot.hash, combined, *target);
+    }
+    for (auto& [hash, history] : task.flow_stocks) {
+        record_flow(context, hash, history, history);
+    }
+
+    if (target) {
+        for (size_t day = 0; day < target->size() && day < task.buffer.size(); ++day) {
+            for (const auto& stock : task.buffer[day].stock_list()) {
+                (*target)[day].add_stock(stock);
+            }
+        }
+    }
+}
+
+void PlanExecutor::record_flow(
+    PlanExecutionContext& context,
+    const std::string& hash,
+    const std::vector<DayData>& history,
+    const std::vector<DayData>& frame
+) {
+    if (!context.task) {
+        context.flow_stocks[hash] = history;
+        return;
+    }
+    context.task->snapshots.push_back(FlowSnapshot{hash, history, &frame == context.task->frame});
+}
+
+void PlanExecutor::record_flow_days(
+    PlanExecutionContext& context,
+    const std::string& hash,
+    const ActiveMaskView& days,
+    const std::vector<DayData>& frame
+) {
+    if (!context.task || &frame != context.task->frame) {
+        if (const auto count = days.count()) {
+            context.flow_count[hash] += static_cast<int>(count);
+        }
+        return;
+    }
+
+    // Days before the frame (sort padding) are active under any mask, so they count right away
+    const auto offset = static_cast<std::ptrdiff_t>(frame.size()) - static_cast<std::ptrdiff_t>(days.size());
+    ActiveMask in_frame(frame.size());
+    int before_frame = 0;
+    days.for_each_set([&](size_t day) {
+        const auto index = offset + static_cast<std::ptrdiff_t>(day);
+        if (index < 0) {
+            ++before_frame;
+        } else {
+            in_frame.set(static_cast<size_t>(index));
+        }
+    });
+    if (before_frame > 0) {
+        context.flow_count[hash] += before_frame;
+    }
+    context.task->day_counts.push_back(FlowDays{hash, std::move(in_frame)});
+}
+
+bool PlanExecutor::should_fork(size_t sibling_count, uint32_t work) const {
+    return pool_ && sibling_count > 1 && work >= options_.serial_threshold;
+}
+
+bool PlanExecutor::has_lazy_caches(const ExecutionPlan& plan, const PlanExecutionContext& context) const {
+    for (const auto& instruction : plan.instructions) {
+        if (instruction.kind == NodeKind::CONDITION &&
+            !ConditionalNodeProcessor::is_cached(instruction.condition(), context.indicator_cache, context.price_cache)) {
+            return true;
+        }
+        if (instruction.kind == NodeKind::ALLOCATION && instruction.group_count == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ActiveMask PlanExecutor::evaluate_condition(
+    const PlanInstruction& instruction,
+    int total_days,
+    PlanExecutionContext& context
+) {
+    const auto& spec = instruction.condition();
+    const auto evaluate = [&] {
+        return condition_processor_.evaluate_condition(
+            spec, context.date_range, total_days, context.indicator_cache, context.price_cache,
+            context.strategy, context.live_execution, context.memory()
+        );
+    };
+
+    // Serial runs and fully prefetched caches need no lock
+    if (!context.run || !context.run->lazy_caches) {
+        return evaluate();
+    }
+    {
+        std::shared_lock<std::shared_mutex> read_lock(context.run->cache_mutex);
+        if (ConditionalNodeProcessor::is_cached(spec, context.indicator_cache, context.price_cache)) {
+            return evaluate();
+        }
+    }
+    std::unique_lock<std::shared_mutex> write_lock(context.run->cache_mutex);
+    return evaluate();
+}
+
+std::unique_lock<std::shared_mutex> PlanExecutor::lock_caches(PlanExecutionContext& context) const {
+    if (!context.run || !context.run->lazy_caches) {
+        return std::unique_lock<std::shared_mutex>();
+    }
+    return std::unique_lock<std::shared_mutex>(context.run->cache_mutex);
+}
+
+} // namespace atlas
@@ -1,95 +1,104 @@
-#include \"strategy_parser.h\"
+#include "strategy_parser.h"
+#include "node_graph.h"
+#include "conditional_node.h"
+#include "sort_node.h"
+#include "allocation_node.h"
 #include <stdexcept>
 #include <set>
 #include <algorithm>
+#include <cmath>
 
 namespace atlas {
 
 StrategyNode::StrategyNode(const nlohmann::json& json_node) {
-    if (json_node.contains(\"id\")) {
-        id = json_node[\"id\"].get<std::string>();
+    if (json_node.contains("id")) {
+        id = json_node["id"].get<std::string>();
     }
     
-    if (json_node.contains(\"type\")) {
-        type = json_node[\"type\"].get<std::string>();
+    if (json_node.contains("type")) {
+        type = json_node["type"].get<std::string>();
     }
     
-    if (json_node.contains(\"name\")) {
-        name = json_node[\"name\"].get<std::string>();
+    if (json_node.contains("name")) {
+        name = json_node["name"].get<std::string>();
     }
     
-    if (json_node.contains(\"componentType\")) {
-        component_type = json_node[\"componentType\"].get<std::string>();
+    if (json_node.contains("componentType")) {
+        component_type = json_node["componentType"].get<std::string>();
     }
     
-    if (json_node.contains(\"properties\")) {
-        properties = json_node[\"properties\"];
+    if (json_node.contains("properties")) {
+        properties = json_node["properties"];
     }
     
-    if (json_node.contains(\"branches\")) {
-        branches = json_node[\"branches\"];
+    if (json_node.contains("branches")) {
+        branches = json_node["branches"];
     }
     
-    if (json_node.contains(\"sequence\") && json_node[\"sequence\"].is_array()) {
-        for (const auto& seq_node : json_node[\"sequence\"]) {
+    if (json_node.contains("sequence") && json_node["sequence"].is_array()) {
+        for (const auto& seq_node : json_node["sequence"]) {
             sequence.emplace_back(seq_node);
         }
     }
     
-    if (json_node.contains(\"hash\")) {
-        hash = json_node[\"hash\"].get<std::string>();
+    if (json_node.contains("hash")) {
+        hash = json_node["hash"].get<std::string>();
     }
     
-    if (json_node.contains(\"parentHash\")) {
-        parent_hash = json_node[\"parentHash\"].get<std::string>();
+    if (json_node.contains("parentHash")) {
+        parent_hash = json_node["parentHash"].get<std::string>();
     }
     
-    if (json_node.contains(\"nodeChildrenHash\")) {
-        node_children_hash = json_node[\"nodeChildrenHash\"].get<std::string>();
+    if (json_node.contains("nodeChildrenHash")) {
+        node_children_hash = json_node["nodeChildrenHash"].get<std::string>();
+    }
+    
+    if (json_node.contains("function") && json_node["function"].is_string()) {
+        function = json_node["function"].get<std::string>();
     }
 }
 
 Strategy::Strategy(const nlohmann::json& json_strategy) {
-    if (!json_strategy.contains(\"json\")) {
-        throw StrategyParseError(\"Missing 'json' field in strategy\");
+    if (!json_strategy.contains("json")) {
+        throw StrategyParseError("Missing 'json' field in strategy");
     }
     
     // Parse the nested JSON string
-    auto inner_json = nlohmann::json::parse(json_strategy[\"json\"].get<std::string>());
+    auto inner_json = nlohmann::json::parse(json_strategy["json"].get<std::string>());
     
     // Parse root node
     root = StrategyNode(inner_json);
     
     // Extract tickers
-    if (inner_json.contains(\"tickers\") && inner_json[\"tickers\"].is_array()) {
-        for (const auto& ticker : inner_json[\"tickers\"]) {
+    if (inner_json.contains("tickers") && inner_json["tickers"].is_array()) {
+        for (const auto& ticker : inner_json["tickers"]) {
             tickers.push_back(ticker.get<std::string>());
         }
     }
     
     // Extract indicators
-    if (inner_json.contains(\"indicators\") && inner_json[\"indicators\"].is_array()) {
-        for (const auto& indicator : inner_json[\"indicators\"]) {
+    if (inner_json.contains("indicators") && inner_json["indicators"].is_array()) {
+        for (const auto& indicator : inner_json["indicators"]) {
             indicators.push_back(indicator);
         }
     }
     
     // Extract node children hash
-    if (inner_json.contains(\"nodeChildrenHash\")) {
-        node_children_hash = inner_json[\"nodeChildrenHash\"].get<std::string>();
+    if (inner_json.contains("nodeChildrenHash")) {
+        node_children_hash = inner_json["nodeChildrenHash"].get<std::string>();
     }
     
     // Extract outer fields
-    if (json_strategy.contains(\"period\")) {
-        period = std::stoi(json_strategy[\"period\"].get<std::string>());
+    if (json_strategy.contains("period")) {
+        period = std::stoi(json_strategy["period"].get<std::string>());
     }
     
-    if (json_strategy.contains(\"end_date\")) {
-        end_date = json_strategy[\"end_date\"].get<std::string>();
+    if (json_strategy.contains("end_date")) {
+        end_date = json_strategy["end_date"].get<std::string>();
     }
     
-    if (json_strategy.contains(\"hash\")) {
-        strategy_hash = json_strategy[\"hash\"].get<std::string>();
+    if (json_strategy.contains("hash")) {
+        strategy_hash = json_strategy["hash"].get<std::string>();
     }
 }
 
@@ -98,21 +107,23 @@ Strategy StrategyParser::parse_strategy(const std::string& json_str) {
         auto json_obj = nlohmann::json::parse(json_str);
         return parse_strategy(json_obj);
     } catch (const nlohmann::json::exception& e) {
-        throw StrategyParseError(\"JSON parsing error: \" + std::string(e.what()));
+        throw StrategyParseError("JSON parsing error: " + std::string(e.what()));
     }
 }
 
 Strategy StrategyParser::parse_strategy(const nlohmann::json& json_obj) {
     try {
         Strategy strategy(json_obj);
+        resolve_specs(strategy.root);
+        strategy.graph = NodeGraph::build(strategy.root);
         
         if (!validate_strategy(strategy)) {
-            throw StrategyParseError(\"Strategy validation failed\");
+            throw StrategyParseError("Strategy validation failed");
         }
         
         return strategy;
     } catch (const std::exception& e) {
-        throw StrategyParseError(\"Strategy parsing error: \" + std::string(e.what()));
+        throw StrategyParseError("Strategy parsing error: " + std::string(e.what()));
     }
 }
 
@@ -141,7 +152,151 @@ bool StrategyParser::validate_strategy(const Strategy& strategy) {
 }
 
 StrategyNode StrategyParser::parse_node(const nlohmann::json& json_node) {
-    return StrategyNode(json_node);
+    StrategyNode node(json_node);
+    resolve_specs(node);
+    
+    // Building the graph parses the branch nodes so bad properties fail at parse time
+    NodeGraph::build(node);
+    return node;
+}
+
+void StrategyParser::resolve_specs(StrategyNode& node) {
+    node.spec = parse_node_spec(node);
+    
+    for (auto& child : node.sequence) {
+        resolve_specs(child);
+    }
+}
+
+NodeSpec StrategyParser::parse_node_spec(const StrategyNode& node) {
+    const auto& properties = node.properties;
+    
+    try {
+        if (node.type == "stock") {
+            if (!properties.contains("symbol") || !properties["symbol"].is_string() ||
+                properties["symbol"].get<std::string>().empty()) {
+                throw StrategyParseError("missing symbol");
+            }
+            auto symbol = properties["symbol"].get<std::string>();
+            return StockSpec{symbol, TickerTable::instance().intern(symbol)};
+        }
+        
+        if (node.type == "condition") {
+            if (!properties.contains("x") || !properties.contains("y") || !properties.contains("comparison")) {
+                throw StrategyParseError("missing x, y or comparison");
+            }
+            ConditionSpec spec;
+            spec.x = parse_operand(properties["x"]);
+            spec.y = parse_operand(properties["y"]);
+            spec.comparison = ConditionalNodeProcessor::parse_comparison_operator(
+                properties["comparison"].get<std::string>()
+            );
+            return spec;
+        }
+        
+        if (node.type == "Sort") {
+            SortSpec spec;
+            if (!SortNodeProcessor::parse_select_properties(properties, spec.select_function, spec.selection_count)) {
+                throw StrategyParseError("invalid select properties");
+            }
+            if (!SortNodeProcessor::parse_sort_properties(properties, spec.sort_function, spec.window)) {
+                throw StrategyParseError("invalid sortby properties");
+            }
+            return spec;
+        }
+        
+        if (node.type == "allocation") {
+            AllocationSpec spec;
+            spec.function = node.function.empty()
+                ? AllocationNodeProcessor::parse_allocation_function(properties)
+                : AllocationNodeProcessor::parse_allocation_function(node.function);
+            
+            if (properties.contains("period")) {
+                spec.period = static_cast<int>(parse_number(properties["period"]));
+            }
+            
+            if (spec.function == AllocationFunction::ALLOCATION) {
+                if (!properties.contains("values") || !properties["values"].is_object()) {
+                    throw StrategyParseError("manual allocation missing values");
+                }
+                float total_weight = 0.0f;
+                for (const auto& [key, value] : properties["values"].items()) {
+                    float percent = parse_number(value);
+                    total_weight += percent;
+                    spec.weights.emplace_back(key, percent / 100.0f);
+                }
+                if (std::abs(total_weight - 100.0f) > 1e-2f) {
+                    throw StrategyParseError("total allocation weight must be 100%, got: " + std::to_string(total_weight));
+                }
+            }
+            return spec;
+        }
+    } catch (const StrategyParseError& e) {
+        throw StrategyParseError("Invalid " + node.type + " node " + node.id + ": " + e.what());
+    } catch (const std::exception& e) {
+        throw StrategyParseError("Invalid " + node.type + " node " + node.id + ": " + std::string(e.what()));
+    }
+    
+    return std::monostate{};
+}
+
+Operand StrategyParser::parse_operand(const nlohmann::json& operand_json) {
+    if (!operand_json.is_object() || !operand_json.contains("indicator") || !operand_json["indicator"].is_string()) {
+        throw StrategyParseError("operand missing indicator");
+    }
+    
+    Operand operand;
+    operand.indicator = operand_json["indicator"].get<std::string>();
+    
+    auto read_string = [&](const char* field) {
+        return operand_json.contains(field) && operand_json[field].is_string()
+            ? operand_json[field].get<std::string>()
+            : std::string();
+    };
+    operand.source = read_string("source");
+    operand.numerator = read_string("numerator");
+    operand.denominator = read_string("denominator");
+    
+    bool has_period = operand_json.contains("period") &&
+        !(operand_json["period"].is_string() && operand_json["period"].get<std::string>().empty());
+    
+    // Constants carry their value in the period field
+    if (operand.is_constant()) {
+        if (!has_period) {
+            throw StrategyParseError("constant operand missing value");
+        }
+        operand.value = parse_number(operand_json["period"]);
+        return operand;
+    }
+    
+    if (operand.source.empty() && !operand.is_ratio()) {
+        throw StrategyParseError("operand " + operand.indicator + " missing source");
+    }
+    
+    if (has_period) {
+        operand.period = static_cast<int>(parse_number(operand_json["period"]));
+        if (operand.period < 0) {
+            throw StrategyParseError("negative period for " + operand.indicator);
+        }
+    }
+    
+    return operand;
+}
+
+float StrategyParser::parse_number(const nlohmann::json& value) {
+    if (value.is_number()) {
+        return value.get<float>();
+    }
+    if (value.is_string()) {
+        const auto text = value.get<std::string>();
+        size_t consumed = 0;
+        float parsed = std::stof(text, &consumed);
+        if (consumed != text.size()) {
+            throw StrategyParseError("invalid number: " + text);
+        }
+        return parsed;
+    }
+    throw StrategyParseError("expected a number");
 }
 
 bool StrategyParser::validate_node(const StrategyNode& node) {
@@ -151,26 +306,26 @@ bool StrategyParser::validate_node(const StrategyNode& node) {
     }
     
     // Type-specific validation
-    if (node.type == \"stock\") {
+    if (node.type == "stock") {
         // Stock nodes must have symbol in properties
-        if (!node.properties.contains(\"symbol\")) {
+        if (!node.properties.contains("symbol")) {
             return false;
         }
-        auto symbol = node.properties[\"symbol\"];
+        auto symbol = node.properties["symbol"];
         if (!symbol.is_string() || symbol.get<std::string>().empty()) {
             return false;
         }
-    } else if (node.type == \"condition\") {
+    } else if (node.type == "condition") {
         // Conditional nodes must have comparison and x/y in properties
-        if (!node.properties.contains(\"comparison\") ||
-            !node.properties.contains(\"x\") ||
-            !node.properties.contains(\"y\")) {
+        if (!node.properties.contains("comparison") ||
+            !node.properties.contains("x") ||
+            !node.properties.contains("y")) {
             return false;
         }
-    } else if (node.type == \"Sort\") {
+    } else if (node.type == "Sort") {
         // Sort nodes must have select and sortby in properties
-        if (!node.properties.contains(\"select\") ||
-            !node.properties.contains(\"sortby\")) {
+        if (!node.properties.contains("select") ||
+            !node.properties.contains("sortby")) {
             return false;
         }
     }
@@ -189,13 +344,13 @@ std::vector<std::string> StrategyParser::extract_tickers(const StrategyNode& roo
     std::set<std::string> ticker_set;
     
     // Extract from current node if it's a stock node
-    if (root.type == \"stock\" && root.properties.contains(\"symbol\")) {
-        ticker_set.insert(root.properties[\"symbol\"].get<std::string>());
+    if (root.type == "stock" && root.properties.contains("symbol")) {
+        ticker_set.insert(root.properties["symbol"].get<std::string>());
     }
     
     // Extract from properties if they reference tickers
-    if (root.properties.contains(\"source\")) {
-        ticker_set.insert(root.properties[\"source\"].get<std::string>());
+    if (root.properties.contains("source")) {
+        ticker_set.insert(root.properties["source"].get<std::string>());
     }
     
     // Recursively extract from child nodes
@@ -212,16 +367,16 @@ std::vector<nlohmann::json> StrategyParser::extract_indicators(const StrategyNod
     std::vector<nlohmann::json> indicators;
     
     // Extract indicators from properties
-    if (root.properties.contains(\"x\") && root.properties[\"x\"].contains(\"indicator\")) {
-        indicators.push_back(root.properties[\"x\"]);
+    if (root.properties.contains("x") && root.properties["x"].contains("indicator")) {
+        indicators.push_back(root.properties["x"]);
     }
     
-    if (root.properties.contains(\"y\") && root.properties[\"y\"].contains(\"indicator\")) {
-        indicators.push_back(root.properties[\"y\"]);
+    if (root.properties.contains("y") && root.properties["y"].contains("indicator")) {
+        indicators.push_back(root.properties["y"]);
     }
     
-    if (root.properties.contains(\"sortby\") && root.properties[\"sortby\"].contains(\"function\")) {
-        indicators.push_back(root.properties[\"sortby\"]);
+    if (root.properties.contains("sortby") && root.properties["sortby"].contains("function")) {
+        indicators.push_back(root.properties["sortby"]);
     }
     
     // Recursively extract from child nodes
@@ -0,0 +1,98 @@
+#include "ticker_prefetch.h"
+#include "work_stealing_pool.h"
+#include <exception>
+#include <stdexcept>
+
+namespace atlas {
+
+TickerPrefetch::TickerPrefetch(WorkStealingPool& io_pool, IndicatorPlanner::PriceLoader loader,
+                               SeriesCache* shared, uint32_t as_of)
+    : io_pool_(io_pool), loader_(std::move(loader)), shared_(shared), as_of_(as_of),
+      started_(std::chrono::steady_clock::now()) {}
+
+TickerPrefetch::~TickerPrefetch() {
+    for (auto& load : loads_) {
+        load.result.wait();
+    }
+}
+
+std::chrono::microseconds TickerPrefetch::elapsed() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started_);
+}
+
+void TickerPrefetch::start(const IndicatorPlan& plan) {
+    started_ = std::chrono::steady_clock::now();
+
+    // Register every load before queueing any, so wait() never races the bookkeeping
+    std::vector<Load*> queued;
+    for (const auto& ticker : plan.tickers) {
+        if (by_ticker_.count(ticker)) {
+            continue;
+        }
+        auto& load = loads_.emplace_back();
+        load.event.ticker = ticker;
+        load.event.days = plan.lookback.at(ticker);
+        load.result = load.promise.get_future().share();
+        by_ticker_.emplace(ticker, &load);
+        queued.push_back(&load);
+    }
+
+    for (Load* load : queued) {
+        load->event.queued = elapsed();
+        io_pool_.submit([this, load] { run(*load); });
+    }
+}
+
+void TickerPrefetch::run(Load& load) {
+    {
+        std::lock_guard<std::mutex> lock(events_mutex_);
+        load.event.started = elapsed();
+    }
+    try {
+        bool cached = false;
+        auto series = IndicatorPlanner::load_prices(load.event.ticker, load.event.days, loader_, shared_, as_of_, &cached);
+        {
+            std::lock_guard<std::mutex> lock(events_mutex_);
+            load.event.values = series->size();
+            load.event.cached = cached;
+            load.event.finished = elapsed();
+            load.event.done = true;
+        }
+        load.promise.set_value(std::move(series));
+    } catch (...) {
+        std::string message = "Unknown error";
+        try {
+            throw;
+        } catch (const std::exception& e) {
+            message = e.what();
+        } catch (...) {
+        }
+        {
+            std::lock_guard<std::mutex> lock(events_mutex_);
+            load.event.error = std::move(message);
+            load.event.finished = elapsed();
+            load.event.done = true;
+        }
+        load.promise.set_exception(std::current_exception());
+    }
+}
+
+SeriesCache::Series TickerPrefetch::wait(const std::string& ticker) {
+    auto it = by_ticker_.find(ticker);
+    if (it == by_ticker_.end()) {
+        throw std::out_of_range("No prefetch was started for " + ticker);
+    }
+    return it->second->result.get();
+}
+
+std::vector<PrefetchEvent> TickerPrefetch::timeline() const {
+    std::lock_guard<std::mutex> lock(events_mutex_);
+    std::vector<PrefetchEvent> events;
+    events.reserve(loads_.size());
+    for (const auto& load : loads_) {
+        events.push_back(load.event);
+    }
+    return events;
+}
+
+} // namespace atlas
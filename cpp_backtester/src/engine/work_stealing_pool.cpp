@@ -0,0 +1,160 @@
+#include "work_stealing_pool.h"
+#include <algorithm>
+#include <exception>
+
+namespace atlas {
+
+namespace {
+
+// Worker identity of the current thread, used to find its home queue
+thread_local const WorkStealingPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    queues_.reserve(thread_count + 1);
+    for (size_t i = 0; i < thread_count + 1; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    threads_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::parallel_for(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<size_t> remaining{count};
+
+    auto run = [&](size_t i) {
+        try {
+            fn(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // Last task of the call: wake the caller if it went to sleep waiting
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            wake_.notify_all();
+        }
+    };
+
+    // Queue all but the first task; pushed in reverse so the owner pops them in index order
+    const size_t home = home_queue();
+    for (size_t i = count; i-- > 1;) {
+        push(home, [&run, i] { run(i); });
+    }
+    run(0);
+
+    // Help with queued work (ours or stolen) until every task of this call is done,
+    // sleeping while nothing is queued and the remaining tasks run elsewhere
+    while (remaining.load(std::memory_order_acquire) != 0) {
+        if (try_run_one(home)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [&] {
+            return remaining.load(std::memory_order_acquire) == 0 || queued_.load(std::memory_order_acquire) != 0;
+        });
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    push(home_queue(), std::move(task));
+}
+
+bool WorkStealingPool::try_run_one(size_t home) {
+    std::function<void()> task;
+
+    // Own queue LIFO for locality
+    {
+        auto& queue = *queues_[home];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+    }
+
+    // Steal FIFO from the others, oldest (largest) tasks first
+    for (size_t offset = 1; !task && offset < queues_.size(); ++offset) {
+        auto& queue = *queues_[(home + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    queued_.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+}
+
+void WorkStealingPool::push(size_t home, std::function<void()> task) {
+    // Count the task before publishing it, so a thief's decrement never precedes the increment
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        queued_.fetch_add(1, std::memory_order_acq_rel);
+    }
+    {
+        auto& queue = *queues_[home];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void WorkStealingPool::worker_loop(size_t index) {
+    current_pool = this;
+    current_worker = index;
+
+    while (true) {
+        if (try_run_one(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_acquire) != 0; });
+        if (stop_) {
+            return;
+        }
+    }
+}
+
+size_t WorkStealingPool::home_queue() const {
+    return current_pool == this ? current_worker : threads_.size();
+}
+
+} // namespace atlas
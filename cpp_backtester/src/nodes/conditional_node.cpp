@@ -1,5 +1,7 @@
-#include \"conditional_node.h\"
-#include \"backtesting_engine.h\"
+#include "conditional_node.h"
+#include "backtesting_engine.h"
+#include "node_graph.h"
+#include "indicator_planner.h"
 #include <algorithm>
 #include <stdexcept>
 #include <cmath>
@@ -12,10 +14,32 @@ NodeResult ConditionalNodeProcessor::process(
     int total_days,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
+    std::unordered_map<std::string, std::vector<float>>& price_cache,
+    const Strategy& strategy,
+    bool live_execution,
+    int global_cache_length
+) {
+    return process(
+        node, ActiveMask::from_bools(active_mask), total_days, node_weight, portfolio_history,
+        date_range, flow_count, flow_stocks, indicator_cache, price_cache, strategy,
+        live_execution, global_cache_length
+    );
+}
+
+NodeResult ConditionalNodeProcessor::process(
+    const StrategyNode& node,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    std::span<const int32_t> date_range,
+    std::unordered_map<std::string, int>& flow_count,
+    std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution,
@@ -24,7 +48,7 @@ NodeResult ConditionalNodeProcessor::process(
     try {
         // Validate conditional node
         if (!validate_conditional_node(node)) {
-            return NodeResult(0, false, \"Invalid conditional node structure\");
+            return NodeResult(0, false, "Invalid conditional node structure");
         }
         
         // Increment flow count
@@ -33,37 +57,31 @@ NodeResult ConditionalNodeProcessor::process(
         }
         
         // Extract branches
-        std::vector<StrategyNode> true_branch, false_branch;
-        extract_branches(node, true_branch, false_branch);
+        std::deque<StrategyNode> branch_storage;
+        std::vector<const StrategyNode*> true_branch, false_branch;
+        extract_branches(node, strategy, branch_storage, true_branch, false_branch);
         
         // Evaluate condition
-        std::vector<bool> condition_result;
+        ActiveMask condition_result;
         try {
             condition_result = evaluate_condition(
                 node, date_range, total_days, indicator_cache, price_cache, strategy, live_execution
             );
         } catch (const std::exception& e) {
-            return NodeResult(0, false, \"Condition evaluation failed: \" + std::string(e.what()));
+            return NodeResult(0, false, "Condition evaluation failed: " + std::string(e.what()));
         }
         
         int effective_days = static_cast<int>(condition_result.size());
         if (effective_days == 0) {
-            return NodeResult(0, false, \"No effective days after condition evaluation\");
+            return NodeResult(0, false, "No effective days after condition evaluation");
         }
         
-        // Create branch masks
-        std::vector<bool> true_branch_mask, false_branch_mask;
-        
-        // Align condition result with active mask
+        // Align condition result with the end of the active mask and split it into branch masks
         int start_offset = std::max(0, static_cast<int>(active_mask.size()) - effective_days);
-        
-        for (int i = 0; i < effective_days; ++i) {
-            int active_idx = start_offset + i;
-            bool is_active = (active_idx < static_cast<int>(active_mask.size())) ? active_mask[active_idx] : false;
-            
-            true_branch_mask.push_back(condition_result[i] && is_active);
-            false_branch_mask.push_back(!condition_result[i] && is_active);
-        }
+        ActiveMask true_branch_mask(active_mask.view(start_offset, effective_days));
+        ActiveMask false_branch_mask(true_branch_mask);
+        true_branch_mask &= condition_result;
+        false_branch_mask.and_not(condition_result);
         
         // Process true branch
         int true_branch_span;
@@ -74,7 +92,7 @@ NodeResult ConditionalNodeProcessor::process(
                 indicator_cache, price_cache, strategy, live_execution, global_cache_length
             );
         } catch (const std::exception& e) {
-            return NodeResult(0, false, \"True branch processing failed: \" + std::string(e.what()));
+            return NodeResult(0, false, "True branch processing failed: " + std::string(e.what()));
         }
         
         // Process false branch
@@ -86,7 +104,7 @@ NodeResult ConditionalNodeProcessor::process(
                 indicator_cache, price_cache, strategy, live_execution, global_cache_length
             );
         } catch (const std::exception& e) {
-            return NodeResult(0, false, \"False branch processing failed: \" + std::string(e.what()));
+            return NodeResult(0, false, "False branch processing failed: " + std::string(e.what()));
         }
         
         // Set flow stocks
@@ -97,69 +115,120 @@ NodeResult ConditionalNodeProcessor::process(
         return NodeResult(std::min({true_branch_span, false_branch_span, effective_days}), true);
         
     } catch (const std::exception& e) {
-        return NodeResult(0, false, \"Conditional node error: \" + std::string(e.what()));
+        return NodeResult(0, false, "Conditional node error: " + std::string(e.what()));
     }
 }
 
 bool ConditionalNodeProcessor::validate_conditional_node(const StrategyNode& node) const {
     // Must have branches
-    if (!node.branches.contains(\"true\") || !node.branches.contains(\"false\")) {
+    if (!node.branches.contains("true") || !node.branches.contains("false")) {
         return false;
     }
     
+    // Parsed specs were validated by StrategyParser
+    if (std::holds_alternative<ConditionSpec>(node.spec)) {
+        return true;
+    }
+    
     // Must have valid properties for condition evaluation
     return validate_condition_properties(node.properties);
 }
 
 bool ConditionalNodeProcessor::validate_condition_properties(const nlohmann::json& properties) const {
     // Must have x, y, and comparison
-    return properties.contains(\"x\") && 
-           properties.contains(\"y\") && 
-           properties.contains(\"comparison\");
+    return properties.contains("x") && 
+           properties.contains("y") && 
+           properties.contains("comparison");
 }
 
-std::vector<bool> ConditionalNodeProcessor::evaluate_condition(
+ActiveMask ConditionalNodeProcessor::evaluate_condition(
     const StrategyNode& node,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
+    int total_days,
+    IndicatorCache& indicator_cache,
+    std::unordered_map<std::string, std::vector<float>>& price_cache,
+    const Strategy& strategy,
+    bool live_execution,
+    ActiveMask::allocator_type alloc
+) {
+    // Nodes built outside StrategyParser carry no spec yet
+    const auto* spec = std::get_if<ConditionSpec>(&node.spec);
+    if (spec == nullptr) {
+        StrategyParser parser;
+        auto parsed = parser.parse_node_spec(node);
+        return evaluate_condition(
+            std::get<ConditionSpec>(parsed), date_range, total_days, indicator_cache, price_cache, strategy,
+            live_execution, alloc
+        );
+    }
+    
+    return evaluate_condition(
+        *spec, date_range, total_days, indicator_cache, price_cache, strategy, live_execution, alloc
+    );
+}
+
+ActiveMask ConditionalNodeProcessor::evaluate_condition(
+    const ConditionSpec& spec,
+    std::span<const int32_t> date_range,
     int total_days,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
-    bool live_execution
+    bool live_execution,
+    ActiveMask::allocator_type alloc
 ) {
-    // Get indicator values for x and y
+    // Views into the run caches; only constants are materialized
+    std::vector<float> x_storage, y_storage;
     auto x = get_indicator_value(
-        node.properties[\"x\"], date_range, total_days, indicator_cache, price_cache, live_execution
+        spec.x, date_range, total_days, indicator_cache, price_cache, live_execution, x_storage
     );
     
     auto y = get_indicator_value(
-        node.properties[\"y\"], date_range, total_days, indicator_cache, price_cache, live_execution
+        spec.y, date_range, total_days, indicator_cache, price_cache, live_execution, y_storage
     );
     
     if (x.empty() || y.empty()) {
-        throw ConditionEvalError(\"Empty indicator values\");
+        throw ConditionEvalError("Empty indicator values");
     }
     
     // Align lengths
     align_indicator_lengths(x, y);
     
-    // Get comparison operator
-    std::string comparison = node.properties[\"comparison\"].get<std::string>();
-    
     // Compare values
-    return compare_values(x, y, comparison);
+    return compare_values(x, y, spec.comparison, alloc);
+}
+
+bool ConditionalNodeProcessor::is_cached(
+    const ConditionSpec& spec,
+    const IndicatorCache& indicator_cache,
+    const std::unordered_map<std::string, std::vector<float>>& price_cache
+) {
+    // Mirrors the lookups of get_indicator_value
+    const auto operand_cached = [&](const Operand& operand) {
+        if (operand.is_constant()) {
+            return true;
+        }
+        if (operand.indicator == "current price") {
+            return price_cache.count(operand.source) != 0;
+        }
+        if (auto batch = IndicatorPlanner::batch_spec(operand.indicator, operand.period)) {
+            return indicator_cache.contains(IndicatorKey::of(operand.source, *batch));
+        }
+        return true;
+    };
+    return operand_cached(spec.x) && operand_cached(spec.y);
 }
 
 int ConditionalNodeProcessor::process_branch(
-    const std::vector<StrategyNode>& nodes,
-    std::vector<bool>& active_mask,
+    const std::vector<const StrategyNode*>& nodes,
+    const ActiveMask& active_mask,
     int total_days,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution,
@@ -170,8 +239,7 @@ int ConditionalNodeProcessor::process_branch(
     }
     
     // Check if any days are active
-    bool has_active_days = std::any_of(active_mask.begin(), active_mask.end(), [](bool b) { return b; });
-    if (!has_active_days) {
+    if (active_mask.none()) {
         return total_days;
     }
     
@@ -179,8 +247,8 @@ int ConditionalNodeProcessor::process_branch(
     
     // Count non-comment nodes
     int node_count = 0;
-    for (const auto& node : nodes) {
-        if (node.type != \"comment\") {
+    for (const auto* node : nodes) {
+        if (node->type != "comment") {
             node_count++;
         }
     }
@@ -190,19 +258,20 @@ int ConditionalNodeProcessor::process_branch(
     // Process each node in the branch
     // Note: This would require access to the post_order_dfs function from BacktestingEngine
     // For now, we'll implement a basic version that handles stock nodes
-    for (const auto& branch_node : nodes) {
-        if (branch_node.type == \"comment\") {
+    for (const auto* branch_ptr : nodes) {
+        const StrategyNode& branch_node = *branch_ptr;
+        if (branch_node.type == "comment") {
             continue;
         }
         
         // For now, we'll handle stock nodes directly
         // In a complete implementation, this would delegate to the engine's post_order_dfs
-        if (branch_node.type == \"stock\") {
+        if (branch_node.type == "stock") {
             // Create a stock processor and process the node
             // This is a simplified implementation
             for (size_t i = 0; i < active_mask.size() && i < portfolio_history.size(); ++i) {
-                if (active_mask[i] && branch_node.properties.contains(\"symbol\")) {
-                    std::string symbol = branch_node.properties[\"symbol\"].get<std::string>();
+                if (active_mask[i] && branch_node.properties.contains("symbol")) {
+                    std::string symbol = branch_node.properties["symbol"].get<std::string>();
                     portfolio_history[i].add_stock(StockInfo(symbol, node_weight_per_node));
                 }
             }
@@ -213,106 +282,79 @@ int ConditionalNodeProcessor::process_branch(
     return min_data_span;
 }
 
-std::vector<float> ConditionalNodeProcessor::get_indicator_value(
-    const nlohmann::json& indicator_def,
-    const std::vector<std::string>& date_range,
+std::span<const float> ConditionalNodeProcessor::get_indicator_value(
+    const Operand& operand,
+    std::span<const int32_t> date_range,
     int total_days,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
-    bool live_execution
+    bool live_execution,
+    std::vector<float>& storage
 ) {
-    // Extract indicator type and parameters
-    if (!indicator_def.contains(\"indicator\") || !indicator_def.contains(\"source\")) {
-        throw ConditionEvalError(\"Missing indicator or source in indicator definition\");
-    }
+    const size_t days = static_cast<size_t>(std::max(total_days, 0));
     
-    std::string indicator_type = indicator_def[\"indicator\"].get<std::string>();
-    std::string source = indicator_def[\"source\"].get<std::string>();
-    
-    // Create cache key
-    std::string cache_key = source + \"_\" + indicator_type;
-    if (indicator_def.contains(\"period\")) {
-        cache_key += \"_\" + indicator_def[\"period\"].get<std::string>();
+    // Fixed values need no data
+    if (operand.is_constant()) {
+        storage.assign(days, operand.value);
+        return storage;
     }
     
-    // Check cache first
-    auto cache_it = indicator_cache.find(cache_key);
-    if (cache_it != indicator_cache.end()) {
-        auto& cached_values = cache_it->second;
-        // Return the last total_days values
-        int start_idx = std::max(0, static_cast<int>(cached_values.size()) - total_days);
-        return std::vector<float>(cached_values.begin() + start_idx, cached_values.end());
-    }
+    const std::string& indicator_type = operand.indicator;
+    const std::string& source = operand.source;
     
     // For current price indicator
-    if (indicator_type == \"current price\") {
+    if (indicator_type == "current price") {
         auto price_it = price_cache.find(source);
-        if (price_it != price_cache.end()) {
-            auto& prices = price_it->second;
-            int start_idx = std::max(0, static_cast<int>(prices.size()) - total_days);
-            return std::vector<float>(prices.begin() + start_idx, prices.end());
-        }
-        
-        // Generate dummy price data for testing
-        std::vector<float> prices;
-        for (int i = 0; i < total_days; ++i) {
-            prices.push_back(100.0f + i * 0.1f); // Simple increasing price
+        if (price_it == price_cache.end()) {
+            // Generate dummy price data for testing
+            price_it = price_cache.emplace(source, IndicatorPlanner::placeholder_prices(total_days)).first;
         }
-        price_cache[source] = prices;
-        return prices;
+        return IndicatorCache::tail(price_it->second, days);
     }
     
-    // For SMA indicator
-    if (indicator_type == \"Simple Moving Average of Price\") {
-        int period = 20; // Default period
-        if (indicator_def.contains(\"period\")) {
-            period = std::stoi(indicator_def[\"period\"].get<std::string>());
+    // Indicators over prices; IndicatorPlanner normally precomputed these before the run
+    if (auto spec = IndicatorPlanner::batch_spec(indicator_type, operand.period)) {
+        // Check cache first
+        const auto cache_key = IndicatorKey::of(source, *spec);
+        if (auto cached = indicator_cache.find(cache_key, days)) {
+            return *cached;
         }
         
-        // Get price data
+        // Get exactly the price history total_days values need
+        Operand price_operand;
+        price_operand.indicator = "current price";
+        price_operand.source = source;
         auto price_data = get_indicator_value(
-            {{\"indicator\", \"current price\"}, {\"source\", source}},
-            date_range, total_days + period, indicator_cache, price_cache, live_execution
+            price_operand, date_range, IndicatorPlanner::lookback(indicator_type, operand.period, total_days),
+            indicator_cache, price_cache, live_execution, storage
         );
         
-        // Calculate SMA
-        std::vector<float> sma_values;
-        for (size_t i = period - 1; i < price_data.size(); ++i) {
-            float sum = 0.0f;
-            for (int j = 0; j < period; ++j) {
-                sum += price_data[i - j];
-            }
-            sma_values.push_back(sum / period);
+        // Calculate the indicator
+        std::vector<float> values;
+        if (price_data.size() > static_cast<size_t>(IndicatorPlanner::warmup(*spec))) {
+            values = IndicatorPlanner::compute(*spec, price_data);
         }
         
-        // Cache the result
-        indicator_cache[cache_key] = sma_values;
-        
-        // Return the last total_days values
-        int start_idx = std::max(0, static_cast<int>(sma_values.size()) - total_days);
-        return std::vector<float>(sma_values.begin() + start_idx, sma_values.end());
+        // Cache the result and return its last total_days values
+        return indicator_cache.insert(cache_key, std::move(values), days);
     }
     
     // For unsupported indicators, return dummy data
-    std::vector<float> dummy_values;
-    for (int i = 0; i < total_days; ++i) {
-        dummy_values.push_back(50.0f); // Dummy value
-    }
-    return dummy_values;
+    storage.assign(days, 50.0f); // Dummy value
+    return storage;
 }
 
-std::vector<bool> ConditionalNodeProcessor::compare_values(
-    const std::vector<float>& x,
-    const std::vector<float>& y,
-    const std::string& comparison_str
+ActiveMask ConditionalNodeProcessor::compare_values(
+    std::span<const float> x,
+    std::span<const float> y,
+    ComparisonOperator op,
+    ActiveMask::allocator_type alloc
 ) {
     if (x.size() != y.size()) {
-        throw ConditionEvalError(\"Vector lengths must match for comparison\");
+        throw ConditionEvalError("Vector lengths must match for comparison");
     }
     
-    auto op = parse_comparison_operator(comparison_str);
-    std::vector<bool> result;
-    result.reserve(x.size());
+    ActiveMask result(x.size(), false, alloc);
     
     for (size_t i = 0; i < x.size(); ++i) {
         bool comparison_result = false;
@@ -338,57 +380,64 @@ std::vector<bool> ConditionalNodeProcessor::compare_values(
                 break;
         }
         
-        result.push_back(comparison_result);
+        if (comparison_result) {
+            result.set(i);
+        }
     }
     
     return result;
 }
 
 ComparisonOperator ConditionalNodeProcessor::parse_comparison_operator(const std::string& comparison_str) {
-    if (comparison_str == \">\") return ComparisonOperator::GREATER_THAN;
-    if (comparison_str == \"<\") return ComparisonOperator::LESS_THAN;
-    if (comparison_str == \"==\" || comparison_str == \"=\") return ComparisonOperator::EQUAL;
-    if (comparison_str == \">=\") return ComparisonOperator::GREATER_EQUAL;
-    if (comparison_str == \"<=\") return ComparisonOperator::LESS_EQUAL;
-    if (comparison_str == \"!=\" || comparison_str == \"<>\") return ComparisonOperator::NOT_EQUAL;
+    if (comparison_str == ">") return ComparisonOperator::GREATER_THAN;
+    if (comparison_str == "<") return ComparisonOperator::LESS_THAN;
+    if (comparison_str == "==" || comparison_str == "=") return ComparisonOperator::EQUAL;
+    if (comparison_str == ">=") return ComparisonOperator::GREATER_EQUAL;
+    if (comparison_str == "<=") return ComparisonOperator::LESS_EQUAL;
+    if (comparison_str == "!=" || comparison_str == "<>") return ComparisonOperator::NOT_EQUAL;
     
-    throw ConditionEvalError(\"Invalid comparison operator: \" + comparison_str);
+    throw ConditionEvalError("Invalid comparison operator: " + comparison_str);
 }
 
-void ConditionalNodeProcessor::align_indicator_lengths(std::vector<float>& x, std::vector<float>& y) {
-    if (x.size() == y.size()) {
-        return;
-    }
-    
-    if (x.size() > y.size()) {
-        // Truncate x to match y's length
-        int start_idx = static_cast<int>(x.size()) - static_cast<int>(y.size());
-        x = std::vector<float>(x.begin() + start_idx, x.end());
-    } else {
-        // Truncate y to match x's length
-        int start_idx = static_cast<int>(y.size()) - static_cast<int>(x.size());
-        y = std::vector<float>(y.begin() + start_idx, y.end());
-    }
+void ConditionalNodeProcessor::align_indicator_lengths(std::span<const float>& x, std::span<const float>& y) {
+    // Both views end on the last day; keep the most recent values of the longer one
+    const size_t length = std::min(x.size(), y.size());
+    x = x.last(length);
+    y = y.last(length);
 }
 
 void ConditionalNodeProcessor::extract_branches(
     const StrategyNode& node,
-    std::vector<StrategyNode>& true_branch,
-    std::vector<StrategyNode>& false_branch
+    const Strategy& strategy,
+    std::deque<StrategyNode>& storage,
+    std::vector<const StrategyNode*>& true_branch,
+    std::vector<const StrategyNode*>& false_branch
 ) {
+    // Walk the parsed graph when the node is part of it
+    const GraphNode* graph_node = (strategy.graph && !node.hash.empty()) ? strategy.graph->find(node.hash) : nullptr;
+    if (graph_node) {
+        for (const auto* branch_node : graph_node->branch("true")) {
+            true_branch.push_back(branch_node->source);
+        }
+        for (const auto* branch_node : graph_node->branch("false")) {
+            false_branch.push_back(branch_node->source);
+        }
+        return;
+    }
+    
     // Extract true branch
-    if (node.branches.contains(\"true\") && node.branches[\"true\"].is_array()) {
-        for (const auto& branch_node_json : node.branches[\"true\"]) {
-            true_branch.emplace_back(branch_node_json);
+    if (node.branches.contains("true") && node.branches["true"].is_array()) {
+        for (const auto& branch_node_json : node.branches["true"]) {
+            true_branch.push_back(&storage.emplace_back(branch_node_json));
         }
     }
     
     // Extract false branch
-    if (node.branches.contains(\"false\") && node.branches[\"false\"].is_array()) {
-        for (const auto& branch_node_json : node.branches[\"false\"]) {
-            false_branch.emplace_back(branch_node_json);
+    if (node.branches.contains("false") && node.branches["false"].is_array()) {
+        for (const auto& branch_node_json : node.branches["false"]) {
+            false_branch.push_back(&storage.emplace_back(branch_node_json));
         }
     }
 }
 
-} // namespace atlas", "original_text": "", "replace_all": false}]
\ No newline at end of file
+} // namespace atlas
\ No newline at end of file
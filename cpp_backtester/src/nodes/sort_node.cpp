@@ -1,4 +1,5 @@
-#include \"sort_node.h\"
+#include "sort_node.h"
+#include "ta_kernels.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -12,10 +13,32 @@ NodeResult SortNodeProcessor::process(
     int total_days,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
+    std::unordered_map<std::string, std::vector<float>>& price_cache,
+    const Strategy& strategy,
+    bool live_execution,
+    int global_cache_length
+) {
+    return process(
+        node, ActiveMask::from_bools(active_mask), total_days, node_weight, portfolio_history,
+        date_range, flow_count, flow_stocks, indicator_cache, price_cache, strategy,
+        live_execution, global_cache_length
+    );
+}
+
+NodeResult SortNodeProcessor::process(
+    const StrategyNode& node,
+    const ActiveMask& active_mask,
+    int total_days,
+    float node_weight,
+    std::vector<DayData>& portfolio_history,
+    std::span<const int32_t> date_range,
+    std::unordered_map<std::string, int>& flow_count,
+    std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution,
@@ -24,26 +47,33 @@ NodeResult SortNodeProcessor::process(
     try {
         // Validate sort node
         if (!validate_sort_node(node)) {
-            return NodeResult(0, false, \"Invalid sort node structure\");
+            return NodeResult(0, false, "Invalid sort node structure");
         }
         
-        // Parse properties
+        // Use the parsed spec when available, otherwise parse properties
         SelectFunction select_function;
         int selection_count;
-        if (!parse_select_properties(node.properties, select_function, selection_count)) {
-            return NodeResult(0, false, \"Invalid selection properties\");
-        }
-        
         SortFunction sort_function;
         int sort_window;
-        if (!parse_sort_properties(node.properties, sort_function, sort_window)) {
-            return NodeResult(0, false, \"Invalid sort properties\");
+        if (const auto* spec = std::get_if<SortSpec>(&node.spec)) {
+            select_function = spec->select_function;
+            selection_count = spec->selection_count;
+            sort_function = spec->sort_function;
+            sort_window = spec->window;
+        } else {
+            if (!parse_select_properties(node.properties, select_function, selection_count)) {
+                return NodeResult(0, false, "Invalid selection properties");
+            }
+            
+            if (!parse_sort_properties(node.properties, sort_function, sort_window)) {
+                return NodeResult(0, false, "Invalid sort properties");
+            }
         }
         
         // Get branches
         auto [branches, has_folder_node] = get_branches(node);
         if (branches.empty()) {
-            return NodeResult(0, false, \"Sort node has no branches\");
+            return NodeResult(0, false, "Sort node has no branches");
         }
         
         // Get branch keys
@@ -53,28 +83,23 @@ NodeResult SortNodeProcessor::process(
         }
         
         if (selection_count > static_cast<int>(branch_keys.size())) {
-            return NodeResult(0, false, \"Selection count exceeds available branches\");
+            return NodeResult(0, false, "Selection count exceeds available branches");
         }
         
         // Adjust total_days based on sort function requirements
         int original_total_days = total_days;
         bool uses_delta = (sort_function == SortFunction::STANDARD_DEVIATION_RETURN ||
-                          sort_function == SortFunction::MOVING_AVERAGE_RETURN);
+                          sort_function == SortFunction::MOVING_AVERAGE_RETURN ||
+                          sort_function == SortFunction::CUMULATIVE_RETURN);
         bool pad_252_days = (sort_function == SortFunction::RELATIVE_STRENGTH_INDEX ||
                              sort_function == SortFunction::EXPONENTIAL_MOVING_AVERAGE);
         
+        ActiveMaskView sort_mask = active_mask.view();
         if (has_folder_node) {
             total_days += sort_window + (uses_delta ? 1 : 0) + (pad_252_days ? 252 : 0);
-            // Update active mask accordingly
-            std::vector<bool> new_active_mask(total_days, true);
-            int offset = std::max(0, static_cast<int>(new_active_mask.size()) - static_cast<int>(active_mask.size()));
-            for (size_t i = 0; i < active_mask.size(); ++i) {
-                size_t new_idx = offset + i;
-                if (new_idx < new_active_mask.size()) {
-                    new_active_mask[new_idx] = active_mask[i];
-                }
-            }
-            active_mask = new_active_mask;
+            // Pad the front of the mask with active days without copying it
+            int offset = std::max(0, total_days - static_cast<int>(active_mask.size()));
+            sort_mask = active_mask.view(-offset, total_days, true);
         }
         
         // Process branches
@@ -92,7 +117,7 @@ NodeResult SortNodeProcessor::process(
         
         // Calculate selection indices
         auto selection_indices = calculate_selection_indices(
-            branch_metrics, active_mask, common_data_span, select_function,
+            branch_metrics, sort_mask, common_data_span, select_function,
             selection_count, node, flow_count
         );
         
@@ -110,36 +135,36 @@ NodeResult SortNodeProcessor::process(
         return NodeResult(common_data_span, true);
         
     } catch (const std::exception& e) {
-        return NodeResult(0, false, \"Sort node error: \" + std::string(e.what()));
+        return NodeResult(0, false, "Sort node error: " + std::string(e.what()));
     }
 }
 
 bool SortNodeProcessor::validate_sort_node(const StrategyNode& node) const {
     // Must have branches
-    if (!node.branches.contains(\"branches\") && node.branches.empty()) {
+    if (!node.branches.contains("branches") && node.branches.empty()) {
         return false;
     }
     
     // Must have select and sortby properties
-    return node.properties.contains(\"select\") && node.properties.contains(\"sortby\");
+    return node.properties.contains("select") && node.properties.contains("sortby");
 }
 
 bool SortNodeProcessor::parse_select_properties(
     const nlohmann::json& properties,
     SelectFunction& select_function,
     int& selection_count
-) const {
-    if (!properties.contains(\"select\")) {
+) {
+    if (!properties.contains("select")) {
         return false;
     }
     
-    auto select_obj = properties[\"select\"];
-    if (!select_obj.contains(\"function\") || !select_obj.contains(\"howmany\")) {
+    auto select_obj = properties["select"];
+    if (!select_obj.contains("function") || !select_obj.contains("howmany")) {
         return false;
     }
     
     // Parse select function
-    std::string function_str = select_obj[\"function\"].get<std::string>();
+    std::string function_str = select_obj["function"].get<std::string>();
     try {
         select_function = parse_select_function(function_str);
     } catch (...) {
@@ -148,7 +173,7 @@ bool SortNodeProcessor::parse_select_properties(
     
     // Parse selection count
     try {
-        selection_count = std::stoi(select_obj[\"howmany\"].get<std::string>());
+        selection_count = std::stoi(select_obj["howmany"].get<std::string>());
     } catch (...) {
         return false;
     }
@@ -160,18 +185,18 @@ bool SortNodeProcessor::parse_sort_properties(
     const nlohmann::json& properties,
     SortFunction& sort_function,
     int& sort_window
-) const {
-    if (!properties.contains(\"sortby\")) {
+) {
+    if (!properties.contains("sortby")) {
         return false;
     }
     
-    auto sortby_obj = properties[\"sortby\"];
-    if (!sortby_obj.contains(\"function\")) {
+    auto sortby_obj = properties["sortby"];
+    if (!sortby_obj.contains("function")) {
         return false;
     }
     
     // Parse sort function
-    std::string function_str = sortby_obj[\"function\"].get<std::string>();
+    std::string function_str = sortby_obj["function"].get<std::string>();
     try {
         sort_function = parse_sort_function(function_str);
     } catch (...) {
@@ -180,15 +205,15 @@ bool SortNodeProcessor::parse_sort_properties(
     
     // Parse sort window (default to 20 if not specified)
     sort_window = 20;
-    if (sortby_obj.contains(\"window\")) {
+    if (sortby_obj.contains("window")) {
         try {
-            sort_window = std::stoi(sortby_obj[\"window\"].get<std::string>());
+            sort_window = std::stoi(sortby_obj["window"].get<std::string>());
         } catch (...) {
             // Use default
         }
-    } else if (sortby_obj.contains(\"period\")) {
+    } else if (sortby_obj.contains("period")) {
         try {
-            sort_window = std::stoi(sortby_obj[\"period\"].get<std::string>());
+            sort_window = std::stoi(sortby_obj["period"].get<std::string>());
         } catch (...) {
             // Use default
         }
@@ -202,10 +227,10 @@ std::tuple<std::vector<std::vector<DayData>>, int> SortNodeProcessor::process_br
     const std::vector<std::string>& branch_keys,
     int total_days,
     float node_weight,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution,
@@ -218,12 +243,12 @@ std::tuple<std::vector<std::vector<DayData>>, int> SortNodeProcessor::process_br
     
     for (const auto& branch_key : branch_keys) {
         if (!branches.contains(branch_key)) {
-            throw SortNodeError(\"Branch key not found: \" + branch_key);
+            throw SortNodeError("Branch key not found: " + branch_key);
         }
         
-        auto branch_nodes = branches[branch_key];
+        const auto& branch_nodes = branches[branch_key];
         if (!branch_nodes.is_array() || branch_nodes.empty()) {
-            throw SortNodeError(\"Empty branch: \" + branch_key);
+            throw SortNodeError("Empty branch: " + branch_key);
         }
         
         // Initialize portfolio for this branch
@@ -231,11 +256,12 @@ std::tuple<std::vector<std::vector<DayData>>, int> SortNodeProcessor::process_br
         
         // For simplicity, we'll process the first node in each branch
         // In a complete implementation, this would process all nodes in the branch
-        auto first_node = StrategyNode(branch_nodes[0]);
+        const auto& first_node = branch_nodes[0];
         
         // Process stock nodes directly (simplified implementation)
-        if (first_node.type == \"stock\" && first_node.properties.contains(\"symbol\")) {
-            std::string symbol = first_node.properties[\"symbol\"].get<std::string>();
+        if (first_node.value("type", std::string()) == "stock" &&
+            first_node.contains("properties") && first_node["properties"].contains("symbol")) {
+            std::string symbol = first_node["properties"]["symbol"].get<std::string>();
             
             // Add stock to all days for this branch
             for (auto& day : branch_portfolio) {
@@ -251,11 +277,11 @@ std::tuple<std::vector<std::vector<DayData>>, int> SortNodeProcessor::process_br
 }
 
 std::vector<std::vector<float>> SortNodeProcessor::calculate_branch_metrics(
-    const std::vector<std::vector<DayData>>& temp_portfolio_vectors,
-    const std::vector<std::string>& date_range,
+    std::span<const std::vector<DayData>> temp_portfolio_vectors,
+    std::span<const int32_t> date_range,
     SortFunction sort_function,
     int sort_window,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     bool live_execution
 ) {
@@ -286,6 +312,16 @@ std::vector<std::vector<float>> SortNodeProcessor::calculate_branch_metrics(
                 metrics = calculate_portfolio_returns(branch_portfolio, price_cache);
                 break;
             }
+            case SortFunction::CUMULATIVE_RETURN: {
+                auto returns = calculate_portfolio_returns(branch_portfolio, price_cache);
+                metrics = calculate_cumulative_return(returns, sort_window);
+                break;
+            }
+            case SortFunction::MAX_DRAWDOWN: {
+                auto returns = calculate_portfolio_returns(branch_portfolio, price_cache);
+                metrics = calculate_max_drawdown(returns, sort_window);
+                break;
+            }
             default: {
                 // For unsupported functions, use dummy values
                 metrics.resize(branch_portfolio.size(), 0.0f);
@@ -307,74 +343,46 @@ std::vector<std::vector<float>> SortNodeProcessor::calculate_branch_metrics(
     return branch_metrics;
 }
 
-std::vector<std::vector<int>> SortNodeProcessor::calculate_selection_indices(
+SelectionMatrix SortNodeProcessor::calculate_selection_indices(
     const std::vector<std::vector<float>>& branch_metrics,
-    const std::vector<bool>& active_mask,
+    const ActiveMaskView& active_mask,
     int data_span,
     SelectFunction select_function,
     int selection_count,
     const StrategyNode& node,
     std::unordered_map<std::string, int>& flow_count
 ) {
-    std::vector<std::vector<int>> selection_indices(data_span);
+    const size_t k = std::min(static_cast<size_t>(std::max(selection_count, 0)), branch_metrics.size());
+    SelectionMatrix selection_indices(data_span, k);
     
-    // Find active days
-    std::vector<int> active_days;
-    int start_offset = std::max(0, static_cast<int>(active_mask.size()) - data_span);
-    for (int i = 0; i < data_span; ++i) {
-        int mask_idx = start_offset + i;
-        if (mask_idx < static_cast<int>(active_mask.size()) && active_mask[mask_idx]) {
-            active_days.push_back(i);
-        }
-    }
+    const bool descending = (select_function == SelectFunction::TOP);
+    std::vector<uint64_t> keys(branch_metrics.size());
     
-    for (int day : active_days) {
+    int start_offset = std::max(0, static_cast<int>(active_mask.size()) - data_span);
+    active_mask.subview(start_offset, data_span).for_each_set([&](size_t day) {
         // Increment flow count
         if (!node.hash.empty()) {
             increment_flow_count(flow_count, node.hash);
         }
         
-        // Get metrics for this day from all branches
-        std::vector<std::pair<float, int>> day_metrics;
+        // Rank this day's metric of every branch that covers it
+        size_t n = 0;
         for (size_t branch_idx = 0; branch_idx < branch_metrics.size(); ++branch_idx) {
-            if (day < static_cast<int>(branch_metrics[branch_idx].size())) {
-                float metric = branch_metrics[branch_idx][day];
-                // Handle NaN and Inf
-                if (std::isnan(metric) || std::isinf(metric)) {
-                    metric = 0.0f;
-                }
-                day_metrics.emplace_back(metric, static_cast<int>(branch_idx));
+            if (day < branch_metrics[branch_idx].size()) {
+                keys[n++] = selection_key(branch_metrics[branch_idx][day], static_cast<uint32_t>(branch_idx), descending);
             }
         }
         
-        // Sort based on select function
-        if (select_function == SelectFunction::TOP) {
-            // Sort in descending order (highest first)
-            std::sort(day_metrics.begin(), day_metrics.end(), 
-                     [](const auto& a, const auto& b) { return a.first > b.first; });
-        } else {
-            // Sort in ascending order (lowest first)
-            std::sort(day_metrics.begin(), day_metrics.end(), 
-                     [](const auto& a, const auto& b) { return a.first < b.first; });
-        }
-        
-        // Select top selection_count indices
-        std::vector<int> selected_indices;
-        int count = std::min(selection_count, static_cast<int>(day_metrics.size()));
-        for (int i = 0; i < count; ++i) {
-            selected_indices.push_back(day_metrics[i].second);
-        }
-        
-        selection_indices[day] = selected_indices;
-    }
+        selection_indices.set_count(day, select_top_k(keys.data(), n, k, selection_indices.row_data(day)));
+    });
     
     return selection_indices;
 }
 
 void SortNodeProcessor::update_portfolio_history(
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::vector<DayData>>& temp_portfolio_vectors,
-    const std::vector<std::vector<int>>& selection_indices,
+    std::span<const std::vector<DayData>> temp_portfolio_vectors,
+    const SelectionMatrix& selection_indices,
     float node_weight,
     int common_data_span,
     int selection_count
@@ -399,7 +407,7 @@ void SortNodeProcessor::update_portfolio_history(
             for (const auto& stock : branch_day.stock_list()) {
                 // Adjust weight
                 float adjusted_weight = stock.weight_tomorrow() / selection_count * node_weight;
-                portfolio_history[portfolio_idx].add_stock(StockInfo(stock.ticker(), adjusted_weight));
+                portfolio_history[portfolio_idx].add_stock(StockInfo(stock.ticker_id(), adjusted_weight));
             }
         }
     }
@@ -408,74 +416,67 @@ void SortNodeProcessor::update_portfolio_history(
 // Utility function implementations
 std::vector<float> SortNodeProcessor::calculate_rsi(const std::vector<float>& prices, int period) {
     std::vector<float> rsi_values;
-    if (prices.size() < static_cast<size_t>(period + 1)) {
+    if (period < 1 || prices.size() < static_cast<size_t>(period + 1)) {
         rsi_values.resize(prices.size(), 50.0f); // Default RSI
         return rsi_values;
     }
     
-    std::vector<float> gains, losses;
-    
-    // Calculate price changes
-    for (size_t i = 1; i < prices.size(); ++i) {
-        float change = prices[i] - prices[i-1];
-        gains.push_back(change > 0 ? change : 0);
-        losses.push_back(change < 0 ? -change : 0);
-    }
+    const size_t count = prices.size() - period;
+    std::vector<float> avg_gain(count), avg_loss(count);
+    ta::wilder_averages(prices.data(), prices.size(), period, avg_gain.data(), avg_loss.data());
     
-    // Calculate initial averages
-    float avg_gain = 0, avg_loss = 0;
-    for (int i = 0; i < period; ++i) {
-        avg_gain += gains[i];
-        avg_loss += losses[i];
-    }
-    avg_gain /= period;
-    avg_loss /= period;
-    
-    // Calculate RSI
+    // Calculate RSI from the first smoothed average on; avg_gain[k] belongs to price index period + k
     rsi_values.resize(prices.size(), 50.0f);
     
-    for (size_t i = period; i < gains.size(); ++i) {
-        avg_gain = (avg_gain * (period - 1) + gains[i]) / period;
-        avg_loss = (avg_loss * (period - 1) + losses[i]) / period;
-        
-        float rs = (avg_loss == 0) ? 100 : avg_gain / avg_loss;
+    for (size_t k = 1; k < count; ++k) {
+        float rs = (avg_loss[k] == 0) ? 100 : avg_gain[k] / avg_loss[k];
         float rsi = 100 - (100 / (1 + rs));
         
-        rsi_values[i + 1] = rsi;
+        rsi_values[period + k] = rsi;
     }
     
     return rsi_values;
 }
 
 std::vector<float> SortNodeProcessor::calculate_sma(const std::vector<float>& values, int period) {
-    std::vector<float> sma_values;
+    // Not enough data for a full window: use the original values
+    std::vector<float> sma_values(values);
     
-    for (size_t i = 0; i < values.size(); ++i) {
-        if (i < static_cast<size_t>(period - 1)) {
-            sma_values.push_back(values[i]); // Not enough data, use original value
-        } else {
-            float sum = 0;
-            for (int j = 0; j < period; ++j) {
-                sum += values[i - j];
-            }
-            sma_values.push_back(sum / period);
-        }
+    if (period >= 1 && values.size() >= static_cast<size_t>(period)) {
+        ta::rolling_mean(values.data(), values.size(), period, sma_values.data() + period - 1);
     }
     
     return sma_values;
 }
 
+std::vector<float> SortNodeProcessor::calculate_cumulative_return(const std::vector<float>& values, int period) {
+    // Days without a full window score 0
+    std::vector<float> return_values(values.size(), 0.0f);
+    
+    if (period >= 1 && values.size() > static_cast<size_t>(period)) {
+        ta::cumulative_return(values.data(), values.size(), period, return_values.data() + period);
+    }
+    
+    return return_values;
+}
+
+std::vector<float> SortNodeProcessor::calculate_max_drawdown(const std::vector<float>& values, int period) {
+    std::vector<float> drawdown_values(values.size(), 0.0f);
+    
+    if (period >= 1 && values.size() >= static_cast<size_t>(period)) {
+        ta::rolling_max_drawdown(values.data(), values.size(), period, drawdown_values.data() + period - 1);
+    }
+    
+    return drawdown_values;
+}
+
 std::vector<float> SortNodeProcessor::calculate_ema(const std::vector<float>& values, int period) {
-    std::vector<float> ema_values;
+    std::vector<float> ema_values(values.size());
     if (values.empty()) return ema_values;
     
     float multiplier = 2.0f / (period + 1);
-    ema_values.push_back(values[0]); // First value is the seed
-    
-    for (size_t i = 1; i < values.size(); ++i) {
-        float ema = (values[i] * multiplier) + (ema_values[i-1] * (1 - multiplier));
-        ema_values.push_back(ema);
-    }
+    ema_values[0] = values[0]; // First value is the seed
+    ta::ema(values.data() + 1, values.size() - 1, multiplier, values[0], ema_values.data() + 1);
     
     return ema_values;
 }
@@ -503,32 +504,34 @@ std::vector<float> SortNodeProcessor::calculate_portfolio_returns(
 }
 
 SortFunction SortNodeProcessor::parse_sort_function(const std::string& sort_function_str) {
-    if (sort_function_str == \"Relative Strength Index\") return SortFunction::RELATIVE_STRENGTH_INDEX;
-    if (sort_function_str == \"Simple Moving Average of Price\") return SortFunction::SIMPLE_MOVING_AVERAGE;
-    if (sort_function_str == \"Exponential Moving Average of Price\") return SortFunction::EXPONENTIAL_MOVING_AVERAGE;
-    if (sort_function_str == \"Standard Deviation of Return\") return SortFunction::STANDARD_DEVIATION_RETURN;
-    if (sort_function_str == \"Moving Average of Return\") return SortFunction::MOVING_AVERAGE_RETURN;
-    if (sort_function_str == \"current price\") return SortFunction::CURRENT_PRICE;
-    if (sort_function_str == \"Portfolio Return\") return SortFunction::PORTFOLIO_RETURN;
-    
-    throw SortNodeError(\"Invalid sort function: \" + sort_function_str);
+    if (sort_function_str == "Relative Strength Index") return SortFunction::RELATIVE_STRENGTH_INDEX;
+    if (sort_function_str == "Simple Moving Average of Price") return SortFunction::SIMPLE_MOVING_AVERAGE;
+    if (sort_function_str == "Exponential Moving Average of Price") return SortFunction::EXPONENTIAL_MOVING_AVERAGE;
+    if (sort_function_str == "Standard Deviation of Return") return SortFunction::STANDARD_DEVIATION_RETURN;
+    if (sort_function_str == "Moving Average of Return") return SortFunction::MOVING_AVERAGE_RETURN;
+    if (sort_function_str == "current price") return SortFunction::CURRENT_PRICE;
+    if (sort_function_str == "Portfolio Return") return SortFunction::PORTFOLIO_RETURN;
+    if (sort_function_str == "Cumulative Return") return SortFunction::CUMULATIVE_RETURN;
+    if (sort_function_str == "Max Drawdown") return SortFunction::MAX_DRAWDOWN;
+    
+    throw SortNodeError("Invalid sort function: " + sort_function_str);
 }
 
 SelectFunction SortNodeProcessor::parse_select_function(const std::string& select_function_str) {
-    if (select_function_str == \"Top\") return SelectFunction::TOP;
-    if (select_function_str == \"Bottom\") return SelectFunction::BOTTOM;
+    if (select_function_str == "Top") return SelectFunction::TOP;
+    if (select_function_str == "Bottom") return SelectFunction::BOTTOM;
     
-    throw SortNodeError(\"Invalid select function: \" + select_function_str);
+    throw SortNodeError("Invalid select function: " + select_function_str);
 }
 
-std::pair<nlohmann::json, bool> SortNodeProcessor::get_branches(const StrategyNode& node) {
+std::pair<const nlohmann::json&, bool> SortNodeProcessor::get_branches(const StrategyNode& node) {
     // Check if node has branches property
-    if (node.branches.contains(\"branches\")) {
-        return std::make_pair(node.branches[\"branches\"], true);
+    if (node.branches.contains("branches")) {
+        return {node.branches["branches"], true};
     }
     
     // Otherwise use the branches directly
-    return std::make_pair(node.branches, false);
+    return {node.branches, false};
 }
 
-} // namespace atlas", "original_text": "", "replace_all": false}]
\ No newline at end of file
+} // namespace atlas
\ No newline at end of file
@@ -1,4 +1,4 @@
-#include \"stock_node.h\"
+#include "stock_node.h"
 #include <algorithm>
 #include <stdexcept>
 
@@ -10,10 +10,10 @@ NodeResult StockNodeProcessor::process(
     int total_days,
     float node_weight,
     std::vector<DayData>& portfolio_history,
-    const std::vector<std::string>& date_range,
+    std::span<const int32_t> date_range,
     std::unordered_map<std::string, int>& flow_count,
     std::unordered_map<std::string, std::vector<DayData>>& flow_stocks,
-    std::unordered_map<std::string, std::vector<float>>& indicator_cache,
+    IndicatorCache& indicator_cache,
     std::unordered_map<std::string, std::vector<float>>& price_cache,
     const Strategy& strategy,
     bool live_execution,
@@ -22,16 +22,17 @@ NodeResult StockNodeProcessor::process(
     try {
         // Validate stock node
         if (!validate_stock_node(node)) {
-            return NodeResult(0, false, \"Invalid stock node structure\");
+            return NodeResult(0, false, "Invalid stock node structure");
         }
         
         // Validate inputs
         if (!validate_inputs(active_mask, total_days, node_weight, portfolio_history)) {
-            return NodeResult(0, false, \"Invalid input parameters\");
+            return NodeResult(0, false, "Invalid input parameters");
         }
         
-        // Extract symbol from properties
-        std::string symbol = node.properties[\"symbol\"].get<std::string>();
+        // Extract symbol from the parsed spec, falling back to properties
+        const auto* spec = std::get_if<StockSpec>(&node.spec);
+        std::string symbol = spec != nullptr ? spec->symbol : node.properties["symbol"].get<std::string>();
         
         // Find active days
         auto active_days = find_active_days(active_mask);
@@ -52,27 +53,31 @@ NodeResult StockNodeProcessor::process(
         return NodeResult(total_days, true);
         
     } catch (const std::exception& e) {
-        return NodeResult(0, false, \"Stock node processing error: \" + std::string(e.what()));
+        return NodeResult(0, false, "Stock node processing error: " + std::string(e.what()));
     }
 }
 
 bool StockNodeProcessor::validate_stock_node(const StrategyNode& node) const {
+    if (const auto* spec = std::get_if<StockSpec>(&node.spec)) {
+        return !spec->symbol.empty();
+    }
+    
     // Must have properties
     if (node.properties.empty()) {
         return false;
     }
     
     // Must have symbol in properties
-    if (!node.properties.contains(\"symbol\")) {
+    if (!node.properties.contains("symbol")) {
         return false;
     }
     
     // Symbol must be a non-empty string
-    if (!node.properties[\"symbol\"].is_string()) {
+    if (!node.properties["symbol"].is_string()) {
         return false;
     }
     
-    std::string symbol = node.properties[\"symbol\"].get<std::string>();
+    std::string symbol = node.properties["symbol"].get<std::string>();
     if (symbol.empty()) {
         return false;
     }
@@ -127,7 +132,7 @@ void StockNodeProcessor::update_portfolio(
         
         // Validate index
         if (portfolio_idx < 0 || portfolio_idx >= static_cast<int>(portfolio_history.size())) {
-            throw std::runtime_error(\"Invalid portfolio index: \" + std::to_string(portfolio_idx));
+            throw std::runtime_error("Invalid portfolio index: " + std::to_string(portfolio_idx));
         }
         
         // Add stock to portfolio
@@ -0,0 +1,411 @@
+#include "indicator_state.h"
+#include "ta_functions.h"
+#include "trading_calendar.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace atlas {
+
+namespace {
+
+constexpr float kNaN = std::numeric_limits<float>::quiet_NaN();
+constexpr float kEpsilon = 1e-8f;   // TAFunctions::EPSILON
+
+const char* kind_name(ta::IndicatorKind kind) {
+    switch (kind) {
+        case ta::IndicatorKind::SMA: return "sma";
+        case ta::IndicatorKind::EMA: return "ema";
+        case ta::IndicatorKind::RSI: return "rsi";
+        case ta::IndicatorKind::STANDARD_DEVIATION: return "sd";
+        case ta::IndicatorKind::RETURNS_STANDARD_DEVIATION: return "returns_sd";
+        case ta::IndicatorKind::CUMULATIVE_RETURN: return "cumulative_return";
+        case ta::IndicatorKind::MAX_DRAWDOWN: return "max_drawdown";
+    }
+    return "sma";
+}
+
+ta::IndicatorKind parse_kind(const std::string& name) {
+    for (auto kind : {ta::IndicatorKind::SMA, ta::IndicatorKind::EMA, ta::IndicatorKind::RSI,
+                      ta::IndicatorKind::STANDARD_DEVIATION, ta::IndicatorKind::RETURNS_STANDARD_DEVIATION}) {
+        if (name == kind_name(kind)) {
+            return kind;
+        }
+    }
+    throw TAFunctionsError("Unknown indicator state kind: " + name);
+}
+
+// JSON has no NaN; nlohmann writes it as null
+float read_float(const nlohmann::json& value) {
+    return value.is_number() ? value.get<float>() : kNaN;
+}
+
+bool is_rolling(ta::IndicatorKind kind) {
+    return kind == ta::IndicatorKind::SMA || kind == ta::IndicatorKind::STANDARD_DEVIATION ||
+           kind == ta::IndicatorKind::RETURNS_STANDARD_DEVIATION;
+}
+
+} // namespace
+
+// IndicatorState implementation
+
+IndicatorState::IndicatorState(ta::IndicatorKind kind, int period)
+    : kind_(kind), period_(period) {
+    const int min_period = kind == ta::IndicatorKind::RETURNS_STANDARD_DEVIATION ? 2 : 1;
+    if (period < min_period) {
+        throw TAFunctionsError("Invalid period " + std::to_string(period) + " for indicator state");
+    }
+    if (kind == ta::IndicatorKind::CUMULATIVE_RETURN || kind == ta::IndicatorKind::MAX_DRAWDOWN) {
+        throw TAFunctionsError(std::string("No incremental state for ") + kind_name(kind));
+    }
+    if (is_rolling(kind)) {
+        window_.assign(static_cast<size_t>(period), 0.0f);
+    }
+    core_.value = kNaN;
+}
+
+float IndicatorState::push(float price) {
+    undo_core_ = core_;
+    undo_head_ = head_;
+    undo_wrote_slot_ = false;
+    core_.value = roll(price);
+    return core_.value;
+}
+
+float IndicatorState::amend(float price) {
+    if (core_.bars == 0) {
+        return push(price);
+    }
+    core_ = undo_core_;
+    head_ = undo_head_;
+    if (undo_wrote_slot_) {
+        window_[head_] = undo_slot_;
+    }
+    return push(price);
+}
+
+void IndicatorState::roll_window(float y, uint64_t count) {
+    // count is the number of window inputs including y
+    const bool ok = std::isfinite(y);
+    if (count == 1) {
+        core_.shift = ok ? y : 0.0;
+    }
+
+    undo_slot_ = window_[head_];
+    undo_wrote_slot_ = true;
+    if (count > static_cast<uint64_t>(period_)) {
+        const float old = window_[head_];
+        if (std::isfinite(old)) {
+            core_.s1 -= old - core_.shift;
+            core_.s2 -= (old - core_.shift) * (old - core_.shift);
+        } else {
+            --core_.bad;
+        }
+    }
+
+    window_[head_] = y;
+    head_ = (head_ + 1) % static_cast<uint32_t>(period_);
+    if (ok) {
+        core_.s1 += y - core_.shift;
+        core_.s2 += (y - core_.shift) * (y - core_.shift);
+    } else {
+        ++core_.bad;
+    }
+
+    // Resum once per lap so rounding in the running sums cannot build up
+    if (head_ == 0) {
+        recompute_sums();
+    }
+}
+
+void IndicatorState::recompute_sums() {
+    core_.s1 = core_.s2 = 0.0;
+    core_.bad = 0;
+    for (float v : window_) {
+        if (std::isfinite(v)) {
+            core_.s1 += v - core_.shift;
+            core_.s2 += (v - core_.shift) * (v - core_.shift);
+        } else {
+            ++core_.bad;
+        }
+    }
+}
+
+float IndicatorState::roll(float x) {
+    const uint64_t n = ++core_.bars;
+    const uint64_t p = static_cast<uint64_t>(period_);
+
+    switch (kind_) {
+        case ta::IndicatorKind::SMA:
+        case ta::IndicatorKind::STANDARD_DEVIATION: {
+            roll_window(x, n);
+            if (n < p || core_.bad > 0) {
+                return kNaN;
+            }
+            if (kind_ == ta::IndicatorKind::SMA) {
+                return static_cast<float>(core_.shift + core_.s1 / period_);
+            }
+            const double variance = std::max(0.0, (core_.s2 - core_.s1 * core_.s1 / period_) / period_);
+            return static_cast<float>(std::sqrt(variance));
+        }
+
+        case ta::IndicatorKind::RETURNS_STANDARD_DEVIATION: {
+            const float prev = core_.last_price;
+            core_.last_price = x;
+            if (n == 1) {
+                return kNaN;
+            }
+            const float r = prev > kEpsilon ? 100.0f * (x - prev) / prev : 0.0f;
+            roll_window(r, n - 1);
+            if (n - 1 < p || core_.bad > 0) {
+                return kNaN;
+            }
+            const double variance = std::max(0.0, (core_.s2 - core_.s1 * core_.s1 / period_) / (period_ - 1));
+            return static_cast<float>(std::sqrt(variance) * 100.0);
+        }
+
+        case ta::IndicatorKind::EMA: {
+            if (n < p) {
+                core_.ema += x;
+                return kNaN;
+            }
+            if (n == p) {
+                core_.ema = (core_.ema + x) / period_;
+            } else {
+                const float multiplier = 2.0f / (period_ + 1.0f);
+                core_.ema = (x * multiplier) + (core_.ema * (1.0f - multiplier));
+            }
+            return core_.ema;
+        }
+
+        case ta::IndicatorKind::RSI: {
+            const float change = x - core_.last_price;
+            core_.last_price = x;
+            if (n == 1) {
+                return kNaN;
+            }
+            const float g = change > 0 ? change : 0.0f;
+            const float l = change > 0 ? 0.0f : -change;
+            const uint64_t changes = n - 1;
+            if (changes < p) {
+                core_.gain += g;
+                core_.loss += l;
+                return kNaN;
+            }
+            if (changes == p) {
+                core_.gain = (core_.gain + g) / period_;
+                core_.loss = (core_.loss + l) / period_;
+            } else {
+                core_.gain = TAFunctions::apply_wilders_smoothing(core_.gain, g, period_);
+                core_.loss = TAFunctions::apply_wilders_smoothing(core_.loss, l, period_);
+            }
+            return core_.loss > kEpsilon ? 100.0f - (100.0f / (1.0f + core_.gain / core_.loss)) : kNaN;
+        }
+
+        case ta::IndicatorKind::CUMULATIVE_RETURN:
+        case ta::IndicatorKind::MAX_DRAWDOWN:
+            break;  // Rejected by the constructor
+    }
+    return kNaN;
+}
+
+nlohmann::json IndicatorState::to_json() const {
+    auto core_json = [](const Core& core) {
+        return nlohmann::json{
+            {"bars", core.bars}, {"s1", core.s1}, {"s2", core.s2}, {"shift", core.shift},
+            {"bad", core.bad}, {"ema", core.ema}, {"gain", core.gain}, {"loss", core.loss},
+            {"last_price", core.last_price}, {"value", core.value}
+        };
+    };
+
+    return nlohmann::json{
+        {"kind", kind_name(kind_)},
+        {"period", period_},
+        {"core", core_json(core_)},
+        {"window", window_},
+        {"head", head_},
+        {"undo", {
+            {"core", core_json(undo_core_)},
+            {"head", undo_head_},
+            {"slot", undo_slot_},
+            {"wrote_slot", undo_wrote_slot_}
+        }}
+    };
+}
+
+IndicatorState IndicatorState::from_json(const nlohmann::json& json) {
+    auto read_core = [](const nlohmann::json& j) {
+        Core core;
+        core.bars = j.at("bars").get<uint64_t>();
+        core.s1 = j.at("s1").get<double>();
+        core.s2 = j.at("s2").get<double>();
+        core.shift = j.at("shift").get<double>();
+        core.bad = j.at("bad").get<int32_t>();
+        core.ema = read_float(j.at("ema"));
+        core.gain = read_float(j.at("gain"));
+        core.loss = read_float(j.at("loss"));
+        core.last_price = read_float(j.at("last_price"));
+        core.value = read_float(j.at("value"));
+        return core;
+    };
+
+    IndicatorState state(parse_kind(json.at("kind").get<std::string>()), json.at("period").get<int>());
+    state.core_ = read_core(json.at("core"));
+    if (!state.window_.empty()) {
+        const auto& window = json.at("window");
+        if (window.size() != state.window_.size()) {
+            throw TAFunctionsError("Indicator state window does not match its period");
+        }
+        for (size_t i = 0; i < window.size(); ++i) {
+            state.window_[i] = read_float(window[i]);
+        }
+        state.head_ = json.at("head").get<uint32_t>() % static_cast<uint32_t>(state.period_);
+    }
+
+    const auto& undo = json.at("undo");
+    state.undo_core_ = read_core(undo.at("core"));
+    state.undo_head_ = undo.at("head").get<uint32_t>();
+    state.undo_slot_ = read_float(undo.at("slot"));
+    state.undo_wrote_slot_ = undo.at("wrote_slot").get<bool>() && !state.window_.empty();
+    return state;
+}
+
+// IndicatorStateKey implementation
+
+std::string IndicatorStateKey::to_string() const {
+    return ticker + "|" + kind_name(kind) + "|" + std::to_string(period);
+}
+
+IndicatorStateKey IndicatorStateKey::parse(const std::string& text) {
+    const size_t period_sep = text.rfind('|');
+    const size_t kind_sep = period_sep == std::string::npos || period_sep == 0
+                                ? std::string::npos : text.rfind('|', period_sep - 1);
+    if (kind_sep == std::string::npos) {
+        throw TAFunctionsError("Malformed indicator state key: " + text);
+    }
+
+    IndicatorStateKey key;
+    key.ticker = text.substr(0, kind_sep);
+    key.kind = parse_kind(text.substr(kind_sep + 1, period_sep - kind_sep - 1));
+    key.period = std::stoi(text.substr(period_sep + 1));
+    return key;
+}
+
+size_t IndicatorStateKeyHash::operator()(const IndicatorStateKey& key) const {
+    size_t seed = std::hash<std::string>{}(key.ticker);
+    seed ^= std::hash<int>{}(static_cast<int>(key.kind)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<int>{}(key.period) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+// IndicatorStateStore implementation
+
+float IndicatorStateStore::advance(const IndicatorStateKey& key, const std::string& date, float price,
+                                   const HistoryFn& history, bool closed) {
+    const auto& calendar = TradingCalendar::nyse();
+    const int32_t day = TradingCalendar::parse(date);
+    if (!calendar.is_trading_day(day)) {
+        throw TAFunctionsError("Indicator state " + key.to_string() + " cannot advance to " + date +
+                               ", not a trading day");
+    }
+    const int32_t previous = calendar.previous_trading_day(day);
+
+    // State behind the previous session (unknown key, or bars missed): fetch
+    // history outside the lock, it may hit the data provider
+    auto behind = [&](const Entry& entry) {
+        return entry.last_date.empty() || TradingCalendar::parse(entry.last_date) < previous;
+    };
+    std::vector<float> closes;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end() || behind(it->second)) {
+            lock.unlock();
+            closes = history();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entries_.try_emplace(key, Entry{IndicatorState(key.kind, key.period), {}, {}, {}}).first->second;
+    if (behind(entry)) {
+        // Replay the missed closes, or reseed if history does not reach back
+        // to the state's last bar
+        const size_t missing = entry.last_date.empty()
+            ? closes.size() + 1
+            : static_cast<size_t>(calendar.trading_days_between(TradingCalendar::parse(entry.last_date), previous));
+        if (missing > closes.size()) {
+            entry.state = IndicatorState(key.kind, key.period);
+        }
+        for (size_t i = closes.size() - std::min(missing, closes.size()); i < closes.size(); ++i) {
+            entry.state.push(closes[i]);
+        }
+        entry.last_date = calendar.format(calendar.index_of(previous));
+    }
+
+    const int32_t last = TradingCalendar::parse(entry.last_date);
+    if (last > day) {
+        throw TAFunctionsError("Indicator state " + key.to_string() + " is at " + entry.last_date +
+                               ", cannot rewind to " + date);
+    }
+    if (last == day) {
+        // A correction of a closed bar, or a late quote for it
+        if (closed) {
+            return entry.state.amend(price);
+        }
+        IndicatorState quoted = entry.state;
+        return quoted.amend(price);
+    }
+
+    // day is the next session after the state's last bar
+    if (closed) {
+        entry.live_date.clear();
+        entry.last_date = date;
+        return entry.state.push(price);
+    }
+    if (entry.live_date == date) {
+        return entry.live.amend(price);
+    }
+    entry.live = entry.state;
+    entry.live_date = date;
+    return entry.live.push(price);
+}
+
+bool IndicatorStateStore::contains(const IndicatorStateKey& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.count(key) > 0;
+}
+
+size_t IndicatorStateStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void IndicatorStateStore::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+nlohmann::json IndicatorStateStore::to_json() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    nlohmann::json json = nlohmann::json::object();
+    for (const auto& [key, entry] : entries_) {
+        json[key.to_string()] = {{"date", entry.last_date}, {"state", entry.state.to_json()}};
+    }
+    return json;
+}
+
+void IndicatorStateStore::load_json(const nlohmann::json& json) {
+    std::unordered_map<IndicatorStateKey, Entry, IndicatorStateKeyHash> loaded;
+    for (auto& [text, value] : json.items()) {
+        loaded[IndicatorStateKey::parse(text)] =
+            Entry{IndicatorState::from_json(value.at("state")), value.at("date").get<std::string>(), {}, {}};
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [key, entry] : loaded) {
+        entries_[key] = std::move(entry);
+    }
+}
+
+} // namespace atlas
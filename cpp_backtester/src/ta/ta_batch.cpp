@@ -0,0 +1,384 @@
+#include "ta_batch.h"
+#include "ta_functions.h"
+#include "ta_kernels.h"
+#include "work_stealing_pool.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace atlas {
+namespace ta {
+
+namespace {
+
+constexpr size_t kRowAlignment = 16;   // Floats per 64-byte line
+constexpr size_t kBlockTickers = 64;   // Tickers per task; lane state stays in L1
+constexpr float kNaN = std::numeric_limits<float>::quiet_NaN();
+constexpr float kEpsilon = 1e-8f;      // TAFunctions::EPSILON
+
+#define ATLAS_INLINE inline __attribute__((always_inline))
+
+/**
+ * @brief One block of tickers [begin, end) of one indicator
+ * Lanes are independent, so every loop over l below vectorizes across tickers.
+ */
+struct Block {
+    const TickerPanel* prices;
+    TickerPanel* out;
+    size_t begin;
+    size_t width;
+    int period;
+};
+
+ATLAS_INLINE bool finite(float v) {
+    return std::fabs(v) <= FLT_MAX;
+}
+
+ATLAS_INLINE float percent_return(float prev, float cur) {
+    return prev > kEpsilon ? 100.0f * (cur - prev) / prev : 0.0f;
+}
+
+ATLAS_INLINE void fill_nan(Block& b, size_t day) {
+    float* __restrict o = b.out->row(day) + b.begin;
+    for (size_t l = 0; l < b.width; ++l) o[l] = kNaN;
+}
+
+// Rolling mean or standard deviation of prices. Sums run in double over values
+// shifted by each ticker's first price; non-finite values are counted instead of summed.
+ATLAS_INLINE void rolling_block(Block b, bool stddev) {
+    const size_t days = b.prices->days();
+    const size_t p = static_cast<size_t>(b.period);
+    double shift[kBlockTickers], s1[kBlockTickers], s2[kBlockTickers];
+    int bad[kBlockTickers];
+
+    const float* first = b.prices->row(0) + b.begin;
+    for (size_t l = 0; l < b.width; ++l) {
+        shift[l] = finite(first[l]) ? first[l] : 0.0;
+        s1[l] = s2[l] = 0.0;
+        bad[l] = 0;
+    }
+
+    for (size_t d = 0; d < days; ++d) {
+        const float* __restrict x = b.prices->row(d) + b.begin;
+        for (size_t l = 0; l < b.width; ++l) {
+            const bool ok = finite(x[l]);
+            const double y = ok ? x[l] - shift[l] : 0.0;
+            s1[l] += y;
+            s2[l] += y * y;
+            bad[l] += !ok;
+        }
+        if (d >= p) {
+            const float* __restrict old = b.prices->row(d - p) + b.begin;
+            for (size_t l = 0; l < b.width; ++l) {
+                const bool ok = finite(old[l]);
+                const double y = ok ? old[l] - shift[l] : 0.0;
+                s1[l] -= y;
+                s2[l] -= y * y;
+                bad[l] -= !ok;
+            }
+        }
+        if (d + 1 < p) {
+            fill_nan(b, d);
+            continue;
+        }
+
+        float* __restrict o = b.out->row(d) + b.begin;
+        if (stddev) {
+            for (size_t l = 0; l < b.width; ++l) {
+                const double variance = std::max(0.0, (s2[l] - s1[l] * s1[l] / p) / p);
+                o[l] = bad[l] ? kNaN : static_cast<float>(std::sqrt(variance));
+            }
+        } else {
+            for (size_t l = 0; l < b.width; ++l) {
+                o[l] = bad[l] ? kNaN : static_cast<float>(shift[l] + s1[l] / p);
+            }
+        }
+    }
+}
+
+// Sample standard deviation (x100) of percent returns; return r[d] comes from days d-1 and d
+ATLAS_INLINE void returns_stddev_block(Block b) {
+    const size_t days = b.prices->days();
+    const size_t p = static_cast<size_t>(b.period);
+    double s1[kBlockTickers], s2[kBlockTickers];
+    int bad[kBlockTickers];
+    for (size_t l = 0; l < b.width; ++l) {
+        s1[l] = s2[l] = 0.0;
+        bad[l] = 0;
+    }
+
+    fill_nan(b, 0);
+    for (size_t d = 1; d < days; ++d) {
+        const float* __restrict prev = b.prices->row(d - 1) + b.begin;
+        const float* __restrict cur = b.prices->row(d) + b.begin;
+        for (size_t l = 0; l < b.width; ++l) {
+            const float r = percent_return(prev[l], cur[l]);
+            const bool ok = finite(r);
+            const double y = ok ? r : 0.0;
+            s1[l] += y;
+            s2[l] += y * y;
+            bad[l] += !ok;
+        }
+        if (d > p) {
+            const float* __restrict old_prev = b.prices->row(d - p - 1) + b.begin;
+            const float* __restrict old_cur = b.prices->row(d - p) + b.begin;
+            for (size_t l = 0; l < b.width; ++l) {
+                const float r = percent_return(old_prev[l], old_cur[l]);
+                const bool ok = finite(r);
+                const double y = ok ? r : 0.0;
+                s1[l] -= y;
+                s2[l] -= y * y;
+                bad[l] -= !ok;
+            }
+        }
+        if (d < p) {
+            fill_nan(b, d);
+            continue;
+        }
+
+        float* __restrict o = b.out->row(d) + b.begin;
+        for (size_t l = 0; l < b.width; ++l) {
+            const double variance = std::max(0.0, (s2[l] - s1[l] * s1[l] / p) / (p - 1));
+            o[l] = bad[l] ? kNaN : static_cast<float>(std::sqrt(variance) * 100.0);
+        }
+    }
+}
+
+// EMA seeded with the SMA of the first period values, as TAFunctions::calculate_ema
+ATLAS_INLINE void ema_block(Block b) {
+    const size_t days = b.prices->days();
+    const size_t p = static_cast<size_t>(b.period);
+    const float multiplier = 2.0f / (b.period + 1.0f);
+    float ema[kBlockTickers];
+    for (size_t l = 0; l < b.width; ++l) ema[l] = 0.0f;
+
+    for (size_t d = 0; d < days; ++d) {
+        const float* __restrict x = b.prices->row(d) + b.begin;
+        float* __restrict o = b.out->row(d) + b.begin;
+        if (d + 1 < p) {
+            for (size_t l = 0; l < b.width; ++l) {
+                ema[l] += x[l];
+                o[l] = kNaN;
+            }
+        } else if (d + 1 == p) {
+            for (size_t l = 0; l < b.width; ++l) {
+                ema[l] = (ema[l] + x[l]) / b.period;
+                o[l] = ema[l];
+            }
+        } else {
+            for (size_t l = 0; l < b.width; ++l) {
+                ema[l] = (x[l] * multiplier) + (ema[l] * (1.0f - multiplier));
+                o[l] = ema[l];
+            }
+        }
+    }
+}
+
+// RSI with Wilder smoothing, as TAFunctions::calculate_rsi
+ATLAS_INLINE void rsi_block(Block b) {
+    const size_t days = b.prices->days();
+    const size_t p = static_cast<size_t>(b.period);
+    float gain[kBlockTickers], loss[kBlockTickers];
+    for (size_t l = 0; l < b.width; ++l) gain[l] = loss[l] = 0.0f;
+
+    fill_nan(b, 0);
+    for (size_t d = 1; d < days; ++d) {
+        const float* __restrict prev = b.prices->row(d - 1) + b.begin;
+        const float* __restrict cur = b.prices->row(d) + b.begin;
+        float* __restrict o = b.out->row(d) + b.begin;
+
+        if (d < p) {
+            for (size_t l = 0; l < b.width; ++l) {
+                const float change = cur[l] - prev[l];
+                gain[l] += change > 0 ? change : 0.0f;
+                loss[l] += change > 0 ? 0.0f : -change;
+                o[l] = kNaN;
+            }
+            continue;
+        }
+
+        for (size_t l = 0; l < b.width; ++l) {
+            const float change = cur[l] - prev[l];
+            const float g = change > 0 ? change : 0.0f;
+            const float lo = change > 0 ? 0.0f : -change;
+            if (d == p) {
+                gain[l] = (gain[l] + g) / b.period;
+                loss[l] = (loss[l] + lo) / b.period;
+            } else {
+                gain[l] = ((gain[l] * (b.period - 1)) + g) / b.period;
+                loss[l] = ((loss[l] * (b.period - 1)) + lo) / b.period;
+            }
+            o[l] = loss[l] > kEpsilon ? 100.0f - (100.0f / (1.0f + gain[l] / loss[l])) : kNaN;
+        }
+    }
+}
+
+// Percent change over period days, as TAFunctions::calculate_rolling_cumulative_return
+ATLAS_INLINE void cumulative_return_block(Block b) {
+    const size_t days = b.prices->days();
+    const size_t p = static_cast<size_t>(b.period);
+    for (size_t d = 0; d < days; ++d) {
+        if (d < p) {
+            fill_nan(b, d);
+            continue;
+        }
+        const float* __restrict old = b.prices->row(d - p) + b.begin;
+        const float* __restrict cur = b.prices->row(d) + b.begin;
+        float* __restrict o = b.out->row(d) + b.begin;
+        for (size_t l = 0; l < b.width; ++l) {
+            o[l] = (cur[l] - old[l]) / old[l] * 100.0f;
+        }
+    }
+}
+
+// The drawdown reduction has no lane-parallel form: each ticker of the block
+// runs the O(n) series kernel on its own column
+void max_drawdown_block(Block b) {
+    const size_t days = b.prices->days();
+    const size_t p = static_cast<size_t>(b.period);
+    const size_t width = std::min(b.width, b.prices->tickers() - std::min(b.begin, b.prices->tickers()));
+    thread_local std::vector<float> series, values;
+    series.resize(days);
+    values.resize(days - p + 1);
+
+    for (size_t d = 0; d + 1 < p; ++d) {
+        fill_nan(b, d);
+    }
+    for (size_t l = 0; l < width; ++l) {
+        for (size_t d = 0; d < days; ++d) {
+            series[d] = (*b.prices)(d, b.begin + l);
+        }
+        rolling_max_drawdown(series.data(), days, b.period, values.data());
+        for (size_t d = p - 1; d < days; ++d) {
+            (*b.out)(d, b.begin + l) = values[d - p + 1];
+        }
+    }
+}
+
+ATLAS_INLINE void run_block(Block b, IndicatorKind kind) {
+    switch (kind) {
+        case IndicatorKind::SMA: rolling_block(b, false); break;
+        case IndicatorKind::STANDARD_DEVIATION: rolling_block(b, true); break;
+        case IndicatorKind::RETURNS_STANDARD_DEVIATION: returns_stddev_block(b); break;
+        case IndicatorKind::EMA: ema_block(b); break;
+        case IndicatorKind::RSI: rsi_block(b); break;
+        case IndicatorKind::CUMULATIVE_RETURN: cumulative_return_block(b); break;
+        case IndicatorKind::MAX_DRAWDOWN: max_drawdown_block(b); break;
+    }
+}
+
+// One instantiation per instruction set, chosen at runtime like the rolling kernels
+void run_block_scalar(Block b, IndicatorKind kind) { run_block(b, kind); }
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) void run_block_avx2(Block b, IndicatorKind kind) { run_block(b, kind); }
+__attribute__((target("avx512f"))) void run_block_avx512(Block b, IndicatorKind kind) { run_block(b, kind); }
+#endif
+
+using BlockFn = void (*)(Block, IndicatorKind);
+
+BlockFn block_kernel() {
+#if defined(__x86_64__) || defined(__i386__)
+    switch (simd_level()) {
+        case SimdLevel::AVX512: return run_block_avx512;
+        case SimdLevel::AVX2: return run_block_avx2;
+        case SimdLevel::SCALAR: break;
+    }
+#endif
+    return run_block_scalar;
+}
+
+size_t required_days(const IndicatorSpec& spec) {
+    switch (spec.kind) {
+        case IndicatorKind::RSI: return spec.period + 1;
+        case IndicatorKind::RETURNS_STANDARD_DEVIATION: return spec.period + 2;
+        case IndicatorKind::CUMULATIVE_RETURN: return spec.period + 1;
+        default: return spec.period;
+    }
+}
+
+void validate(const TickerPanel& prices, const IndicatorSpec& spec) {
+    const int min_period = spec.kind == IndicatorKind::RETURNS_STANDARD_DEVIATION ? 2 : 1;
+    if (spec.period < min_period) {
+        throw TAFunctionsError("Invalid period " + std::to_string(spec.period) + " for batched indicator");
+    }
+    if (prices.days() < required_days(spec)) {
+        throw TAFunctionsError("Insufficient data for batched indicator calculation");
+    }
+}
+
+} // namespace
+
+TickerPanel::TickerPanel(size_t tickers, size_t days, float fill)
+    : tickers_(tickers), days_(days),
+      stride_((tickers + kRowAlignment - 1) / kRowAlignment * kRowAlignment),
+      data_(stride_ * days, 0.0f) {
+    if (fill != 0.0f) {
+        for (size_t d = 0; d < days_; ++d) {
+            std::fill_n(row(d), tickers_, fill);
+        }
+    }
+}
+
+void TickerPanel::set_series(size_t ticker, std::span<const float> values) {
+    if (ticker >= tickers_ || values.size() != days_) {
+        throw std::out_of_range("TickerPanel series does not match panel shape");
+    }
+    for (size_t d = 0; d < days_; ++d) {
+        data_[d * stride_ + ticker] = values[d];
+    }
+}
+
+std::vector<float> TickerPanel::series(size_t ticker) const {
+    if (ticker >= tickers_) {
+        throw std::out_of_range("TickerPanel ticker index out of range");
+    }
+    std::vector<float> values(days_);
+    for (size_t d = 0; d < days_; ++d) {
+        values[d] = data_[d * stride_ + ticker];
+    }
+    return values;
+}
+
+TickerPanel compute_indicator(const TickerPanel& prices, const IndicatorSpec& spec, WorkStealingPool* pool) {
+    auto panels = compute_indicators(prices, std::span<const IndicatorSpec>(&spec, 1), pool);
+    return std::move(panels.front());
+}
+
+std::vector<TickerPanel> compute_indicators(const TickerPanel& prices, std::span<const IndicatorSpec> specs,
+                                            WorkStealingPool* pool) {
+    for (const auto& spec : specs) {
+        validate(prices, spec);
+    }
+
+    std::vector<TickerPanel> outputs;
+    outputs.reserve(specs.size());
+    for (size_t i = 0; i < specs.size(); ++i) {
+        outputs.emplace_back(prices.tickers(), prices.days());
+    }
+
+    // Blocks cover the padded stride so lane loops run full vectors; padding lanes are zero
+    const size_t blocks = (prices.stride() + kBlockTickers - 1) / kBlockTickers;
+    const BlockFn kernel = block_kernel();
+    auto task = [&](size_t index) {
+        const size_t s = index / blocks;
+        const size_t begin = (index % blocks) * kBlockTickers;
+        Block block{&prices, &outputs[s], begin, std::min(kBlockTickers, prices.stride() - begin), specs[s].period};
+        kernel(block, specs[s].kind);
+    };
+
+    const size_t tasks = specs.size() * blocks;
+    if (pool && tasks > 1) {
+        pool->parallel_for(tasks, task);
+    } else {
+        for (size_t i = 0; i < tasks; ++i) {
+            task(i);
+        }
+    }
+    return outputs;
+}
+
+} // namespace ta
+} // namespace atlas
@@ -1,4 +1,6 @@
 #include "ta_functions.h"
+#include "ta_kernels.h"
+#include "global_cache.h"
 #include <algorithm>
 #include <stdexcept>
 #include <iostream>
@@ -14,33 +16,15 @@ std::vector<float> TAFunctions::calculate_rsi(const std::vector<float>& prices,
     }
     
     std::vector<float> rsi_values(prices.size(), NAN_VALUE);
-    auto price_changes = calculate_price_changes(prices);
-    auto [gains, losses] = separate_gains_losses(price_changes);
-    
-    // Calculate initial average gain and loss for the first period
-    float sum_gains = 0.0f, sum_losses = 0.0f;
-    for (int i = 0; i < period; ++i) {
-        sum_gains += gains[i];
-        sum_losses += losses[i];
-    }
-    
-    float avg_gain = sum_gains / period;
-    float avg_loss = sum_losses / period;
-    
-    // Calculate RSI for the first valid point
-    if (avg_loss > EPSILON) {
-        float rs = calculate_rs(avg_gain, avg_loss);
-        rsi_values[period] = 100.0f - (100.0f / (1.0f + rs));
-    }
-    
-    // Calculate RSI for subsequent points using Wilder's smoothing
-    for (size_t i = period + 1; i < prices.size(); ++i) {
-        avg_gain = apply_wilders_smoothing(avg_gain, gains[i-1], period);
-        avg_loss = apply_wilders_smoothing(avg_loss, losses[i-1], period);
-        
-        if (avg_loss > EPSILON) {
-            float rs = calculate_rs(avg_gain, avg_loss);
-            rsi_values[i] = 100.0f - (100.0f / (1.0f + rs));
+    const size_t count = prices.size() - period;
+    std::vector<float> avg_gain(count), avg_loss(count);
+    ta::wilder_averages(prices.data(), prices.size(), period, avg_gain.data(), avg_loss.data());
+    
+    // RSI from the Wilder-smoothed averages; avg_gain[k] belongs to price index period + k
+    for (size_t k = 0; k < count; ++k) {
+        if (avg_loss[k] > EPSILON) {
+            float rs = calculate_rs(avg_gain[k], avg_loss[k]);
+            rsi_values[period + k] = 100.0f - (100.0f / (1.0f + rs));
         }
     }
     
@@ -53,14 +37,7 @@ std::vector<float> TAFunctions::calculate_sma(const std::vector<float>& data, in
     }
     
     std::vector<float> sma_values(data.size(), NAN_VALUE);
-    
-    for (size_t i = period - 1; i < data.size(); ++i) {
-        float sum = 0.0f;
-        for (int j = 0; j < period; ++j) {
-            sum += data[i - j];
-        }
-        sma_values[i] = sum / period;
-    }
+    ta::rolling_mean(data.data(), data.size(), period, sma_values.data() + period - 1);
     
     return sma_values;
 }
@@ -81,9 +58,8 @@ std::vector<float> TAFunctions::calculate_ema(const std::vector<float>& data, in
     ema_values[period - 1] = sum / period;
     
     // Calculate EMA for subsequent values
-    for (size_t i = period; i < data.size(); ++i) {
-        ema_values[i] = (data[i] * multiplier) + (ema_values[i-1] * (1.0f - multiplier));
-    }
+    ta::ema(data.data() + period, data.size() - period, multiplier, ema_values[period - 1],
+            ema_values.data() + period);
     
     return ema_values;
 }
@@ -94,11 +70,7 @@ std::vector<float> TAFunctions::calculate_standard_deviation(const std::vector<f
     }
     
     std::vector<float> std_dev_values(data.size(), NAN_VALUE);
-    
-    for (size_t i = period - 1; i < data.size(); ++i) {
-        auto [mean, variance] = calculate_window_stats(data, i - period + 1, i + 1);
-        std_dev_values[i] = std::sqrt(variance);
-    }
+    ta::rolling_stddev(data.data(), data.size(), period, false, 1.0f, std_dev_values.data() + period - 1);
     
     return std_dev_values;
 }
@@ -108,17 +80,8 @@ std::vector<float> TAFunctions::calculate_returns(const std::vector<float>& pric
         throw TAFunctionsError("Insufficient data for return calculation");
     }
     
-    std::vector<float> returns;
-    returns.reserve(prices.size() - 1);
-    
-    for (size_t i = 1; i < prices.size(); ++i) {
-        if (prices[i-1] > EPSILON) {
-            float return_val = 100.0f * (prices[i] - prices[i-1]) / prices[i-1];
-            returns.push_back(return_val);
-        } else {
-            returns.push_back(0.0f);
-        }
-    }
+    std::vector<float> returns(prices.size() - 1);
+    ta::percent_returns(prices.data(), prices.size(), returns.data());
     
     return returns;
 }
@@ -139,13 +102,8 @@ std::vector<float> TAFunctions::calculate_returns_standard_deviation(const std::
     
     auto returns = calculate_returns(prices);
     std::vector<float> std_dev_values(prices.size() - 1, NAN_VALUE);
-    
-    for (size_t i = period - 1; i < returns.size(); ++i) {
-        auto [mean, variance] = calculate_window_stats(returns, i - period + 1, i + 1);
-        // Use sample standard deviation (n-1 denominator)
-        float sample_variance = variance * period / (period - 1);
-        std_dev_values[i] = std::sqrt(sample_variance) * 100.0f;
-    }
+    // Use sample standard deviation (n-1 denominator)
+    ta::rolling_stddev(returns.data(), returns.size(), period, true, 100.0f, std_dev_values.data() + period - 1);
     
     return std_dev_values;
 }
@@ -186,16 +144,31 @@ float TAFunctions::calculate_max_drawdown(const std::vector<float>& returns) {
 }
 
 std::vector<float> TAFunctions::calculate_rolling_max_drawdown(const std::vector<float>& returns, int period) {
-    std::vector<float> rolling_drawdowns(returns.size(), NAN_VALUE);
+    if (period < 1) {
+        throw TAFunctionsError("Invalid period for rolling max drawdown calculation");
+    }
     
-    for (size_t i = period - 1; i < returns.size(); ++i) {
-        std::vector<float> window(returns.begin() + i - period + 1, returns.begin() + i + 1);
-        rolling_drawdowns[i] = calculate_max_drawdown(window);
+    std::vector<float> rolling_drawdowns(returns.size(), NAN_VALUE);
+    if (returns.size() >= static_cast<size_t>(period)) {
+        ta::rolling_max_drawdown(returns.data(), returns.size(), period, rolling_drawdowns.data() + period - 1);
     }
     
     return rolling_drawdowns;
 }
 
+std::vector<float> TAFunctions::calculate_rolling_cumulative_return(const std::vector<float>& prices, int period) {
+    if (period < 1 || !validate_data_length(prices.size(), static_cast<size_t>(period))) {
+        throw TAFunctionsError("Insufficient data for cumulative return calculation");
+    }
+    
+    std::vector<float> cumulative_returns(prices.size(), NAN_VALUE);
+    if (prices.size() > static_cast<size_t>(period)) {
+        ta::cumulative_return(prices.data(), prices.size(), period, cumulative_returns.data() + period);
+    }
+    
+    return cumulative_returns;
+}
+
 std::vector<float> TAFunctions::calculate_market_cap_weighting(const std::vector<float>& market_caps) {
     float total_market_cap = std::accumulate(market_caps.begin(), market_caps.end(), 0.0f);
     
@@ -422,6 +395,73 @@ IndicatorResult TechnicalIndicators::get_standard_deviation(const std::string& t
     }
 }
 
+std::vector<IndicatorResult> TechnicalIndicators::get_indicator_batch(const std::vector<std::string>& tickers,
+                                                                     const ta::IndicatorSpec& spec, int length_data,
+                                                                     const std::string& end_date, bool live_data,
+                                                                     WorkStealingPool* pool) {
+    std::vector<IndicatorResult> results(tickers.size());
+    if (tickers.empty()) {
+        return results;
+    }
+    
+    try {
+        // Same history length as the per-ticker getters, fetched once per ticker
+        const int days = length_data + spec.period;
+        ta::TickerPanel prices(tickers.size(), static_cast<size_t>(std::max(days, 0)));
+        for (size_t t = 0; t < tickers.size(); ++t) {
+            prices.set_series(t, get_historical_prices(tickers[t], end_date, days, live_data));
+        }
+        
+        auto values = ta::compute_indicator(prices, spec, pool);
+        
+        // Extract the requested length of data
+        size_t start_idx = values.days() >= static_cast<size_t>(length_data) ? 
+                          values.days() - length_data : 0;
+        
+        for (size_t t = 0; t < tickers.size(); ++t) {
+            auto series = values.series(t);
+            results[t] = IndicatorResult(std::vector<float>(series.begin() + start_idx, series.end()));
+        }
+        
+    } catch (const std::exception& e) {
+        for (auto& result : results) {
+            result = IndicatorResult();
+            result.error_message = "Error in get_indicator_batch: " + std::string(e.what());
+        }
+    }
+    
+    return results;
+}
+
+IndicatorResult TechnicalIndicators::get_live_indicator(const std::string& ticker, const ta::IndicatorSpec& spec,
+                                                        const std::string& end_date, int seed_length,
+                                                        bool session_closed) {
+    try {
+        // Last bar is the live one; everything before it seeds a new state
+        auto prices = get_historical_prices(ticker, end_date, 1, true);
+        if (prices.empty()) {
+            throw TAFunctionsError("No live price for " + ticker);
+        }
+        
+        auto history = [&]() {
+            auto closes = get_historical_prices(ticker, end_date, seed_length + 1, true);
+            closes.pop_back();
+            return closes;
+        };
+        
+        IndicatorStateKey key{ticker, spec.kind, spec.period};
+        auto& states = GlobalCache::instance().indicator_states();
+        float value = states.advance(key, end_date, prices.back(), history, session_closed);
+        
+        return IndicatorResult(std::vector<float>{value});
+        
+    } catch (const std::exception& e) {
+        IndicatorResult error_result;
+        error_result.error_message = "Error in get_live_indicator: " + std::string(e.what());
+        return error_result;
+    }
+}
+
 // Mock data provider implementation
 std::vector<float> TechnicalIndicators::get_historical_prices(const std::string& ticker, 
                                                             const std::string& end_date, 
@@ -0,0 +1,630 @@
+#include "ta_kernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ATLAS_TA_X86 1
+#endif
+
+namespace atlas {
+namespace ta {
+
+namespace {
+
+// Same threshold as TAFunctions::calculate_returns
+constexpr float kReturnEpsilon = 1e-8f;
+
+// rolling_stddev re-centers its prefix sums every block of at least this many outputs
+constexpr size_t kStddevBlock = 64;
+
+// Largest ratio of a block's sum of squares to a window's squared deviation that
+// the one-pass variance resolves to about 1e-7; windows beyond it are recomputed
+constexpr double kCancellationLimit = 1e9;
+
+// Per-ISA bodies of the vectorizable steps. Prefix arrays hold count + period entries.
+struct KernelTable {
+    void (*window_mean)(const double* prefix, size_t count, int period, double shift, float* out);
+    void (*window_stddev)(const double* s1, const double* s2, size_t count, int period,
+                          double denom, double scale, float* out);
+    void (*returns)(const float* prices, size_t n, float* out);
+};
+
+// Each body below is a template on the window length. P = 0 is the generic kernel
+// taking the period at runtime; P > 0 is a specialization for one common window,
+// where the window offset is an immediate and the division by the length folds
+// into a multiply by its reciprocal.
+
+template <int P>
+constexpr int window_length(int period) {
+    return P > 0 ? P : period;
+}
+
+// Scalar
+
+template <int P>
+void window_mean_scalar(const double* prefix, size_t count, int period, double shift, float* out) {
+    const int w = window_length<P>(period);
+    for (size_t k = 0; k < count; ++k) {
+        const double sum = prefix[k + w] - prefix[k];
+        out[k] = static_cast<float>(shift + (P > 0 ? sum * (1.0 / P) : sum / period));
+    }
+}
+
+template <int P>
+void window_stddev_scalar(const double* s1, const double* s2, size_t count, int period,
+                          double denom, double scale, float* out) {
+    const int w = window_length<P>(period);
+    const double inv_denom = 1.0 / denom;
+    for (size_t k = 0; k < count; ++k) {
+        const double sum = s1[k + w] - s1[k];
+        const double sum_sq = s2[k + w] - s2[k];
+        const double variance = P > 0 ? std::max(0.0, (sum_sq - sum * sum * (1.0 / P)) * inv_denom)
+                                      : std::max(0.0, (sum_sq - sum * sum / period) / denom);
+        out[k] = static_cast<float>(std::sqrt(variance) * scale);
+    }
+}
+
+void returns_scalar(const float* prices, size_t n, float* out) {
+    for (size_t i = 1; i < n; ++i) {
+        out[i - 1] = prices[i - 1] > kReturnEpsilon ? 100.0f * (prices[i] - prices[i - 1]) / prices[i - 1] : 0.0f;
+    }
+}
+
+#if defined(ATLAS_TA_X86)
+
+// AVX2: 4 doubles or 8 floats per step; the scalar bodies finish the tails
+
+template <int P>
+__attribute__((target("avx2")))
+void window_mean_avx2(const double* prefix, size_t count, int period, double shift, float* out) {
+    const int w = window_length<P>(period);
+    const __m256d p = _mm256_set1_pd(period);
+    const __m256d inv = _mm256_set1_pd(P > 0 ? 1.0 / P : 0.0);
+    const __m256d s = _mm256_set1_pd(shift);
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m256d diff = _mm256_sub_pd(_mm256_loadu_pd(prefix + k + w), _mm256_loadu_pd(prefix + k));
+        __m256d mean = P > 0 ? _mm256_mul_pd(diff, inv) : _mm256_div_pd(diff, p);
+        _mm_storeu_ps(out + k, _mm256_cvtpd_ps(_mm256_add_pd(s, mean)));
+    }
+    window_mean_scalar<P>(prefix + k, count - k, period, shift, out + k);
+}
+
+template <int P>
+__attribute__((target("avx2")))
+void window_stddev_avx2(const double* s1, const double* s2, size_t count, int period,
+                        double denom, double scale, float* out) {
+    const int w = window_length<P>(period);
+    const __m256d p = _mm256_set1_pd(period);
+    const __m256d d = _mm256_set1_pd(denom);
+    const __m256d inv = _mm256_set1_pd(P > 0 ? 1.0 / P : 0.0);
+    const __m256d inv_d = _mm256_set1_pd(1.0 / denom);
+    const __m256d sc = _mm256_set1_pd(scale);
+    const __m256d zero = _mm256_setzero_pd();
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m256d sum = _mm256_sub_pd(_mm256_loadu_pd(s1 + k + w), _mm256_loadu_pd(s1 + k));
+        __m256d sum_sq = _mm256_sub_pd(_mm256_loadu_pd(s2 + k + w), _mm256_loadu_pd(s2 + k));
+        __m256d square = _mm256_mul_pd(sum, sum);
+        __m256d variance = P > 0
+            ? _mm256_mul_pd(_mm256_sub_pd(sum_sq, _mm256_mul_pd(square, inv)), inv_d)
+            : _mm256_div_pd(_mm256_sub_pd(sum_sq, _mm256_div_pd(square, p)), d);
+        variance = _mm256_max_pd(variance, zero);
+        _mm_storeu_ps(out + k, _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_sqrt_pd(variance), sc)));
+    }
+    window_stddev_scalar<P>(s1 + k, s2 + k, count - k, period, denom, scale, out + k);
+}
+
+__attribute__((target("avx2")))
+void returns_avx2(const float* prices, size_t n, float* out) {
+    const __m256 eps = _mm256_set1_ps(kReturnEpsilon);
+    const __m256 hundred = _mm256_set1_ps(100.0f);
+    size_t i = 1;
+    for (; i + 8 <= n; i += 8) {
+        __m256 prev = _mm256_loadu_ps(prices + i - 1);
+        __m256 cur = _mm256_loadu_ps(prices + i);
+        __m256 value = _mm256_div_ps(_mm256_mul_ps(hundred, _mm256_sub_ps(cur, prev)), prev);
+        __m256 valid = _mm256_cmp_ps(prev, eps, _CMP_GT_OQ);
+        _mm256_storeu_ps(out + i - 1, _mm256_and_ps(value, valid));
+    }
+    if (i < n) {
+        returns_scalar(prices + i - 1, n - i + 1, out + i - 1);
+    }
+}
+
+// AVX-512: 8 doubles or 16 floats per step
+
+template <int P>
+__attribute__((target("avx512f")))
+void window_mean_avx512(const double* prefix, size_t count, int period, double shift, float* out) {
+    const int w = window_length<P>(period);
+    const __m512d p = _mm512_set1_pd(period);
+    const __m512d inv = _mm512_set1_pd(P > 0 ? 1.0 / P : 0.0);
+    const __m512d s = _mm512_set1_pd(shift);
+    size_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m512d diff = _mm512_sub_pd(_mm512_loadu_pd(prefix + k + w), _mm512_loadu_pd(prefix + k));
+        __m512d mean = P > 0 ? _mm512_mul_pd(diff, inv) : _mm512_div_pd(diff, p);
+        _mm256_storeu_ps(out + k, _mm512_maskz_cvtpd_ps(0xFF, _mm512_add_pd(s, mean)));
+    }
+    window_mean_scalar<P>(prefix + k, count - k, period, shift, out + k);
+}
+
+template <int P>
+__attribute__((target("avx512f")))
+void window_stddev_avx512(const double* s1, const double* s2, size_t count, int period,
+                          double denom, double scale, float* out) {
+    const int w = window_length<P>(period);
+    const __m512d p = _mm512_set1_pd(period);
+    const __m512d d = _mm512_set1_pd(denom);
+    const __m512d inv = _mm512_set1_pd(P > 0 ? 1.0 / P : 0.0);
+    const __m512d inv_d = _mm512_set1_pd(1.0 / denom);
+    const __m512d sc = _mm512_set1_pd(scale);
+    const __m512d zero = _mm512_setzero_pd();
+    size_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m512d sum = _mm512_sub_pd(_mm512_loadu_pd(s1 + k + w), _mm512_loadu_pd(s1 + k));
+        __m512d sum_sq = _mm512_sub_pd(_mm512_loadu_pd(s2 + k + w), _mm512_loadu_pd(s2 + k));
+        __m512d square = _mm512_mul_pd(sum, sum);
+        __m512d variance = P > 0
+            ? _mm512_mul_pd(_mm512_sub_pd(sum_sq, _mm512_mul_pd(square, inv)), inv_d)
+            : _mm512_div_pd(_mm512_sub_pd(sum_sq, _mm512_div_pd(square, p)), d);
+        // Zero-masked forms: the unmasked ones pass an undefined vector through, which GCC 12 flags as uninitialized
+        variance = _mm512_maskz_max_pd(0xFF, variance, zero);
+        __m512d stddev = _mm512_mul_pd(_mm512_maskz_sqrt_pd(0xFF, variance), sc);
+        _mm256_storeu_ps(out + k, _mm512_maskz_cvtpd_ps(0xFF, stddev));
+    }
+    window_stddev_scalar<P>(s1 + k, s2 + k, count - k, period, denom, scale, out + k);
+}
+
+__attribute__((target("avx512f")))
+void returns_avx512(const float* prices, size_t n, float* out) {
+    const __m512 eps = _mm512_set1_ps(kReturnEpsilon);
+    const __m512 hundred = _mm512_set1_ps(100.0f);
+    size_t i = 1;
+    for (; i + 16 <= n; i += 16) {
+        __m512 prev = _mm512_loadu_ps(prices + i - 1);
+        __m512 cur = _mm512_loadu_ps(prices + i);
+        __mmask16 valid = _mm512_cmp_ps_mask(prev, eps, _CMP_GT_OQ);
+        __m512 value = _mm512_div_ps(_mm512_mul_ps(hundred, _mm512_sub_ps(cur, prev)), prev);
+        _mm512_storeu_ps(out + i - 1, _mm512_maskz_mov_ps(valid, value));
+    }
+    if (i < n) {
+        returns_scalar(prices + i - 1, n - i + 1, out + i - 1);
+    }
+}
+
+#endif
+
+// Wilder smoothing is a serial recurrence, so it has no per-ISA variants. The
+// fixed-period version unrolls the warm-up sum and replaces the two divisions
+// per bar by multiplies with the folded (P - 1) / P and 1 / P factors.
+template <int P>
+void wilder_fixed(const float* prices, size_t n, float* avg_gain, float* avg_loss) {
+    float gain = 0.0f;
+    float loss = 0.0f;
+    auto accumulate = [&](size_t i) {
+        const float change = prices[i] - prices[i - 1];
+        gain += change > 0 ? change : 0.0f;
+        loss += change > 0 ? 0.0f : -change;
+    };
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (accumulate(I + 1), ...);
+    }(std::make_index_sequence<P>{});
+    gain /= P;
+    loss /= P;
+
+    constexpr float keep = static_cast<float>(P - 1) / P;
+    constexpr float inv_period = 1.0f / P;
+    avg_gain[0] = gain;
+    avg_loss[0] = loss;
+
+    for (size_t t = P + 1; t < n; ++t) {
+        const float change = prices[t] - prices[t - 1];
+        gain = gain * keep + (change > 0 ? change : 0.0f) * inv_period;
+        loss = loss * keep + (change > 0 ? 0.0f : -change) * inv_period;
+        avg_gain[t - P] = gain;
+        avg_loss[t - P] = loss;
+    }
+}
+
+using WilderFn = void (*)(const float* prices, size_t n, float* avg_gain, float* avg_loss);
+
+template <int P>
+constexpr KernelTable scalar_kernels() {
+    return {window_mean_scalar<P>, window_stddev_scalar<P>, returns_scalar};
+}
+#if defined(ATLAS_TA_X86)
+template <int P>
+constexpr KernelTable avx2_kernels() {
+    return {window_mean_avx2<P>, window_stddev_avx2<P>, returns_avx2};
+}
+template <int P>
+constexpr KernelTable avx512_kernels() {
+    return {window_mean_avx512<P>, window_stddev_avx512<P>, returns_avx512};
+}
+#endif
+
+constexpr KernelTable kScalarKernels = scalar_kernels<0>();
+#if defined(ATLAS_TA_X86)
+constexpr KernelTable kAvx2Kernels = avx2_kernels<0>();
+constexpr KernelTable kAvx512Kernels = avx512_kernels<0>();
+#endif
+
+/**
+ * @brief Kernels specialized for one window length, per instruction set
+ */
+struct FixedKernels {
+    int period;
+    KernelTable scalar;
+#if defined(ATLAS_TA_X86)
+    KernelTable avx2;
+    KernelTable avx512;
+#endif
+    WilderFn wilder;
+};
+
+template <int P>
+constexpr FixedKernels fixed_kernels() {
+#if defined(ATLAS_TA_X86)
+    return {P, scalar_kernels<P>(), avx2_kernels<P>(), avx512_kernels<P>(), wilder_fixed<P>};
+#else
+    return {P, scalar_kernels<P>(), wilder_fixed<P>};
+#endif
+}
+
+// Must list the same periods as kSpecializedPeriods
+constexpr FixedKernels kFixedKernels[] = {
+    fixed_kernels<10>(), fixed_kernels<14>(), fixed_kernels<20>(), fixed_kernels<50>(), fixed_kernels<200>()
+};
+static_assert(std::size(kFixedKernels) == std::size(kSpecializedPeriods));
+
+std::atomic<bool>& specialized_enabled() {
+    static std::atomic<bool> enabled{true};
+    return enabled;
+}
+
+const FixedKernels* find_fixed(int period) {
+    if (!specialized_enabled().load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    for (const auto& entry : kFixedKernels) {
+        if (entry.period == period) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+// Generic kernels, or the specialized ones when period has an entry in kFixedKernels
+const KernelTable& kernels(int period = 0) {
+    const FixedKernels* fixed = period > 0 ? find_fixed(period) : nullptr;
+#if defined(ATLAS_TA_X86)
+    switch (simd_level()) {
+        case SimdLevel::AVX512: return fixed ? fixed->avx512 : kAvx512Kernels;
+        case SimdLevel::AVX2: return fixed ? fixed->avx2 : kAvx2Kernels;
+        case SimdLevel::SCALAR: break;
+    }
+#endif
+    return fixed ? fixed->scalar : kScalarKernels;
+}
+
+void check_window(size_t n, int period) {
+    if (period < 1 || n < static_cast<size_t>(period)) {
+        throw std::invalid_argument("Rolling window of " + std::to_string(period) +
+                                    " over " + std::to_string(n) + " values");
+    }
+}
+
+bool all_finite(const float* in, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (!std::isfinite(in[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Prefix sums are rebuilt per call; keep the buffers per thread
+std::vector<double>& scratch(size_t which) {
+    thread_local std::vector<double> buffers[2];
+    return buffers[which];
+}
+
+// Two-pass variance of one window, for inputs the prefix-sum kernels cannot resolve
+float window_stddev_two_pass(const float* in, int period, double denom, float scale) {
+    double mean = 0.0;
+    for (int j = 0; j < period; ++j) {
+        mean += in[j];
+    }
+    mean /= period;
+    double sum_sq = 0.0;
+    for (int j = 0; j < period; ++j) {
+        sum_sq += (in[j] - mean) * (in[j] - mean);
+    }
+    return static_cast<float>(std::sqrt(sum_sq / denom) * scale);
+}
+
+bool all_positive(const float* in, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (!(in[i] > 0.0f) || !std::isfinite(in[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Drawdown summary of a run of consecutive positive prices
+ * Runs combine left to right: the largest drop of a.b is the larger of both
+ * drops and the drop from a's peak to b's trough. That makes the windowed
+ * maximum drawdown an associative reduction.
+ */
+struct DrawdownRun {
+    double peak;
+    double trough;
+    double drop;    // Largest (peak - later price) / peak within the run
+};
+
+DrawdownRun drawdown_run(float price) {
+    return {price, price, 0.0};
+}
+
+DrawdownRun combine(const DrawdownRun& a, const DrawdownRun& b) {
+    return {std::max(a.peak, b.peak), std::min(a.trough, b.trough),
+            std::max({a.drop, b.drop, (a.peak - b.trough) / a.peak})};
+}
+
+std::vector<DrawdownRun>& drawdown_scratch(size_t which) {
+    thread_local std::vector<DrawdownRun> buffers[2];
+    return buffers[which];
+}
+
+// Direct evaluation, as TAFunctions::calculate_max_drawdown
+float window_max_drawdown(const float* in, int period) {
+    float peak = in[0];
+    float max_drawdown = 0.0f;
+    for (int j = 0; j < period; ++j) {
+        if (in[j] > peak) {
+            peak = in[j];
+        }
+        const float drawdown = (peak - in[j]) / peak * 100.0f;
+        if (drawdown > max_drawdown) {
+            max_drawdown = drawdown;
+        }
+    }
+    return max_drawdown;
+}
+
+} // namespace
+
+bool has_specialized_kernel(int period) {
+    return find_fixed(period) != nullptr;
+}
+
+bool specialized_kernels() {
+    return specialized_enabled().load(std::memory_order_relaxed);
+}
+
+void set_specialized_kernels(bool enabled) {
+    specialized_enabled().store(enabled, std::memory_order_relaxed);
+}
+
+void rolling_mean(const float* in, size_t n, int period, float* out) {
+    check_window(n, period);
+    const size_t count = n - period + 1;
+
+    if (!all_finite(in, n)) {
+        for (size_t k = 0; k < count; ++k) {
+            double sum = 0.0;
+            for (int j = 0; j < period; ++j) {
+                sum += in[k + j];
+            }
+            out[k] = static_cast<float>(sum / period);
+        }
+        return;
+    }
+
+    // Shift by the first value so the double prefix sums stay small
+    const double shift = in[0];
+    auto& prefix = scratch(0);
+    prefix.resize(n + 1);
+    prefix[0] = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        prefix[i + 1] = prefix[i] + (in[i] - shift);
+    }
+    kernels(period).window_mean(prefix.data(), count, period, shift, out);
+}
+
+void rolling_stddev(const float* in, size_t n, int period, bool sample, float scale, float* out) {
+    check_window(n, period);
+    const size_t count = n - period + 1;
+    const double denom = sample ? period - 1 : period;
+
+    if (!all_finite(in, n)) {
+        for (size_t k = 0; k < count; ++k) {
+            out[k] = window_stddev_two_pass(in + k, period, denom, scale);
+        }
+        return;
+    }
+
+    // sum_sq - sum * sum / period cancels once the sums are large next to a window's
+    // spread, e.g. a high price with little movement. Each block of outputs gets its own
+    // prefix sums, centered on the mean of its first window, so they only see the block.
+    const auto& table = kernels(period);
+    const size_t block = std::max(kStddevBlock, 2 * static_cast<size_t>(period));
+    auto& s1 = scratch(0);
+    auto& s2 = scratch(1);
+    for (size_t first = 0; first < count; first += block) {
+        const size_t outputs = std::min(block, count - first);
+        const size_t inputs = outputs + period - 1;
+        const float* x = in + first;
+
+        double shift = 0.0;
+        for (int j = 0; j < period; ++j) {
+            shift += x[j];
+        }
+        shift /= period;
+
+        s1.resize(inputs + 1);
+        s2.resize(inputs + 1);
+        s1[0] = s2[0] = 0.0;
+        for (size_t i = 0; i < inputs; ++i) {
+            const double y = x[i] - shift;
+            s1[i + 1] = s1[i] + y;
+            s2[i + 1] = s2[i] + y * y;
+        }
+        float* block_out = out + first;
+        table.window_stddev(s1.data(), s2.data(), outputs, period, denom, scale, block_out);
+
+        // A jump inside the block can still leave a quiet window next to large sums; redo those
+        if (scale == 0.0f) {
+            continue;
+        }
+        const auto squared_deviation = [&](float stddev) {
+            const double root = static_cast<double>(stddev) / scale;
+            return root * root * denom;
+        };
+        float smallest = std::abs(block_out[0]);
+        for (size_t k = 1; k < outputs; ++k) {
+            smallest = std::min(smallest, std::abs(block_out[k]));
+        }
+        if (s2[inputs] <= kCancellationLimit * squared_deviation(smallest)) {
+            continue;
+        }
+        for (size_t k = 0; k < outputs; ++k) {
+            if (s2[k + period] > kCancellationLimit * squared_deviation(block_out[k])) {
+                block_out[k] = window_stddev_two_pass(x + k, period, denom, scale);
+            }
+        }
+    }
+}
+
+void percent_returns(const float* prices, size_t n, float* out) {
+    if (n < 2) {
+        return;
+    }
+    kernels().returns(prices, n, out);
+}
+
+void ema(const float* in, size_t n, float alpha, float seed, float* out) {
+    float previous = seed;
+    for (size_t i = 0; i < n; ++i) {
+        previous = (in[i] * alpha) + (previous * (1.0f - alpha));
+        out[i] = previous;
+    }
+}
+
+void wilder_averages(const float* prices, size_t n, int period, float* avg_gain, float* avg_loss) {
+    if (period < 1 || n < static_cast<size_t>(period) + 1) {
+        throw std::invalid_argument("Wilder smoothing of " + std::to_string(period) +
+                                    " over " + std::to_string(n) + " prices");
+    }
+    if (const FixedKernels* fixed = find_fixed(period)) {
+        fixed->wilder(prices, n, avg_gain, avg_loss);
+        return;
+    }
+
+    float gain = 0.0f;
+    float loss = 0.0f;
+    for (int i = 1; i <= period; ++i) {
+        const float change = prices[i] - prices[i - 1];
+        gain += change > 0 ? change : 0.0f;
+        loss += change > 0 ? 0.0f : -change;
+    }
+    gain /= period;
+    loss /= period;
+    avg_gain[0] = gain;
+    avg_loss[0] = loss;
+
+    for (size_t t = period + 1; t < n; ++t) {
+        const float change = prices[t] - prices[t - 1];
+        gain = ((gain * (period - 1)) + (change > 0 ? change : 0.0f)) / period;
+        loss = ((loss * (period - 1)) + (change > 0 ? 0.0f : -change)) / period;
+        avg_gain[t - period] = gain;
+        avg_loss[t - period] = loss;
+    }
+}
+
+void rolling_max_drawdown(const float* prices, size_t n, int period, float* out) {
+    check_window(n, period);
+    const size_t count = n - period + 1;
+
+    if (!all_positive(prices, n)) {
+        for (size_t k = 0; k < count; ++k) {
+            out[k] = window_max_drawdown(prices + k, period);
+        }
+        return;
+    }
+
+    // van Herk/Gil-Werman: runs accumulate forward and backward within blocks of
+    // period prices, and each window joins the backward run from its start with
+    // the forward run to its end, so every price is combined a constant number of times
+    const size_t p = static_cast<size_t>(period);
+    auto& forward = drawdown_scratch(0);
+    auto& backward = drawdown_scratch(1);
+    forward.resize(n);
+    backward.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        forward[i] = i % p == 0 ? drawdown_run(prices[i]) : combine(forward[i - 1], drawdown_run(prices[i]));
+    }
+    for (size_t i = n; i-- > 0;) {
+        backward[i] = i % p == p - 1 || i == n - 1 ? drawdown_run(prices[i])
+                                                   : combine(drawdown_run(prices[i]), backward[i + 1]);
+    }
+    for (size_t k = 0; k < count; ++k) {
+        const DrawdownRun window = k % p == 0 ? backward[k] : combine(backward[k], forward[k + p - 1]);
+        out[k] = static_cast<float>(window.drop * 100.0);
+    }
+}
+
+void cumulative_return(const float* prices, size_t n, int period, float* out) {
+    if (period < 1 || n <= static_cast<size_t>(period)) {
+        throw std::invalid_argument("Cumulative return over " + std::to_string(period) +
+                                    " days of " + std::to_string(n) + " prices");
+    }
+    for (size_t k = 0; k + period < n; ++k) {
+        out[k] = prices[k] > kReturnEpsilon ? (prices[k + period] - prices[k]) / prices[k] * 100.0f : 0.0f;
+    }
+}
+
+Series rolling_mean(std::span<const float> in, int period) {
+    check_window(in.size(), period);
+    Series out(in.size() - period + 1);
+    rolling_mean(in.data(), in.size(), period, out.data());
+    return out;
+}
+
+Series rolling_stddev(std::span<const float> in, int period, bool sample, float scale) {
+    check_window(in.size(), period);
+    Series out(in.size() - period + 1);
+    rolling_stddev(in.data(), in.size(), period, sample, scale, out.data());
+    return out;
+}
+
+Series rolling_max_drawdown(std::span<const float> prices, int period) {
+    check_window(prices.size(), period);
+    Series out(prices.size() - period + 1);
+    rolling_max_drawdown(prices.data(), prices.size(), period, out.data());
+    return out;
+}
+
+Series cumulative_return(std::span<const float> prices, int period) {
+    Series out(period >= 1 && prices.size() > static_cast<size_t>(period) ? prices.size() - period : 0);
+    cumulative_return(prices.data(), prices.size(), period, out.data());
+    return out;
+}
+
+Series percent_returns(std::span<const float> prices) {
+    Series out(prices.size() < 2 ? 0 : prices.size() - 1);
+    percent_returns(prices.data(), prices.size(), out.data());
+    return out;
+}
+
+} // namespace ta
+} // namespace atlas
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "ta_kernels.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace atlas;
+
+class TAKernelBenchmarkTest : public ::testing::Test {
+protected:
+    static constexpr size_t kPrices = 5000;   // ~20 years of daily closes
+    static constexpr int kRuns = 7;
+
+    void TearDown() override {
+        ta::set_specialized_kernels(true);
+    }
+
+    static std::vector<float> random_walk(size_t size) {
+        std::mt19937 rng(11);
+        std::normal_distribution<float> step(0.0f, 2.0f);
+        std::vector<float> prices(size);
+        float price = 400.0f;
+        for (auto& p : prices) {
+            price = std::max(1.0f, price + step(rng));
+            p = price;
+        }
+        return prices;
+    }
+
+    // Best of kRuns, in nanoseconds per price
+    template <typename Kernel>
+    static double time_kernel(Kernel&& kernel, int iterations) {
+        double best = 1e300;
+        for (int run = 0; run < kRuns; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                kernel();
+            }
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        return best / (static_cast<double>(iterations) * kPrices);
+    }
+
+    template <typename Kernel>
+    static void report(const char* name, int period, Kernel&& kernel) {
+        constexpr int iterations = 200;
+        ta::set_specialized_kernels(false);
+        const double generic = time_kernel(kernel, iterations);
+        ta::set_specialized_kernels(true);
+        const double fixed = time_kernel(kernel, iterations);
+
+        std::cout << "  " << std::left << std::setw(16) << name << std::right << std::setw(4) << period
+                  << std::fixed << std::setprecision(3)
+                  << "  generic " << std::setw(7) << generic << " ns/price"
+                  << "  specialized " << std::setw(7) << fixed << " ns/price"
+                  << std::setprecision(2) << "  speedup " << generic / fixed << "x" << std::endl;
+    }
+};
+
+TEST_F(TAKernelBenchmarkTest, SpecializedVersusGenericKernels) {
+    auto prices = random_walk(kPrices);
+    std::vector<float> out(kPrices), gain(kPrices), loss(kPrices);
+
+    std::cout << "\nTA kernels, " << kPrices << " prices" << std::endl;
+    for (int period : {10, 14}) {
+        report("wilder_averages", period, [&] {
+            ta::wilder_averages(prices.data(), prices.size(), period, gain.data(), loss.data());
+        });
+    }
+    for (int period : {20, 50, 200}) {
+        report("rolling_mean", period, [&] {
+            ta::rolling_mean(prices.data(), prices.size(), period, out.data());
+        });
+    }
+    report("rolling_stddev", 20, [&] {
+        ta::rolling_stddev(prices.data(), prices.size(), 20, false, 1.0f, out.data());
+    });
+
+    // Keep the outputs observable
+    EXPECT_GT(gain[100] + loss[100] + out[100], 0.0f);
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "active_mask.h"
+#include "cpu_features.h"
+
+using namespace atlas;
+
+class ActiveMaskTest : public ::testing::Test {
+protected:
+    // Deterministic pattern spanning several words and a partial tail
+    static std::vector<bool> pattern(size_t size, size_t stride, size_t phase = 0) {
+        std::vector<bool> bools(size);
+        for (size_t i = 0; i < size; ++i) {
+            bools[i] = (i + phase) % stride == 0;
+        }
+        return bools;
+    }
+};
+
+TEST_F(ActiveMaskTest, RoundTripsBools) {
+    auto bools = pattern(1260, 3);
+    auto mask = ActiveMask::from_bools(bools);
+
+    EXPECT_EQ(mask.size(), 1260u);
+    EXPECT_EQ(mask.word_count(), 20u);
+    EXPECT_EQ(mask.to_bools(), bools);
+    for (size_t i = 0; i < bools.size(); ++i) {
+        ASSERT_EQ(mask[i], bools[i]) << "bit " << i;
+    }
+}
+
+TEST_F(ActiveMaskTest, ConstructFillAndResize) {
+    ActiveMask mask(70, true);
+    EXPECT_EQ(mask.count(), 70u);
+
+    mask.resize(130, true);
+    EXPECT_EQ(mask.count(), 130u);
+
+    mask.resize(100);
+    EXPECT_EQ(mask.count(), 100u);
+    mask.resize(140, false);
+    EXPECT_EQ(mask.count(), 100u);
+    EXPECT_FALSE(mask.test(120));
+
+    mask.fill(false);
+    EXPECT_TRUE(mask.none());
+    mask.set(99);
+    EXPECT_TRUE(mask.any());
+    mask.set(99, false);
+    EXPECT_FALSE(mask.any());
+}
+
+TEST_F(ActiveMaskTest, AlgebraMatchesBoolOps) {
+    // Long enough to exercise the SIMD body and the scalar tail
+    const size_t size = 1260;
+    auto a_bools = pattern(size, 2);
+    auto b_bools = pattern(size, 3, 1);
+    auto a = ActiveMask::from_bools(a_bools);
+    auto b = ActiveMask::from_bools(b_bools);
+
+    auto and_mask = a & b;
+    auto or_mask = a | b;
+    auto andnot_mask = a;
+    andnot_mask.and_not(b);
+    auto flipped = a;
+    flipped.flip();
+
+    for (size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(and_mask[i], a_bools[i] && b_bools[i]) << "bit " << i;
+        ASSERT_EQ(or_mask[i], a_bools[i] || b_bools[i]) << "bit " << i;
+        ASSERT_EQ(andnot_mask[i], a_bools[i] && !b_bools[i]) << "bit " << i;
+        ASSERT_EQ(flipped[i], !a_bools[i]) << "bit " << i;
+    }
+    EXPECT_EQ(flipped.count(), size - a.count());
+
+    ActiveMask other_size(10);
+    EXPECT_THROW(a &= other_size, std::invalid_argument);
+}
+
+TEST_F(ActiveMaskTest, EverySimdLevelAgrees) {
+    const size_t size = 1260;
+    auto a = ActiveMask::from_bools(pattern(size, 2));
+    auto b = ActiveMask::from_bools(pattern(size, 3, 1));
+    ActiveMask empty(size);
+
+    const auto saved = simd_level();
+    std::vector<std::vector<bool>> results;
+    std::vector<size_t> counts;
+    for (auto level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > detected_simd_level()) {
+            continue;
+        }
+        set_simd_level(level);
+        auto and_mask = a & b;
+        auto or_mask = a | b;
+        auto andnot_mask = a;
+        andnot_mask.and_not(b);
+        results.push_back(and_mask.to_bools());
+        results.push_back(or_mask.to_bools());
+        results.push_back(andnot_mask.to_bools());
+        counts.push_back(and_mask.count());
+        counts.push_back(or_mask.count());
+        EXPECT_TRUE(or_mask.any());
+        EXPECT_FALSE(empty.any());
+    }
+    set_simd_level(saved);
+
+    for (size_t i = 3; i < results.size(); ++i) {
+        EXPECT_EQ(results[i], results[i % 3]) << "level " << i / 3;
+    }
+    for (size_t i = 2; i < counts.size(); ++i) {
+        EXPECT_EQ(counts[i], counts[i % 2]) << "level " << i / 2;
+    }
+}
+
+TEST_F(ActiveMaskTest, CountAndScan) {
+    ActiveMask mask(1000);
+    EXPECT_EQ(mask.count(), 0u);
+    EXPECT_EQ(mask.first_set(), ActiveMask::npos);
+    EXPECT_EQ(mask.last_set(), ActiveMask::npos);
+
+    mask.set(130);
+    mask.set(640);
+    mask.set(999);
+    EXPECT_EQ(mask.count(), 3u);
+    EXPECT_EQ(mask.first_set(), 130u);
+    EXPECT_EQ(mask.last_set(), 999u);
+
+    std::vector<size_t> seen;
+    mask.for_each_set([&seen](size_t index) { seen.push_back(index); });
+    EXPECT_EQ(seen, (std::vector<size_t>{130, 640, 999}));
+}
+
+TEST_F(ActiveMaskTest, OffsetViewPadsFront) {
+    auto bools = pattern(200, 5);
+    auto mask = ActiveMask::from_bools(bools);
+
+    // Pad 73 active days in front, as a sort window does
+    auto padded = mask.view(-73, 273, true);
+    ASSERT_EQ(padded.size(), 273u);
+    for (size_t i = 0; i < padded.size(); ++i) {
+        bool expected = i < 73 ? true : bools[i - 73];
+        ASSERT_EQ(padded[i], expected) << "bit " << i;
+    }
+    EXPECT_EQ(padded.count(), 73u + mask.count());
+
+    ActiveMask materialized(padded);
+    for (size_t i = 0; i < padded.size(); ++i) {
+        ASSERT_EQ(materialized[i], padded[i]) << "bit " << i;
+    }
+}
+
+TEST_F(ActiveMaskTest, OffsetViewWindows) {
+    auto bools = pattern(300, 7, 3);
+    auto mask = ActiveMask::from_bools(bools);
+
+    // End-aligned window at an unaligned offset, then a window past the end
+    auto tail = mask.view(37, 263);
+    ActiveMask tail_mask(tail);
+    for (size_t i = 0; i < tail.size(); ++i) {
+        ASSERT_EQ(tail_mask[i], bools[i + 37]) << "bit " << i;
+    }
+
+    auto overrun = mask.view(250, 100);
+    for (size_t i = 0; i < overrun.size(); ++i) {
+        bool expected = i + 250 < bools.size() ? bools[i + 250] : false;
+        ASSERT_EQ(overrun[i], expected) << "bit " << i;
+    }
+
+    std::vector<size_t> seen;
+    tail.subview(10, 50).for_each_set([&seen](size_t index) { seen.push_back(index); });
+    for (size_t index : seen) {
+        EXPECT_TRUE(bools[index + 47]);
+    }
+    EXPECT_FALSE(mask.view(0, 0).any());
+}
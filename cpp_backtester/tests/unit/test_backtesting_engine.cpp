@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
-#include \"backtesting_engine.h\"
-#include \"strategy_parser.h\"
+#include "backtesting_engine.h"
+#include "global_cache.h"
+#include "strategy_parser.h"
+#include "trading_calendar.h"
 
 using namespace atlas;
 
@@ -10,12 +12,12 @@ protected:
     StrategyParser parser;
     
     // Simple stock-only strategy for testing
-    const std::string simple_strategy_json = R\"({
-        \"json\": \"{\\\"type\\\":\\\"root\\\",\\\"properties\\\":{\\\"id\\\":\\\"test\\\",\\\"step\\\":\\\"root\\\",\\\"name\\\":\\\"root node\\\"},\\\"sequence\\\":[{\\\"id\\\":\\\"stock1\\\",\\\"type\\\":\\\"stock\\\",\\\"name\\\":\\\"BUY AAPL\\\",\\\"properties\\\":{\\\"symbol\\\":\\\"AAPL\\\"}}],\\\"tickers\\\":[\\\"AAPL\\\"],\\\"indicators\\\":[]}\",
-        \"period\": \"5\",
-        \"end_date\": \"2024-11-25\",
-        \"hash\": \"test_hash\"
-    })\";
+    const std::string simple_strategy_json = R"({
+        "json": "{\"type\":\"root\",\"properties\":{\"id\":\"test\",\"step\":\"root\",\"name\":\"root node\"},\"sequence\":[{\"id\":\"stock1\",\"type\":\"stock\",\"name\":\"BUY AAPL\",\"properties\":{\"symbol\":\"AAPL\"}}],\"tickers\":[\"AAPL\"],\"indicators\":[]}",
+        "period": "5",
+        "end_date": "2024-11-25",
+        "hash": "test_hash"
+    })";
 };
 
 TEST_F(BacktestingEngineTest, ExecuteSimpleBacktest) {
@@ -26,7 +28,7 @@ TEST_F(BacktestingEngineTest, ExecuteSimpleBacktest) {
     BacktestParams params;
     params.strategy = strategy;
     params.period = 5;
-    params.end_date = \"2024-11-25\";
+    params.end_date = "2024-11-25";
     params.live_execution = false;
     params.global_cache_length = 0;
     
@@ -34,7 +36,7 @@ TEST_F(BacktestingEngineTest, ExecuteSimpleBacktest) {
     BacktestResult result = engine.execute_backtest(params);
     
     // Verify success
-    EXPECT_TRUE(result.success) << \"Backtest failed: \" << result.error_message;
+    EXPECT_TRUE(result.success) << "Backtest failed: " << result.error_message;
     EXPECT_GT(result.execution_time.count(), 0);
     
     // Verify portfolio history
@@ -44,7 +46,7 @@ TEST_F(BacktestingEngineTest, ExecuteSimpleBacktest) {
     bool found_aapl = false;
     for (const auto& day : result.portfolio_history) {
         for (const auto& stock : day.stock_list()) {
-            if (stock.ticker() == \"AAPL\") {
+            if (stock.ticker() == "AAPL") {
                 found_aapl = true;
                 EXPECT_GT(stock.weight_tomorrow(), 0.0f);
             }
@@ -53,6 +55,21 @@ TEST_F(BacktestingEngineTest, ExecuteSimpleBacktest) {
     EXPECT_TRUE(found_aapl);
 }
 
+TEST_F(BacktestingEngineTest, EndDateNamesTheLastBarOfEveryRun) {
+    // 2024-11-28 is Thanksgiving; in a live run 11-29 is today's bar
+    const auto& calendar = TradingCalendar::nyse();
+    auto days = engine.generate_date_range(5, "2024-11-29");
+    ASSERT_EQ(days.size(), 5u);
+    EXPECT_EQ(calendar.format(days.front()), "2024-11-22");
+    EXPECT_EQ(calendar.format(days.back()), "2024-11-29");
+
+    // The cache counts the same sessions: results through 11-27 miss only 11-29
+    const auto& cache = GlobalCache::instance();
+    EXPECT_EQ(cache.get_trading_days("2024-11-27", "2024-11-29"), 1);
+    EXPECT_EQ(cache.get_trading_days(calendar.format(days.front()), "2024-11-29"), static_cast<int>(days.size()) - 1);
+    EXPECT_EQ(cache.get_trading_days("2024-11-29", "2024-11-29"), 0);
+}
+
 TEST_F(BacktestingEngineTest, ExecuteBacktestInvalidParams) {
     BacktestParams invalid_params;
     invalid_params.period = 0; // Invalid period
@@ -69,21 +86,21 @@ TEST_F(BacktestingEngineTest, HandleBacktestingAPI) {
     // Parse response
     auto response = nlohmann::json::parse(json_response);
     
-    EXPECT_TRUE(response.contains(\"success\"));
-    EXPECT_TRUE(response[\"success\"].get<bool>());
-    EXPECT_TRUE(response.contains(\"execution_time_ms\"));
-    EXPECT_TRUE(response.contains(\"portfolio_history\"));
+    EXPECT_TRUE(response.contains("success"));
+    EXPECT_TRUE(response["success"].get<bool>());
+    EXPECT_TRUE(response.contains("execution_time_ms"));
+    EXPECT_TRUE(response.contains("portfolio_history"));
 }
 
 TEST_F(BacktestingEngineTest, HandleInvalidAPIRequest) {
-    std::string invalid_json = \"invalid json\";
+    std::string invalid_json = "invalid json";
     
     std::string json_response = engine.handle_backtesting_api(invalid_json);
     auto response = nlohmann::json::parse(json_response);
     
-    EXPECT_TRUE(response.contains(\"success\"));
-    EXPECT_FALSE(response[\"success\"].get<bool>());
-    EXPECT_TRUE(response.contains(\"error\"));
+    EXPECT_TRUE(response.contains("success"));
+    EXPECT_FALSE(response["success"].get<bool>());
+    EXPECT_TRUE(response.contains("error"));
 }
 
 TEST_F(BacktestingEngineTest, PostOrderDFSStockNode) {
@@ -94,16 +111,16 @@ TEST_F(BacktestingEngineTest, PostOrderDFSStockNode) {
     int common_data_span = 3;
     float node_weight = 1.0f;
     std::vector<DayData> portfolio_history(3);
-    std::vector<std::string> date_range = {\"2024-11-23\", \"2024-11-24\", \"2024-11-25\"};
+    auto date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-11-25"), 3);
     std::unordered_map<std::string, int> flow_count;
     std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-    std::unordered_map<std::string, std::vector<float>> indicator_cache;
+    IndicatorCache indicator_cache;
     std::unordered_map<std::string, std::vector<float>> price_cache;
     
     // Execute post-order DFS on stock node
     StrategyNode stock_node;
-    stock_node.type = \"stock\";
-    stock_node.properties = nlohmann::json{{\"symbol\", \"AAPL\"}};
+    stock_node.type = "stock";
+    stock_node.properties = nlohmann::json{{"symbol", "AAPL"}};
     
     int result = engine.post_order_dfs(
         stock_node, active_mask, common_data_span, node_weight,
@@ -128,16 +145,16 @@ TEST_F(BacktestingEngineTest, PostOrderDFSFolderNode) {
     
     // Create a folder node with child stock nodes
     StrategyNode folder_node;
-    folder_node.type = \"folder\";
-    folder_node.hash = \"folder_hash\";
+    folder_node.type = "folder";
+    folder_node.hash = "folder_hash";
     
     StrategyNode child1;
-    child1.type = \"stock\";
-    child1.properties = nlohmann::json{{\"symbol\", \"AAPL\"}};
+    child1.type = "stock";
+    child1.properties = nlohmann::json{{"symbol", "AAPL"}};
     
     StrategyNode child2;
-    child2.type = \"stock\";
-    child2.properties = nlohmann::json{{\"symbol\", \"GOOGL\"}};
+    child2.type = "stock";
+    child2.properties = nlohmann::json{{"symbol", "GOOGL"}};
     
     folder_node.sequence = {child1, child2};
     
@@ -146,10 +163,10 @@ TEST_F(BacktestingEngineTest, PostOrderDFSFolderNode) {
     int common_data_span = 2;
     float node_weight = 1.0f;
     std::vector<DayData> portfolio_history(2);
-    std::vector<std::string> date_range = {\"2024-11-24\", \"2024-11-25\"};
+    auto date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-11-25"), 2);
     std::unordered_map<std::string, int> flow_count;
     std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-    std::unordered_map<std::string, std::vector<float>> indicator_cache;
+    IndicatorCache indicator_cache;
     std::unordered_map<std::string, std::vector<float>> price_cache;
     
     int result = engine.post_order_dfs(
@@ -161,14 +178,14 @@ TEST_F(BacktestingEngineTest, PostOrderDFSFolderNode) {
     EXPECT_EQ(result, common_data_span);
     
     // Verify flow count was incremented for folder
-    EXPECT_EQ(flow_count[\"folder_hash\"], 1);
+    EXPECT_EQ(flow_count["folder_hash"], 1);
     
     // Verify both stocks were added
     bool found_aapl = false, found_googl = false;
     for (const auto& day : portfolio_history) {
         for (const auto& stock : day.stock_list()) {
-            if (stock.ticker() == \"AAPL\") found_aapl = true;
-            if (stock.ticker() == \"GOOGL\") found_googl = true;
+            if (stock.ticker() == "AAPL") found_aapl = true;
+            if (stock.ticker() == "GOOGL") found_googl = true;
         }
     }
     EXPECT_TRUE(found_aapl);
@@ -179,16 +196,16 @@ TEST_F(BacktestingEngineTest, PostOrderDFSUnknownNodeType) {
     Strategy strategy = parser.parse_strategy(simple_strategy_json);
     
     StrategyNode unknown_node;
-    unknown_node.type = \"unknown_type\";
+    unknown_node.type = "unknown_type";
     
     std::vector<bool> active_mask = {true};
     int common_data_span = 1;
     float node_weight = 1.0f;
     std::vector<DayData> portfolio_history(1);
-    std::vector<std::string> date_range = {\"2024-11-25\"};
+    auto date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-11-25"), 1);
     std::unordered_map<std::string, int> flow_count;
     std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-    std::unordered_map<std::string, std::vector<float>> indicator_cache;
+    IndicatorCache indicator_cache;
     std::unordered_map<std::string, std::vector<float>> price_cache;
     
     EXPECT_THROW({
@@ -198,4 +215,4 @@ TEST_F(BacktestingEngineTest, PostOrderDFSUnknownNodeType) {
             indicator_cache, price_cache, strategy
         );
     }, std::runtime_error);
-}", "original_text": "", "replace_all": false}]
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,571 @@
+#include <gtest/gtest.h>
+#include "execution_plan.h"
+#include "plan_executor.h"
+#include <thread>
+
+using namespace atlas;
+
+class ExecutionPlanTest : public ::testing::Test {
+protected:
+    PlanCompiler compiler;
+    PlanExecutor executor;
+
+    std::vector<int32_t> date_range{0, 1, 2, 3, 4};
+    std::unordered_map<std::string, int> flow_count;
+    std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
+    IndicatorCache indicator_cache;
+    std::unordered_map<std::string, std::vector<float>> price_cache;
+    Strategy strategy;
+
+    static nlohmann::json stock(const std::string& symbol, const std::string& hash = "") {
+        nlohmann::json node = {{"type", "stock"}, {"properties", {{"symbol", symbol}}}};
+        if (!hash.empty()) {
+            node["hash"] = hash;
+        }
+        return node;
+    }
+
+    PlanExecutionContext make_context() {
+        return PlanExecutionContext{
+            date_range, flow_count, flow_stocks, indicator_cache, price_cache, strategy, false, 0
+        };
+    }
+
+    float total_weight(const DayData& day, const std::string& ticker) const {
+        float weight = 0.0f;
+        for (const auto& stock : day.stock_list()) {
+            if (stock.ticker() == ticker) {
+                weight += stock.weight_tomorrow();
+            }
+        }
+        return weight;
+    }
+};
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+TEST_F(ExecutionPlanTest, ResolveNodeKinds) {
+    EXPECT_EQ(resolve_node_kind("root"), NodeKind::ROOT);
+    EXPECT_EQ(resolve_node_kind("folder"), NodeKind::FOLDER);
+    EXPECT_EQ(resolve_node_kind("stock"), NodeKind::STOCK);
+    EXPECT_EQ(resolve_node_kind("condition"), NodeKind::CONDITION);
+    EXPECT_EQ(resolve_node_kind("Sort"), NodeKind::SORT);
+    EXPECT_EQ(resolve_node_kind("allocation"), NodeKind::ALLOCATION);
+    EXPECT_EQ(resolve_node_kind("comment"), NodeKind::NOOP);
+    EXPECT_EQ(resolve_node_kind("icon"), NodeKind::NOOP);
+    EXPECT_THROW(resolve_node_kind("unknown"), StrategyParseError);
+}
+
+TEST_F(ExecutionPlanTest, CompileIsPostOrder) {
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {
+            {{"type", "folder"}, {"sequence", {stock("AAPL"), stock("MSFT")}}},
+            {{"type", "comment"}},
+            stock("SPY")
+        }}
+    });
+
+    ExecutionPlan plan = compiler.compile(root);
+
+    // Comment is dropped: AAPL, MSFT, folder, SPY, root
+    ASSERT_EQ(plan.size(), 5u);
+    EXPECT_EQ(plan.root_index, 4u);
+    EXPECT_EQ(plan.root().kind, NodeKind::ROOT);
+    EXPECT_EQ(plan.instructions[0].stock().symbol, "AAPL");
+    EXPECT_EQ(plan.instructions[2].kind, NodeKind::FOLDER);
+
+    // Every child precedes its parent
+    for (uint32_t i = 0; i < plan.size(); ++i) {
+        const auto& instruction = plan.instructions[i];
+        for (uint32_t g = 0; g < instruction.group_count; ++g) {
+            const auto& group = plan.group(instruction, g);
+            for (uint32_t c = 0; c < group.child_count; ++c) {
+                EXPECT_LT(plan.children[group.first_child + c], i);
+            }
+        }
+    }
+
+    const auto& root_group = plan.group(plan.root(), 0);
+    EXPECT_EQ(root_group.child_count, 2u);
+}
+
+TEST_F(ExecutionPlanTest, CompileParsesSortParameters) {
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {{
+            {"type", "Sort"},
+            {"properties", {
+                {"select", {{"function", "Bottom"}, {"howmany", "2"}}},
+                {"sortby", {{"function", "Relative Strength Index"}, {"window", "10"}}}
+            }},
+            {"branches", {{"Bottom-2", {stock("AAPL"), {{"type", "icon"}}, stock("MSFT"), stock("SPY")}}}}
+        }}}
+    });
+
+    ExecutionPlan plan = compiler.compile(root);
+    const auto& sort = plan.instructions[plan.size() - 2];
+
+    ASSERT_EQ(sort.kind, NodeKind::SORT);
+    EXPECT_EQ(sort.sort().select_function, SelectFunction::BOTTOM);
+    EXPECT_EQ(sort.sort().selection_count, 2);
+    EXPECT_EQ(sort.sort().sort_function, SortFunction::RELATIVE_STRENGTH_INDEX);
+    EXPECT_EQ(sort.sort().window, 10);
+    EXPECT_FALSE(sort.has_folder_branch);
+
+    // One candidate group per non-icon node, each with its own result slot
+    EXPECT_EQ(sort.group_count, 3u);
+    EXPECT_EQ(sort.result_slot, 0);
+    EXPECT_EQ(plan.result_slot_count, 3u);
+}
+
+TEST_F(ExecutionPlanTest, CompileManualAllocationWeights) {
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {{
+            {"type", "allocation"},
+            {"properties", {
+                {"function", "Allocation"},
+                {"values", {{"a (w%)", 25.0}, {"b (w%)", 75.0}}}
+            }},
+            {"branches", {{"a", {stock("AAPL")}}, {"b", {stock("MSFT")}}}}
+        }}}
+    });
+
+    ExecutionPlan plan = compiler.compile(root);
+    const auto& allocation = plan.instructions[plan.size() - 2];
+
+    ASSERT_EQ(allocation.kind, NodeKind::ALLOCATION);
+    ASSERT_EQ(allocation.group_count, 2u);
+    EXPECT_FLOAT_EQ(plan.group(allocation, 0).weight, 0.25f);
+    EXPECT_FLOAT_EQ(plan.group(allocation, 1).weight, 0.75f);
+}
+
+TEST_F(ExecutionPlanTest, CompileRejectsInvalidNodes) {
+    StrategyNode missing_symbol(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {{{"type", "stock"}, {"properties", nlohmann::json::object()}}}}
+    });
+    EXPECT_THROW(compiler.compile(missing_symbol), PlanCompileError);
+
+    StrategyNode bad_comparison(nlohmann::json{
+        {"type", "condition"},
+        {"properties", {{"x", nlohmann::json::object()}, {"y", nlohmann::json::object()}, {"comparison", "~"}}},
+        {"branches", {{"true", nlohmann::json::array()}, {"false", nlohmann::json::array()}}}
+    });
+    EXPECT_THROW(compiler.compile(bad_comparison), PlanCompileError);
+}
+
+// ============================================================================
+// Execution
+// ============================================================================
+
+TEST_F(ExecutionPlanTest, ExecuteFolderSplitsWeight) {
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {
+            {{"type", "folder"}, {"hash", "folder_hash"}, {"sequence", {stock("AAPL"), stock("MSFT")}}},
+            stock("SPY", "spy_hash")
+        }}
+    });
+
+    ExecutionPlan plan = compiler.compile(root);
+    std::vector<bool> active_mask(5, true);
+    active_mask[1] = false;
+    std::vector<DayData> portfolio(5);
+    auto context = make_context();
+
+    int days = executor.execute(plan, active_mask, 5, 1.0f, portfolio, context);
+
+    EXPECT_EQ(days, 5);
+    EXPECT_FLOAT_EQ(total_weight(portfolio[0], "SPY"), 0.5f);
+    EXPECT_FLOAT_EQ(total_weight(portfolio[0], "AAPL"), 0.25f);
+    EXPECT_FLOAT_EQ(total_weight(portfolio[0], "MSFT"), 0.25f);
+    EXPECT_TRUE(portfolio[1].empty());
+    EXPECT_EQ(flow_count["folder_hash"], 1);
+    EXPECT_EQ(flow_count["spy_hash"], 1);
+    EXPECT_EQ(flow_stocks["spy_hash"].size(), 5u);
+}
+
+TEST_F(ExecutionPlanTest, ExecuteNestedFolders) {
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {stock("AAPL"), {{"type", "folder"}, {"sequence", {stock("MSFT"), stock("SPY")}}}}}
+    });
+
+    ExecutionPlan plan = compiler.compile(root);
+    std::vector<bool> active_mask(5, true);
+    std::vector<DayData> portfolio(5);
+    auto context = make_context();
+    executor.execute(plan, active_mask, 5, 1.0f, portfolio, context);
+
+    for (const auto& day : portfolio) {
+        EXPECT_FLOAT_EQ(total_weight(day, "AAPL"), 0.5f);
+        EXPECT_FLOAT_EQ(total_weight(day, "MSFT"), 0.25f);
+        EXPECT_FLOAT_EQ(total_weight(day, "SPY"), 0.25f);
+    }
+}
+
+TEST_F(ExecutionPlanTest, ExecuteEqualAllocation) {
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {{
+            {"type", "allocation"},
+            {"properties", {{"function", "Equal Allocation"}}},
+            {"branches", {{"a", {stock("AAPL")}}, {"b", {stock("MSFT")}}}}
+        }}}
+    });
+
+    ExecutionPlan plan = compiler.compile(root);
+    std::vector<bool> active_mask(5, true);
+    std::vector<DayData> portfolio(5);
+    auto context = make_context();
+    executor.execute(plan, active_mask, 5, 1.0f, portfolio, context);
+
+    EXPECT_FLOAT_EQ(total_weight(portfolio[4], "AAPL"), 0.5f);
+    EXPECT_FLOAT_EQ(total_weight(portfolio[4], "MSFT"), 0.5f);
+}
+
+TEST_F(ExecutionPlanTest, ParallelMatchesSerial) {
+    auto condition = [](const std::string& hash, nlohmann::json true_nodes, nlohmann::json false_nodes) {
+        return nlohmann::json{
+            {"type", "condition"},
+            {"hash", hash},
+            {"properties", {
+                {"comparison", ">"},
+                {"x", {{"indicator", "current price"}, {"source", "SPY"}}},
+                {"y", {{"indicator", "Fixed-Value"}, {"period", "100.25"}}}
+            }},
+            {"branches", {{"true", std::move(true_nodes)}, {"false", std::move(false_nodes)}}}
+        };
+    };
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"hash", "root"},
+        {"sequence", {
+            {{"type", "folder"}, {"hash", "f1"}, {"sequence", {
+                stock("AAPL", "s1"),
+                condition("c1",
+                    {stock("MSFT", "s2"), {{"type", "folder"}, {"hash", "f2"}, {"sequence", {stock("SPY", "s3"), stock("QQQ", "s4")}}}},
+                    {stock("TLT", "s5")})
+            }}},
+            {
+                {"type", "Sort"},
+                {"hash", "sort"},
+                {"properties", {
+                    {"select", {{"function", "Top"}, {"howmany", "1"}}},
+                    {"sortby", {{"function", "Relative Strength Index"}, {"window", "3"}}}
+                }},
+                {"branches", {{"Top-1", {stock("GLD", "s6"), stock("SLV", "s7")}}}}
+            },
+            {
+                {"type", "allocation"},
+                {"hash", "alloc"},
+                {"properties", {{"function", "Equal Allocation"}}},
+                {"branches", {{"a", {stock("IEF", "s8")}}, {"b", {condition("c2", {stock("XLE", "s9")}, {stock("XLF", "s10")})}}}}
+            }
+        }}
+    });
+    ExecutionPlan plan = compiler.compile(root);
+
+    auto run = [&](PlanExecutor& runner, std::unordered_map<std::string, int>& counts,
+                   std::unordered_map<std::string, std::vector<DayData>>& stocks) {
+        IndicatorCache indicators;
+        std::unordered_map<std::string, std::vector<float>> prices;
+        PlanExecutionContext context{date_range, counts, stocks, indicators, prices, strategy, false, 0};
+        std::vector<bool> active_mask(5, true);
+        std::vector<DayData> portfolio(5);
+        int days = runner.execute(plan, active_mask, 5, 1.0f, portfolio, context);
+        return std::make_pair(days, portfolio);
+    };
+
+    std::unordered_map<std::string, int> serial_counts;
+    std::unordered_map<std::string, std::vector<DayData>> serial_stocks;
+    auto [serial_days, serial_portfolio] = run(executor, serial_counts, serial_stocks);
+
+    PlanExecutor parallel(ParallelOptions{4, 1});
+    std::unordered_map<std::string, int> parallel_counts;
+    std::unordered_map<std::string, std::vector<DayData>> parallel_stocks;
+    auto [parallel_days, parallel_portfolio] = run(parallel, parallel_counts, parallel_stocks);
+
+    // Identical results, including stock order within each day
+    EXPECT_EQ(parallel_days, serial_days);
+    EXPECT_EQ(parallel_portfolio, serial_portfolio);
+    EXPECT_EQ(parallel_counts, serial_counts);
+    EXPECT_EQ(parallel_stocks, serial_stocks);
+    EXPECT_EQ(serial_stocks.size(), 14u);
+}
+
+TEST_F(ExecutionPlanTest, ParallelBelowThresholdRunsSerially) {
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {stock("AAPL", "a"), stock("MSFT", "b")}}
+    });
+    ExecutionPlan plan = compiler.compile(root);
+
+    PlanExecutor parallel(ParallelOptions{2, 100});
+    EXPECT_EQ(parallel.parallel_options().thread_count, 2u);
+
+    std::vector<bool> active_mask(5, true);
+    std::vector<DayData> portfolio(5);
+    auto context = make_context();
+    parallel.execute(plan, active_mask, 5, 1.0f, portfolio, context);
+
+    ASSERT_EQ(portfolio[0].size(), 2u);
+    EXPECT_EQ(portfolio[0].stock_list()[0].ticker(), "AAPL");
+    EXPECT_EQ(portfolio[0].stock_list()[1].ticker(), "MSFT");
+    EXPECT_EQ(flow_stocks["b"][0].size(), 2u);
+}
+
+TEST_F(ExecutionPlanTest, SharedSubtreesLoweredOnce) {
+    auto block = [](const std::string& hash) {
+        return nlohmann::json{
+            {"type", "folder"},
+            {"hash", hash},
+            {"nodeChildrenHash", "block"},
+            {"sequence", {stock("AAPL"), stock("MSFT")}}
+        };
+    };
+    nlohmann::json different = block("f3");
+    different["properties"] = {{"name", "other"}};
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {block("f1"), {{"type", "folder"}, {"sequence", {block("f2"), stock("SPY")}}}, different}}
+    });
+
+    ExecutionPlan plan = compiler.compile(root);
+
+    // Root, outer folder, SPY, two copies of the block (3 each): f1 and f2 share one
+    EXPECT_EQ(plan.size(), 9u);
+    EXPECT_EQ(plan.shared_subtree_count, 1u);
+    const auto& root_group = plan.group(plan.root(), 0);
+    const auto& first = plan.child(root_group, 0);
+    EXPECT_EQ(first.shared_index, 0);
+    const auto& outer = plan.child(root_group, 1);
+    EXPECT_EQ(&plan.child(plan.group(outer, 0), 0), &first);
+    EXPECT_EQ(plan.child(root_group, 2).shared_index, -1);
+
+    compiler.set_deduplicate_subtrees(false);
+    EXPECT_EQ(compiler.compile(root).shared_subtree_count, 0u);
+}
+
+TEST_F(ExecutionPlanTest, SharedSubtreeReplayMatchesDirect) {
+    // Both copies share a body but keep their own hashes, so flow data must land on each copy's nodes
+    auto block = [](const std::string& prefix) {
+        return nlohmann::json{
+            {"type", "condition"},
+            {"hash", prefix + "c"},
+            {"nodeChildrenHash", "block"},
+            {"properties", {
+                {"comparison", ">"},
+                {"x", {{"indicator", "current price"}, {"source", "SPY"}}},
+                {"y", {{"indicator", "Fixed-Value"}, {"period", "100.25"}}}
+            }},
+            {"branches", {
+                {"true", {stock("AAPL", prefix + "a"), stock("MSFT", prefix + "m")}},
+                {"false", {stock("TLT", prefix + "t")}}
+            }}
+        };
+    };
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {block("x"), {{"type", "folder"}, {"sequence", {block("y"), stock("SPY"), stock("QQQ")}}}}}
+    });
+
+    std::vector<bool> active_mask(5, true);
+    active_mask[3] = false;
+
+    std::vector<DayData> direct(5);
+    compiler.set_deduplicate_subtrees(false);
+    ExecutionPlan direct_plan = compiler.compile(root);
+    auto direct_context = make_context();
+    int direct_days = executor.execute(direct_plan, active_mask, 5, 1.0f, direct, direct_context);
+
+    std::unordered_map<std::string, int> shared_counts;
+    std::unordered_map<std::string, std::vector<DayData>> shared_stocks;
+    std::vector<DayData> shared(5);
+    compiler.set_deduplicate_subtrees(true);
+    ExecutionPlan shared_plan = compiler.compile(root);
+    ASSERT_EQ(shared_plan.shared_subtree_count, 1u);
+    PlanExecutionContext shared_context{
+        date_range, shared_counts, shared_stocks, indicator_cache, price_cache, strategy, false, 0
+    };
+    int shared_days = executor.execute(shared_plan, active_mask, 5, 1.0f, shared, shared_context);
+
+    EXPECT_EQ(shared_days, direct_days);
+    for (size_t day = 0; day < direct.size(); ++day) {
+        ASSERT_EQ(shared[day].size(), direct[day].size()) << "day " << day;
+        for (const char* ticker : {"AAPL", "MSFT", "TLT", "SPY", "QQQ"}) {
+            EXPECT_FLOAT_EQ(total_weight(shared[day], ticker), total_weight(direct[day], ticker))
+                << ticker << " day " << day;
+        }
+    }
+    EXPECT_TRUE(shared[3].empty());
+    EXPECT_FLOAT_EQ(total_weight(shared[4], "AAPL"), 0.25f + 0.5f / 3.0f / 2.0f);
+
+    EXPECT_EQ(shared_counts, flow_count);
+    EXPECT_EQ(shared_stocks, flow_stocks);
+    EXPECT_TRUE(shared_counts.count("yc"));
+    EXPECT_TRUE(shared_stocks.count("yc"));
+}
+
+TEST_F(ExecutionPlanTest, ParallelSharedSortMatchesSerial) {
+    // A shared sort is reached at the run's span and, inside a folder candidate, at the padded span,
+    // so its evaluations overlap on the pool and each needs its own candidate slots
+    auto block = [](const std::string& prefix) {
+        return nlohmann::json{
+            {"type", "Sort"},
+            {"hash", prefix + "sort"},
+            {"nodeChildrenHash", "block"},
+            {"properties", {
+                {"select", {{"function", "Top"}, {"howmany", "1"}}},
+                {"sortby", {{"function", "Relative Strength Index"}, {"window", "3"}}}
+            }},
+            {"branches", {{"Top-1", {
+                {{"type", "folder"}, {"hash", prefix + "fa"}, {"sequence", {stock("AAPL", prefix + "a"), stock("MSFT", prefix + "m")}}},
+                {{"type", "folder"}, {"hash", prefix + "fb"}, {"sequence", {stock("TLT", prefix + "t")}}}
+            }}}}
+        };
+    };
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"hash", "root"},
+        {"sequence", {
+            block("x"),
+            {{"type", "folder"}, {"hash", "o"}, {"sequence", {block("y"), stock("SPY", "spy")}}},
+            {
+                {"type", "Sort"},
+                {"hash", "outer"},
+                {"properties", {
+                    {"select", {{"function", "Top"}, {"howmany", "1"}}},
+                    {"sortby", {{"function", "Relative Strength Index"}, {"window", "3"}}}
+                }},
+                {"branches", {{"Top-1", {
+                    {{"type", "folder"}, {"hash", "c1"}, {"sequence", {block("z"), stock("QQQ", "qqq")}}},
+                    {{"type", "folder"}, {"hash", "c2"}, {"sequence", {block("w"), stock("GLD", "gld")}}}
+                }}}}
+            }
+        }}
+    });
+
+    auto run = [&](const ExecutionPlan& plan, PlanExecutor& runner, std::unordered_map<std::string, int>& counts,
+                   std::unordered_map<std::string, std::vector<DayData>>& stocks) {
+        IndicatorCache indicators;
+        std::unordered_map<std::string, std::vector<float>> prices;
+        PlanExecutionContext context{date_range, counts, stocks, indicators, prices, strategy, false, 0};
+        std::vector<bool> active_mask(5, true);
+        active_mask[1] = false;
+        std::vector<DayData> portfolio(5);
+        int days = runner.execute(plan, active_mask, 5, 1.0f, portfolio, context);
+        return std::make_pair(days, portfolio);
+    };
+
+    compiler.set_deduplicate_subtrees(false);
+    ExecutionPlan direct_plan = compiler.compile(root);
+    std::unordered_map<std::string, int> direct_counts;
+    std::unordered_map<std::string, std::vector<DayData>> direct_stocks;
+    auto [direct_days, direct_portfolio] = run(direct_plan, executor, direct_counts, direct_stocks);
+
+    compiler.set_deduplicate_subtrees(true);
+    ExecutionPlan shared_plan = compiler.compile(root);
+    ASSERT_EQ(shared_plan.shared_subtree_count, 1u);
+    ASSERT_LT(shared_plan.size(), direct_plan.size());
+
+    PlanExecutor parallel(ParallelOptions{4, 1});
+    for (int attempt = 0; attempt < 20; ++attempt) {
+        std::unordered_map<std::string, int> counts;
+        std::unordered_map<std::string, std::vector<DayData>> stocks;
+        auto [days, portfolio] = run(shared_plan, parallel, counts, stocks);
+
+        EXPECT_EQ(days, direct_days);
+        EXPECT_EQ(portfolio, direct_portfolio);
+        EXPECT_EQ(counts, direct_counts);
+        EXPECT_EQ(stocks, direct_stocks);
+        EXPECT_TRUE(counts.count("wsort"));
+    }
+}
+
+TEST_F(ExecutionPlanTest, ConcurrentRunsOnOneExecutor) {
+    // Result slots and shared subtree state belong to each run, so runs on one executor do not interfere
+    auto block = [](const std::string& prefix) {
+        return nlohmann::json{
+            {"type", "Sort"},
+            {"hash", prefix + "sort"},
+            {"nodeChildrenHash", "block"},
+            {"properties", {
+                {"select", {{"function", "Top"}, {"howmany", "1"}}},
+                {"sortby", {{"function", "Relative Strength Index"}, {"window", "3"}}}
+            }},
+            {"branches", {{"Top-1", {
+                {{"type", "folder"}, {"hash", prefix + "fa"}, {"sequence", {stock("AAPL", prefix + "a")}}},
+                {{"type", "folder"}, {"hash", prefix + "fb"}, {"sequence", {stock("TLT", prefix + "t")}}}
+            }}}}
+        };
+    };
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"hash", "root"},
+        {"sequence", {
+            block("x"),
+            {
+                {"type", "condition"},
+                {"hash", "c"},
+                {"properties", {
+                    {"comparison", ">"},
+                    {"x", {{"indicator", "Relative Strength Index"}, {"source", "SPY"}, {"period", "3"}}},
+                    {"y", {{"indicator", "Fixed-Value"}, {"period", "50"}}}
+                }},
+                {"branches", {{"true", {block("y")}}, {"false", {stock("GLD", "gld")}}}}
+            }
+        }}
+    });
+    ExecutionPlan plan = compiler.compile(root);
+    ASSERT_EQ(plan.shared_subtree_count, 1u);
+
+    // Nothing is prefetched, so the condition's lazy insert races the other runs' reads
+    auto run = [&](PlanExecutor& runner, std::unordered_map<std::string, int>& counts,
+                   std::unordered_map<std::string, std::vector<DayData>>& stocks) {
+        IndicatorCache indicators;
+        std::unordered_map<std::string, std::vector<float>> prices;
+        PlanExecutionContext context{date_range, counts, stocks, indicators, prices, strategy, false, 0};
+        std::vector<bool> active_mask(5, true);
+        std::vector<DayData> portfolio(5);
+        int days = runner.execute(plan, active_mask, 5, 1.0f, portfolio, context);
+        return std::make_pair(days, portfolio);
+    };
+
+    std::unordered_map<std::string, int> serial_counts;
+    std::unordered_map<std::string, std::vector<DayData>> serial_stocks;
+    auto [serial_days, serial_portfolio] = run(executor, serial_counts, serial_stocks);
+
+    PlanExecutor parallel(ParallelOptions{4, 1});
+    constexpr size_t kRuns = 4;
+    std::vector<std::unordered_map<std::string, int>> counts(kRuns);
+    std::vector<std::unordered_map<std::string, std::vector<DayData>>> stocks(kRuns);
+    std::vector<std::pair<int, std::vector<DayData>>> results(kRuns);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kRuns; ++i) {
+        threads.emplace_back([&, i] { results[i] = run(parallel, counts[i], stocks[i]); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < kRuns; ++i) {
+        EXPECT_EQ(results[i].first, serial_days);
+        EXPECT_EQ(results[i].second, serial_portfolio);
+        EXPECT_EQ(counts[i], serial_counts);
+        EXPECT_EQ(stocks[i], serial_stocks);
+    }
+}
+
+TEST_F(ExecutionPlanTest, ExecuteEmptyPlanThrows) {
+    ExecutionPlan plan;
+    std::vector<bool> active_mask(5, true);
+    std::vector<DayData> portfolio(5);
+    auto context = make_context();
+
+    EXPECT_THROW(executor.execute(plan, active_mask, 5, 1.0f, portfolio, context), NodeProcessingError);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "indicator_cache.h"
+#include "indicator_planner.h"
+#include <numeric>
+#include <unordered_set>
+
+using namespace atlas;
+
+TEST(IndicatorCacheTest, KeysUseTheEffectivePeriod) {
+    // SMA without a period is the default window, so both spellings share an entry
+    auto implicit = IndicatorKey::of("SPY", *IndicatorPlanner::batch_spec("Simple Moving Average of Price", 0));
+    auto explicit_20 = IndicatorKey::of("SPY", *IndicatorPlanner::batch_spec("Simple Moving Average of Price", 20));
+    EXPECT_EQ(implicit, explicit_20);
+    EXPECT_EQ(IndicatorKeyHash{}(implicit), IndicatorKeyHash{}(explicit_20));
+
+    // Dotted symbols resolve to the same ticker as their data-file spelling
+    EXPECT_EQ(IndicatorKey::of("BRK.B", {ta::IndicatorKind::RSI, 14}), IndicatorKey::of("BRK-B", {ta::IndicatorKind::RSI, 14}));
+
+    std::unordered_set<IndicatorKey, IndicatorKeyHash> keys;
+    for (auto kind : {ta::IndicatorKind::SMA, ta::IndicatorKind::RSI, ta::IndicatorKind::EMA}) {
+        for (int period : {10, 14, 20}) {
+            keys.insert(IndicatorKey::of("SPY", {kind, period}));
+            keys.insert(IndicatorKey::of("QQQ", {kind, period}));
+        }
+    }
+    EXPECT_EQ(keys.size(), 18u);
+}
+
+TEST(IndicatorCacheTest, ViewsShareCachedStorage) {
+    IndicatorCache cache;
+    const auto key = IndicatorKey::of("SPY", {ta::IndicatorKind::RSI, 14});
+    EXPECT_FALSE(cache.find(key, 10).has_value());
+
+    std::vector<float> values(100);
+    std::iota(values.begin(), values.end(), 0.0f);
+    auto inserted = cache.insert(key, values, 30);
+    ASSERT_EQ(inserted.size(), 30u);
+    EXPECT_EQ(inserted.front(), 70.0f);
+
+    // Lookups return the tail of the stored series without copying it
+    auto view = *cache.find(key, 10);
+    ASSERT_EQ(view.size(), 10u);
+    EXPECT_EQ(view.data(), inserted.data() + 20);
+    EXPECT_EQ(cache.find(key, 1000)->size(), 100u);
+
+    // Existing series are kept, and other inserts leave earlier views valid
+    cache.insert(key, std::vector<float>(5, -1.0f), 5);
+    for (int i = 0; i < 64; ++i) {
+        cache.insert(IndicatorKey::of("SPY", {ta::IndicatorKind::SMA, i + 1}), std::vector<float>(8), 8);
+    }
+    EXPECT_EQ(cache.find(key, 10)->data(), view.data());
+    EXPECT_EQ(view.back(), 99.0f);
+    EXPECT_EQ(cache.size(), 65u);
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "indicator_planner.h"
+#include "execution_plan.h"
+#include "conditional_node.h"
+#include <cmath>
+
+using namespace atlas;
+
+class IndicatorPlannerTest : public ::testing::Test {
+protected:
+    PlanCompiler compiler;
+    IndicatorCache indicator_cache;
+    std::unordered_map<std::string, std::vector<float>> price_cache;
+
+    static nlohmann::json stock(const std::string& symbol) {
+        return {{"type", "stock"}, {"properties", {{"symbol", symbol}}}};
+    }
+
+    static nlohmann::json operand(const std::string& indicator, const std::string& source, int period) {
+        return {{"indicator", indicator}, {"source", source}, {"period", std::to_string(period)}};
+    }
+
+    static nlohmann::json condition(nlohmann::json x, const std::string& comparison, nlohmann::json y) {
+        return {
+            {"type", "condition"},
+            {"properties", {{"x", std::move(x)}, {"y", std::move(y)}, {"comparison", comparison}}},
+            {"branches", {{"true", {stock("SPY")}}, {"false", {stock("BIL")}}}}
+        };
+    }
+
+    // Two SPY conditions sharing an RSI, and a QQQ condition inside a folder candidate of an RSI sort
+    static StrategyNode strategy() {
+        auto rsi = operand("Relative Strength Index", "SPY", 14);
+        auto fixed = nlohmann::json{{"indicator", "Fixed-Value"}, {"period", "70"}};
+        return StrategyNode(nlohmann::json{
+            {"type", "root"},
+            {"sequence", {
+                condition(rsi, ">", fixed),
+                condition(rsi, "<", operand("Simple Moving Average of Price", "SPY", 50)),
+                {{"type", "Sort"},
+                 {"properties", {
+                     {"select", {{"function", "Top"}, {"howmany", "1"}}},
+                     {"sortby", {{"function", "Relative Strength Index"}, {"window", "10"}}}
+                 }},
+                 {"branches", {{"Top-1", {
+                     stock("TLT"),
+                     {{"type", "folder"}, {"sequence", {
+                         condition(operand("current price", "QQQ", 0), ">",
+                                   operand("Simple Moving Average of Price", "QQQ", 20))
+                     }}}
+                 }}}}}
+            }}
+        });
+    }
+
+    // Full cached series of a key
+    std::vector<float> cached(const IndicatorKey& key) const {
+        auto values = indicator_cache.find(key, SIZE_MAX);
+        return values ? std::vector<float>(values->begin(), values->end()) : std::vector<float>{};
+    }
+
+    static std::vector<float> zigzag(int days) {
+        std::vector<float> prices(days);
+        for (int i = 0; i < days; ++i) {
+            prices[i] = 100.0f + 5.0f * std::sin(i * 0.3f) + i * 0.05f;
+        }
+        return prices;
+    }
+};
+
+TEST_F(IndicatorPlannerTest, DedupesRequestsAndSizesLookbacks) {
+    auto plan = compiler.compile(strategy());
+    auto indicators = IndicatorPlanner::plan(plan, 100);
+
+    ASSERT_EQ(indicators.requests.size(), 3u);
+    EXPECT_EQ(indicators.requests[0].cache_key(), IndicatorKey::of("SPY", {ta::IndicatorKind::RSI, 14}));
+    EXPECT_EQ(indicators.requests[1].cache_key(), IndicatorKey::of("SPY", {ta::IndicatorKind::SMA, 50}));
+    EXPECT_EQ(indicators.requests[2].cache_key(), IndicatorKey::of("QQQ", {ta::IndicatorKind::SMA, 20}));
+    EXPECT_EQ(indicators.requests[0].days, 100 + 14);
+    EXPECT_EQ(indicators.requests[1].days, 100 + 49);
+
+    // SPY: SMA 50 needs 49 warm-up days, more than RSI 14's 14
+    EXPECT_EQ(indicators.lookback.at("SPY"), 100 + 49);
+    // QQQ runs inside an RSI sort folder: window 10 plus 252 days of padding, then SMA 20 warm-up
+    EXPECT_EQ(indicators.lookback.at("QQQ"), 100 + 10 + 252 + 19);
+    EXPECT_EQ(indicators.tickers, (std::vector<std::string>{"SPY", "QQQ"}));
+}
+
+TEST_F(IndicatorPlannerTest, PrefetchLoadsEachTickerOnce) {
+    auto plan = compiler.compile(strategy());
+    auto indicators = IndicatorPlanner::plan(plan, 100);
+
+    std::unordered_map<std::string, int> loads;
+    IndicatorPlanner::PriceLoader loader = [&](const std::string& ticker, int days) {
+        ++loads[ticker];
+        return zigzag(days);
+    };
+    IndicatorPlanner::prefetch(indicators, loader, indicator_cache, price_cache);
+
+    EXPECT_EQ(loads.at("SPY"), 1);
+    EXPECT_EQ(loads.at("QQQ"), 1);
+    EXPECT_EQ(price_cache.at("SPY").size(), 149u);
+
+    // Every indicator covers the full span its conditions read, computed over its own lookback
+    for (const auto& request : indicators.requests) {
+        auto values = cached(request.cache_key());
+        auto spec = *IndicatorPlanner::batch_spec(request.indicator, request.period);
+        EXPECT_EQ(values, IndicatorPlanner::compute(spec, IndicatorCache::tail(price_cache.at(request.source), request.days)));
+        EXPECT_GE(values.size(), 100u);
+    }
+    EXPECT_EQ(cached(IndicatorKey::of("SPY", {ta::IndicatorKind::SMA, 50})).size(), 100u);
+}
+
+TEST_F(IndicatorPlannerTest, ConditionsReadPrefetchedValues) {
+    auto plan = compiler.compile(strategy());
+    IndicatorPlanner::PriceLoader loader = [](const std::string&, int days) { return zigzag(days); };
+    IndicatorPlanner::prefetch(IndicatorPlanner::plan(plan, 100), loader, indicator_cache, price_cache);
+    const size_t cached_series = indicator_cache.size();
+
+    const ConditionSpec* rsi_below_sma = nullptr;
+    for (const auto& instruction : plan.instructions) {
+        if (instruction.kind == NodeKind::CONDITION && instruction.condition().comparison == ComparisonOperator::LESS_THAN) {
+            rsi_below_sma = &instruction.condition();
+        }
+    }
+    ASSERT_NE(rsi_below_sma, nullptr);
+
+    ConditionalNodeProcessor processor;
+    Strategy context;
+    std::vector<std::string> dates;
+    auto result = processor.evaluate_condition(
+        *rsi_below_sma, dates, 100, indicator_cache, price_cache, context, false
+    );
+
+    // RSI < SMA reads both series from the cache without recomputing or reloading
+    ASSERT_EQ(result.size(), 100u);
+    EXPECT_EQ(indicator_cache.size(), cached_series);
+    auto rsi = cached(IndicatorKey::of("SPY", {ta::IndicatorKind::RSI, 14}));
+    auto sma = cached(IndicatorKey::of("SPY", {ta::IndicatorKind::SMA, 50}));
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(result[i], rsi[rsi.size() - 100 + i] < sma[i]);
+    }
+}
+
+TEST_F(IndicatorPlannerTest, PrefetchMatchesLazyPathPerIndicator) {
+    // SMA 200 makes SPY's price history much longer than RSI 14 needs; the RSI seed must not see it
+    auto rsi = operand("Relative Strength Index", "SPY", 14);
+    StrategyNode root(nlohmann::json{
+        {"type", "root"},
+        {"sequence", {
+            condition(rsi, ">", nlohmann::json{{"indicator", "Fixed-Value"}, {"period", "50"}}),
+            condition(operand("current price", "SPY", 0), ">", operand("Simple Moving Average of Price", "SPY", 200))
+        }}
+    });
+    auto plan = compiler.compile(root);
+    IndicatorPlanner::PriceLoader loader = [](const std::string&, int days) { return zigzag(days); };
+    IndicatorPlanner::prefetch(IndicatorPlanner::plan(plan, 60), loader, indicator_cache, price_cache);
+    ASSERT_EQ(price_cache.at("SPY").size(), 60u + 199u);
+
+    const ConditionSpec* rsi_condition = nullptr;
+    for (const auto& instruction : plan.instructions) {
+        if (instruction.kind == NodeKind::CONDITION && instruction.condition().x.indicator == "Relative Strength Index") {
+            rsi_condition = &instruction.condition();
+        }
+    }
+    ASSERT_NE(rsi_condition, nullptr);
+
+    // Lazy evaluation over the same prices, with nothing precomputed
+    IndicatorCache lazy_cache;
+    auto lazy_prices = price_cache;
+    Strategy context;
+    std::vector<std::string> dates;
+    ConditionalNodeProcessor().evaluate_condition(*rsi_condition, dates, 60, lazy_cache, lazy_prices, context, false);
+
+    const auto key = IndicatorKey::of("SPY", {ta::IndicatorKind::RSI, 14});
+    auto lazy = lazy_cache.find(key, SIZE_MAX);
+    ASSERT_TRUE(lazy.has_value());
+    EXPECT_EQ(cached(key), std::vector<float>(lazy->begin(), lazy->end()));
+    EXPECT_EQ(cached(key).size(), 60u);
+}
+
+TEST_F(IndicatorPlannerTest, LazyPathUsesTheSameSizing) {
+    EXPECT_EQ(IndicatorPlanner::lookback("Relative Strength Index", 14, 30), 44);
+    EXPECT_EQ(IndicatorPlanner::lookback("Simple Moving Average of Price", 0, 30), 49);
+    EXPECT_EQ(IndicatorPlanner::lookback("Standard Deviation of Return", 10, 30), 41);
+    EXPECT_EQ(IndicatorPlanner::lookback("Cumulative Return", 10, 30), 40);
+    EXPECT_EQ(IndicatorPlanner::lookback("Max Drawdown", 10, 30), 39);
+    EXPECT_EQ(IndicatorPlanner::lookback("current price", 0, 30), 30);
+    EXPECT_FALSE(IndicatorPlanner::batch_spec("Portfolio Return", 10).has_value());
+}
+
+TEST_F(IndicatorPlannerTest, SharedCacheServesLaterRequests) {
+    auto plan = compiler.compile(strategy());
+    auto indicators = IndicatorPlanner::plan(plan, 100);
+    indicators.as_of = SeriesCache::date_key("2024-01-05");
+
+    int loads = 0;
+    IndicatorPlanner::PriceLoader loader = [&](const std::string&, int days) {
+        ++loads;
+        return zigzag(days);
+    };
+    SeriesCache shared;
+    IndicatorPlanner::prefetch(indicators, loader, indicator_cache, price_cache, nullptr, &shared);
+    EXPECT_EQ(loads, 2);
+    const auto first_rsi = cached(IndicatorKey::of("SPY", {ta::IndicatorKind::RSI, 14}));
+
+    // A second request on the same date loads nothing and computes nothing
+    IndicatorCache second_indicators;
+    std::unordered_map<std::string, std::vector<float>> second_prices;
+    const auto computed = shared.stats().insertions;
+    IndicatorPlanner::prefetch(indicators, loader, second_indicators, second_prices, nullptr, &shared);
+    EXPECT_EQ(loads, 2);
+    EXPECT_EQ(shared.stats().insertions, computed);
+    EXPECT_EQ(second_prices, price_cache);
+    auto rsi = *second_indicators.find(IndicatorKey::of("SPY", {ta::IndicatorKind::RSI, 14}), SIZE_MAX);
+    EXPECT_EQ(std::vector<float>(rsi.begin(), rsi.end()), first_rsi);
+
+    // A shorter lookback reuses the longer shared history
+    auto shorter = IndicatorPlanner::plan(plan, 50);
+    shorter.as_of = indicators.as_of;
+    IndicatorCache third_indicators;
+    std::unordered_map<std::string, std::vector<float>> third_prices;
+    IndicatorPlanner::prefetch(shorter, loader, third_indicators, third_prices, nullptr, &shared);
+    EXPECT_EQ(loads, 2);
+    EXPECT_EQ(third_prices.at("SPY").size(), 99u);
+
+    // Other dates miss
+    indicators.as_of = SeriesCache::date_key("2024-01-08");
+    IndicatorCache other_indicators;
+    std::unordered_map<std::string, std::vector<float>> other_prices;
+    IndicatorPlanner::prefetch(indicators, loader, other_indicators, other_prices, nullptr, &shared);
+    EXPECT_EQ(loads, 4);
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include "indicator_state.h"
+#include "global_cache.h"
+#include "ta_batch.h"
+#include "ta_functions.h"
+#include <cmath>
+#include <filesystem>
+#include <random>
+
+using namespace atlas;
+
+class IndicatorStateTest : public ::testing::Test {
+protected:
+    static std::vector<float> random_walk(size_t size) {
+        std::mt19937 rng(5);
+        std::normal_distribution<float> step(0.0f, 1.5f);
+        std::vector<float> prices(size);
+        float price = 150.0f;
+        for (auto& p : prices) {
+            price = std::max(1.0f, price + step(rng));
+            p = price;
+        }
+        return prices;
+    }
+
+    static void expect_same(float actual, float expected, size_t bar) {
+        if (std::isnan(expected)) {
+            EXPECT_TRUE(std::isnan(actual)) << "bar " << bar;
+        } else {
+            EXPECT_NEAR(actual, expected, std::max(1e-3f, std::abs(expected) * 1e-4f)) << "bar " << bar;
+        }
+    }
+
+    static const std::vector<ta::IndicatorSpec>& specs() {
+        static const std::vector<ta::IndicatorSpec> all{
+            {ta::IndicatorKind::SMA, 20},
+            {ta::IndicatorKind::EMA, 12},
+            {ta::IndicatorKind::RSI, 14},
+            {ta::IndicatorKind::STANDARD_DEVIATION, 10},
+            {ta::IndicatorKind::RETURNS_STANDARD_DEVIATION, 21},
+        };
+        return all;
+    }
+};
+
+TEST_F(IndicatorStateTest, IncrementalMatchesBatchRecompute) {
+    // Several ring laps exercise the periodic resum
+    auto prices = random_walk(400);
+    ta::TickerPanel panel(1, prices.size());
+    panel.set_series(0, prices);
+
+    for (const auto& spec : specs()) {
+        SCOPED_TRACE(static_cast<int>(spec.kind));
+        auto expected = ta::compute_indicator(panel, spec).series(0);
+        IndicatorState state(spec.kind, spec.period);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            expect_same(state.push(prices[i]), expected[i], i);
+        }
+        EXPECT_EQ(state.bars(), prices.size());
+    }
+}
+
+TEST_F(IndicatorStateTest, AmendReplacesLastBar) {
+    auto prices = random_walk(120);
+    for (const auto& spec : specs()) {
+        SCOPED_TRACE(static_cast<int>(spec.kind));
+        IndicatorState reference(spec.kind, spec.period);
+        IndicatorState live(spec.kind, spec.period);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            reference.push(prices[i]);
+            // Live quotes move several times before the close
+            live.push(prices[i] * 1.02f);
+            live.amend(prices[i] * 0.97f);
+            live.amend(prices[i]);
+            expect_same(live.value(), reference.value(), i);
+        }
+    }
+}
+
+TEST_F(IndicatorStateTest, JsonRoundTripResumes) {
+    auto prices = random_walk(90);
+    for (const auto& spec : specs()) {
+        SCOPED_TRACE(static_cast<int>(spec.kind));
+        IndicatorState full(spec.kind, spec.period);
+        IndicatorState first(spec.kind, spec.period);
+        for (size_t i = 0; i < 60; ++i) {
+            full.push(prices[i]);
+            first.push(prices[i]);
+        }
+
+        auto resumed = IndicatorState::from_json(nlohmann::json::parse(first.to_json().dump()));
+        expect_same(resumed.amend(prices[59]), full.value(), 59);
+        for (size_t i = 60; i < prices.size(); ++i) {
+            expect_same(resumed.push(prices[i]), full.push(prices[i]), i);
+        }
+    }
+}
+
+TEST_F(IndicatorStateTest, StoreSeedsOnceThenAdvancesByDate) {
+    IndicatorStateStore store;
+    IndicatorStateKey key{"BRK.B", ta::IndicatorKind::RSI, 14};
+    EXPECT_EQ(IndicatorStateKey::parse(key.to_string()), key);
+
+    auto prices = random_walk(50);
+    int seeds = 0;
+    auto history = [&]() {
+        ++seeds;
+        return std::vector<float>(prices.begin(), prices.begin() + 40);
+    };
+
+    IndicatorState reference(key.kind, key.period);
+    for (size_t i = 0; i < 42; ++i) {
+        reference.push(prices[i]);
+    }
+
+    store.advance(key, "2024-03-01", prices[40], history, true);
+    store.advance(key, "2024-03-04", 1.0f, history, true);
+    float value = store.advance(key, "2024-03-04", prices[41], history, true);
+
+    EXPECT_EQ(seeds, 1);
+    EXPECT_EQ(store.size(), 1u);
+    EXPECT_FLOAT_EQ(value, reference.value());
+    EXPECT_THROW(store.advance(key, "2024-02-28", prices[41], history, true), TAFunctionsError);
+    EXPECT_THROW(store.advance(key, "2024-03-09", prices[42], history, true), TAFunctionsError);
+}
+
+TEST_F(IndicatorStateTest, StoreReplaysMissedSessions) {
+    IndicatorStateStore store;
+    IndicatorStateKey key{"SPY", ta::IndicatorKind::SMA, 20};
+    auto prices = random_walk(50);
+
+    // History of each date: closes of the sessions before it
+    size_t available = 40;
+    int fetches = 0;
+    auto history = [&]() {
+        ++fetches;
+        return std::vector<float>(prices.begin(), prices.begin() + available);
+    };
+
+    // Fri 2024-03-01 is bar 40; Mon 03-04 and Tue 03-05 are missed
+    store.advance(key, "2024-03-01", prices[40], history, true);
+    available = 43;
+    float value = store.advance(key, "2024-03-06", prices[43], history, true);
+
+    IndicatorState reference(key.kind, key.period);
+    for (size_t i = 0; i < 44; ++i) {
+        reference.push(prices[i]);
+    }
+    EXPECT_EQ(fetches, 2);
+    expect_same(value, reference.value(), 43);
+    EXPECT_EQ(store.to_json()[key.to_string()]["date"], "2024-03-06");
+
+    // Next session needs no history
+    store.advance(key, "2024-03-07", prices[44], history, true);
+    EXPECT_EQ(fetches, 2);
+}
+
+TEST_F(IndicatorStateTest, LiveBarIsNotSavedUntilClosed) {
+    IndicatorStateStore store;
+    IndicatorStateKey key{"QQQ", ta::IndicatorKind::EMA, 10};
+    auto prices = random_walk(50);
+    auto history = [&]() { return std::vector<float>(prices.begin(), prices.begin() + 40); };
+
+    store.advance(key, "2024-03-01", prices[40], history, true);
+    auto committed = store.to_json();
+
+    IndicatorState reference(key.kind, key.period);
+    for (size_t i = 0; i < 41; ++i) {
+        reference.push(prices[i]);
+    }
+
+    // Intraday quotes move the value but not the saved state
+    IndicatorState quoted = reference;
+    store.advance(key, "2024-03-04", 1.0f, history, false);
+    expect_same(store.advance(key, "2024-03-04", 2.0f, history, false), quoted.push(2.0f), 41);
+    EXPECT_EQ(store.to_json(), committed);
+
+    IndicatorStateStore restored;
+    restored.load_json(committed);
+    expect_same(restored.advance(key, "2024-03-04", prices[41], history, true), reference.push(prices[41]), 41);
+
+    // The close commits from the saved state, not from the last quote
+    expect_same(store.advance(key, "2024-03-04", prices[41], history, true), reference.value(), 41);
+    EXPECT_EQ(store.to_json(), restored.to_json());
+}
+
+TEST_F(IndicatorStateTest, PersistedWithGlobalCache) {
+    auto& cache = GlobalCache::instance();
+    cache.clear_cache();
+
+    auto first = TechnicalIndicators::get_live_indicator("SPY", {ta::IndicatorKind::EMA, 10}, "2024-06-03", 100);
+    ASSERT_TRUE(first.success) << first.error_message;
+    ASSERT_EQ(first.values.size(), 1u);
+
+    // Only the seeded closes are saved; the live bar of 2024-06-03 is not
+    auto committed = cache.indicator_states().to_json()["SPY|ema|10"];
+    EXPECT_EQ(committed["date"], "2024-05-31");
+    EXPECT_EQ(committed["state"]["core"]["bars"], 100u);
+
+    const auto dir = (std::filesystem::temp_directory_path() / "atlas_indicator_state_test").string();
+    ASSERT_TRUE(cache.save_cache_to_file(dir));
+    auto saved = cache.indicator_states().to_json();
+
+    cache.clear_cache();
+    EXPECT_EQ(cache.indicator_states().size(), 0u);
+    ASSERT_TRUE(cache.load_cache_from_file(dir));
+    EXPECT_EQ(cache.indicator_states().to_json(), saved);
+
+    std::filesystem::remove_all(dir);
+    cache.clear_cache();
+}
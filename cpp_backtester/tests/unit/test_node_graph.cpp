@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "node_graph.h"
+
+using namespace atlas;
+
+class NodeGraphTest : public ::testing::Test {
+protected:
+    static nlohmann::json stock(const std::string& symbol, const std::string& hash) {
+        return {{"type", "stock"}, {"hash", hash}, {"properties", {{"symbol", symbol}}}};
+    }
+
+    static nlohmann::json condition(const std::string& hash, nlohmann::json true_nodes, nlohmann::json false_nodes) {
+        return {
+            {"type", "condition"},
+            {"hash", hash},
+            {"properties", {
+                {"comparison", ">"},
+                {"x", {{"indicator", "current price"}, {"source", "SPY"}}},
+                {"y", {{"indicator", "Fixed-Value"}, {"period", "100"}}}
+            }},
+            {"branches", {{"true", std::move(true_nodes)}, {"false", std::move(false_nodes)}}}
+        };
+    }
+
+    static StrategyNode root_with(nlohmann::json sequence) {
+        return StrategyNode(nlohmann::json{{"type", "root"}, {"hash", "root"}, {"sequence", std::move(sequence)}});
+    }
+};
+
+TEST_F(NodeGraphTest, BuildsPreOrderArena) {
+    auto root = root_with({
+        condition("cond", {stock("AAPL", "s1")}, {stock("MSFT", "s2")}),
+        stock("SPY", "s3")
+    });
+    auto graph = NodeGraph::build(root);
+
+    ASSERT_EQ(graph->size(), 5u);
+    const auto& graph_root = graph->root();
+    EXPECT_EQ(graph_root.kind, NodeKind::ROOT);
+    EXPECT_EQ(graph_root.parent, nullptr);
+    EXPECT_EQ(&graph_root, &graph->nodes().front());
+
+    // Parents precede their children in the arena
+    for (const auto& node : graph->nodes()) {
+        if (node.parent) {
+            EXPECT_LT(node.parent, &node);
+        }
+    }
+
+    auto sequence = graph_root.branch("sequence");
+    ASSERT_EQ(sequence.size(), 2u);
+    EXPECT_EQ(sequence[0]->kind, NodeKind::CONDITION);
+    EXPECT_EQ(sequence[1]->kind, NodeKind::STOCK);
+}
+
+TEST_F(NodeGraphTest, ConditionBranchesByReference) {
+    auto root = root_with({condition("cond", {stock("AAPL", "s1"), stock("GOOG", "s4")}, {stock("MSFT", "s2")})});
+    auto graph = NodeGraph::build(root);
+
+    const auto* cond = graph->find("cond");
+    ASSERT_NE(cond, nullptr);
+    EXPECT_EQ(cond->parent, &graph->root());
+
+    auto true_branch = cond->branch("true");
+    auto false_branch = cond->branch("false");
+    ASSERT_EQ(true_branch.size(), 2u);
+    ASSERT_EQ(false_branch.size(), 1u);
+    EXPECT_EQ(true_branch[0]->parent, cond);
+    EXPECT_EQ(std::get<StockSpec>(true_branch[1]->spec()).symbol, "GOOG");
+    EXPECT_EQ(std::get<StockSpec>(false_branch[0]->spec()).symbol, "MSFT");
+    EXPECT_TRUE(cond->branch("missing").empty());
+
+    // Repeated lookups return the same nodes, nothing is rebuilt
+    EXPECT_EQ(graph->find("s1"), true_branch[0]);
+    EXPECT_EQ(graph->find("cond")->branch("true").data(), true_branch.data());
+}
+
+TEST_F(NodeGraphTest, ResolvesSpecsOfBranchNodes) {
+    auto root = root_with({condition("cond", {stock("AAPL", "s1")}, nlohmann::json::array())});
+    auto graph = NodeGraph::build(root);
+
+    const auto* cond = graph->find("cond");
+    ASSERT_NE(cond, nullptr);
+    const auto& spec = std::get<ConditionSpec>(cond->spec());
+    EXPECT_EQ(spec.comparison, ComparisonOperator::GREATER_THAN);
+    EXPECT_FLOAT_EQ(spec.y.value, 100.0f);
+    EXPECT_EQ(graph->find("unknown"), nullptr);
+}
+
+TEST_F(NodeGraphTest, OutlivesSourceTree) {
+    std::shared_ptr<const NodeGraph> graph;
+    {
+        auto root = root_with({condition("cond", {stock("AAPL", "s1")}, {stock("MSFT", "s2")})});
+        graph = NodeGraph::build(root);
+    }
+
+    const auto* leaf = graph->find("s2");
+    ASSERT_NE(leaf, nullptr);
+    EXPECT_EQ(std::get<StockSpec>(leaf->spec()).symbol, "MSFT");
+    EXPECT_EQ(leaf->parent->hash(), "cond");
+}
+
+TEST_F(NodeGraphTest, RejectsInvalidNodes) {
+    auto unknown = root_with({{{"type", "bogus"}}});
+    EXPECT_THROW(NodeGraph::build(unknown), StrategyParseError);
+
+    nlohmann::json bad_leaf = {{"type", "stock"}, {"properties", nlohmann::json::object()}};
+    auto bad_branch = root_with({condition("cond", {bad_leaf}, nlohmann::json::array())});
+    EXPECT_THROW(NodeGraph::build(bad_branch), StrategyParseError);
+}
@@ -2,6 +2,7 @@
 #include "conditional_node.h"
 #include "sort_node.h"
 #include "strategy.h"
+#include "trading_calendar.h"
 #include "types.h"
 #include <nlohmann/json.hpp>
 
@@ -12,7 +13,7 @@ class NodeProcessorsTest : public ::testing::Test {
 protected:
     void SetUp() override {
         // Setup common test data
-        date_range = {"2024-01-01", "2024-01-02", "2024-01-03", "2024-01-04", "2024-01-05"};
+        date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-01-08"), 5);
         total_days = static_cast<int>(date_range.size());
         
         // Initialize portfolio history
@@ -44,10 +45,10 @@ protected:
         price_cache["SPY"] = spy_prices;
         price_cache["QQQ"] = qqq_prices;
         
-        indicator_cache["SPY_SMA_200"] = spy_sma_200;
-        indicator_cache["QQQ_SMA_20"] = qqq_sma_20;
-        indicator_cache["PSQ_RSI_10"] = psq_rsi_10;
-        indicator_cache["SHY_RSI_10"] = shy_rsi_10;
+        indicator_cache.insert(IndicatorKey::of("SPY", {ta::IndicatorKind::SMA, 200}), spy_sma_200, 0);
+        indicator_cache.insert(IndicatorKey::of("QQQ", {ta::IndicatorKind::SMA, 20}), qqq_sma_20, 0);
+        indicator_cache.insert(IndicatorKey::of("PSQ", {ta::IndicatorKind::RSI, 10}), psq_rsi_10, 0);
+        indicator_cache.insert(IndicatorKey::of("SHY", {ta::IndicatorKind::RSI, 10}), shy_rsi_10, 0);
     }
     
     void setupTestStrategy() {
@@ -57,13 +58,13 @@ protected:
     }
     
     // Test data
-    std::vector<std::string> date_range;
+    std::vector<int32_t> date_range;
     int total_days;
     std::vector<DayData> portfolio_history;
     std::vector<bool> active_mask;
     std::unordered_map<std::string, int> flow_count;
     std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-    std::unordered_map<std::string, std::vector<float>> indicator_cache;
+    IndicatorCache indicator_cache;
     std::unordered_map<std::string, std::vector<float>> price_cache;
     Strategy strategy;
     
@@ -457,19 +458,16 @@ TEST_F(NodeProcessorsTest, Performance_LargeDataset) {
     
     // Create larger dataset
     int large_days = 1000;
-    std::vector<std::string> large_date_range;
+    auto large_date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-01-05"), large_days);
     std::vector<bool> large_active_mask(large_days, true);
     std::vector<DayData> large_portfolio(large_days);
     
-    for (int i = 0; i < large_days; ++i) {
-        large_date_range.push_back("2024-01-" + std::to_string(i + 1));
-    }
-    
     // Create large cache data
     std::vector<float> large_spy_prices(large_days, 450.0f);
     std::vector<float> large_spy_sma(large_days, 448.0f);
     price_cache["SPY"] = large_spy_prices;
-    indicator_cache["SPY_SMA_200"] = large_spy_sma;
+    indicator_cache.clear();
+    indicator_cache.insert(IndicatorKey::of("SPY", {ta::IndicatorKind::SMA, 200}), large_spy_sma, 0);
     
     auto node = create_conditional_node();
     
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "price_ingest.h"
+#include "civil_day.h"
+#include "price_store.h"
+#include "stock_data_provider.h"
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+using namespace atlas;
+
+class PriceIngestTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root = std::filesystem::temp_directory_path() / ("atlas_price_ingest_" + std::to_string(::getpid()));
+        std::filesystem::create_directories(root / "in");
+        options.output_root = (root / "out").string();
+        options.threads = 2;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root);
+    }
+
+    std::string write_csv(const std::string& name, const std::string& text) {
+        const auto path = (root / "in" / name).string();
+        std::ofstream(path) << text;
+        return path;
+    }
+
+    std::filesystem::path root;
+    IngestOptions options;
+};
+
+TEST_F(PriceIngestTest, ParsesDatesLikeScalarParser) {
+    std::vector<std::string> text{"1970-01-01", "2000-02-29", "2024-12-31 16:00:00", "1999-10-09"};
+    for (int32_t day = -1000; day < 60000; day += 113) {
+        text.push_back(format_civil_day(day));
+    }
+    std::vector<std::string_view> dates(text.begin(), text.end());
+    std::vector<int32_t> days(dates.size());
+    ASSERT_EQ(parse_civil_days(dates, days), dates.size());
+    for (size_t i = 0; i < dates.size(); ++i) {
+        EXPECT_EQ(days[i], parse_civil_day(dates[i])) << dates[i];
+    }
+
+    for (std::string_view bad : {"2023-02-29", "2024-00-10", "2024-04-31", "2024-1a-01", "2024/01/01", "2024-01-"}) {
+        std::string_view one[] = {bad};
+        int32_t out[1];
+        EXPECT_EQ(parse_civil_days(one, out), 0u) << bad;
+    }
+}
+
+TEST_F(PriceIngestTest, ReadsCsvColumnsByName) {
+    const auto path = write_csv("SPY.csv",
+        "Date,Open,Close,Adj Close,Volume\r\n"
+        "2024-01-02,1,2,472.5,100\r\n"
+        "2024-01-03,1,2,,100\r\n"
+        "2024-01-04,1,2,470.25,\r\n");
+    auto bars = read_price_csv(path);
+    ASSERT_EQ(bars.days.size(), 2u);
+    EXPECT_EQ(bars.days[0], *parse_civil_day("2024-01-02"));
+    EXPECT_EQ(bars.closes[1], 470.25f);
+    EXPECT_EQ(bars.volumes[0], 100.0f);
+    EXPECT_EQ(bars.volumes[1], 0.0f);
+    EXPECT_EQ(bars.skipped, 1u);
+
+    EXPECT_THROW(read_price_csv(write_csv("A.csv", "date,close\n2024-01-03,1\n2024-01-02,2\n")), StockDataError);
+    EXPECT_THROW(read_price_csv(write_csv("B.csv", "date,close\n2024-01-03,1\n2024-01-03,2\n")), StockDataError);
+    EXPECT_THROW(read_price_csv(write_csv("C.csv", "date,close\n01/03/2024,1\n")), StockDataError);
+    EXPECT_THROW(read_price_csv(write_csv("D.csv", "day,price\n2024-01-03,1\n")), StockDataError);
+}
+
+TEST_F(PriceIngestTest, IngestsInParallelAndAppendsNightly) {
+    const auto spy = write_csv("SPY.csv", "date,adjusted_close\n2024-01-02,10\n2024-01-03,11\n");
+    const auto brk = write_csv("BRK.B.csv", "date,adjusted_close\n2024-01-02,20\n");
+    const auto bad = write_csv("XYZ.csv", "date,adjusted_close\n2024-01-03,1\n2024-01-02,2\n");
+    const auto parquet = write_csv("QQQ.parquet", "");
+
+    auto reports = ingest_price_files({spy, brk, bad, parquet}, options);
+    ASSERT_EQ(reports.size(), 4u);
+    EXPECT_TRUE(reports[0].ok());
+    EXPECT_EQ(reports[0].written, 2u);
+    EXPECT_EQ(reports[1].ticker, "BRK-B");
+    EXPECT_FALSE(reports[2].ok());
+    EXPECT_FALSE(reports[3].ok());
+
+    auto manifest = write_price_manifest(options.output_root);
+    ASSERT_EQ(manifest["tickers"].size(), 2u);
+    EXPECT_EQ(manifest["tickers"]["SPY"]["last_date"], "2024-01-03");
+    EXPECT_TRUE(std::filesystem::exists(root / "out" / "manifest.json"));
+
+    // A nightly export overlaps the stored history; only the new day is added
+    auto file = MappedPriceFile::open(MappedStockDataProvider::price_file_path(options.output_root, "SPY"));
+    const float* history = file->closes().data();
+    write_csv("SPY.csv", "date,adjusted_close\n2024-01-03,99\n2024-01-04,12\n");
+    options.append = true;
+    reports = ingest_price_files({spy}, options);
+    ASSERT_TRUE(reports[0].ok()) << reports[0].error;
+    EXPECT_EQ(reports[0].written, 1u);
+    EXPECT_EQ(reports[0].already_stored, 1u);
+
+    ASSERT_EQ(file->rows(), 3u);
+    EXPECT_EQ(file->closes().data(), history);
+    EXPECT_EQ(file->closes()[1], 11.0f);
+    EXPECT_EQ(file->closes()[2], 12.0f);
+
+    EXPECT_FALSE(ingest_price_files({spy, spy}, options)[1].ok());
+}
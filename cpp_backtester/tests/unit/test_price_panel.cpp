@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "price_panel.h"
+#include "civil_day.h"
+#include "price_store.h"
+#include "stock_data_provider.h"
+#include <cmath>
+#include <filesystem>
+#include <unistd.h>
+
+using namespace atlas;
+
+namespace {
+
+std::vector<int32_t> weekdays(const char* first, int count) {
+    std::vector<int32_t> days;
+    for (int32_t day = *parse_civil_day(first); static_cast<int>(days.size()) < count; ++day) {
+        if ((day + 3) % 7 < 5) {   // 1970-01-01 was a Thursday
+            days.push_back(day);
+        }
+    }
+    return days;
+}
+
+} // namespace
+
+TEST(PricePanelTest, AlignsSeriesToCalendar) {
+    const auto calendar = weekdays("2024-01-01", 10);
+    PricePanel panel(calendar, {"SPY", "QQQ"});
+    EXPECT_EQ(panel.stride() % 16, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(panel.series(1).data()) % 64, 0u);
+
+    // SPY misses day 3 and has a weekend row; QQQ starts late and stops early
+    std::vector<int32_t> spy_days{calendar[0], calendar[1], calendar[2], calendar[4], calendar[4] + 1};
+    std::vector<float> spy_closes{1, 2, 3, 5, 99};
+    panel.set_series(0, spy_days, spy_closes);
+    std::vector<int32_t> qqq_days(calendar.begin() + 2, calendar.begin() + 8);
+    std::vector<float> qqq_closes{10, 11, 12, 13, 14, 15};
+    panel.set_series(panel.column_of("QQQ"), qqq_days, qqq_closes);
+
+    EXPECT_EQ(panel.first_valid(0), 0u);
+    EXPECT_EQ(panel.last_valid(0), 4u);
+    EXPECT_FALSE(panel.valid(0, 3));
+    EXPECT_TRUE(std::isnan(panel.series(0)[3]));
+    EXPECT_EQ(panel.series(0)[4], 5.0f);
+    EXPECT_EQ(panel.validity(0)[0], 0b10111u);
+    EXPECT_EQ(panel.valid_series(1).size(), 6u);
+    EXPECT_EQ(panel.common_range(), std::make_pair(size_t(2), size_t(5)));
+    EXPECT_EQ(panel.index_of(calendar[4] + 1), 4u);
+    EXPECT_EQ(panel.index_of(calendar[0] - 1), PricePanel::kNoValid);
+    EXPECT_EQ(panel.column_of("IWM"), PricePanel::kNoValid);
+
+    panel.forward_fill();
+    EXPECT_EQ(panel.series(0)[3], 3.0f);
+    EXPECT_EQ(panel.series(0)[9], 5.0f);
+    EXPECT_FALSE(panel.valid(0, 3));
+    EXPECT_TRUE(std::isnan(panel.series(1)[1]));
+
+    auto window = panel.window(2, 3);
+    EXPECT_EQ(window(0, 0), 3.0f);
+    EXPECT_EQ(window(2, 1), 12.0f);
+
+    EXPECT_THROW(PricePanel({3, 2}, {"SPY"}), std::invalid_argument);
+    EXPECT_THROW(PricePanel({1, 2}, {"SPY", "SPY"}), std::invalid_argument);
+}
+
+TEST(PricePanelTest, LoadsFromMappedProvider) {
+    const auto root = std::filesystem::temp_directory_path() / ("atlas_price_panel_" + std::to_string(::getpid()));
+    std::filesystem::create_directories(root);
+    const auto calendar = weekdays("2024-01-01", 5);
+    std::vector<float> closes{1, 2, 3, 4, 5};
+    write_price_file(MappedStockDataProvider::price_file_path(root.string(), "SPY"), calendar, closes, closes);
+    std::vector<int32_t> sparse{calendar[1], calendar[3]};
+    write_price_file(MappedStockDataProvider::price_file_path(root.string(), "BRK-B"), sparse, std::span(closes).first(2), std::span(closes).first(2));
+
+    MappedStockDataProvider provider(root.string());
+    auto panel = provider.load_panel({"SPY", "BRK.B"}, calendar, true);
+    EXPECT_EQ(panel.series(0)[4], 5.0f);
+    EXPECT_EQ(panel.first_valid(1), 1u);
+    EXPECT_EQ(panel.series(1)[2], 1.0f);
+    EXPECT_EQ(panel.series(1)[4], 2.0f);
+    EXPECT_THROW(provider.load_panel({"QQQ"}, calendar), StockDataError);
+
+    std::filesystem::remove_all(root);
+}
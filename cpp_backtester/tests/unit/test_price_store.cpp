@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "price_store.h"
+#include "civil_day.h"
+#include "stock_data_provider.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+using namespace atlas;
+
+class PriceStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root = std::filesystem::temp_directory_path() / ("atlas_price_store_" + std::to_string(::getpid()));
+        std::filesystem::create_directories(root);
+
+        // Two weeks of weekdays starting Monday 2024-01-01
+        const int32_t monday = *parse_civil_day("2024-01-01");
+        for (int32_t day = monday; day < monday + 14; ++day) {
+            if ((day - monday) % 7 < 5) {
+                days.push_back(day);
+                closes.push_back(100.0f + static_cast<float>(days.size()));
+                volumes.push_back(1000.0f * static_cast<float>(days.size()));
+            }
+        }
+        write_price_file(MappedStockDataProvider::price_file_path(root.string(), "SPY"), days, closes, volumes);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root);
+    }
+
+    std::filesystem::path root;
+    std::vector<int32_t> days;
+    std::vector<float> closes;
+    std::vector<float> volumes;
+};
+
+TEST_F(PriceStoreTest, LooksUpRowsByDate) {
+    auto file = MappedPriceFile::open(MappedStockDataProvider::price_file_path(root.string(), "SPY"));
+    ASSERT_EQ(file->rows(), 10u);
+    EXPECT_EQ(file->last_day(), days.back());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(file->closes().data()) % 64, 0u);
+
+    EXPECT_EQ(file->rows_through(days.front() - 1), 0u);
+    EXPECT_EQ(file->rows_through(days.front()), 1u);
+    // Saturday and Sunday resolve to Friday's row
+    EXPECT_EQ(file->rows_through(days[4] + 1), 5u);
+    EXPECT_EQ(file->rows_through(days[4] + 2), 5u);
+    EXPECT_EQ(file->rows_through(days.back() + 100), 10u);
+
+    auto window = file->closes_through(days[4] + 2, 3);
+    ASSERT_EQ(window.size(), 3u);
+    EXPECT_EQ(window.data(), file->closes().data() + 2);
+    EXPECT_EQ(file->closes_through(days[1], 50).size(), 2u);
+}
+
+TEST_F(PriceStoreTest, ProviderServesRecordsAndViews) {
+    auto provider = StockDataProviderFactory::create_provider("mmap", root.string());
+
+    auto history = provider->get_historical_data("SPY", 3, "2024-01-07");
+    ASSERT_EQ(history.size(), 3u);
+    EXPECT_EQ(history.front().date, "2024-01-03");
+    EXPECT_EQ(history.back().date, "2024-01-05");
+    EXPECT_EQ(history.back().adjusted_close, closes[4]);
+    EXPECT_EQ(history.back().volume, volumes[4]);
+
+    auto range = provider->get_historical_data_range("SPY", "2024-01-06", "2024-01-09");
+    ASSERT_EQ(range.size(), 2u);
+    EXPECT_EQ(range.front().date, "2024-01-08");
+    EXPECT_TRUE(provider->get_historical_data_range("SPY", "2024-01-09", "2024-01-08").empty());
+
+    auto& mapped = dynamic_cast<MappedStockDataProvider&>(*provider);
+    auto view = mapped.get_closes("SPY", 4, "2024-01-12");
+    ASSERT_EQ(view.size(), 4u);
+    EXPECT_EQ(view.back(), closes.back());
+    EXPECT_EQ(view.data(), mapped.file("SPY")->closes().data() + 6);
+
+    EXPECT_FALSE(provider->get_live_data("SPY"));
+    EXPECT_THROW(provider->get_historical_data("QQQ", 3, "2024-01-07"), StockDataError);
+    EXPECT_THROW(provider->get_historical_data("SPY", 3, "Jan 7"), StockDataError);
+}
+
+TEST_F(PriceStoreTest, RejectsMalformedFiles) {
+    const auto path = (root / "BAD.apx").string();
+    std::ofstream(path, std::ios::binary) << "not a price file, just some text padding it out to header size....";
+    EXPECT_THROW(MappedPriceFile::open(path), StockDataError);
+
+    // Truncating a valid file breaks its recorded size
+    const auto spy = MappedStockDataProvider::price_file_path(root.string(), "SPY");
+    std::filesystem::resize_file(spy, std::filesystem::file_size(spy) - 4);
+    EXPECT_THROW(MappedPriceFile::open(spy), StockDataError);
+
+    std::vector<int32_t> unsorted{5, 4};
+    std::vector<float> values{1.0f, 2.0f};
+    EXPECT_THROW(write_price_file(path, unsorted, values, values), StockDataError);
+}
+
+TEST_F(PriceStoreTest, AppendsWithoutMovingHistory) {
+    const auto path = (root / "QQQ.apx").string();
+    const std::vector<int32_t> first_days(days.begin(), days.begin() + 5);
+    write_price_file(path, first_days, std::span(closes).first(5), std::span(volumes).first(5), price_file_capacity(5));
+    auto file = MappedPriceFile::open(path);
+    const float* history = file->closes().data();
+
+    // Overlapping rows are already stored and only the new ones are added
+    auto overlapping = append_price_file(path, std::span(days).subspan(3), std::span(closes).subspan(3), std::span(volumes).subspan(3));
+    EXPECT_EQ(overlapping.appended, 5u);
+    EXPECT_EQ(overlapping.skipped, 2u);
+    auto repeated = append_price_file(path, days, closes, volumes);
+    EXPECT_EQ(repeated.appended, 0u);
+    EXPECT_EQ(repeated.skipped, 10u);
+
+    // The existing mapping sees the new rows in place
+    ASSERT_EQ(file->rows(), 10u);
+    EXPECT_EQ(file->last_day(), days.back());
+    EXPECT_EQ(file->closes().data(), history);
+    EXPECT_EQ(file->closes().back(), closes.back());
+    EXPECT_EQ(file->rows_through(days[4] + 2), 5u);
+    EXPECT_EQ(file->rows_through(days[7]), 8u);
+
+    auto reopened = MappedPriceFile::open(path);
+    EXPECT_TRUE(std::equal(days.begin(), days.end(), reopened->days().begin(), reopened->days().end()));
+
+    // Outgrowing the reserve rewrites the file with room to spare
+    std::vector<int32_t> more_days;
+    std::vector<float> more_values;
+    for (int32_t i = 1; i <= 400; ++i) {
+        more_days.push_back(days.back() + i);
+        more_values.push_back(static_cast<float>(i));
+    }
+    EXPECT_EQ(append_price_file(path, more_days, more_values, more_values).appended, 400u);
+    auto grown = MappedPriceFile::open(path);
+    EXPECT_EQ(grown->rows(), 410u);
+    EXPECT_EQ(grown->closes()[9], closes.back());
+    EXPECT_EQ(grown->rows_through(more_days[199]), 210u);
+}
+
+TEST_F(PriceStoreTest, ReadersSeePublishedRowsDuringAppends) {
+    const auto path = (root / "IWM.apx").string();
+    std::vector<int32_t> all_days{days.front()};
+    std::vector<float> all_closes{0.0f};
+    for (int32_t i = 1; i < 200; ++i) {
+        all_days.push_back(days.front() + i);
+        all_closes.push_back(static_cast<float>(i));
+    }
+    write_price_file(path, std::span(all_days).first(1), std::span(all_closes).first(1), std::span(all_closes).first(1),
+                     price_file_capacity(1));
+    auto file = MappedPriceFile::open(path);
+
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (size_t i = 1; i < all_days.size(); ++i) {
+            append_price_file(path, std::span(all_days).subspan(i, 1), std::span(all_closes).subspan(i, 1),
+                              std::span(all_closes).subspan(i, 1));
+        }
+        done = true;
+    });
+
+    // Every row a view covers is complete, whatever the writer is doing
+    size_t seen = 0;
+    while (!done || seen < all_days.size()) {
+        const auto closes_view = file->closes();
+        const auto days_view = file->days();
+        ASSERT_GE(closes_view.size(), seen);
+        seen = closes_view.size();
+        for (size_t i = 0; i < std::min(closes_view.size(), days_view.size()); ++i) {
+            ASSERT_EQ(closes_view[i], all_closes[i]);
+            ASSERT_EQ(days_view[i], all_days[i]);
+        }
+        const int32_t last = file->last_day();
+        const auto tail = file->closes_through(last, 1);
+        ASSERT_EQ(tail.size(), 1u);
+        EXPECT_EQ(tail[0], static_cast<float>(last - all_days.front()));
+    }
+    writer.join();
+    EXPECT_EQ(file->rows(), all_days.size());
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "run_arena.h"
+#include "active_mask.h"
+
+using namespace atlas;
+
+TEST(RunArenaTest, RetainsHighWaterBlock) {
+    RunArena arena(1024);
+    {
+        RunArena::Scope scope(arena);
+        std::pmr::vector<int> values(arena.resource());
+        values.resize(10000);
+        EXPECT_GT(arena.overflow_bytes(), 0u);
+    }
+
+    // The overflowing run grew the block, so the same run now fits without the heap
+    EXPECT_GE(arena.block_bytes(), 10000 * sizeof(int));
+    EXPECT_EQ(arena.overflow_bytes(), 0u);
+    {
+        RunArena::Scope scope(arena);
+        std::pmr::vector<int> values(arena.resource());
+        values.reserve(10000);
+        EXPECT_EQ(arena.overflow_bytes(), 0u);
+    }
+}
+
+TEST(RunArenaTest, NestedScopesResetOnce) {
+    RunArena arena(256);
+    RunArena::Scope outer(arena);
+    std::pmr::vector<char> first(512, 'a', arena.resource());
+    {
+        RunArena::Scope inner(arena);
+        std::pmr::vector<char> second(512, 'b', arena.resource());
+    }
+
+    // The inner scope must not release memory the outer run still uses
+    EXPECT_GT(arena.overflow_bytes(), 0u);
+    EXPECT_EQ(first.back(), 'a');
+}
+
+TEST(RunArenaTest, MasksAllocateFromArena) {
+    RunArena arena;
+    RunArena::Scope scope(arena);
+
+    ActiveMask mask(1000, true, arena.resource());
+    ActiveMask copy(mask, arena.resource());
+    ActiveMask heap_copy = mask;
+
+    EXPECT_EQ(mask.get_allocator().resource(), arena.resource());
+    EXPECT_EQ(copy.get_allocator().resource(), arena.resource());
+    EXPECT_EQ(heap_copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy, heap_copy);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "selection_matrix.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+using namespace atlas;
+
+class SelectionMatrixTest : public ::testing::Test {
+protected:
+    // Julia partialsortperm: NaN/Inf as 0, stable by branch index
+    static std::vector<int32_t> reference(std::vector<float> scores, size_t k, bool descending) {
+        for (auto& s : scores) {
+            if (!std::isfinite(s)) s = 0.0f;
+        }
+        std::vector<int32_t> order(scores.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int32_t a, int32_t b) {
+            return descending ? scores[a] > scores[b] : scores[a] < scores[b];
+        });
+        order.resize(std::min(k, order.size()));
+        return order;
+    }
+
+    static std::vector<int32_t> select(const std::vector<float>& scores, size_t k, bool descending) {
+        std::vector<uint64_t> keys(scores.size());
+        for (size_t b = 0; b < scores.size(); ++b) {
+            keys[b] = selection_key(scores[b], static_cast<uint32_t>(b), descending);
+        }
+        std::vector<int32_t> out(k);
+        out.resize(select_top_k(keys.data(), keys.size(), k, out.data()));
+        return out;
+    }
+};
+
+TEST_F(SelectionMatrixTest, MatchesStableSortForSmallAndLargeSorts) {
+    std::mt19937 rng(3);
+    // Few distinct values so ties are common
+    std::uniform_int_distribution<int> value(-5, 5);
+    for (size_t n : {1, 3, 8, 16, 17, 40, 200}) {
+        std::vector<float> scores(n);
+        for (auto& s : scores) s = static_cast<float>(value(rng)) * 0.5f;
+        for (size_t k : {size_t{1}, size_t{2}, n / 2 + 1, n, n + 3}) {
+            SCOPED_TRACE(testing::Message() << "n=" << n << " k=" << k);
+            EXPECT_EQ(select(scores, k, true), reference(scores, k, true));
+            EXPECT_EQ(select(scores, k, false), reference(scores, k, false));
+        }
+    }
+}
+
+TEST_F(SelectionMatrixTest, TiesGoToLowerBranch) {
+    std::vector<float> scores{1.0f, 2.0f, 2.0f, 1.0f, 2.0f};
+    EXPECT_EQ(select(scores, 2, true), (std::vector<int32_t>{1, 2}));
+    EXPECT_EQ(select(scores, 2, false), (std::vector<int32_t>{0, 3}));
+}
+
+TEST_F(SelectionMatrixTest, NonFiniteScoresRankAsZero) {
+    const float inf = std::numeric_limits<float>::infinity();
+    std::vector<float> scores{std::nanf(""), 1.0f, -inf, -1.0f, inf};
+    EXPECT_EQ(select(scores, 5, true), (std::vector<int32_t>{1, 0, 2, 4, 3}));
+    EXPECT_EQ(select(scores, 5, false), (std::vector<int32_t>{3, 0, 2, 4, 1}));
+}
+
+TEST_F(SelectionMatrixTest, NegativeZeroOrdersBeforeZero) {
+    std::vector<float> scores{0.0f, -0.0f};
+    EXPECT_EQ(select(scores, 1, false), (std::vector<int32_t>{1}));
+    EXPECT_EQ(select(scores, 1, true), (std::vector<int32_t>{0}));
+}
+
+TEST_F(SelectionMatrixTest, RowsHoldSelectedCounts) {
+    auto matrix = SelectionMatrix::from_rows({{2, 0}, {}, {1}});
+    ASSERT_EQ(matrix.size(), 3u);
+    EXPECT_EQ(matrix.k(), 2u);
+    EXPECT_EQ(std::vector<int32_t>(matrix[0].begin(), matrix[0].end()), (std::vector<int32_t>{2, 0}));
+    EXPECT_TRUE(matrix[1].empty());
+    EXPECT_EQ(matrix[2].size(), 1u);
+
+    SelectionMatrix empty(4, 0);
+    EXPECT_EQ(empty.size(), 4u);
+    EXPECT_TRUE(empty[3].empty());
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "series_cache.h"
+#include <thread>
+#include <vector>
+
+using namespace atlas;
+
+class SeriesCacheTest : public ::testing::Test {
+protected:
+    static SeriesKey price(uint32_t ticker) {
+        return SeriesKey::price(ticker, 20240105);
+    }
+
+    // Budget for about `entries` series of `floats` each in a single shard
+    static SeriesCache::Options budget_for(size_t entries, size_t floats) {
+        SeriesCache probe(SeriesCache::Options{size_t(1) << 30, std::chrono::hours(4), 1});
+        probe.insert(price(0), std::vector<float>(floats));
+        SeriesCache::Options options;
+        options.byte_budget = probe.stats().bytes * entries;
+        options.shards = 1;
+        return options;
+    }
+};
+
+TEST_F(SeriesCacheTest, CountsHitsMissesAndReplacements) {
+    SeriesCache cache;
+    EXPECT_EQ(cache.find(price(1)), nullptr);
+
+    cache.insert(price(1), {1.0f, 2.0f});
+    auto hit = cache.find(price(1));
+    ASSERT_NE(hit, nullptr);
+    EXPECT_EQ(*hit, (std::vector<float>{1.0f, 2.0f}));
+
+    // Replacing keeps readers of the old series valid
+    cache.insert(price(1), {3.0f});
+    EXPECT_EQ(*cache.find(price(1)), std::vector<float>{3.0f});
+    EXPECT_EQ(hit->size(), 2u);
+
+    // Different dates and history lengths are different entries
+    auto indicator = IndicatorKey{1, ta::IndicatorKind::RSI, 14};
+    cache.insert(SeriesKey::indicator_of(indicator, 20240105, 300), {50.0f});
+    EXPECT_EQ(cache.find(SeriesKey::indicator_of(indicator, 20240105, 400)), nullptr);
+    EXPECT_EQ(cache.find(SeriesKey::price(1, 20240108)), nullptr);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.insertions, 3u);
+    EXPECT_EQ(stats.entries, 2u);
+}
+
+TEST_F(SeriesCacheTest, EvictsUnreferencedEntriesFirst) {
+    SeriesCache cache(budget_for(4, 256));
+    for (uint32_t t = 1; t <= 4; ++t) {
+        cache.insert(price(t), std::vector<float>(256));
+    }
+    EXPECT_EQ(cache.stats().evictions, 0u);
+
+    // A first sweep clears every reference bit and drops the oldest entry
+    cache.insert(price(5), std::vector<float>(256));
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_EQ(cache.find(price(1)), nullptr);
+
+    // Entries read since the last sweep survive the next one
+    ASSERT_NE(cache.find(price(2)), nullptr);
+    cache.insert(price(6), std::vector<float>(256));
+    EXPECT_NE(cache.find(price(2)), nullptr);
+    EXPECT_EQ(cache.find(price(3)), nullptr);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.evictions, 2u);
+    EXPECT_EQ(stats.entries, 4u);
+    EXPECT_LE(stats.bytes, cache.options().byte_budget);
+
+    // Series beyond the budget are returned but not kept
+    auto huge = cache.insert(price(7), std::vector<float>(4096));
+    EXPECT_EQ(huge->size(), 4096u);
+    EXPECT_EQ(cache.find(price(7)), nullptr);
+}
+
+TEST_F(SeriesCacheTest, ExpiresEntriesByAge) {
+    SeriesCache cache(SeriesCache::Options{size_t(1) << 20, std::chrono::milliseconds(20), 4});
+    cache.insert(price(1), {1.0f});
+    ASSERT_NE(cache.find(price(1)), nullptr);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    EXPECT_EQ(cache.find(price(1)), nullptr);
+    EXPECT_EQ(cache.erase_expired(), 1u);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.expirations, 1u);
+    EXPECT_EQ(stats.entries, 0u);
+    EXPECT_EQ(stats.bytes, 0u);
+}
+
+TEST_F(SeriesCacheTest, ConcurrentReadersAndWriters) {
+    SeriesCache cache(SeriesCache::Options{size_t(1) << 20, std::chrono::hours(4), 8});
+    for (uint32_t t = 0; t < 64; ++t) {
+        cache.insert(price(t), std::vector<float>(16, static_cast<float>(t)));
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] {
+            for (int round = 0; round < 2000; ++round) {
+                const uint32_t t = static_cast<uint32_t>((round * 7 + i) % 64);
+                if (round % 10 == 0) {
+                    cache.insert(price(t), std::vector<float>(16, static_cast<float>(t)));
+                } else if (auto series = cache.find(price(t))) {
+                    EXPECT_EQ(series->front(), static_cast<float>(t));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.entries, 64u);
+    EXPECT_EQ(stats.hits + stats.misses, 4u * 1800u);
+}
+
+TEST_F(SeriesCacheTest, PacksDates) {
+    EXPECT_EQ(SeriesCache::date_key("2024-01-05"), 20240105u);
+    EXPECT_EQ(SeriesCache::date_key("2024-1-5"), 0u);
+    EXPECT_EQ(SeriesCache::date_key(""), 0u);
+}
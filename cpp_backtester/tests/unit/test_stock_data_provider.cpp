@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "civil_day.h"
+#include "price_store.h"
+#include "stock_data_provider.h"
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+using namespace atlas;
+
+namespace {
+
+std::shared_ptr<const PriceHistory> make_history(std::initializer_list<const char*> dates) {
+    auto history = std::make_shared<PriceHistory>();
+    float close = 100.0f;
+    for (const char* date : dates) {
+        history->days.push_back(*parse_civil_day(date));
+        history->closes.push_back(close);
+        history->volumes.push_back(close * 10.0f);
+        close += 1.0f;
+    }
+    return history;
+}
+
+class StockDataProviderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = std::filesystem::temp_directory_path() / ("atlas_provider_" + std::to_string(::getpid()));
+        std::filesystem::create_directories(root_);
+        std::ofstream(root_ / "SPY.parquet").put('\0');
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root_);
+    }
+
+    std::filesystem::path root_;
+};
+
+} // namespace
+
+TEST(PriceHistoryTest, SlicesByDay) {
+    auto history = make_history({"2024-01-02", "2024-01-03", "2024-01-05", "2024-01-08"});
+
+    EXPECT_EQ(history->rows_through(*parse_civil_day("2024-01-01")), 0u);
+    EXPECT_EQ(history->rows_through(*parse_civil_day("2024-01-03")), 2u);
+    EXPECT_EQ(history->rows_through(*parse_civil_day("2024-01-04")), 2u);
+    EXPECT_EQ(history->rows_through(*parse_civil_day("2024-12-31")), 4u);
+
+    PriceSlice slice(history, 1, 3);
+    ASSERT_EQ(slice.size(), 2u);
+    EXPECT_EQ(slice.closes.data(), history->closes.data() + 1);
+    EXPECT_FLOAT_EQ(slice.closes[1], 102.0f);
+
+    auto records = slice.records();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].date, "2024-01-03");
+    EXPECT_EQ(records[1].date, "2024-01-05");
+    EXPECT_FLOAT_EQ(records[1].volume, 1020.0f);
+
+    EXPECT_TRUE(PriceSlice(history, 4, 4).empty());
+}
+
+TEST_F(StockDataProviderTest, RequestsShareOneHistoryPerTicker) {
+    StockDataProvider provider(root_.string());
+
+    auto history = provider.get_full_history("SPY");
+    ASSERT_FALSE(history->days.empty());
+    const std::string last_date = format_civil_day(history->days.back());
+
+    // Different periods, end dates and ranges all slice the same cached columns
+    auto a = provider.get_history_slice("SPY", 5, last_date);
+    auto b = provider.get_history_slice("SPY", 200, "2099-12-31");
+    auto c = provider.get_history_slice_range("SPY", "1990-01-01", last_date);
+    auto d = provider.get_history_slice_until("SPY", last_date);
+    EXPECT_EQ(a.history, history);
+    EXPECT_EQ(b.history, history);
+    EXPECT_EQ(c.history, history);
+    EXPECT_EQ(d.history, history);
+    EXPECT_EQ(b.closes.data() + b.size(), history->closes.data() + history->size());
+    EXPECT_EQ(d.size(), history->size());
+
+    EXPECT_TRUE(provider.get_history_slice("SPY", 5, "1990-01-01").empty());
+    EXPECT_TRUE(provider.get_historical_data_range("SPY", last_date, "1990-01-01").empty());
+    EXPECT_EQ(provider.get_historical_data("SPY", 1, last_date).back().date, last_date);
+
+    // The live bar is appended to records, never to the cached history
+    auto with_live = provider.get_historical_data_until_end_date("SPY", last_date, true);
+    EXPECT_EQ(with_live.size(), history->size() + 1);
+    EXPECT_EQ(provider.get_full_history("SPY")->size(), history->size());
+}
+
+TEST_F(StockDataProviderTest, ReloadsWhenDataFileChanges) {
+    StockDataProvider provider(root_.string());
+    auto first = provider.get_full_history("SPY");
+    EXPECT_EQ(provider.get_full_history("SPY"), first);
+
+    const auto path = root_ / "SPY.parquet";
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+    auto reloaded = provider.get_full_history("SPY");
+    EXPECT_NE(reloaded, first);
+
+    provider.invalidate_cache("SPY");
+    EXPECT_NE(provider.get_full_history("SPY"), reloaded);
+
+    EXPECT_THROW(provider.get_full_history("QQQ"), StockDataError);
+    EXPECT_THROW(provider.get_history_slice("SPY", 5, "not-a-date"), StockDataError);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
-#include \"stock_node.h\"
-#include \"strategy_parser.h\"
+#include "stock_node.h"
+#include "strategy_parser.h"
+#include "trading_calendar.h"
 
 using namespace atlas;
 
@@ -12,27 +13,27 @@ protected:
     void SetUp() override {
         // Set up a basic strategy context
         strategy.period = 5;
-        strategy.end_date = \"2024-11-25\";
-        strategy.tickers = {\"AAPL\", \"GOOGL\"};
+        strategy.end_date = "2024-11-25";
+        strategy.tickers = {"AAPL", "GOOGL"};
     }
 };
 
 TEST_F(StockNodeTest, ProcessValidStockNode) {
     // Create a valid stock node
     StrategyNode stock_node;
-    stock_node.type = \"stock\";
-    stock_node.properties = nlohmann::json{{\"symbol\", \"AAPL\"}};
-    stock_node.hash = \"test_hash\";
+    stock_node.type = "stock";
+    stock_node.properties = nlohmann::json{{"symbol", "AAPL"}};
+    stock_node.hash = "test_hash";
     
     // Set up test data
     std::vector<bool> active_mask = {true, true, false, true, false};
     int total_days = 5;
     float node_weight = 0.5f;
     std::vector<DayData> portfolio_history(total_days);
-    std::vector<std::string> date_range = {\"2024-11-21\", \"2024-11-22\", \"2024-11-23\", \"2024-11-24\", \"2024-11-25\"};
+    auto date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-11-25"), 5);
     std::unordered_map<std::string, int> flow_count;
     std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-    std::unordered_map<std::string, std::vector<float>> indicator_cache;
+    IndicatorCache indicator_cache;
     std::unordered_map<std::string, std::vector<float>> price_cache;
     
     // Process the node
@@ -47,7 +48,7 @@ TEST_F(StockNodeTest, ProcessValidStockNode) {
     EXPECT_EQ(result.processed_days, total_days);
     
     // Verify flow count was incremented
-    EXPECT_EQ(flow_count[\"test_hash\"], 1);
+    EXPECT_EQ(flow_count["test_hash"], 1);
     
     // Verify portfolio was updated for active days (days 0, 1, 3)
     // Check that stocks were added to the correct days
@@ -56,7 +57,7 @@ TEST_F(StockNodeTest, ProcessValidStockNode) {
         if (!day.empty()) {
             found_stocks = true;
             for (const auto& stock : day.stock_list()) {
-                EXPECT_EQ(stock.ticker(), \"AAPL\");
+                EXPECT_EQ(stock.ticker(), "AAPL");
                 EXPECT_FLOAT_EQ(stock.weight_tomorrow(), 0.5f);
             }
         }
@@ -67,17 +68,17 @@ TEST_F(StockNodeTest, ProcessValidStockNode) {
 TEST_F(StockNodeTest, ProcessInvalidNodeMissingSymbol) {
     // Create a stock node without symbol
     StrategyNode invalid_node;
-    invalid_node.type = \"stock\";
-    invalid_node.properties = nlohmann::json{{\"name\", \"test\"}}; // Missing symbol
+    invalid_node.type = "stock";
+    invalid_node.properties = nlohmann::json{{"name", "test"}}; // Missing symbol
     
     std::vector<bool> active_mask = {true, false};
     int total_days = 2;
     float node_weight = 1.0f;
     std::vector<DayData> portfolio_history(total_days);
-    std::vector<std::string> date_range = {\"2024-11-24\", \"2024-11-25\"};
+    auto date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-11-25"), 2);
     std::unordered_map<std::string, int> flow_count;
     std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-    std::unordered_map<std::string, std::vector<float>> indicator_cache;
+    IndicatorCache indicator_cache;
     std::unordered_map<std::string, std::vector<float>> price_cache;
     
     NodeResult result = processor.process(
@@ -93,17 +94,17 @@ TEST_F(StockNodeTest, ProcessInvalidNodeMissingSymbol) {
 
 TEST_F(StockNodeTest, ProcessInvalidWeightRange) {
     StrategyNode stock_node;
-    stock_node.type = \"stock\";
-    stock_node.properties = nlohmann::json{{\"symbol\", \"AAPL\"}};
+    stock_node.type = "stock";
+    stock_node.properties = nlohmann::json{{"symbol", "AAPL"}};
     
     std::vector<bool> active_mask = {true};
     int total_days = 1;
     float invalid_weight = 1.5f; // Invalid weight > 1.0
     std::vector<DayData> portfolio_history(total_days);
-    std::vector<std::string> date_range = {\"2024-11-25\"};
+    auto date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-11-25"), 1);
     std::unordered_map<std::string, int> flow_count;
     std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-    std::unordered_map<std::string, std::vector<float>> indicator_cache;
+    IndicatorCache indicator_cache;
     std::unordered_map<std::string, std::vector<float>> price_cache;
     
     NodeResult result = processor.process(
@@ -117,17 +118,17 @@ TEST_F(StockNodeTest, ProcessInvalidWeightRange) {
 
 TEST_F(StockNodeTest, ProcessEmptyActiveMask) {
     StrategyNode stock_node;
-    stock_node.type = \"stock\";
-    stock_node.properties = nlohmann::json{{\"symbol\", \"AAPL\"}};
+    stock_node.type = "stock";
+    stock_node.properties = nlohmann::json{{"symbol", "AAPL"}};
     
     std::vector<bool> empty_mask; // Empty mask
     int total_days = 1;
     float node_weight = 0.5f;
     std::vector<DayData> portfolio_history(total_days);
-    std::vector<std::string> date_range = {\"2024-11-25\"};
+    auto date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-11-25"), 1);
     std::unordered_map<std::string, int> flow_count;
     std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-    std::unordered_map<std::string, std::vector<float>> indicator_cache;
+    IndicatorCache indicator_cache;
     std::unordered_map<std::string, std::vector<float>> price_cache;
     
     NodeResult result = processor.process(
@@ -141,18 +142,18 @@ TEST_F(StockNodeTest, ProcessEmptyActiveMask) {
 
 TEST_F(StockNodeTest, ProcessWithAllActiveDays) {
     StrategyNode stock_node;
-    stock_node.type = \"stock\";
-    stock_node.properties = nlohmann::json{{\"symbol\", \"GOOGL\"}};
+    stock_node.type = "stock";
+    stock_node.properties = nlohmann::json{{"symbol", "GOOGL"}};
     
     // All days active
     std::vector<bool> active_mask = {true, true, true};
     int total_days = 3;
     float node_weight = 0.33f;
     std::vector<DayData> portfolio_history(total_days);
-    std::vector<std::string> date_range = {\"2024-11-23\", \"2024-11-24\", \"2024-11-25\"};
+    auto date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-11-25"), 3);
     std::unordered_map<std::string, int> flow_count;
     std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-    std::unordered_map<std::string, std::vector<float>> indicator_cache;
+    IndicatorCache indicator_cache;
     std::unordered_map<std::string, std::vector<float>> price_cache;
     
     NodeResult result = processor.process(
@@ -166,25 +167,25 @@ TEST_F(StockNodeTest, ProcessWithAllActiveDays) {
     // All days should have the stock
     for (const auto& day : portfolio_history) {
         EXPECT_FALSE(day.empty());
-        EXPECT_EQ(day.stock_list()[0].ticker(), \"GOOGL\");
+        EXPECT_EQ(day.stock_list()[0].ticker(), "GOOGL");
         EXPECT_FLOAT_EQ(day.stock_list()[0].weight_tomorrow(), 0.33f);
     }
 }
 
 TEST_F(StockNodeTest, ProcessWithNoActiveDays) {
     StrategyNode stock_node;
-    stock_node.type = \"stock\";
-    stock_node.properties = nlohmann::json{{\"symbol\", \"TSLA\"}};
+    stock_node.type = "stock";
+    stock_node.properties = nlohmann::json{{"symbol", "TSLA"}};
     
     // No days active
     std::vector<bool> active_mask = {false, false, false};
     int total_days = 3;
     float node_weight = 1.0f;
     std::vector<DayData> portfolio_history(total_days);
-    std::vector<std::string> date_range = {\"2024-11-23\", \"2024-11-24\", \"2024-11-25\"};
+    auto date_range = TradingCalendar::nyse().range(TradingCalendar::parse("2024-11-25"), 3);
     std::unordered_map<std::string, int> flow_count;
     std::unordered_map<std::string, std::vector<DayData>> flow_stocks;
-    std::unordered_map<std::string, std::vector<float>> indicator_cache;
+    IndicatorCache indicator_cache;
     std::unordered_map<std::string, std::vector<float>> price_cache;
     
     NodeResult result = processor.process(
@@ -202,5 +203,5 @@ TEST_F(StockNodeTest, ProcessWithNoActiveDays) {
 }
 
 TEST_F(StockNodeTest, GetNodeType) {
-    EXPECT_EQ(processor.get_node_type(), \"stock\");
-}", "original_text": "", "replace_all": false}]
\ No newline at end of file
+    EXPECT_EQ(processor.get_node_type(), "stock");
+}
\ No newline at end of file
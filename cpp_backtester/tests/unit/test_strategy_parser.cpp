@@ -1,5 +1,5 @@
 #include <gtest/gtest.h>
-#include \"strategy_parser.h\"
+#include "strategy_parser.h"
 #include <nlohmann/json.hpp>
 
 using namespace atlas;
@@ -9,12 +9,12 @@ protected:
     StrategyParser parser;
     
     // Sample strategy JSON similar to SmallStrategy.json
-    const std::string sample_strategy_json = R\"({
-        \"json\": \"{\\\"type\\\":\\\"root\\\",\\\"properties\\\":{\\\"id\\\":\\\"f5575cedaa4a16c0c192cda063fe0724\\\",\\\"step\\\":\\\"root\\\",\\\"name\\\":\\\"root node\\\",\\\"triggerPeriod\\\":\\\"monthly\\\"},\\\"sequence\\\":[{\\\"id\\\":\\\"714628fcdeda1ca52722fd562e0f97f5\\\",\\\"componentType\\\":\\\"task\\\",\\\"type\\\":\\\"stock\\\",\\\"name\\\":\\\"BUY QQQ\\\",\\\"properties\\\":{\\\"symbol\\\":\\\"QQQ\\\"},\\\"hash\\\":\\\"3d78dfbadec0f0703a82240269cdef47\\\",\\\"parentHash\\\":\\\"a533604873cbe4f0523af58547683c45\\\"}],\\\"tickers\\\":[\\\"QQQ\\\"],\\\"indicators\\\":[],\\\"nodeChildrenHash\\\":\\\"c51d42f7f3a70aaab465d21954f457d9\\\"}\",
-        \"period\": \"10\",
-        \"end_date\": \"2024-11-25\",
-        \"hash\": \"d2936843a0ad3275a5f5e72749594ffe\"
-    })\";
+    const std::string sample_strategy_json = R"({
+        "json": "{\"type\":\"root\",\"properties\":{\"id\":\"f5575cedaa4a16c0c192cda063fe0724\",\"step\":\"root\",\"name\":\"root node\",\"triggerPeriod\":\"monthly\"},\"sequence\":[{\"id\":\"714628fcdeda1ca52722fd562e0f97f5\",\"componentType\":\"task\",\"type\":\"stock\",\"name\":\"BUY QQQ\",\"properties\":{\"symbol\":\"QQQ\"},\"hash\":\"3d78dfbadec0f0703a82240269cdef47\",\"parentHash\":\"a533604873cbe4f0523af58547683c45\"}],\"tickers\":[\"QQQ\"],\"indicators\":[],\"nodeChildrenHash\":\"c51d42f7f3a70aaab465d21954f457d9\"}",
+        "period": "10",
+        "end_date": "2024-11-25",
+        "hash": "d2936843a0ad3275a5f5e72749594ffe"
+    })";
 };
 
 TEST_F(StrategyParserTest, ParseValidStrategy) {
@@ -22,16 +22,16 @@ TEST_F(StrategyParserTest, ParseValidStrategy) {
         Strategy strategy = parser.parse_strategy(sample_strategy_json);
         
         EXPECT_EQ(strategy.period, 10);
-        EXPECT_EQ(strategy.end_date, \"2024-11-25\");
-        EXPECT_EQ(strategy.strategy_hash, \"d2936843a0ad3275a5f5e72749594ffe\");
-        EXPECT_EQ(strategy.root.type, \"root\");
+        EXPECT_EQ(strategy.end_date, "2024-11-25");
+        EXPECT_EQ(strategy.strategy_hash, "d2936843a0ad3275a5f5e72749594ffe");
+        EXPECT_EQ(strategy.root.type, "root");
         EXPECT_FALSE(strategy.tickers.empty());
-        EXPECT_EQ(strategy.tickers[0], \"QQQ\");
+        EXPECT_EQ(strategy.tickers[0], "QQQ");
     });
 }
 
 TEST_F(StrategyParserTest, ParseInvalidJSON) {
-    std::string invalid_json = \"invalid json\";
+    std::string invalid_json = "invalid json";
     
     EXPECT_THROW({
         parser.parse_strategy(invalid_json);
@@ -39,11 +39,11 @@ TEST_F(StrategyParserTest, ParseInvalidJSON) {
 }
 
 TEST_F(StrategyParserTest, ParseMissingJsonField) {
-    std::string missing_json_field = R\"({
-        \"period\": \"10\",
-        \"end_date\": \"2024-11-25\",
-        \"hash\": \"test\"
-    })\";
+    std::string missing_json_field = R"({
+        "period": "10",
+        "end_date": "2024-11-25",
+        "hash": "test"
+    })";
     
     EXPECT_THROW({
         parser.parse_strategy(missing_json_field);
@@ -64,84 +64,194 @@ TEST_F(StrategyParserTest, ValidateInvalidStrategy) {
 
 TEST_F(StrategyParserTest, ParseStockNode) {
     nlohmann::json stock_node_json = {
-        {\"id\", \"test_id\"},
-        {\"type\", \"stock\"},
-        {\"name\", \"BUY AAPL\"},
-        {\"componentType\", \"task\"},
-        {\"properties\", {{\"symbol\", \"AAPL\"}}},
-        {\"hash\", \"test_hash\"}
+        {"id", "test_id"},
+        {"type", "stock"},
+        {"name", "BUY AAPL"},
+        {"componentType", "task"},
+        {"properties", {{"symbol", "AAPL"}}},
+        {"hash", "test_hash"}
     };
     
     StrategyNode node = parser.parse_node(stock_node_json);
     
-    EXPECT_EQ(node.id, \"test_id\");
-    EXPECT_EQ(node.type, \"stock\");
-    EXPECT_EQ(node.name, \"BUY AAPL\");
-    EXPECT_EQ(node.component_type, \"task\");
-    EXPECT_EQ(node.hash, \"test_hash\");
-    EXPECT_TRUE(node.properties.contains(\"symbol\"));
-    EXPECT_EQ(node.properties[\"symbol\"].get<std::string>(), \"AAPL\");
+    EXPECT_EQ(node.id, "test_id");
+    EXPECT_EQ(node.type, "stock");
+    EXPECT_EQ(node.name, "BUY AAPL");
+    EXPECT_EQ(node.component_type, "task");
+    EXPECT_EQ(node.hash, "test_hash");
+    EXPECT_TRUE(node.properties.contains("symbol"));
+    EXPECT_EQ(node.properties["symbol"].get<std::string>(), "AAPL");
 }
 
 TEST_F(StrategyParserTest, ParseConditionalNode) {
     nlohmann::json conditional_node_json = {
-        {\"id\", \"cond_id\"},
-        {\"type\", \"condition\"},
-        {\"name\", \"Price Condition\"},
-        {\"properties\", {
-            {\"comparison\", \"<\"},
-            {\"x\", {{\"indicator\", \"current price\"}, {\"source\", \"SPY\"}}},
-            {\"y\", {{\"indicator\", \"SMA\"}, {\"period\", \"200\"}, {\"source\", \"SPY\"}}}
+        {"id", "cond_id"},
+        {"type", "condition"},
+        {"name", "Price Condition"},
+        {"properties", {
+            {"comparison", "<"},
+            {"x", {{"indicator", "current price"}, {"source", "SPY"}}},
+            {"y", {{"indicator", "SMA"}, {"period", "200"}, {"source", "SPY"}}}
         }},
-        {\"branches\", {
-            {\"true\", nlohmann::json::array()},
-            {\"false\", nlohmann::json::array()}
+        {"branches", {
+            {"true", nlohmann::json::array()},
+            {"false", nlohmann::json::array()}
         }}
     };
     
     StrategyNode node = parser.parse_node(conditional_node_json);
     
-    EXPECT_EQ(node.type, \"condition\");
-    EXPECT_TRUE(node.properties.contains(\"comparison\"));
-    EXPECT_TRUE(node.properties.contains(\"x\"));
-    EXPECT_TRUE(node.properties.contains(\"y\"));
-    EXPECT_TRUE(node.branches.contains(\"true\"));
-    EXPECT_TRUE(node.branches.contains(\"false\"));
+    EXPECT_EQ(node.type, "condition");
+    EXPECT_TRUE(node.properties.contains("comparison"));
+    EXPECT_TRUE(node.properties.contains("x"));
+    EXPECT_TRUE(node.properties.contains("y"));
+    EXPECT_TRUE(node.branches.contains("true"));
+    EXPECT_TRUE(node.branches.contains("false"));
 }
 
 TEST_F(StrategyParserTest, ParseNodeWithSequence) {
     nlohmann::json folder_node_json = {
-        {\"type\", \"folder\"},
-        {\"sequence\", nlohmann::json::array({
+        {"type", "folder"},
+        {"sequence", nlohmann::json::array({
             {
-                {\"type\", \"stock\"},
-                {\"properties\", {{\"symbol\", \"AAPL\"}}}
+                {"type", "stock"},
+                {"properties", {{"symbol", "AAPL"}}}
             },
             {
-                {\"type\", \"stock\"},
-                {\"properties\", {{\"symbol\", \"GOOGL\"}}}
+                {"type", "stock"},
+                {"properties", {{"symbol", "GOOGL"}}}
             }
         })}
     };
     
     StrategyNode node = parser.parse_node(folder_node_json);
     
-    EXPECT_EQ(node.type, \"folder\");
+    EXPECT_EQ(node.type, "folder");
     EXPECT_EQ(node.sequence.size(), 2);
-    EXPECT_EQ(node.sequence[0].type, \"stock\");
-    EXPECT_EQ(node.sequence[1].type, \"stock\");
+    EXPECT_EQ(node.sequence[0].type, "stock");
+    EXPECT_EQ(node.sequence[1].type, "stock");
 }
 
 TEST_F(StrategyParserTest, ValidateStockNodeValid) {
     nlohmann::json valid_stock = {
-        {\"type\", \"stock\"},
-        {\"properties\", {{\"symbol\", \"AAPL\"}}}
+        {"type", "stock"},
+        {"properties", {{"symbol", "AAPL"}}}
     };
     
     StrategyNode node = parser.parse_node(valid_stock);
     // Note: We would need to expose validate_node as public to test it directly
     // For now, this test validates that parsing completes successfully
-    EXPECT_EQ(node.type, \"stock\");
+    EXPECT_EQ(node.type, "stock");
+}
+
+TEST_F(StrategyParserTest, ParseNodeResolvesConditionSpec) {
+    nlohmann::json conditional_node_json = {
+        {"type", "condition"},
+        {"properties", {
+            {"comparison", ">="},
+            {"x", {{"indicator", "Relative Strength Index"}, {"period", "10"}, {"source", "SPY"}}},
+            {"y", {{"indicator", "Fixed-Value"}, {"period", "60.00"}}}
+        }},
+        {"branches", {
+            {"true", nlohmann::json::array()},
+            {"false", nlohmann::json::array()}
+        }}
+    };
+    
+    StrategyNode node = parser.parse_node(conditional_node_json);
+    
+    const auto* spec = std::get_if<ConditionSpec>(&node.spec);
+    ASSERT_NE(spec, nullptr);
+    EXPECT_EQ(spec->comparison, ComparisonOperator::GREATER_EQUAL);
+    EXPECT_EQ(spec->x.indicator, "Relative Strength Index");
+    EXPECT_EQ(spec->x.source, "SPY");
+    EXPECT_EQ(spec->x.period, 10);
+    EXPECT_TRUE(spec->y.is_constant());
+    EXPECT_FLOAT_EQ(spec->y.value, 60.0f);
+}
+
+TEST_F(StrategyParserTest, ParseNodeResolvesSortAndAllocationSpecs) {
+    nlohmann::json sort_node_json = {
+        {"type", "Sort"},
+        {"properties", {
+            {"select", {{"function", "Top"}, {"howmany", "2"}}},
+            {"sortby", {{"function", "Relative Strength Index"}, {"window", "14"}}}
+        }},
+        {"branches", {{"Top-2", nlohmann::json::array()}}}
+    };
+    
+    StrategyNode sort_node = parser.parse_node(sort_node_json);
+    const auto* sort_spec = std::get_if<SortSpec>(&sort_node.spec);
+    ASSERT_NE(sort_spec, nullptr);
+    EXPECT_EQ(sort_spec->select_function, SelectFunction::TOP);
+    EXPECT_EQ(sort_spec->selection_count, 2);
+    EXPECT_EQ(sort_spec->window, 14);
+    
+    // Allocation function lives at the top level of the node
+    nlohmann::json allocation_node_json = {
+        {"type", "allocation"},
+        {"function", "Allocation"},
+        {"properties", {{"values", {{"a", 45}, {"b", "55"}}}}},
+        {"branches", {{"a", nlohmann::json::array()}, {"b", nlohmann::json::array()}}}
+    };
+    
+    StrategyNode allocation_node = parser.parse_node(allocation_node_json);
+    const auto* allocation_spec = std::get_if<AllocationSpec>(&allocation_node.spec);
+    ASSERT_NE(allocation_spec, nullptr);
+    EXPECT_EQ(allocation_spec->function, AllocationFunction::ALLOCATION);
+    ASSERT_EQ(allocation_spec->weights.size(), 2);
+    EXPECT_FLOAT_EQ(allocation_spec->weights[0].second, 0.45f);
+    EXPECT_FLOAT_EQ(allocation_spec->weights[1].second, 0.55f);
+}
+
+TEST_F(StrategyParserTest, ParseNodeRejectsInvalidProperties) {
+    // Unknown comparison operator
+    nlohmann::json bad_comparison = {
+        {"type", "condition"},
+        {"properties", {
+            {"comparison", "~"},
+            {"x", {{"indicator", "current price"}, {"source", "SPY"}}},
+            {"y", {{"indicator", "current price"}, {"source", "QQQ"}}}
+        }}
+    };
+    EXPECT_THROW(parser.parse_node(bad_comparison), StrategyParseError);
+    
+    // Non-numeric period
+    nlohmann::json bad_period = {
+        {"type", "condition"},
+        {"properties", {
+            {"comparison", "<"},
+            {"x", {{"indicator", "Relative Strength Index"}, {"period", "ten"}, {"source", "SPY"}}},
+            {"y", {{"indicator", "constant"}, {"period", "50"}}}
+        }}
+    };
+    EXPECT_THROW(parser.parse_node(bad_period), StrategyParseError);
+    
+    // Invalid node nested in a branch is rejected at parse time
+    nlohmann::json bad_branch = {
+        {"type", "folder"},
+        {"sequence", nlohmann::json::array({
+            {
+                {"type", "Sort"},
+                {"properties", {
+                    {"select", {{"function", "Top"}, {"howmany", "1"}}},
+                    {"sortby", {{"function", "Relative Strength Index"}, {"window", "10"}}}
+                }},
+                {"branches", {{"Top-1", nlohmann::json::array({
+                    {{"type", "stock"}, {"properties", nlohmann::json::object()}}
+                })}}}
+            }
+        })}
+    };
+    EXPECT_THROW(parser.parse_node(bad_branch), StrategyParseError);
+    
+    // Manual allocation must sum to 100%
+    nlohmann::json bad_allocation = {
+        {"type", "allocation"},
+        {"function", "Allocation"},
+        {"properties", {{"values", {{"a", 40}, {"b", 40}}}}}
+    };
+    EXPECT_THROW(parser.parse_node(bad_allocation), StrategyParseError);
 }
 
 TEST_F(StrategyParserTest, ComplexStrategyParsing) {
@@ -149,8 +259,8 @@ TEST_F(StrategyParserTest, ComplexStrategyParsing) {
     Strategy strategy = parser.parse_strategy(sample_strategy_json);
     
     // Verify root node
-    EXPECT_EQ(strategy.root.type, \"root\");
-    EXPECT_TRUE(strategy.root.properties.contains(\"id\"));
+    EXPECT_EQ(strategy.root.type, "root");
+    EXPECT_TRUE(strategy.root.properties.contains("id"));
     
     // Verify tickers are extracted
     EXPECT_FALSE(strategy.tickers.empty());
@@ -158,4 +268,4 @@ TEST_F(StrategyParserTest, ComplexStrategyParsing) {
     // Verify basic structure
     EXPECT_GE(strategy.period, 1);
     EXPECT_FALSE(strategy.end_date.empty());
-}", "original_text": "", "replace_all": false}]
\ No newline at end of file
+}
\ No newline at end of file
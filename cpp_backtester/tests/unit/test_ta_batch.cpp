@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "ta_batch.h"
+#include "ta_functions.h"
+#include "ta_kernels.h"
+#include "work_stealing_pool.h"
+#include <cmath>
+#include <random>
+
+using namespace atlas;
+
+class TABatchTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        set_simd_level(detected_simd_level());
+    }
+
+    // 70 tickers spans two blocks and a padded row
+    static ta::TickerPanel random_panel(size_t tickers = 70, size_t days = 300) {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> level(20.0f, 500.0f);
+        std::normal_distribution<float> step(0.0f, 1.0f);
+        ta::TickerPanel panel(tickers, days);
+        for (size_t t = 0; t < tickers; ++t) {
+            float price = level(rng);
+            for (size_t d = 0; d < days; ++d) {
+                price = std::max(1.0f, price + step(rng));
+                panel(d, t) = price;
+            }
+        }
+        return panel;
+    }
+
+    static std::vector<float> scalar(const std::vector<float>& prices, const ta::IndicatorSpec& spec) {
+        switch (spec.kind) {
+            case ta::IndicatorKind::SMA: return TAFunctions::calculate_sma(prices, spec.period);
+            case ta::IndicatorKind::EMA: return TAFunctions::calculate_ema(prices, spec.period);
+            case ta::IndicatorKind::RSI: return TAFunctions::calculate_rsi(prices, spec.period);
+            case ta::IndicatorKind::STANDARD_DEVIATION:
+                return TAFunctions::calculate_standard_deviation(prices, spec.period);
+            case ta::IndicatorKind::RETURNS_STANDARD_DEVIATION: {
+                // Day-align the returns-based result
+                auto values = TAFunctions::calculate_returns_standard_deviation(prices, spec.period);
+                values.insert(values.begin(), std::nanf(""));
+                return values;
+            }
+            case ta::IndicatorKind::CUMULATIVE_RETURN:
+                return TAFunctions::calculate_rolling_cumulative_return(prices, spec.period);
+            case ta::IndicatorKind::MAX_DRAWDOWN:
+                return TAFunctions::calculate_rolling_max_drawdown(prices, spec.period);
+        }
+        return {};
+    }
+
+    static void expect_matches_scalar(const ta::TickerPanel& prices, const ta::TickerPanel& batch,
+                                      const ta::IndicatorSpec& spec) {
+        for (size_t t = 0; t < prices.tickers(); ++t) {
+            auto expected = scalar(prices.series(t), spec);
+            auto actual = batch.series(t);
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t d = 0; d < actual.size(); ++d) {
+                if (std::isnan(expected[d])) {
+                    EXPECT_TRUE(std::isnan(actual[d])) << "ticker " << t << " day " << d;
+                } else {
+                    EXPECT_NEAR(actual[d], expected[d], std::max(1e-3f, std::abs(expected[d]) * 1e-4f))
+                        << "ticker " << t << " day " << d;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(TABatchTest, PanelRowsAreAlignedAndPadded) {
+    ta::TickerPanel panel(70, 5);
+    EXPECT_EQ(panel.stride(), 80u);
+    for (size_t d = 0; d < panel.days(); ++d) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(panel.row(d)) % 64, 0u);
+    }
+
+    std::vector<float> series{1, 2, 3, 4, 5};
+    panel.set_series(69, series);
+    EXPECT_EQ(panel.series(69), series);
+    EXPECT_THROW(panel.set_series(70, series), std::out_of_range);
+}
+
+TEST_F(TABatchTest, EveryIndicatorMatchesScalarPerTicker) {
+    auto prices = random_panel();
+    const std::vector<ta::IndicatorSpec> specs{
+        {ta::IndicatorKind::SMA, 20},
+        {ta::IndicatorKind::EMA, 12},
+        {ta::IndicatorKind::RSI, 14},
+        {ta::IndicatorKind::STANDARD_DEVIATION, 10},
+        {ta::IndicatorKind::RETURNS_STANDARD_DEVIATION, 21},
+        {ta::IndicatorKind::CUMULATIVE_RETURN, 20},
+        {ta::IndicatorKind::MAX_DRAWDOWN, 63},
+    };
+
+    WorkStealingPool pool(4);
+    auto batched = ta::compute_indicators(prices, specs, &pool);
+    ASSERT_EQ(batched.size(), specs.size());
+    for (size_t s = 0; s < specs.size(); ++s) {
+        SCOPED_TRACE(static_cast<int>(specs[s].kind));
+        expect_matches_scalar(prices, batched[s], specs[s]);
+    }
+}
+
+TEST_F(TABatchTest, SimdLevelsAgree) {
+    auto prices = random_panel(33, 120);
+    const ta::IndicatorSpec spec{ta::IndicatorKind::RSI, 10};
+
+    set_simd_level(SimdLevel::SCALAR);
+    auto expected = ta::compute_indicator(prices, spec);
+    for (auto level : {SimdLevel::AVX2, SimdLevel::AVX512}) {
+        set_simd_level(level);
+        auto actual = ta::compute_indicator(prices, spec);
+        expect_matches_scalar(prices, actual, spec);
+        for (size_t t = 0; t < prices.tickers(); ++t) {
+            for (size_t d = spec.period; d < prices.days(); ++d) {
+                EXPECT_NEAR(actual(d, t), expected(d, t), 1e-3f);
+            }
+        }
+    }
+}
+
+TEST_F(TABatchTest, GapsOnlyAffectTheirWindows) {
+    auto prices = random_panel(3, 60);
+    prices(30, 1) = std::nanf("");
+    auto sma = ta::compute_indicator(prices, {ta::IndicatorKind::SMA, 5});
+
+    for (size_t d = 4; d < prices.days(); ++d) {
+        EXPECT_FALSE(std::isnan(sma(d, 0)));
+        EXPECT_EQ(std::isnan(sma(d, 1)), d >= 30 && d < 35) << "day " << d;
+    }
+}
+
+TEST_F(TABatchTest, RejectsShortHistoryAndBadPeriod) {
+    auto prices = random_panel(4, 10);
+    EXPECT_THROW(ta::compute_indicator(prices, {ta::IndicatorKind::RSI, 10}), TAFunctionsError);
+    EXPECT_THROW(ta::compute_indicator(prices, {ta::IndicatorKind::SMA, 0}), TAFunctionsError);
+    EXPECT_NO_THROW(ta::compute_indicator(prices, {ta::IndicatorKind::SMA, 10}));
+}
+
+TEST_F(TABatchTest, BatchGetterMatchesPerTickerGetter) {
+    const std::vector<std::string> tickers{"SPY", "QQQ", "AAPL", "MSFT", "XLK"};
+    auto batch = TechnicalIndicators::get_indicator_batch(tickers, {ta::IndicatorKind::RSI, 14}, 30, "2024-01-01");
+    ASSERT_EQ(batch.size(), tickers.size());
+
+    for (size_t t = 0; t < tickers.size(); ++t) {
+        auto single = TechnicalIndicators::get_rsi(tickers[t], 30, 14, "2024-01-01");
+        ASSERT_TRUE(batch[t].success) << batch[t].error_message;
+        ASSERT_EQ(batch[t].values.size(), single.values.size());
+        for (size_t i = 0; i < single.values.size(); ++i) {
+            if (std::isnan(single.values[i])) {
+                EXPECT_TRUE(std::isnan(batch[t].values[i]));
+            } else {
+                EXPECT_NEAR(batch[t].values[i], single.values[i], 1e-3f);
+            }
+        }
+    }
+}
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+#include "ta_kernels.h"
+#include "ta_functions.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace atlas;
+
+class TAKernelsTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        set_simd_level(detected_simd_level());
+        ta::set_specialized_kernels(true);
+    }
+
+    // Price-like random walk around a large level, where naive float sums lose precision
+    static std::vector<float> random_walk(size_t size, float start = 4000.0f) {
+        std::mt19937 rng(7);
+        std::normal_distribution<float> step(0.0f, 5.0f);
+        std::vector<float> prices(size);
+        float price = start;
+        for (auto& p : prices) {
+            price += step(rng);
+            p = price;
+        }
+        return prices;
+    }
+
+    static void expect_close(float actual, double reference) {
+        const double tolerance = std::max(1e-4, std::abs(reference) * ta::kJuliaRelativeTolerance);
+        EXPECT_NEAR(actual, reference, tolerance);
+    }
+
+    static std::vector<SimdLevel> levels() {
+        std::vector<SimdLevel> result{SimdLevel::SCALAR};
+        if (detected_simd_level() >= SimdLevel::AVX2) result.push_back(SimdLevel::AVX2);
+        if (detected_simd_level() >= SimdLevel::AVX512) result.push_back(SimdLevel::AVX512);
+        return result;
+    }
+};
+
+TEST_F(TAKernelsTest, RollingMeanMatchesDoubleReference) {
+    // Odd length exercises the vector bodies and their scalar tails
+    auto data = random_walk(1003);
+    const int period = 21;
+
+    for (auto level : levels()) {
+        set_simd_level(level);
+        auto sma = ta::rolling_mean(data, period);
+        ASSERT_EQ(sma.size(), data.size() - period + 1);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(sma.data()) % 64, 0u);
+
+        for (size_t k = 0; k < sma.size(); ++k) {
+            double sum = 0.0;
+            for (int j = 0; j < period; ++j) sum += data[k + j];
+            expect_close(sma[k], sum / period);
+        }
+    }
+}
+
+TEST_F(TAKernelsTest, RollingStddevMatchesDoubleReference) {
+    auto data = random_walk(517);
+    const int period = 14;
+
+    for (auto level : levels()) {
+        set_simd_level(level);
+        auto population = ta::rolling_stddev(data, period);
+        auto sample = ta::rolling_stddev(data, period, true, 100.0f);
+
+        for (size_t k = 0; k < population.size(); ++k) {
+            double mean = 0.0;
+            for (int j = 0; j < period; ++j) mean += data[k + j];
+            mean /= period;
+            double sum_sq = 0.0;
+            for (int j = 0; j < period; ++j) sum_sq += (data[k + j] - mean) * (data[k + j] - mean);
+            expect_close(population[k], std::sqrt(sum_sq / period));
+            expect_close(sample[k], std::sqrt(sum_sq / (period - 1)) * 100.0);
+        }
+    }
+}
+
+TEST_F(TAKernelsTest, RollingStddevHighLevelLowVariance) {
+    // Quiet trading far above the first prices, with a jump in the middle of a block:
+    // one-pass sums centered on the start would cancel to noise
+    std::mt19937 rng(11);
+    std::normal_distribution<float> noise(0.0f, 0.25f);
+    std::vector<float> data;
+    for (int i = 0; i < 40; ++i) data.push_back(100.0f + noise(rng));
+    for (int i = 0; i < 700; ++i) data.push_back(1.0e6f + noise(rng));
+    for (int i = 0; i < 500; ++i) data.push_back(2.5e6f + noise(rng));
+
+    for (int period : {13, 20}) {
+        for (auto level : levels()) {
+            set_simd_level(level);
+            auto population = ta::rolling_stddev(data, period);
+            auto sample = ta::rolling_stddev(data, period, true, 100.0f);
+            ASSERT_EQ(population.size(), data.size() - period + 1);
+
+            for (size_t k = 0; k < population.size(); ++k) {
+                double mean = 0.0;
+                for (int j = 0; j < period; ++j) mean += data[k + j];
+                mean /= period;
+                double sum_sq = 0.0;
+                for (int j = 0; j < period; ++j) sum_sq += (data[k + j] - mean) * (data[k + j] - mean);
+                const double reference = std::sqrt(sum_sq / period);
+                EXPECT_NEAR(population[k], reference, reference * ta::kJuliaRelativeTolerance + 1e-6)
+                    << "window " << k << " period " << period;
+                expect_close(sample[k], std::sqrt(sum_sq / (period - 1)) * 100.0);
+            }
+        }
+    }
+}
+
+TEST_F(TAKernelsTest, ReturnsMatchScalarExactly) {
+    auto prices = random_walk(301, 10.0f);
+    prices[40] = 0.0f;
+    prices[41] = -3.0f;
+
+    set_simd_level(SimdLevel::SCALAR);
+    auto expected = ta::percent_returns(prices);
+    EXPECT_EQ(expected[40], 0.0f);
+    EXPECT_EQ(expected[41], 0.0f);
+
+    for (auto level : levels()) {
+        set_simd_level(level);
+        auto returns = ta::percent_returns(prices);
+        ASSERT_EQ(returns.size(), expected.size());
+        for (size_t i = 0; i < returns.size(); ++i) {
+            EXPECT_EQ(returns[i], expected[i]) << "index " << i;
+        }
+    }
+}
+
+TEST_F(TAKernelsTest, NonFiniteInputOnlyAffectsItsWindows) {
+    auto data = random_walk(100);
+    data[50] = std::nanf("");
+    const int period = 10;
+
+    auto sma = ta::rolling_mean(data, period);
+    for (size_t k = 0; k < sma.size(); ++k) {
+        const bool covers_gap = k <= 50 && 50 < k + period;
+        EXPECT_EQ(std::isnan(sma[k]), covers_gap) << "window " << k;
+    }
+}
+
+TEST_F(TAKernelsTest, RejectsInvalidWindows) {
+    std::vector<float> data(5, 1.0f);
+    EXPECT_THROW(ta::rolling_mean(data, 0), std::invalid_argument);
+    EXPECT_THROW(ta::rolling_mean(data, 6), std::invalid_argument);
+    EXPECT_TRUE(ta::percent_returns(std::span<const float>(data.data(), 1)).empty());
+}
+
+TEST_F(TAKernelsTest, RollingMaxDrawdownMatchesPerWindow) {
+    // Window lengths around the block size, including one longer than most runs
+    auto prices = random_walk(400, 100.0f);
+    for (int period : {1, 2, 7, 63, 252}) {
+        SCOPED_TRACE(period);
+        auto drawdowns = ta::rolling_max_drawdown(prices, period);
+        ASSERT_EQ(drawdowns.size(), prices.size() - period + 1);
+        for (size_t k = 0; k < drawdowns.size(); ++k) {
+            std::vector<float> window(prices.begin() + k, prices.begin() + k + period);
+            expect_close(drawdowns[k], TAFunctions::calculate_max_drawdown(window));
+        }
+    }
+
+    // Non-positive values take the per-window path
+    std::vector<float> curve{-1.0f, -2.0f, -3.0f, -4.0f, -5.0f};
+    auto fallback = ta::rolling_max_drawdown(curve, 3);
+    for (size_t k = 0; k < fallback.size(); ++k) {
+        std::vector<float> window(curve.begin() + k, curve.begin() + k + 3);
+        EXPECT_EQ(fallback[k], TAFunctions::calculate_max_drawdown(window));
+    }
+}
+
+TEST_F(TAKernelsTest, CumulativeReturnFollowsJuliaLayout) {
+    std::vector<float> curve{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    auto values = TAFunctions::calculate_rolling_cumulative_return(curve, 3);
+    ASSERT_EQ(values.size(), curve.size());
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_TRUE(std::isnan(values[i]));
+    }
+    for (size_t i = 3; i < curve.size(); ++i) {
+        EXPECT_FLOAT_EQ(values[i], (curve[i] - curve[i - 3]) / curve[i - 3] * 100.0f);
+    }
+
+    std::vector<float> short_curve{1, 2, 3};
+    auto all_nan = TAFunctions::calculate_rolling_cumulative_return(short_curve, 3);
+    EXPECT_TRUE(std::all_of(all_nan.begin(), all_nan.end(), [](float v) { return std::isnan(v); }));
+    EXPECT_THROW(TAFunctions::calculate_rolling_cumulative_return(short_curve, 5), TAFunctionsError);
+
+    // A zero base price gives 0, as percent_returns does, rather than inf or nan
+    std::vector<float> zero_curve{0, 2, 4, 0, 5};
+    auto guarded = ta::cumulative_return(zero_curve, 2);
+    ASSERT_EQ(guarded.size(), 3u);
+    EXPECT_EQ(guarded[0], 0.0f);
+    EXPECT_FLOAT_EQ(guarded[1], -100.0f);
+    EXPECT_FLOAT_EQ(guarded[2], 25.0f);
+}
+
+TEST_F(TAKernelsTest, SpecializedPeriodsMatchGenericKernels) {
+    auto prices = random_walk(777);
+    for (int period : ta::kSpecializedPeriods) {
+        SCOPED_TRACE(period);
+        const size_t count = prices.size() - period;
+        for (auto level : levels()) {
+            set_simd_level(level);
+
+            ta::set_specialized_kernels(false);
+            EXPECT_FALSE(ta::has_specialized_kernel(period));
+            auto mean = ta::rolling_mean(prices, period);
+            auto stddev = ta::rolling_stddev(prices, period, true, 100.0f);
+            std::vector<float> gain(count), loss(count);
+            ta::wilder_averages(prices.data(), prices.size(), period, gain.data(), loss.data());
+
+            ta::set_specialized_kernels(true);
+            EXPECT_TRUE(ta::has_specialized_kernel(period));
+            auto fixed_mean = ta::rolling_mean(prices, period);
+            auto fixed_stddev = ta::rolling_stddev(prices, period, true, 100.0f);
+            std::vector<float> fixed_gain(count), fixed_loss(count);
+            ta::wilder_averages(prices.data(), prices.size(), period, fixed_gain.data(), fixed_loss.data());
+
+            ASSERT_EQ(fixed_mean.size(), mean.size());
+            for (size_t k = 0; k < mean.size(); ++k) {
+                expect_close(fixed_mean[k], mean[k]);
+                expect_close(fixed_stddev[k], stddev[k]);
+            }
+            for (size_t k = 0; k < count; ++k) {
+                expect_close(fixed_gain[k], gain[k]);
+                expect_close(fixed_loss[k], loss[k]);
+            }
+        }
+    }
+    EXPECT_FALSE(ta::has_specialized_kernel(21));
+}
+
+TEST_F(TAKernelsTest, TAFunctionsKeepOutputLayout) {
+    auto prices = random_walk(60);
+    const int period = 14;
+
+    auto sma = TAFunctions::calculate_sma(prices, period);
+    ASSERT_EQ(sma.size(), prices.size());
+    EXPECT_TRUE(std::isnan(sma[period - 2]));
+    EXPECT_FALSE(std::isnan(sma[period - 1]));
+
+    // Wilder smoothing written out directly
+    auto rsi = TAFunctions::calculate_rsi(prices, period);
+    float gain = 0.0f, loss = 0.0f;
+    for (int i = 1; i <= period; ++i) {
+        float change = prices[i] - prices[i - 1];
+        gain += change > 0 ? change : 0.0f;
+        loss += change > 0 ? 0.0f : -change;
+    }
+    gain /= period;
+    loss /= period;
+    for (size_t i = period + 1; i < prices.size(); ++i) {
+        float change = prices[i] - prices[i - 1];
+        gain = (gain * (period - 1) + (change > 0 ? change : 0.0f)) / period;
+        loss = (loss * (period - 1) + (change > 0 ? 0.0f : -change)) / period;
+    }
+    EXPECT_FLOAT_EQ(rsi.back(), 100.0f - 100.0f / (1.0f + gain / loss));
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "ticker_prefetch.h"
+#include "work_stealing_pool.h"
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace atlas;
+
+namespace {
+
+IndicatorPlan plan_of(const std::vector<std::string>& tickers, int days) {
+    IndicatorPlan plan;
+    for (const auto& ticker : tickers) {
+        plan.tickers.push_back(ticker);
+        plan.lookback[ticker] = days;
+    }
+    return plan;
+}
+
+std::vector<float> closes(int days) {
+    std::vector<float> values(static_cast<size_t>(days));
+    for (int i = 0; i < days; ++i) {
+        values[static_cast<size_t>(i)] = 100.0f + static_cast<float>(i);
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(TickerPrefetchTest, LoadsTickersConcurrently) {
+    WorkStealingPool io_pool(4);
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    IndicatorPlanner::PriceLoader loader = [&](const std::string&, int days) {
+        const int now = ++running;
+        for (int seen = peak.load(); seen < now && !peak.compare_exchange_weak(seen, now);) {
+        }
+        // Hold each load until all four overlap, or give up after a while
+        for (int i = 0; i < 2000 && peak.load() < 4; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        --running;
+        return closes(days);
+    };
+
+    TickerPrefetch loads(io_pool, loader);
+    loads.start(plan_of({"SPY", "QQQ", "IWM", "TLT"}, 30));
+    for (const auto* ticker : {"SPY", "QQQ", "IWM", "TLT"}) {
+        EXPECT_EQ(loads.wait(ticker)->size(), 30u);
+    }
+    EXPECT_EQ(peak.load(), 4);
+
+    const auto timeline = loads.timeline();
+    ASSERT_EQ(timeline.size(), 4u);
+    for (const auto& event : timeline) {
+        EXPECT_TRUE(event.done);
+        EXPECT_LE(event.queued, event.started);
+        EXPECT_LE(event.started, event.finished);
+        EXPECT_EQ(event.values, 30u);
+    }
+}
+
+TEST(TickerPrefetchTest, WaitsOnlyForTheRequestedTicker) {
+    WorkStealingPool io_pool(2);
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    IndicatorPlanner::PriceLoader loader = [&](const std::string& ticker, int days) {
+        if (ticker == "SLOW") {
+            released.wait();
+        }
+        if (ticker == "BAD") {
+            throw std::runtime_error("no data for BAD");
+        }
+        return closes(days);
+    };
+
+    TickerPrefetch loads(io_pool, loader);
+    loads.start(plan_of({"SLOW", "FAST", "BAD"}, 10));
+    EXPECT_EQ(loads.wait("FAST")->back(), 109.0f);
+    EXPECT_THROW(loads.wait("BAD"), std::runtime_error);
+    EXPECT_THROW(loads.wait("NONE"), std::out_of_range);
+    EXPECT_FALSE(loads.timeline()[0].done);
+
+    release.set_value();
+    EXPECT_EQ(loads.wait("SLOW")->size(), 10u);
+    const auto timeline = loads.timeline();
+    EXPECT_TRUE(timeline[0].done);
+    EXPECT_EQ(timeline[2].error, "no data for BAD");
+}
+
+TEST(TickerPrefetchTest, FeedsThePlannerThroughTheSharedCache) {
+    WorkStealingPool io_pool(2);
+    SeriesCache shared;
+    std::atomic<int> calls{0};
+    IndicatorPlanner::PriceLoader loader = [&](const std::string&, int days) {
+        ++calls;
+        return closes(days);
+    };
+    auto plan = plan_of({"SPY", "QQQ"}, 40);
+    plan.as_of = 20240105;
+
+    IndicatorCache indicator_cache;
+    std::unordered_map<std::string, std::vector<float>> price_cache;
+    {
+        TickerPrefetch loads(io_pool, loader, &shared, plan.as_of);
+        loads.start(plan);
+        IndicatorPlanner::prefetch(plan, loader, indicator_cache, price_cache, nullptr, &shared, &loads);
+    }
+    EXPECT_EQ(calls.load(), 2);
+    EXPECT_EQ(price_cache.at("QQQ"), closes(40));
+
+    // A shorter request is served from the shared cache without loading
+    auto shorter = plan_of({"SPY"}, 25);
+    shorter.as_of = plan.as_of;
+    TickerPrefetch again(io_pool, loader, &shared, shorter.as_of);
+    again.start(shorter);
+    EXPECT_EQ(again.wait("SPY")->size(), 40u);
+    EXPECT_TRUE(again.timeline()[0].cached);
+    EXPECT_EQ(calls.load(), 2);
+}
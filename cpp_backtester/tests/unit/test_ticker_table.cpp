@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "ticker_table.h"
+#include <thread>
+
+using namespace atlas;
+
+TEST(TickerTableTest, InternsStableDenseIds) {
+    TickerTable table;
+    TickerId spy = table.intern("SPY");
+    TickerId qqq = table.intern("QQQ");
+
+    EXPECT_EQ(spy, 0u);
+    EXPECT_EQ(qqq, 1u);
+    EXPECT_EQ(table.intern("SPY"), spy);
+    EXPECT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.name(qqq), "QQQ");
+    EXPECT_EQ(table.find("QQQ"), qqq);
+    EXPECT_FALSE(table.find("TLT").has_value());
+    EXPECT_THROW(table.name(2), std::out_of_range);
+}
+
+TEST(TickerTableTest, NormalizesBeforeInterning) {
+    TickerTable table;
+    TickerId id = table.intern("BRK.B");
+
+    EXPECT_EQ(table.name(id), "BRK-B");
+    EXPECT_EQ(table.intern("BRK-B"), id);
+    EXPECT_EQ(table.find("BRK.B"), id);
+    EXPECT_EQ(normalize_ticker("BF.B"), "BF-B");
+}
+
+TEST(TickerTableTest, GrowsPastInitialIndex) {
+    TickerTable table;
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(table.intern("T" + std::to_string(i)), static_cast<TickerId>(i));
+    }
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(table.find("T" + std::to_string(i)), static_cast<TickerId>(i));
+    }
+    EXPECT_EQ(table.name(4097), "T4097");
+
+    EXPECT_EQ(TickerTable::compact(4999), 4999u);
+    EXPECT_THROW(TickerTable::compact(70000), std::out_of_range);
+}
+
+TEST(TickerTableTest, ConcurrentInternAgrees) {
+    // Every thread interns every symbol, starting at a different point
+    TickerTable table;
+    const int threads = 8;
+    const int symbols = 3000;
+    std::vector<std::vector<TickerId>> ids(threads, std::vector<TickerId>(symbols));
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&table, &ids, t] {
+            for (int i = 0; i < symbols; ++i) {
+                int symbol = (i + t * 397) % symbols;
+                ids[t][symbol] = table.intern("S" + std::to_string(symbol));
+                ASSERT_EQ(table.name(ids[t][symbol]), "S" + std::to_string(symbol));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(table.size(), static_cast<size_t>(symbols));
+    for (int i = 0; i < symbols; ++i) {
+        TickerId expected = *table.find("S" + std::to_string(i));
+        for (int t = 0; t < threads; ++t) {
+            ASSERT_EQ(ids[t][i], expected) << "thread " << t << " symbol " << i;
+        }
+    }
+}
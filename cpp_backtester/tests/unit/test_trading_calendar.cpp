@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "trading_calendar.h"
+#include "civil_day.h"
+
+using namespace atlas;
+
+namespace {
+
+int32_t day(const char* date) {
+    return TradingCalendar::parse(date);
+}
+
+int trading_days_in(int year) {
+    const auto& calendar = TradingCalendar::nyse();
+    return calendar.trading_days_between(civil_day(year - 1, 12, 31), civil_day(year, 12, 31));
+}
+
+} // namespace
+
+TEST(CivilDayTest, RoundTrips) {
+    EXPECT_EQ(parse_civil_day("1970-01-01"), 0);
+    EXPECT_EQ(parse_civil_day("2000-03-01"), 11017);
+    EXPECT_EQ(parse_civil_day("2024-02-29 16:00:00"), *parse_civil_day("2024-02-29"));
+    EXPECT_FALSE(parse_civil_day("2023-02-29"));
+    EXPECT_FALSE(parse_civil_day("2024-13-01"));
+    EXPECT_FALSE(parse_civil_day("20240101"));
+    for (int32_t day = -800; day < 60000; day += 37) {
+        EXPECT_EQ(parse_civil_day(format_civil_day(day)), day);
+    }
+}
+
+TEST(TradingCalendarTest, AppliesNyseHolidayRules) {
+    std::vector<int32_t> expected;
+    for (const char* date : {"2024-01-01", "2024-01-15", "2024-02-19", "2024-03-29", "2024-05-27",
+                             "2024-06-19", "2024-07-04", "2024-09-02", "2024-11-28", "2024-12-25"}) {
+        expected.push_back(day(date));
+    }
+    EXPECT_EQ(TradingCalendar::holidays(2024), expected);
+
+    const auto& calendar = TradingCalendar::nyse();
+    // 2022: New Year's on Saturday is not observed; Juneteenth and Christmas on Sunday move to Monday
+    EXPECT_TRUE(calendar.is_trading_day(day("2021-12-31")));
+    EXPECT_FALSE(calendar.is_trading_day(day("2022-06-20")));
+    EXPECT_FALSE(calendar.is_trading_day(day("2022-12-26")));
+    // 2021: Independence Day on Sunday closes Monday; 2020: on Saturday closes Friday
+    EXPECT_FALSE(calendar.is_trading_day(day("2021-07-05")));
+    EXPECT_FALSE(calendar.is_trading_day(day("2020-07-03")));
+    EXPECT_FALSE(calendar.is_trading_day(day("2001-09-12")));
+    EXPECT_FALSE(calendar.is_trading_day(day("2024-03-30")));
+    EXPECT_TRUE(calendar.is_trading_day(day("1997-01-20")));    // Before MLK Day closings
+
+    EXPECT_EQ(trading_days_in(2019), 252);
+    EXPECT_EQ(trading_days_in(2023), 250);
+    EXPECT_EQ(trading_days_in(2024), 252);
+}
+
+TEST(TradingCalendarTest, ConvertsBetweenDaysAndIndices) {
+    const auto& calendar = TradingCalendar::nyse();
+    EXPECT_EQ(calendar.day_at(0), day("1990-01-02"));
+    EXPECT_EQ(calendar.index_of(day("1990-01-02")), 0);
+    EXPECT_EQ(calendar.index_of(day("1990-01-06")), -1);
+
+    const int32_t friday = day("2024-11-22");
+    const int32_t index = calendar.index_of(friday);
+    EXPECT_EQ(calendar.index_on_or_before(day("2024-11-24")), index);
+    EXPECT_EQ(calendar.day_at(index), friday);
+    EXPECT_EQ(calendar.format(index + 1), "2024-11-25");
+
+    EXPECT_EQ(calendar.next_trading_day(day("2024-11-27")), day("2024-11-29"));
+    EXPECT_EQ(calendar.previous_trading_day(day("2024-11-29")), day("2024-11-27"));
+    EXPECT_EQ(calendar.previous_trading_day(day("2024-12-02")), day("2024-11-29"));
+    EXPECT_EQ(calendar.trading_days_between(day("2024-11-22"), day("2024-11-29")), 4);
+    EXPECT_EQ(calendar.trading_days_between(day("2024-11-29"), day("2024-11-22")), -4);
+
+    auto range = calendar.range(day("2024-11-24"), 3);
+    ASSERT_EQ(range.size(), 3u);
+    EXPECT_EQ(range.back(), index);
+    EXPECT_EQ(calendar.format(range.front()), "2024-11-20");
+
+    EXPECT_THROW(calendar.range(day("1990-01-03"), 5), std::out_of_range);
+    EXPECT_THROW(calendar.next_trading_day(day("2101-01-01")), std::out_of_range);
+    EXPECT_THROW(TradingCalendar::parse("2024-11-31"), std::invalid_argument);
+}
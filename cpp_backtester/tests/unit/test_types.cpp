@@ -1,5 +1,5 @@
 #include <gtest/gtest.h>
-#include \"types.h\"
+#include "types.h"
 
 using namespace atlas;
 
@@ -12,16 +12,16 @@ protected:
 
 // StockInfo tests
 TEST_F(TypesTest, StockInfoConstruction) {
-    StockInfo stock(\"AAPL\", 0.5f);
-    EXPECT_EQ(stock.ticker(), \"AAPL\");
+    StockInfo stock("AAPL", 0.5f);
+    EXPECT_EQ(stock.ticker(), "AAPL");
     EXPECT_FLOAT_EQ(stock.weight_tomorrow(), 0.5f);
 }
 
 TEST_F(TypesTest, StockInfoEquality) {
-    StockInfo stock1(\"AAPL\", 0.5f);
-    StockInfo stock2(\"AAPL\", 0.5f);
-    StockInfo stock3(\"GOOGL\", 0.5f);
-    StockInfo stock4(\"AAPL\", 0.6f);
+    StockInfo stock1("AAPL", 0.5f);
+    StockInfo stock2("AAPL", 0.5f);
+    StockInfo stock3("GOOGL", 0.5f);
+    StockInfo stock4("AAPL", 0.6f);
     
     EXPECT_EQ(stock1, stock2);
     EXPECT_NE(stock1, stock3);
@@ -30,10 +30,10 @@ TEST_F(TypesTest, StockInfoEquality) {
 
 TEST_F(TypesTest, StockInfoSetters) {
     StockInfo stock;
-    stock.set_ticker(\"MSFT\");
+    stock.set_ticker("MSFT");
     stock.set_weight_tomorrow(0.75f);
     
-    EXPECT_EQ(stock.ticker(), \"MSFT\");
+    EXPECT_EQ(stock.ticker(), "MSFT");
     EXPECT_FLOAT_EQ(stock.weight_tomorrow(), 0.75f);
 }
 
@@ -46,42 +46,72 @@ TEST_F(TypesTest, DayDataConstruction) {
 
 TEST_F(TypesTest, DayDataWithStocks) {
     std::vector<StockInfo> stocks = {
-        StockInfo(\"AAPL\", 0.3f),
-        StockInfo(\"GOOGL\", 0.7f)
+        StockInfo("AAPL", 0.3f),
+        StockInfo("GOOGL", 0.7f)
     };
     
     DayData day(stocks);
     EXPECT_FALSE(day.empty());
     EXPECT_EQ(day.size(), 2);
-    EXPECT_EQ(day.stock_list()[0].ticker(), \"AAPL\");
-    EXPECT_EQ(day.stock_list()[1].ticker(), \"GOOGL\");
+    EXPECT_EQ(day.stock_list()[0].ticker(), "AAPL");
+    EXPECT_EQ(day.stock_list()[1].ticker(), "GOOGL");
 }
 
 TEST_F(TypesTest, DayDataAddStock) {
     DayData day;
-    StockInfo stock(\"TSLA\", 1.0f);
+    StockInfo stock("TSLA", 1.0f);
     
     day.add_stock(stock);
     EXPECT_EQ(day.size(), 1);
-    EXPECT_EQ(day.stock_list()[0].ticker(), \"TSLA\");
+    EXPECT_EQ(day.stock_list()[0].ticker(), "TSLA");
 }
 
 TEST_F(TypesTest, DayDataEquality) {
     // Test equality with same stocks in different order (like Julia implementation)
     DayData day1;
-    day1.add_stock(StockInfo(\"AAPL\", 0.3f));
-    day1.add_stock(StockInfo(\"GOOGL\", 0.7f));
+    day1.add_stock(StockInfo("AAPL", 0.3f));
+    day1.add_stock(StockInfo("GOOGL", 0.7f));
     
     DayData day2;
-    day2.add_stock(StockInfo(\"GOOGL\", 0.7f));
-    day2.add_stock(StockInfo(\"AAPL\", 0.3f));
+    day2.add_stock(StockInfo("GOOGL", 0.7f));
+    day2.add_stock(StockInfo("AAPL", 0.3f));
     
     EXPECT_EQ(day1, day2); // Should be equal due to sorting in comparison
 }
 
+TEST_F(TypesTest, DayDataInlineStorage) {
+    DayData day;
+    for (int i = 0; i < 8; ++i) {
+        day.add_stock(StockInfo("T" + std::to_string(i), 0.125f));
+    }
+    EXPECT_TRUE(day.stock_list().is_inline());
+
+    // Spilling to the heap keeps every entry, and copies stay independent
+    day.add_stock(StockInfo("T8", 0.5f));
+    EXPECT_FALSE(day.stock_list().is_inline());
+    DayData copy = day;
+    copy.stock_list()[0].set_weight_tomorrow(1.0f);
+    ASSERT_EQ(day.size(), 9);
+    EXPECT_EQ(day.stock_list()[8].ticker(), "T8");
+    EXPECT_FLOAT_EQ(day.stock_list()[0].weight_tomorrow(), 0.125f);
+
+    DayData moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 9);
+    EXPECT_EQ(moved.stock_list()[8].ticker(), "T8");
+}
+
+TEST_F(TypesTest, StockInfoKeepsExactSymbol) {
+    // Positions echo the strategy's spelling; only data lookups normalize
+    StockInfo stock("BRK.B", 1.0f);
+    EXPECT_EQ(stock.ticker(), "BRK.B");
+    EXPECT_NE(stock, StockInfo("BRK-B", 1.0f));
+    EXPECT_EQ(StockInfo().ticker(), "");
+    EXPECT_EQ(sizeof(StockInfo), 8u);
+}
+
 TEST_F(TypesTest, DayDataClear) {
     DayData day;
-    day.add_stock(StockInfo(\"AAPL\", 0.5f));
+    day.add_stock(StockInfo("AAPL", 0.5f));
     EXPECT_FALSE(day.empty());
     
     day.clear();
@@ -99,13 +129,13 @@ TEST_F(TypesTest, CacheDataConstruction) {
 
 TEST_F(TypesTest, CacheDataWithData) {
     std::unordered_map<std::string, std::vector<float>> response;
-    response[\"AAPL\"] = {100.0f, 101.0f, 102.0f};
+    response["AAPL"] = {100.0f, 101.0f, 102.0f};
     
     CacheData cache(response, 5, true);
     EXPECT_EQ(cache.uncalculated_days(), 5);
     EXPECT_TRUE(cache.cache_present());
     EXPECT_EQ(cache.response().size(), 1);
-    EXPECT_EQ(cache.response().at(\"AAPL\").size(), 3);
+    EXPECT_EQ(cache.response().at("AAPL").size(), 3);
 }
 
 // SubtreeContext tests
@@ -121,8 +151,8 @@ TEST_F(TypesTest, SubtreeContextConstruction) {
 
 TEST_F(TypesTest, SubtreeContextWithData) {
     std::vector<DayData> history(10);
-    std::unordered_map<std::string, int> flow_count{{\"hash1\", 5}};
-    std::vector<std::string> dates{\"2024-01-01\", \"2024-01-02\"};
+    std::unordered_map<std::string, int> flow_count{{"hash1", 5}};
+    std::vector<std::string> dates{"2024-01-01", "2024-01-02"};
     std::vector<bool> mask{true, false, true};
     
     SubtreeContext context(30, history, flow_count, {}, dates, mask, 25);
@@ -133,4 +163,4 @@ TEST_F(TypesTest, SubtreeContextWithData) {
     EXPECT_EQ(context.flow_count().size(), 1);
     EXPECT_EQ(context.trading_dates().size(), 2);
     EXPECT_EQ(context.active_mask().size(), 3);
-}", "original_text": "", "replace_all": false}]
\ No newline at end of file
+}
\ No newline at end of file
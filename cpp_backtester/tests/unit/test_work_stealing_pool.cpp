@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "work_stealing_pool.h"
+#include <chrono>
+#include <ctime>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+using namespace atlas;
+
+TEST(WorkStealingPoolTest, RunsEveryTaskOnce) {
+    WorkStealingPool pool(4);
+    EXPECT_EQ(pool.thread_count(), 4u);
+
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallel_for(hits.size(), [&hits](size_t i) { hits[i]++; });
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+    pool.parallel_for(0, [](size_t) { FAIL(); });
+}
+
+TEST(WorkStealingPoolTest, NestedParallelFor) {
+    WorkStealingPool pool(2);
+
+    // More nested fork-joins than workers must not deadlock
+    std::vector<long> sums(8, 0);
+    pool.parallel_for(sums.size(), [&](size_t outer) {
+        std::vector<long> inner(64);
+        pool.parallel_for(inner.size(), [&](size_t i) { inner[i] = static_cast<long>(outer * i); });
+        sums[outer] = std::accumulate(inner.begin(), inner.end(), 0L);
+    });
+
+    for (size_t outer = 0; outer < sums.size(); ++outer) {
+        EXPECT_EQ(sums[outer], static_cast<long>(outer * 63 * 64 / 2));
+    }
+}
+
+TEST(WorkStealingPoolTest, WaitingCallerSleeps) {
+    WorkStealingPool pool(1);
+    std::atomic<bool> started{false};
+    timespec begin{};
+
+    // Task 0 runs on the caller and returns once the worker holds task 1, leaving nothing to help with
+    pool.parallel_for(2, [&](size_t i) {
+        if (i == 1) {
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            return;
+        }
+        while (!started) {
+            std::this_thread::yield();
+        }
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &begin);
+    });
+
+    timespec end{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+    const double cpu_ms = (end.tv_sec - begin.tv_sec) * 1e3 + (end.tv_nsec - begin.tv_nsec) / 1e6;
+    EXPECT_LT(cpu_ms, 20.0);
+}
+
+TEST(WorkStealingPoolTest, RethrowsLowestIndexError) {
+    WorkStealingPool pool(3);
+    std::atomic<int> completed{0};
+
+    try {
+        pool.parallel_for(16, [&](size_t i) {
+            if (i == 5 || i == 11) {
+                throw std::runtime_error("task " + std::to_string(i));
+            }
+            completed++;
+        });
+        FAIL() << "expected an exception";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "task 5");
+    }
+    EXPECT_EQ(completed.load(), 14);
+}